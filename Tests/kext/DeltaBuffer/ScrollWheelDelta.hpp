@@ -0,0 +1 @@
+../../../src/core/kext/Classes/ScrollWheelDelta.hpp
\ No newline at end of file
@@ -1,10 +1,13 @@
 #define CATCH_CONFIG_MAIN
 #include "../../include/catch.hpp"
 
+#include <chrono>
+#include <iostream>
 #include <ostream>
 #include <stdexcept>
 
 #include "DeltaBuffer.hpp"
+#include "ScrollWheelDelta.hpp"
 
 using namespace org_pqrs_Karabiner;
 
@@ -53,3 +56,164 @@ TEST_CASE("push", "[DeltaBuffer]") {
   REQUIRE(deltaBuffer.sum() == 0);
   REQUIRE(deltaBuffer.isFull() == false);
 }
+
+TEST_CASE("ring buffer", "[DeltaBuffer]") {
+  DeltaBuffer deltaBuffer;
+
+  // The sum is the sum of the last 5 values.
+  for (int i = 1; i <= 20; ++i) {
+    deltaBuffer.push(i);
+
+    int expected = 0;
+    for (int j = i; j > 0 && j > i - 5; --j) {
+      expected += j;
+    }
+    REQUIRE(deltaBuffer.sum() == expected);
+  }
+
+  // Values are cleared when the direction is changed, even if the ring buffer is wrapped around.
+  deltaBuffer.push(-2);
+  REQUIRE(deltaBuffer.sum() == -2);
+  REQUIRE(deltaBuffer.isFull() == false);
+
+  for (int i = 0; i < 4; ++i) {
+    deltaBuffer.push(-2);
+  }
+  REQUIRE(deltaBuffer.sum() == -10);
+  REQUIRE(deltaBuffer.isFull() == true);
+
+  deltaBuffer.push(0);
+  REQUIRE(deltaBuffer.sum() == -8);
+}
+
+TEST_CASE("benchmark", "[DeltaBuffer]") {
+  // A 1000 Hz mouse moving for 60 seconds.
+  const int EVENTS = 1000 * 60;
+
+  DeltaBuffer deltaBuffer;
+  long long total = 0;
+
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < EVENTS; ++i) {
+    // Change the direction sometimes.
+    int dx = ((i / 500) % 2 == 0) ? (i % 7) + 1 : -((i % 5) + 1);
+    deltaBuffer.push(dx);
+    total += deltaBuffer.sum();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(total != 0);
+
+  double microseconds = std::chrono::duration<double, std::micro>(end - begin).count();
+  std::cout << "DeltaBuffer: " << EVENTS << " events in " << microseconds << " us" << std::endl;
+
+  // Convert each event into a scroll wheel event.
+  ScrollWheelDelta scrollWheelDelta;
+  long long sumFixedDelta = 0;
+
+  begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < EVENTS; ++i) {
+    short deltaAxis = 0;
+    int fixedDelta = 0;
+    int pointDelta = 0;
+    scrollWheelDelta.convert(((i % 7) + 1) * ScrollWheelDelta::DELTA_SCALE, 150, deltaAxis, fixedDelta, pointDelta);
+    sumFixedDelta += fixedDelta;
+  }
+  end = std::chrono::steady_clock::now();
+
+  REQUIRE(sumFixedDelta != 0);
+
+  microseconds = std::chrono::duration<double, std::micro>(end - begin).count();
+  std::cout << "ScrollWheelDelta: " << EVENTS << " events in " << microseconds << " us" << std::endl;
+}
+
+TEST_CASE("convert", "[ScrollWheelDelta]") {
+  // relative2scroll_rate == 1024 (1.0)
+  {
+    ScrollWheelDelta scrollWheelDelta;
+    short deltaAxis = 0;
+    int fixedDelta = 0;
+    int pointDelta = 0;
+
+    scrollWheelDelta.convert(3 * ScrollWheelDelta::DELTA_SCALE, 1024, deltaAxis, fixedDelta, pointDelta);
+    REQUIRE(deltaAxis == 3);
+    REQUIRE(fixedDelta == 3 * ScrollWheelDelta::FIXED_SCALE);
+    REQUIRE(pointDelta == 30);
+
+    scrollWheelDelta.convert(0, 1024, deltaAxis, fixedDelta, pointDelta);
+    REQUIRE(deltaAxis == 0);
+    REQUIRE(fixedDelta == 0);
+    REQUIRE(pointDelta == 0);
+  }
+
+  // Fractions are carried over.
+  {
+    ScrollWheelDelta scrollWheelDelta;
+    short deltaAxis = 0;
+    int fixedDelta = 0;
+    int pointDelta = 0;
+
+    int sumDeltaAxis = 0;
+    long long sumFixedDelta = 0;
+    int sumPointDelta = 0;
+
+    // 0.25 lines per event.
+    for (int i = 0; i < 8; ++i) {
+      scrollWheelDelta.convert(ScrollWheelDelta::DELTA_SCALE / 4, 1024, deltaAxis, fixedDelta, pointDelta);
+      sumDeltaAxis += deltaAxis;
+      sumFixedDelta += fixedDelta;
+      sumPointDelta += pointDelta;
+
+      REQUIRE(fixedDelta == ScrollWheelDelta::FIXED_SCALE / 4);
+      REQUIRE(sumDeltaAxis == (i + 1) / 4);
+    }
+    REQUIRE(sumDeltaAxis == 2);
+    REQUIRE(sumFixedDelta == 2 * ScrollWheelDelta::FIXED_SCALE);
+    REQUIRE(sumPointDelta == 20);
+  }
+
+  // The default rate (150 / 1024) with odd deltas.
+  {
+    ScrollWheelDelta scrollWheelDelta;
+    short deltaAxis = 0;
+    int fixedDelta = 0;
+    int pointDelta = 0;
+
+    long long sumInput = 0;
+    long long sumFixedDelta = 0;
+    long long sumPointDelta = 0;
+    for (int i = 0; i < 1000; ++i) {
+      int delta = (i % 13) * ScrollWheelDelta::DELTA_SCALE + (i % 3);
+      sumInput += delta;
+
+      scrollWheelDelta.convert(delta, 150, deltaAxis, fixedDelta, pointDelta);
+      sumFixedDelta += fixedDelta;
+      sumPointDelta += pointDelta;
+    }
+
+    // The difference from the exact value is less than one unit.
+    long long denominator = static_cast<long long>(ScrollWheelDelta::RATE_SCALE) * ScrollWheelDelta::DELTA_SCALE;
+    REQUIRE(sumFixedDelta == sumInput * 150 * ScrollWheelDelta::FIXED_SCALE / denominator);
+    REQUIRE(sumPointDelta == sumFixedDelta * ScrollWheelDelta::POINT_SCALE / ScrollWheelDelta::FIXED_SCALE);
+  }
+
+  // The carry is cleared when the direction is changed.
+  {
+    ScrollWheelDelta scrollWheelDelta;
+    short deltaAxis = 0;
+    int fixedDelta = 0;
+    int pointDelta = 0;
+
+    scrollWheelDelta.convert(ScrollWheelDelta::DELTA_SCALE * 3 / 4, 1024, deltaAxis, fixedDelta, pointDelta);
+    REQUIRE(deltaAxis == 0);
+
+    scrollWheelDelta.convert(-ScrollWheelDelta::DELTA_SCALE / 2, 1024, deltaAxis, fixedDelta, pointDelta);
+    REQUIRE(deltaAxis == 0);
+    REQUIRE(fixedDelta == -ScrollWheelDelta::FIXED_SCALE / 2);
+    REQUIRE(pointDelta == -5);
+
+    scrollWheelDelta.convert(-ScrollWheelDelta::DELTA_SCALE / 2, 1024, deltaAxis, fixedDelta, pointDelta);
+    REQUIRE(deltaAxis == -1);
+    REQUIRE(pointDelta == -5);
+  }
+}
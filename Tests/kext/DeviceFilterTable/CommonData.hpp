@@ -0,0 +1 @@
+../mock/CommonData.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/DeviceFilterTable.cpp
\ No newline at end of file
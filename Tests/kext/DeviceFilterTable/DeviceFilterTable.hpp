@@ -0,0 +1 @@
+../../../src/core/kext/Classes/DeviceFilterTable.hpp
\ No newline at end of file
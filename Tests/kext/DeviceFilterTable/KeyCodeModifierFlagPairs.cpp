@@ -0,0 +1 @@
+../../../src/core/kext/Classes/KeyCodeModifierFlagPairs.cpp
\ No newline at end of file
@@ -0,0 +1,236 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <ostream>
+#include <vector>
+
+#include "Config.hpp"
+#include "DeviceFilterTable.hpp"
+
+using namespace org_pqrs_Karabiner;
+Config config;
+
+namespace {
+DeviceIdentifier makeDeviceIdentifier(unsigned int vendor, unsigned int product, unsigned int location) {
+  return DeviceIdentifier(DeviceVendor(vendor), DeviceProduct(product), DeviceLocation(location));
+}
+
+uint32_t registerTargets(const std::vector<DeviceIdentifier>& targets) {
+  Vector_DeviceIdentifier v;
+  for (const auto& t : targets) {
+    v.push_back(t);
+  }
+  return DeviceFilterTable::registerTargets(v);
+}
+
+// The algorithm of DeviceFilter::isblocked before DeviceFilterTable.
+bool isMatched(const DeviceIdentifier& deviceIdentifier, const std::vector<DeviceIdentifier>& targets) {
+  for (const auto& t : targets) {
+    if (deviceIdentifier.isEqual(t)) return true;
+  }
+  return false;
+}
+
+void reset(void) {
+  DeviceFilterTable::clearTargets();
+  DeviceFilterTable::clearDevices();
+}
+}
+
+TEST_CASE("empty", "[DeviceFilterTable]") {
+  reset();
+
+  DeviceFilterTable::setCurrentDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(0) == false);
+  REQUIRE(DeviceFilterTable::exists(0) == false);
+
+  // Filters which have no target.
+  uint32_t id = registerTargets({});
+  REQUIRE(id == 0);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id) == false);
+  REQUIRE(DeviceFilterTable::exists(id) == false);
+}
+
+TEST_CASE("wildcard", "[DeviceFilterTable]") {
+  reset();
+
+  const unsigned int vendors[] = {0x05ac, 0x046d};
+  const unsigned int products[] = {0x0250, 0x0251, DeviceProduct::ANY.get()};
+  const unsigned int locations[] = {0x1234, 0x5678, DeviceLocation::ANY.get()};
+
+  // All combinations of vendors, products (including wildcard) and locations (including wildcard).
+  std::vector<DeviceIdentifier> identifiers;
+  for (auto v : vendors) {
+    for (auto p : products) {
+      for (auto l : locations) {
+        identifiers.push_back(makeDeviceIdentifier(v, p, l));
+      }
+    }
+  }
+
+  // Filters which have one target and filters which have two targets.
+  std::vector<std::vector<DeviceIdentifier>> filters;
+  std::vector<uint32_t> ids;
+  for (size_t i = 0; i < identifiers.size(); ++i) {
+    filters.push_back({identifiers[i]});
+    filters.push_back({identifiers[i], identifiers[(i * 7 + 3) % identifiers.size()]});
+  }
+  for (const auto& f : filters) {
+    ids.push_back(registerTargets(f));
+  }
+  REQUIRE(ids.size() > 32);
+
+  // Hooked devices do not have wildcard values.
+  std::vector<DeviceIdentifier> devices = {
+      makeDeviceIdentifier(0x05ac, 0x0250, 0x1234),
+      makeDeviceIdentifier(0x05ac, 0x0251, 0x5678),
+  };
+  for (const auto& d : devices) {
+    DeviceFilterTable::addDevice(d);
+  }
+
+  // Events of hooked devices and events of a disconnected device.
+  std::vector<DeviceIdentifier> currents = devices;
+  currents.push_back(makeDeviceIdentifier(0x046d, 0x0250, 0x5678));
+  currents.push_back(makeDeviceIdentifier(0x05ac, 0x9999, 0x1234));
+
+  size_t mismatch = 0;
+  for (const auto& c : currents) {
+    DeviceFilterTable::setCurrentDevice(c);
+    for (size_t i = 0; i < filters.size(); ++i) {
+      if (DeviceFilterTable::isCurrentDeviceMatched(ids[i]) != isMatched(c, filters[i])) {
+        ++mismatch;
+      }
+    }
+  }
+  REQUIRE(mismatch == 0);
+
+  for (size_t i = 0; i < filters.size(); ++i) {
+    bool expected = false;
+    for (const auto& d : devices) {
+      if (isMatched(d, filters[i])) {
+        expected = true;
+      }
+    }
+    if (DeviceFilterTable::exists(ids[i]) != expected) {
+      ++mismatch;
+    }
+  }
+  REQUIRE(mismatch == 0);
+
+  // (vendor, ANY, ANY) matches all devices of the vendor.
+  DeviceFilterTable::setCurrentDevice(makeDeviceIdentifier(0x05ac, 0x0251, 0x1234));
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(registerTargets({makeDeviceIdentifier(0x05ac, DeviceProduct::ANY.get(), DeviceLocation::ANY.get())})) == true);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(registerTargets({makeDeviceIdentifier(0x046d, DeviceProduct::ANY.get(), DeviceLocation::ANY.get())})) == false);
+}
+
+TEST_CASE("devices", "[DeviceFilterTable]") {
+  reset();
+
+  uint32_t apple = registerTargets({makeDeviceIdentifier(0x05ac, DeviceProduct::ANY.get(), DeviceLocation::ANY.get())});
+  uint32_t logitech = registerTargets({makeDeviceIdentifier(0x046d, 0xc52b, DeviceLocation::ANY.get())});
+
+  REQUIRE(DeviceFilterTable::exists(apple) == false);
+  REQUIRE(DeviceFilterTable::exists(logitech) == false);
+
+  // connect
+  DeviceFilterTable::clearDevices();
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  REQUIRE(DeviceFilterTable::exists(apple) == true);
+  REQUIRE(DeviceFilterTable::exists(logitech) == false);
+
+  DeviceFilterTable::clearDevices();
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x046d, 0xc52b, 0x5678));
+  REQUIRE(DeviceFilterTable::exists(apple) == true);
+  REQUIRE(DeviceFilterTable::exists(logitech) == true);
+
+  DeviceFilterTable::setCurrentDevice(makeDeviceIdentifier(0x046d, 0xc52b, 0x5678));
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(apple) == false);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(logitech) == true);
+
+  // disconnect
+  DeviceFilterTable::clearDevices();
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  REQUIRE(DeviceFilterTable::exists(apple) == true);
+  REQUIRE(DeviceFilterTable::exists(logitech) == false);
+
+  // The current device is resolved even if it is disconnected.
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(apple) == false);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(logitech) == true);
+}
+
+TEST_CASE("targets", "[DeviceFilterTable]") {
+  reset();
+
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  DeviceFilterTable::setCurrentDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+
+  // Filters which are registered after devices are connected.
+  uint32_t id1 = registerTargets({makeDeviceIdentifier(0x05ac, 0x0250, DeviceLocation::ANY.get())});
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id1) == true);
+  REQUIRE(DeviceFilterTable::exists(id1) == true);
+
+  uint32_t id2 = registerTargets({makeDeviceIdentifier(0x05ac, 0x0250, 0x5678)});
+  REQUIRE(id2 != id1);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id1) == true);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id2) == false);
+  REQUIRE(DeviceFilterTable::exists(id2) == false);
+
+  // Ids are invalid after clearTargets.
+  DeviceFilterTable::clearTargets();
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id1) == false);
+  REQUIRE(DeviceFilterTable::exists(id1) == false);
+}
+
+TEST_CASE("unregisterTargets", "[DeviceFilterTable]") {
+  reset();
+
+  DeviceFilterTable::addDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+  DeviceFilterTable::setCurrentDevice(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+
+  uint32_t apple = registerTargets({makeDeviceIdentifier(0x05ac, DeviceProduct::ANY.get(), DeviceLocation::ANY.get())});
+  uint32_t logitech = registerTargets({makeDeviceIdentifier(0x046d, 0xc52b, DeviceLocation::ANY.get())});
+
+  // A released id does not match any device.
+  DeviceFilterTable::unregisterTargets(apple);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(apple) == false);
+  REQUIRE(DeviceFilterTable::exists(apple) == false);
+
+  // The released id is reused.
+  uint32_t id = registerTargets({makeDeviceIdentifier(0x05ac, 0x0250, DeviceLocation::ANY.get())});
+  REQUIRE(id == apple);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id) == true);
+  REQUIRE(DeviceFilterTable::exists(id) == true);
+  REQUIRE(DeviceFilterTable::exists(logitech) == false);
+
+  // Repeated replacements of filters (remapclasses delta) do not grow the table.
+  std::vector<uint32_t> ids;
+  for (int i = 0; i < 100; ++i) {
+    ids.push_back(registerTargets({
+        makeDeviceIdentifier(0x05ac, 0x0250 + i, DeviceLocation::ANY.get()),
+        makeDeviceIdentifier(0x046d, 0xc52b, 0x5678),
+    }));
+  }
+  size_t idCount = DeviceFilterTable::idCount();
+
+  for (int n = 0; n < 1000; ++n) {
+    size_t i = (n * 7) % ids.size();
+    DeviceFilterTable::unregisterTargets(ids[i]);
+    ids[i] = registerTargets({
+        makeDeviceIdentifier(0x05ac, 0x0250 + n % 2, DeviceLocation::ANY.get()),
+        makeDeviceIdentifier(0x046d, 0xc52b, 0x5678),
+    });
+
+    REQUIRE(DeviceFilterTable::idCount() == idCount);
+    REQUIRE(DeviceFilterTable::targetCount() <= 2 * (2 * ids.size() + 1));
+  }
+
+  // Targets of registered ids are kept after compaction.
+  for (int n = 990; n < 1000; ++n) {
+    size_t i = (n * 7) % ids.size();
+    REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(ids[i]) == (n % 2 == 0));
+  }
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(id) == true);
+  REQUIRE(DeviceFilterTable::isCurrentDeviceMatched(logitech) == false);
+}
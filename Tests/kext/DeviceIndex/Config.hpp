@@ -0,0 +1 @@
+../mock/Config.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/DeviceIndex.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/FlagStatus.hpp
\ No newline at end of file
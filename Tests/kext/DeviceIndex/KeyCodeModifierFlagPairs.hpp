@@ -0,0 +1 @@
+../../../src/core/kext/Classes/KeyCodeModifierFlagPairs.hpp
\ No newline at end of file
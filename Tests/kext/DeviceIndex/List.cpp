@@ -0,0 +1 @@
+../../../src/core/kext/Classes/List.cpp
\ No newline at end of file
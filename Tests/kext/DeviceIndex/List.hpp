@@ -0,0 +1 @@
+../../../src/core/kext/Classes/List.hpp
\ No newline at end of file
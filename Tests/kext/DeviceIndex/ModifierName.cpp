@@ -0,0 +1 @@
+../../../src/core/kext/Classes/ModifierName.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../mock/Types.hpp
\ No newline at end of file
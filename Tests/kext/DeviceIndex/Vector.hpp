@@ -0,0 +1 @@
+../../../src/core/kext/Classes/Vector.hpp
\ No newline at end of file
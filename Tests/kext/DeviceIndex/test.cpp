@@ -0,0 +1,142 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <ostream>
+#include <vector>
+
+#include "Config.hpp"
+#include "DeviceIndex.hpp"
+#include "List.hpp"
+
+using namespace org_pqrs_Karabiner;
+Config config;
+
+namespace {
+class TestItem final : public List::Item {
+public:
+  TestItem(const DeviceIdentifier& deviceIdentifier) : deviceIdentifier_(deviceIdentifier) {}
+  virtual ~TestItem(void) {}
+
+  // We use the address of TestItem as a device pointer.
+  const void* device(void) const { return this; }
+  const DeviceIdentifier& getDeviceIdentifier(void) const { return deviceIdentifier_; }
+
+private:
+  DeviceIdentifier deviceIdentifier_;
+};
+
+void rebuild(DeviceIndex& index, const List& list) {
+  index.reserve(list.size());
+  for (auto p = static_cast<TestItem*>(list.safe_front()); p; p = static_cast<TestItem*>(p->getnext())) {
+    index.add(p->device(), p, p->getDeviceIdentifier());
+  }
+}
+
+DeviceIdentifier makeDeviceIdentifier(unsigned int vendor, unsigned int product, unsigned int location) {
+  return DeviceIdentifier(DeviceVendor(vendor), DeviceProduct(product), DeviceLocation(location));
+}
+}
+
+TEST_CASE("empty", "[DeviceIndex]") {
+  DeviceIndex index;
+  REQUIRE(index.size() == 0);
+  REQUIRE(index.get(nullptr) == nullptr);
+  REQUIRE(index.get(&index) == nullptr);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234)) == false);
+
+  index.reserve(0);
+  REQUIRE(index.get(&index) == nullptr);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234)) == false);
+}
+
+TEST_CASE("get", "[DeviceIndex]") {
+  List list;
+  DeviceIndex index;
+  std::vector<TestItem*> items;
+
+  for (int i = 0; i < 100; ++i) {
+    auto p = new TestItem(makeDeviceIdentifier(0x05ac, i, 0));
+    list.push_back(p);
+    items.push_back(p);
+
+    rebuild(index, list);
+    REQUIRE(index.size() == static_cast<size_t>(i + 1));
+  }
+
+  for (auto& p : items) {
+    REQUIRE(index.get(p->device()) == p);
+  }
+  REQUIRE(index.get(nullptr) == nullptr);
+  REQUIRE(index.get(&list) == nullptr);
+
+  // erase
+  for (size_t i = 0; i < items.size(); i += 2) {
+    list.erase_and_delete(items[i]);
+  }
+  rebuild(index, list);
+  REQUIRE(index.size() == 50);
+
+  for (size_t i = 1; i < items.size(); i += 2) {
+    REQUIRE(index.get(items[i]->device()) == items[i]);
+  }
+
+  index.clear();
+  REQUIRE(index.size() == 0);
+  REQUIRE(index.get(items[1]->device()) == nullptr);
+}
+
+TEST_CASE("add without reserve", "[DeviceIndex]") {
+  DeviceIndex index;
+  TestItem item(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234));
+
+  index.add(item.device(), &item, item.getDeviceIdentifier());
+  REQUIRE(index.size() == 0);
+  REQUIRE(index.get(item.device()) == nullptr);
+}
+
+TEST_CASE("exists", "[DeviceIndex]") {
+  List list;
+  DeviceIndex index;
+
+  list.push_back(new TestItem(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234)));
+  list.push_back(new TestItem(makeDeviceIdentifier(0x046d, 0xc52b, 0x5678)));
+  list.push_back(new TestItem(makeDeviceIdentifier(0x046d, 0xc52b, 0x9abc)));
+  rebuild(index, list);
+
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0250, 0x1234)) == true);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0250, 0)) == true);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0, 0x1234)) == true);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0, 0)) == true);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x046d, 0xc52b, 0x9abc)) == true);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x046d, 0, 0)) == true);
+
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0250, 0x5678)) == false);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0x0251, 0)) == false);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0, 0x5678)) == false);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x046d, 0xc52b, 0x1234)) == false);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x1234, 0, 0)) == false);
+
+  // Compare with DeviceIdentifier::isEqual.
+  for (auto query : {
+           makeDeviceIdentifier(0x05ac, 0x0250, 0x1234),
+           makeDeviceIdentifier(0x05ac, 0, 0x9abc),
+           makeDeviceIdentifier(0x046d, 0xc52b, 0),
+           makeDeviceIdentifier(0x046d, 0xc52b, 0x1234),
+           makeDeviceIdentifier(0x046d, 0, 0x5678),
+           makeDeviceIdentifier(0, 0, 0),
+       }) {
+    bool expected = false;
+    for (auto p = static_cast<TestItem*>(list.safe_front()); p; p = static_cast<TestItem*>(p->getnext())) {
+      if (p->getDeviceIdentifier().isEqual(query)) {
+        expected = true;
+      }
+    }
+    REQUIRE(index.exists(query) == expected);
+  }
+
+  // erase
+  list.pop_front();
+  rebuild(index, list);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x05ac, 0, 0)) == false);
+  REQUIRE(index.exists(makeDeviceIdentifier(0x046d, 0, 0)) == true);
+}
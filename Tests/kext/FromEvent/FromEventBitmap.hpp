@@ -0,0 +1 @@
+../../../src/core/kext/Classes/FromEventBitmap.hpp
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <ostream>
 
 #include "FromEvent.hpp"
+#include "FromEventBitmap.hpp"
 #include "KeyCodeModifierFlagPairs.hpp"
 
 using namespace org_pqrs_Karabiner;
@@ -240,3 +241,53 @@ TEST_CASE("isTargetDownEvent", "[Generic]") {
     REQUIRE(fe.isTargetUpEvent(*up_shift) == true);
   }
 }
+
+TEST_CASE("FromEventBitmap", "[Generic]") {
+  FromEventBitmap bitmap;
+
+  REQUIRE(bitmap.isTarget(*down_return) == false);
+  REQUIRE(bitmap.isTarget(*down_shift) == false);
+
+  bitmap.add(FromEvent(KeyCode::RETURN));
+  bitmap.add(FromEvent(ConsumerKeyCode::VOLUME_MUTE));
+  bitmap.add(FromEvent(PointingButton::LEFT));
+  bitmap.add(FromEvent());
+
+  REQUIRE(bitmap.isTarget(*down_return) == true);
+  REQUIRE(bitmap.isTarget(*up_return) == true);
+  REQUIRE(bitmap.isTarget(*down_shift) == false);
+  REQUIRE(bitmap.isTarget(*up_shift) == false);
+
+  {
+    Params_KeyboardSpecialEventCallback params(EventType::DOWN, Flags(0), ConsumerKeyCode::VOLUME_MUTE, false);
+    REQUIRE(bitmap.isTarget(params) == true);
+  }
+  {
+    Params_KeyboardSpecialEventCallback params(EventType::DOWN, Flags(0), ConsumerKeyCode::VOLUME_UP, false);
+    REQUIRE(bitmap.isTarget(params) == false);
+  }
+  {
+    Params_RelativePointerEventCallback params(Buttons(0), 0, 0, PointingButton::LEFT, true);
+    REQUIRE(bitmap.isTarget(params) == true);
+  }
+  {
+    Params_RelativePointerEventCallback params(Buttons(0), 0, 0, PointingButton::RIGHT, true);
+    REQUIRE(bitmap.isTarget(params) == false);
+  }
+  {
+    // Pointer move events are not target.
+    Params_RelativePointerEventCallback params(Buttons(0), 10, 0, PointingButton::NONE, false);
+    REQUIRE(bitmap.isTarget(params) == false);
+  }
+
+  // Virtual KeyCodes
+  {
+    Params_KeyboardEventCallBack params(EventType::DOWN, Flags(0), KeyCode::VK_NONE, CharCode(0), CharSet(0), OrigCharCode(0), OrigCharSet(0), KeyboardType(0), false);
+    REQUIRE(bitmap.isTarget(params) == false);
+    bitmap.add(FromEvent(KeyCode::VK_LOCK_SHIFT_L));
+    REQUIRE(bitmap.isTarget(params) == true);
+  }
+
+  bitmap.clear();
+  REQUIRE(bitmap.isTarget(*down_return) == false);
+}
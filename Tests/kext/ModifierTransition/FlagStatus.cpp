@@ -0,0 +1 @@
+../../../src/core/kext/Classes/FlagStatus.cpp
\ No newline at end of file
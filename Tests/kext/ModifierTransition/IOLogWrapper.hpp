@@ -0,0 +1 @@
+../mock/IOLogWrapper.hpp
\ No newline at end of file
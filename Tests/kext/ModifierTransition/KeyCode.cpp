@@ -0,0 +1 @@
+../../../src/core/kext/KeyCode.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/KeyCode.hpp
\ No newline at end of file
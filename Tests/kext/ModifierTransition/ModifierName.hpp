@@ -0,0 +1 @@
+../../../src/core/kext/Classes/ModifierName.hpp
\ No newline at end of file
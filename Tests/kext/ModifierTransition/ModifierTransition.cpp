@@ -0,0 +1 @@
+../../../src/core/kext/Classes/ModifierTransition.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/ModifierTransition.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/lib/strlcpy_utf8/strlcpy_utf8.hpp
\ No newline at end of file
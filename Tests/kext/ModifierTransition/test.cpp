@@ -0,0 +1,184 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Config.hpp"
+#include "FlagStatus.hpp"
+#include "KeyCode.hpp"
+#include "KeyCodeModifierFlagPairs.hpp"
+#include "ModifierTransition.hpp"
+
+using namespace org_pqrs_Karabiner;
+Config config;
+
+namespace {
+typedef std::vector<std::pair<unsigned int, unsigned int>> Events;
+
+// The algorithm of EventOutputQueue::FireModifiers::fire before ModifierTransition.
+// (Return (key, flags) of events and set the last flags into `lastFlags`.)
+Events fire(Flags& lastFlags, Flags toFlags) {
+  Events events;
+  if (lastFlags == toFlags) return events;
+
+  if (!toFlags.isOn(ModifierFlag::NUMPAD)) {
+    lastFlags.remove(ModifierFlag::NUMPAD);
+  }
+
+  for (size_t i = 0; i < FlagStatus::globalFlagStatus().itemSize(); ++i) {
+    ModifierFlag flag = FlagStatus::globalFlagStatus().getFlag(i);
+    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
+    if (flag.getRawBits() == 0) continue;
+    if (!lastFlags.isOn(flag)) continue;
+    if (toFlags.isOn(flag)) continue;
+
+    lastFlags.remove(flag);
+    events.push_back(std::make_pair(flag.getKeyCode().get(), lastFlags.get()));
+  }
+
+  for (size_t i = 0; i < FlagStatus::globalFlagStatus().itemSize(); ++i) {
+    ModifierFlag flag = FlagStatus::globalFlagStatus().getFlag(i);
+    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
+    if (flag.getRawBits() == 0) continue;
+    if (!toFlags.isOn(flag)) continue;
+    if (lastFlags.isOn(flag)) continue;
+
+    lastFlags.add(flag);
+    events.push_back(std::make_pair(flag.getKeyCode().get(), lastFlags.get()));
+  }
+
+  if (toFlags.isOn(ModifierFlag::NUMPAD)) {
+    lastFlags.add(ModifierFlag::NUMPAD);
+  }
+
+  return events;
+}
+
+Events getEvents(const ModifierTransition& transition) {
+  Events events;
+  for (size_t i = 0; i < transition.size(); ++i) {
+    events.push_back(std::make_pair(transition[i].key.get(), transition[i].flags.get()));
+  }
+  return events;
+}
+
+// All combinations of physical modifiers and ModifierFlag::NUMPAD.
+std::vector<Flags> getAllFlags(void) {
+  const ModifierFlag modifierFlags[] = {
+      ModifierFlag::CAPSLOCK,
+      ModifierFlag::COMMAND_L,
+      ModifierFlag::COMMAND_R,
+      ModifierFlag::CONTROL_L,
+      ModifierFlag::CONTROL_R,
+      ModifierFlag::FN,
+      ModifierFlag::OPTION_L,
+      ModifierFlag::OPTION_R,
+      ModifierFlag::SHIFT_L,
+      ModifierFlag::SHIFT_R,
+      ModifierFlag::NUMPAD,
+  };
+  const size_t size = sizeof(modifierFlags) / sizeof(modifierFlags[0]);
+
+  std::vector<Flags> v;
+  for (size_t bits = 0; bits < (1u << size); ++bits) {
+    Flags flags(0);
+    for (size_t i = 0; i < size; ++i) {
+      if (bits & (1u << i)) {
+        flags.add(modifierFlags[i]);
+      }
+    }
+    v.push_back(flags);
+  }
+  return v;
+}
+}
+
+TEST_CASE("setUp", "[Generic]") {
+  KeyCodeModifierFlagPairs::clearVirtualModifiers();
+}
+
+TEST_CASE("make", "[ModifierTransition]") {
+  ModifierTransition transition;
+
+  transition.make(Flags(ModifierFlag::SHIFT_L), Flags(ModifierFlag::SHIFT_L));
+  REQUIRE(transition.size() == 0);
+  REQUIRE(transition.getLastFlags() == Flags(ModifierFlag::SHIFT_L));
+
+  // KeyUp events are sent before KeyDown events.
+  transition.make(Flags(ModifierFlag::COMMAND_L), Flags(ModifierFlag::OPTION_L).add(ModifierFlag::SHIFT_L));
+  REQUIRE(transition.size() == 3);
+  REQUIRE(transition[0].key == KeyCode::COMMAND_L);
+  REQUIRE(transition[0].flags == Flags(0));
+  REQUIRE(transition[1].key == KeyCode::OPTION_L);
+  REQUIRE(transition[1].flags == Flags(ModifierFlag::OPTION_L));
+  REQUIRE(transition[2].key == KeyCode::SHIFT_L);
+  REQUIRE(transition[2].flags == Flags(ModifierFlag::OPTION_L).add(ModifierFlag::SHIFT_L));
+  REQUIRE(transition.getLastFlags() == Flags(ModifierFlag::OPTION_L).add(ModifierFlag::SHIFT_L));
+
+  // ModifierFlag::NUMPAD is not included in modifier events.
+  transition.make(Flags(0), Flags(ModifierFlag::SHIFT_L).add(ModifierFlag::NUMPAD));
+  REQUIRE(transition.size() == 1);
+  REQUIRE(transition[0].flags == Flags(ModifierFlag::SHIFT_L));
+  REQUIRE(transition.getLastFlags() == Flags(ModifierFlag::SHIFT_L).add(ModifierFlag::NUMPAD));
+
+  transition.make(Flags(ModifierFlag::SHIFT_L).add(ModifierFlag::NUMPAD), Flags(0));
+  REQUIRE(transition.size() == 1);
+  REQUIRE(transition[0].flags == Flags(0));
+  REQUIRE(transition.getLastFlags() == Flags(0));
+}
+
+TEST_CASE("equivalence", "[ModifierTransition]") {
+  std::vector<Flags> allFlags = getAllFlags();
+
+  // Compare all pairs of flags.
+  size_t mismatch = 0;
+  for (const auto& from : allFlags) {
+    for (const auto& to : allFlags) {
+      Flags lastFlags = from;
+      Events expected = fire(lastFlags, to);
+
+      const ModifierTransition& transition = ModifierTransition::get(from, to);
+      if (getEvents(transition) != expected ||
+          !(transition.getLastFlags() == lastFlags)) {
+        ++mismatch;
+      }
+    }
+  }
+  REQUIRE(mismatch == 0);
+}
+
+TEST_CASE("cache", "[ModifierTransition]") {
+  Flags from(ModifierFlag::SHIFT_L);
+  Flags to(ModifierFlag::CONTROL_L);
+
+  const ModifierTransition& t1 = ModifierTransition::get(from, to);
+  REQUIRE(t1.size() == 2);
+  // The same entry is returned.
+  REQUIRE(&(ModifierTransition::get(from, to)) == &t1);
+
+  // Entries are remade when KeyCodeModifierFlagPairs is changed.
+  uint32_t generation = KeyCodeModifierFlagPairs::getGeneration();
+  ModifierFlag m = ModifierFlag::VK__AUTOINDEX__BEGIN__;
+  KeyCodeModifierFlagPairs::registerVirtualModifier(m,
+                                                    KeyCode(0x20000000),
+                                                    KeyCode(0x20000001),
+                                                    KeyCode(0x20000002),
+                                                    KeyCode(0x20000003),
+                                                    KeyCode(0x20000004),
+                                                    KeyCode(0x20000005),
+                                                    KeyCode(0x20000006),
+                                                    KeyCode(0x20000007),
+                                                    KeyCode(0x20000008),
+                                                    KeyCode(0x20000009));
+  REQUIRE(KeyCodeModifierFlagPairs::getGeneration() != generation);
+
+  Flags lastFlags = from;
+  Events expected = fire(lastFlags, to);
+  const ModifierTransition& t2 = ModifierTransition::get(from, to);
+  REQUIRE(getEvents(t2) == expected);
+  REQUIRE(t2.getLastFlags() == lastFlags);
+
+  KeyCodeModifierFlagPairs::clearVirtualModifiers();
+}
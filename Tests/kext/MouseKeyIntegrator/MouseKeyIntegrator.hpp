@@ -0,0 +1 @@
+../../../src/core/kext/Classes/MouseKeyIntegrator.hpp
\ No newline at end of file
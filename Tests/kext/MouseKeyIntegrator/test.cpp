@@ -0,0 +1,185 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+
+#include "MouseKeyIntegrator.hpp"
+
+using namespace org_pqrs_Karabiner;
+
+namespace {
+typedef MouseKeyIntegrator::Parameters Parameters;
+
+// Move until `duration` with ticks of `period` + jitter (0 .. maxJitter) milliseconds.
+// (Return the distance of x.)
+long long move(const Parameters& parameters, uint32_t duration, uint32_t maxJitter, int dx, int dy, int magnitude) {
+  MouseKeyIntegrator integrator;
+  long long total = 0;
+  uint32_t now = 0;
+
+  while (now < duration) {
+    now += parameters.period;
+    if (maxJitter > 0) {
+      now += static_cast<uint32_t>(rand()) % (maxJitter + 1);
+    }
+    if (now > duration) {
+      now = duration;
+    }
+
+    int x = 0;
+    int y = 0;
+    integrator.integrate(parameters, now, dx, dy, magnitude, x, y);
+    total += x;
+  }
+  return total;
+}
+}
+
+TEST_CASE("constant", "[MouseKeyIntegrator]") {
+  MouseKeyIntegrator integrator;
+  Parameters parameters(Parameters::Curve::CONSTANT, 3, 0, 3, 20, 0);
+
+  int x = 0;
+  int y = 0;
+
+  // 3 units per 20 ms.
+  integrator.integrate(parameters, 20, 1, 0, 1, x, y);
+  REQUIRE(x == 3);
+  REQUIRE(y == 0);
+
+  // Fractions are carried over.
+  integrator.integrate(parameters, 30, 1, 0, 1, x, y);
+  REQUIRE(x == 1);
+  integrator.integrate(parameters, 40, 1, 0, 1, x, y);
+  REQUIRE(x == 2);
+
+  integrator.integrate(parameters, 60, -1, 1, 1, x, y);
+  REQUIRE(x == -2);
+  REQUIRE(y == 2);
+
+  // `now` which is not later than getElapsed() is ignored.
+  integrator.integrate(parameters, 60, 1, 0, 1, x, y);
+  REQUIRE(x == 0);
+  REQUIRE(integrator.getElapsed() == 60);
+}
+
+TEST_CASE("piecewise linear", "[MouseKeyIntegrator]") {
+  // The same as the default of mouse keys.
+  Parameters parameters(Parameters::Curve::PIECEWISE_LINEAR, 1, 1, 20, 20, 0);
+
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 0) == 20);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 20) == 40);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 380) == 400);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 1000) == 400);
+
+  // The speed reaches the maximum in 380 ms.
+  // (sum of 20 .. 399 + 400 * 620) / 400
+  REQUIRE(move(parameters, 1000, 0, 1, 0, 1) == (((20 + 399) * 380 / 2) + 400 * 620) / 400);
+}
+
+TEST_CASE("exponential", "[MouseKeyIntegrator]") {
+  Parameters parameters(Parameters::Curve::EXPONENTIAL, 1, 0, 20, 20, 200);
+
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 0) == 20);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 200) == 40);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 400) == 80);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 10000) == 400);
+  REQUIRE(MouseKeyIntegrator::getScaledSpeed(parameters, 0xffffffff) == 400);
+
+  long long last = 0;
+  for (uint32_t t = 0; t < 1000; ++t) {
+    long long speed = MouseKeyIntegrator::getScaledSpeed(parameters, t);
+    REQUIRE(speed >= last);
+    last = speed;
+  }
+}
+
+TEST_CASE("pow2", "[MouseKeyIntegrator]") {
+  REQUIRE(MouseKeyIntegrator::pow2(0) == 65536);
+  REQUIRE(MouseKeyIntegrator::pow2(65536) == 131072);
+  REQUIRE(MouseKeyIntegrator::pow2(3 * 65536) == 8 * 65536);
+
+  // 2^0.5
+  long long v = MouseKeyIntegrator::pow2(32768);
+  REQUIRE(v > 92682 * 997 / 1000);
+  REQUIRE(v < 92682 * 1003 / 1000);
+}
+
+TEST_CASE("jitter", "[MouseKeyIntegrator]") {
+  srand(0);
+
+  Parameters linear(Parameters::Curve::PIECEWISE_LINEAR, 1, 1, 20, 20, 0);
+  Parameters exponential(Parameters::Curve::EXPONENTIAL, 1, 0, 20, 20, 200);
+  Parameters constant(Parameters::Curve::CONSTANT, 50, 0, 50, 20, 0);
+
+  Parameters* parameters[] = {&linear, &exponential, &constant};
+  for (auto p : parameters) {
+    for (uint32_t duration : {0, 1, 7, 20, 333, 1000, 5000}) {
+      long long expected = move(*p, duration, 0, 1, 0, 1);
+      for (uint32_t jitter : {1, 5, 20, 100}) {
+        REQUIRE(move(*p, duration, jitter, 1, 0, 1) == expected);
+        REQUIRE(move(*p, duration, jitter, 1, 1, 128) == move(*p, duration, 0, 1, 1, 128));
+      }
+    }
+  }
+}
+
+TEST_CASE("diagonal", "[MouseKeyIntegrator]") {
+  Parameters parameters(Parameters::Curve::CONSTANT, 100, 0, 100, 10, 0);
+
+  REQUIRE(move(parameters, 1000, 0, 1, 0, 1) == 10000);
+  // 10000 / sqrt(2)
+  REQUIRE(move(parameters, 1000, 0, 1, 1, 1) == 7071);
+}
+
+TEST_CASE("fixed distance", "[MouseKeyIntegrator]") {
+  // Scroll 5 * DELTA_SCALE in 100 ms.
+  Parameters parameters(Parameters::Curve::CONSTANT, 1, 0, 1, 100, 0);
+
+  for (uint32_t jitter : {0, 1, 3}) {
+    MouseKeyIntegrator integrator;
+    long long total = 0;
+    uint32_t now = 0;
+    while (integrator.getElapsed() < 100) {
+      now += 1 + (jitter > 0 ? static_cast<uint32_t>(rand()) % (jitter + 1) : 0);
+      if (now > 100) now = 100;
+
+      int x = 0;
+      int y = 0;
+      integrator.integrate(parameters, now, 0, -1, 5 * 128, x, y);
+      REQUIRE(x == 0);
+      total += y;
+    }
+    REQUIRE(total == -5 * 128);
+  }
+}
+
+TEST_CASE("direction change", "[MouseKeyIntegrator]") {
+  MouseKeyIntegrator integrator;
+  Parameters parameters(Parameters::Curve::CONSTANT, 1, 0, 1, 20, 0);
+
+  int x = 0;
+  int y = 0;
+  integrator.integrate(parameters, 10, 1, 0, 1, x, y);
+  REQUIRE(x == 0);
+
+  // The carry (0.5) is cleared.
+  integrator.integrate(parameters, 20, -1, 0, 1, x, y);
+  REQUIRE(x == 0);
+  integrator.integrate(parameters, 30, -1, 0, 1, x, y);
+  REQUIRE(x == -1);
+}
+
+TEST_CASE("stall", "[MouseKeyIntegrator]") {
+  MouseKeyIntegrator integrator;
+  Parameters parameters(Parameters::Curve::CONSTANT, 1, 0, 1, 1, 0);
+
+  int x = 0;
+  int y = 0;
+  integrator.integrate(parameters, 60000, 1, 0, 1, x, y);
+  REQUIRE(x == MouseKeyIntegrator::MAX_MILLISECONDS);
+  REQUIRE(integrator.getElapsed() == 60000);
+}
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/GlobalLock.cpp
\ No newline at end of file
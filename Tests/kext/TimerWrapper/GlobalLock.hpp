@@ -0,0 +1 @@
+../../../src/core/kext/Classes/GlobalLock.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/TimerWrapper.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../src/core/kext/Classes/TimerWrapper.hpp
\ No newline at end of file
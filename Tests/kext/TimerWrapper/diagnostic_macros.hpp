@@ -0,0 +1 @@
+../../../src/core/kext/diagnostic_macros.hpp
\ No newline at end of file
@@ -0,0 +1,141 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <IOKit/IOTimerEventSource.h>
+#include <string>
+#include <vector>
+
+#include "GlobalLock.hpp"
+#include "TimerWrapper.hpp"
+
+using namespace org_pqrs_Karabiner;
+
+namespace {
+const uint64_t MS = 1000 * 1000;
+
+std::vector<std::string> fired;
+
+class Target final : public OSObject {
+public:
+  Target(IOWorkLoop& workloop, const char* name) : name(name) {
+    timer.initialize(&workloop, this, callback);
+  }
+  ~Target(void) {
+    timer.terminate();
+  }
+
+  static void callback(OSObject* owner, IOTimerEventSource* sender) {
+    Target* self = OSDynamicCast(Target, owner);
+    if (!self) return;
+
+    fired.push_back(self->name);
+    if (self->cancel) {
+      self->cancel->timer.cancelTimeout();
+    }
+    if (self->reset) {
+      self->reset->timer.setTimeoutMS(10);
+    }
+  }
+
+  std::string name;
+  TimerWrapper timer;
+  // Cancel or reset other timers in callback.
+  Target* cancel = nullptr;
+  Target* reset = nullptr;
+};
+
+class Environment final {
+public:
+  Environment(void) : workloop(IOWorkLoop::workLoop()) {
+    fired.clear();
+    mock_iokit::set_uptime_ns(1000 * MS);
+    GlobalLock::initialize();
+    TimerWrapper::static_initialize(*workloop);
+  }
+  ~Environment(void) {
+    TimerWrapper::static_terminate();
+    GlobalLock::terminate();
+    workloop->release();
+  }
+
+  IOWorkLoop* workloop;
+};
+
+// Fire the shared IOTimerEventSource once at `ns`.
+// (The callback processes all ticks between the last callback and `ns`.)
+void fire_at(uint64_t ns) {
+  mock_iokit::set_uptime_ns(ns);
+  IOTimerEventSource* timer = mock_iokit::get_next_timer();
+  REQUIRE(timer != nullptr);
+  timer->fire();
+}
+}
+
+TEST_CASE("same slot", "[TimerWrapper]") {
+  Environment environment;
+  Target a(*environment.workloop, "a");
+  Target b(*environment.workloop, "b");
+  Target c(*environment.workloop, "c");
+
+  // Timers with the same deadline are fired in order of setTimeoutMS.
+  b.timer.setTimeoutMS(5);
+  a.timer.setTimeoutMS(5);
+  c.timer.setTimeoutMS(5);
+
+  mock_iokit::run_until(1010 * MS);
+  REQUIRE(fired == std::vector<std::string>({"b", "a", "c"}));
+  REQUIRE(!a.timer.isActive());
+  REQUIRE(!b.timer.isActive());
+  REQUIRE(!c.timer.isActive());
+}
+
+TEST_CASE("multiple ticks", "[TimerWrapper]") {
+  Environment environment;
+  Target a(*environment.workloop, "a");
+  Target b(*environment.workloop, "b");
+  Target c(*environment.workloop, "c");
+  Target d(*environment.workloop, "d");
+  Target e(*environment.workloop, "e");
+
+  // One callback processes several ticks.
+  c.timer.setTimeoutMS(3);
+  a.timer.setTimeoutMS(1);
+  d.timer.setTimeoutMS(3);
+  b.timer.setTimeoutMS(2);
+  // e is in the same slot as a. (WHEEL_SIZE == 256)
+  e.timer.setTimeoutMS(257);
+
+  fire_at(1010 * MS);
+  REQUIRE(fired == std::vector<std::string>({"a", "b", "c", "d"}));
+  REQUIRE(e.timer.isActive());
+
+  fired.clear();
+  a.timer.setTimeoutMS(1);
+  fire_at(1300 * MS);
+  REQUIRE(fired == std::vector<std::string>({"a", "e"}));
+}
+
+TEST_CASE("cancel in callback", "[TimerWrapper]") {
+  Environment environment;
+  Target a(*environment.workloop, "a");
+  Target b(*environment.workloop, "b");
+  Target c(*environment.workloop, "c");
+  Target d(*environment.workloop, "d");
+
+  // a cancels b and resets c, which are expired in the same callback.
+  a.cancel = &b;
+  a.reset = &c;
+  a.timer.setTimeoutMS(1);
+  b.timer.setTimeoutMS(2);
+  c.timer.setTimeoutMS(2);
+  d.timer.setTimeoutMS(3);
+
+  fire_at(1010 * MS);
+  REQUIRE(fired == std::vector<std::string>({"a", "d"}));
+  REQUIRE(!b.timer.isActive());
+  REQUIRE(c.timer.isActive());
+
+  fired.clear();
+  mock_iokit::run_until(1030 * MS);
+  REQUIRE(fired == std::vector<std::string>({"c"}));
+}
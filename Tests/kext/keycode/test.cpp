@@ -428,6 +428,50 @@ TEST_CASE("isModifier", "[KeyCode]") {
   REQUIRE(KeyCode(KeyCode::VK_NONE).isModifier() == false);
 }
 
+TEST_CASE("registerVirtualModifier", "[KeyCodeModifierFlagPairs]") {
+  typedef KeyCodeModifierFlagPairs::KeyCodeType KeyCodeType;
+
+  KeyCodeModifierFlagPairs::clearVirtualModifiers();
+
+  // ModifierFlag values of virtual modifiers are assigned from VK__AUTOINDEX__BEGIN__.
+  ModifierFlag m = ModifierFlag::VK__AUTOINDEX__BEGIN__;
+  KeyCodeModifierFlagPairs::registerVirtualModifier(m,
+                                                    KeyCode(0x20000000),
+                                                    KeyCode(0x20000001),
+                                                    KeyCode(0x20000002),
+                                                    KeyCode(0x20000003),
+                                                    KeyCode(0x20000004),
+                                                    KeyCode(0x20000005),
+                                                    KeyCode(0x20000006),
+                                                    KeyCode(0x20000007),
+                                                    KeyCode(0x20000008),
+                                                    KeyCode(0x20000009));
+
+  REQUIRE(KeyCode(0x20000000).getModifierFlag() == m);
+  REQUIRE(KeyCode(0x20000000).isModifier() == true);
+  REQUIRE(m.getKeyCode() == KeyCode(0x20000000));
+  REQUIRE(KeyCodeModifierFlagPairs::getModifierFlag(KeyCode(0x20000001), KeyCodeType::VK_LOCK) == m);
+  REQUIRE(KeyCodeModifierFlagPairs::getModifierFlag(KeyCode(0x20000001), KeyCodeType::VK_STICKY) == ModifierFlag::ZERO);
+  REQUIRE(KeyCodeModifierFlagPairs::getModifierFlag(KeyCode(0x20000009), KeyCodeType::VK_STICKY_FORCE_OFF) == m);
+  REQUIRE(KeyCodeModifierFlagPairs::getKeyCode(m, KeyCodeType::VK_STICKY) == KeyCode(0x20000007));
+
+  // normal modifiers
+  REQUIRE(KeyCode::SHIFT_L.getModifierFlag() == ModifierFlag::SHIFT_L);
+  REQUIRE(KeyCodeModifierFlagPairs::getModifierFlag(KeyCode::VK_LOCK_SHIFT_L, KeyCodeType::VK_LOCK) == ModifierFlag::SHIFT_L);
+  REQUIRE(KeyCodeModifierFlagPairs::getModifierFlag(KeyCode::VK_LOCK_SHIFT_L, KeyCodeType::KEYCODE) == ModifierFlag::ZERO);
+
+  // unregistered
+  REQUIRE(ModifierFlag::NONE.getKeyCode() == KeyCode::VK_NONE);
+  REQUIRE(ModifierFlag(100000).getKeyCode() == KeyCode::VK_NONE);
+
+  KeyCodeModifierFlagPairs::clearVirtualModifiers();
+
+  REQUIRE(KeyCode(0x20000000).getModifierFlag() == ModifierFlag::ZERO);
+  REQUIRE(KeyCode(0x20000000).isModifier() == false);
+  REQUIRE(m.getKeyCode() == KeyCode::VK_NONE);
+  REQUIRE(KeyCode::SHIFT_L.getModifierFlag() == ModifierFlag::SHIFT_L);
+}
+
 TEST_CASE("isRepeatable", "[ConsumerKeyCode]") {
   REQUIRE(ConsumerKeyCode::BRIGHTNESS_DOWN.isRepeatable() == true);
   REQUIRE(ConsumerKeyCode::BRIGHTNESS_UP.isRepeatable() == true);
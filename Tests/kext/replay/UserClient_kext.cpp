@@ -0,0 +1,7 @@
+#include "UserClient_kext.hpp"
+#include "harness.hpp"
+
+// The replay harness records notifications instead of sending them to userspace.
+void USERCLIENT_KEXT_CLASSNAME::send_notification_to_userspace(uint32_t type, uint32_t option) {
+  replay::harness::record_notification(type, option);
+}
@@ -0,0 +1,758 @@
+#include "harness.hpp"
+#include "xml_loader.hpp"
+
+#include <IOKit/IOTimerEventSource.h>
+#include <IOKit/hid/IOHIDKeys.h>
+#include <IOKit/hidsystem/IOHIKeyboard.h>
+#include <IOKit/hidsystem/IOHIPointing.h>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+#include "BinaryLog.hpp"
+#include "CommonData.hpp"
+#include "Config.hpp"
+#include "Core.hpp"
+#include "DeviceFilterTable.hpp"
+#include "EventInputQueue.hpp"
+#include "EventTrace.hpp"
+#include "GlobalLock.hpp"
+#include "KeyCode.hpp"
+#include "LatencyHistogram.hpp"
+#include "RemapClass.hpp"
+#include "log_format.h"
+
+using namespace org_pqrs_Karabiner;
+
+namespace replay {
+harness* harness::current_ = nullptr;
+
+namespace {
+const uint64_t NANOSECONDS_PER_MILLISECOND = 1000 * 1000;
+
+// The trace time 0 is mapped to this uptime in order to fire timers which are set in initialization
+// (eg. RemapClassManager::refresh) before the first event.
+const uint64_t TRACE_START_UPTIME_NS = 1000 * NANOSECONDS_PER_MILLISECOND;
+
+uint64_t get_wall_clock_ns(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ----------------------------------------------------------------------
+// Original event actions. (The kext sends remapped events to them.)
+std::string flags_to_string(unsigned int flags);
+
+void keyboard_event_action(OSObject* target, unsigned eventType, unsigned flags, unsigned key,
+                           unsigned charCode, unsigned charSet, unsigned origCharCode, unsigned origCharSet,
+                           unsigned keyboardType, bool repeat, AbsoluteTime ts, OSObject* sender, void* refcon);
+void keyboard_special_event_action(OSObject* target, unsigned eventType, unsigned flags, unsigned key,
+                                   unsigned flavor, UInt64 guid, bool repeat, AbsoluteTime ts, OSObject* sender, void* refcon);
+void update_event_flags_action(OSObject* target, unsigned flags, OSObject* sender, void* refcon);
+void relative_pointer_event_action(OSObject* target, int buttons, int dx, int dy, AbsoluteTime ts, OSObject* sender, void* refcon);
+void scroll_wheel_event_action(OSObject* target, short deltaAxis1, short deltaAxis2, short deltaAxis3,
+                               IOFixed fixedDelta1, IOFixed fixedDelta2, IOFixed fixedDelta3,
+                               SInt32 pointDelta1, SInt32 pointDelta2, SInt32 pointDelta3,
+                               SInt32 options, AbsoluteTime ts, OSObject* sender, void* refcon);
+
+class mock_keyboard final : public IOHIKeyboard {
+public:
+  mock_keyboard(uint32_t vendor_id, uint32_t product_id, const char* product_name) {
+    setName("IOHIDKeyboard");
+    setProperty(kIOHIDVendorIDKey, vendor_id, 32);
+    setProperty(kIOHIDProductIDKey, product_id, 32);
+    setProperty(kIOHIDLocationIDKey, 0x14000000, 32);
+    setProperty(kIOHIDManufacturerKey, "Apple Inc.");
+    setProperty(kIOHIDProductKey, product_name);
+
+    _keyboardEventTarget = this;
+    _keyboardEventAction = reinterpret_cast<KeyboardEventAction>(keyboard_event_action);
+    _keyboardSpecialEventTarget = this;
+    _keyboardSpecialEventAction = reinterpret_cast<KeyboardSpecialEventAction>(keyboard_special_event_action);
+    _updateEventFlagsTarget = this;
+    _updateEventFlagsAction = reinterpret_cast<UpdateEventFlagsAction>(update_event_flags_action);
+  }
+
+  void dispatchKeyboardEvent(unsigned eventType, unsigned flags, unsigned key, AbsoluteTime ts) {
+    auto action = reinterpret_cast<KeyboardEventCallback>(_keyboardEventAction);
+    action(_keyboardEventTarget, eventType, flags, key, 0, 0, 0, 0, 0, false, ts, this, nullptr);
+  }
+
+  void dispatchKeyboardSpecialEvent(unsigned eventType, unsigned flags, unsigned key, AbsoluteTime ts) {
+    auto action = reinterpret_cast<KeyboardSpecialEventCallback>(_keyboardSpecialEventAction);
+    action(_keyboardSpecialEventTarget, eventType, flags, key, key, static_cast<UInt64>(-1), false, ts, this, nullptr);
+  }
+};
+
+class mock_pointing final : public IOHIPointing {
+public:
+  mock_pointing(void) {
+    setName("IOHIDPointing");
+    setProperty(kIOHIDVendorIDKey, 0x05ac, 32);
+    setProperty(kIOHIDProductIDKey, 0x030d, 32);
+    setProperty(kIOHIDLocationIDKey, 0x14100000, 32);
+    setProperty(kIOHIDManufacturerKey, "Apple Inc.");
+    setProperty(kIOHIDProductKey, "Apple Magic Mouse");
+
+    _relativePointerEventTarget = this;
+    _relativePointerEventAction = reinterpret_cast<RelativePointerEventAction>(relative_pointer_event_action);
+    _scrollWheelEventTarget = this;
+    _scrollWheelEventAction = reinterpret_cast<ScrollWheelEventAction>(scroll_wheel_event_action);
+  }
+
+  void dispatchRelativePointerEvent(int buttons, int dx, int dy, AbsoluteTime ts) {
+    auto action = reinterpret_cast<RelativePointerEventCallback>(_relativePointerEventAction);
+    action(_relativePointerEventTarget, buttons, dx, dy, ts, this, nullptr);
+  }
+
+  void dispatchScrollWheelEvent(short delta1, short delta2, AbsoluteTime ts) {
+    auto action = reinterpret_cast<ScrollWheelEventCallback>(_scrollWheelEventAction);
+    action(_scrollWheelEventTarget, delta1, delta2, 0,
+           delta1 << 16, delta2 << 16, 0,
+           delta1, delta2, 0,
+           0, ts, this, nullptr);
+  }
+};
+
+mock_keyboard* keyboard = nullptr;
+mock_pointing* pointing = nullptr;
+xml_loader* current_xml_loader = nullptr;
+
+std::string key_to_string(const char* type, unsigned int value) {
+  if (!current_xml_loader) return "";
+  return current_xml_loader->get_name(type, value);
+}
+
+std::string flags_to_string(unsigned int flags) {
+  const KeyCode modifiers[] = {
+      KeyCode::CAPSLOCK,
+      KeyCode::SHIFT_L,
+      KeyCode::SHIFT_R,
+      KeyCode::CONTROL_L,
+      KeyCode::CONTROL_R,
+      KeyCode::OPTION_L,
+      KeyCode::OPTION_R,
+      KeyCode::COMMAND_L,
+      KeyCode::COMMAND_R,
+      KeyCode::FN,
+  };
+
+  std::string s;
+  for (const auto& key : modifiers) {
+    unsigned int bits = key.getModifierFlag().getRawBits();
+    if (bits != 0 && (flags & bits) == bits) {
+      // The names of modifier keys and modifier flags are the same. (KeyCode::SHIFT_L and ModifierFlag::SHIFT_L)
+      std::string name = key_to_string("KeyCode", key.get());
+      if (name.compare(0, 9, "KeyCode::") == 0) {
+        name = "ModifierFlag::" + name.substr(9);
+      }
+
+      if (!s.empty()) s += "|";
+      s += name;
+    }
+  }
+  return s;
+}
+
+std::string event_type_to_string(unsigned int eventType) {
+  if (EventType(eventType) == EventType::DOWN) return "down";
+  if (EventType(eventType) == EventType::UP) return "up";
+  if (EventType(eventType) == EventType::MODIFY) return "modify";
+  return "unknown";
+}
+
+void keyboard_event_action(OSObject* target, unsigned eventType, unsigned flags, unsigned key,
+                           unsigned charCode, unsigned charSet, unsigned origCharCode, unsigned origCharSet,
+                           unsigned keyboardType, bool repeat, AbsoluteTime ts, OSObject* sender, void* refcon) {
+  std::string s = event_type_to_string(eventType) + " " + key_to_string("KeyCode", key);
+  std::string f = flags_to_string(flags);
+  if (!f.empty()) {
+    s += " " + f;
+  }
+  if (repeat) {
+    s += " repeat";
+  }
+  harness::record_output(s);
+}
+
+void keyboard_special_event_action(OSObject* target, unsigned eventType, unsigned flags, unsigned key,
+                                   unsigned flavor, UInt64 guid, bool repeat, AbsoluteTime ts, OSObject* sender, void* refcon) {
+  std::string s = event_type_to_string(eventType) + " " + key_to_string("ConsumerKeyCode", key);
+  std::string f = flags_to_string(flags);
+  if (!f.empty()) {
+    s += " " + f;
+  }
+  if (repeat) {
+    s += " repeat";
+  }
+  harness::record_output(s);
+}
+
+void update_event_flags_action(OSObject* target, unsigned flags, OSObject* sender, void* refcon) {
+  harness::record_output("flags " + flags_to_string(flags));
+}
+
+void relative_pointer_event_action(OSObject* target, int buttons, int dx, int dy, AbsoluteTime ts, OSObject* sender, void* refcon) {
+  std::ostringstream os;
+  os << "pointer buttons:0x" << std::hex << buttons << std::dec << " dx:" << dx << " dy:" << dy;
+  harness::record_output(os.str());
+}
+
+void scroll_wheel_event_action(OSObject* target, short deltaAxis1, short deltaAxis2, short deltaAxis3,
+                               IOFixed fixedDelta1, IOFixed fixedDelta2, IOFixed fixedDelta3,
+                               SInt32 pointDelta1, SInt32 pointDelta2, SInt32 pointDelta3,
+                               SInt32 options, AbsoluteTime ts, OSObject* sender, void* refcon) {
+  std::ostringstream os;
+  os << "scroll " << deltaAxis1 << " " << deltaAxis2;
+  harness::record_output(os.str());
+}
+}
+
+// ======================================================================
+harness::harness(const std::string& system_xml_directory, const std::string& private_xml_directory) : xml_loader_(nullptr),
+                                                                                                    started_(false),
+                                                                                                    keyboard_vendor_id_(0x05ac),
+                                                                                                    keyboard_product_id_(0x0250),
+                                                                                                    keyboard_product_name_("Apple Keyboard"),
+                                                                                                    timer_processing_time_ns_(0),
+                                                                                                    remapclasses_delta_processing_time_ns_(0),
+                                                                                                    flags_(0),
+                                                                                                    buttons_(0) {
+  xml_loader_ = new xml_loader(system_xml_directory, private_xml_directory);
+}
+
+harness::~harness(void) {
+  stop();
+  delete xml_loader_;
+}
+
+void harness::start(void) {
+  if (started_) return;
+  if (current_) {
+    throw std::runtime_error("another harness is running");
+  }
+
+  current_ = this;
+  current_xml_loader = xml_loader_;
+  started_ = true;
+
+  mock_iokit::set_uptime_ns(0);
+
+  Core::start();
+
+  {
+    GlobalLock::ScopedLock lk;
+
+    auto& initialize_vector = xml_loader_->get_remapclasses_initialize_vector();
+    if (!RemapClassManager::load_remapclasses_initialize_vector(&(initialize_vector[0]), initialize_vector.size() * sizeof(uint32_t))) {
+      throw std::runtime_error("load_remapclasses_initialize_vector failed");
+    }
+    xml_loader_->set_remapclasses_initialize_vector_uploaded();
+
+    auto config = make_config_vector();
+    if (!RemapClassManager::set_config(&(config[0]), config.size() * sizeof(int32_t))) {
+      throw std::runtime_error("set_config failed");
+    }
+
+    Config::set_initialized(true);
+  }
+
+  keyboard = new mock_keyboard(keyboard_vendor_id_, keyboard_product_id_, keyboard_product_name_.c_str());
+  pointing = new mock_pointing;
+  Core::IOHIKeyboard_gIOMatchedNotification_callback(nullptr, nullptr, keyboard, nullptr);
+  Core::IOHIPointing_gIOMatchedNotification_callback(nullptr, nullptr, pointing, nullptr);
+
+  mock_iokit::run_until(TRACE_START_UPTIME_NS);
+}
+
+std::vector<int32_t> harness::make_config_vector(void) const {
+  // The server enables devices at launch.
+  std::vector<std::pair<std::string, int>> essential_configurations;
+  essential_configurations.push_back(std::make_pair("notsave.automatically_enable_keyboard_device", 1));
+  essential_configurations.push_back(std::make_pair("notsave.automatically_enable_pointing_device", 1));
+  for (const auto& it : essential_configurations_) {
+    essential_configurations.push_back(it);
+  }
+
+  return xml_loader_->make_config_vector(enabled_identifiers_, essential_configurations);
+}
+
+void harness::stop(void) {
+  if (!started_) return;
+
+  // (Devices are not connected if start failed.)
+  if (keyboard) {
+    Core::IOHIKeyboard_gIOTerminatedNotification_callback(nullptr, nullptr, keyboard, nullptr);
+  }
+  if (pointing) {
+    Core::IOHIPointing_gIOTerminatedNotification_callback(nullptr, nullptr, pointing, nullptr);
+  }
+
+  // sysctl variables are static and kept after Core::stop.
+  Config::unset_debug_flags();
+
+  Core::stop();
+
+  if (keyboard) {
+    keyboard->release();
+    keyboard = nullptr;
+  }
+  if (pointing) {
+    pointing->release();
+    pointing = nullptr;
+  }
+
+  flags_ = 0;
+  buttons_ = 0;
+
+  current_ = nullptr;
+  current_xml_loader = nullptr;
+  started_ = false;
+}
+
+// ----------------------------------------------------------------------
+void harness::replay(std::istream& trace) {
+  std::string line;
+  while (std::getline(trace, line)) {
+    replay_line(line);
+  }
+}
+
+void harness::replay_line(const std::string& line) {
+  std::string l = line;
+  {
+    auto pos = l.find('#');
+    if (pos != std::string::npos) {
+      l.erase(pos);
+    }
+  }
+
+  std::istringstream is(l);
+  double time_ms = 0;
+  std::string command;
+  if (!(is >> time_ms)) {
+    // Empty line
+    return;
+  }
+  if (!(is >> command)) {
+    throw std::runtime_error("invalid line: " + line);
+  }
+
+  if (!started_) {
+    start();
+  }
+
+  uint64_t time_ns = static_cast<uint64_t>(time_ms * NANOSECONDS_PER_MILLISECOND);
+  if (TRACE_START_UPTIME_NS + time_ns < mock_iokit::get_uptime_ns()) {
+    throw std::runtime_error("time goes backward: " + line);
+  }
+
+  if (command == "down" || command == "up") {
+    std::string name;
+    if (!(is >> name)) {
+      throw std::runtime_error("invalid line: " + line);
+    }
+    bool isdown = (command == "down");
+    uint32_t value = xml_loader_->get_symbol(name);
+
+    if (name.compare(0, 9, "KeyCode::") == 0) {
+      push_key(time_ns, isdown, value);
+    } else if (name.compare(0, 17, "ConsumerKeyCode::") == 0) {
+      push_consumer(time_ns, isdown, value);
+    } else if (name.compare(0, 16, "PointingButton::") == 0) {
+      push_button(time_ns, isdown, value);
+    } else {
+      throw std::runtime_error("invalid symbol: " + line);
+    }
+
+  } else if (command == "move") {
+    int dx = 0;
+    int dy = 0;
+    if (!(is >> dx >> dy)) {
+      throw std::runtime_error("invalid line: " + line);
+    }
+    push_move(time_ns, dx, dy);
+
+  } else if (command == "scroll") {
+    int delta1 = 0;
+    int delta2 = 0;
+    if (!(is >> delta1 >> delta2)) {
+      throw std::runtime_error("invalid line: " + line);
+    }
+    push_scroll(time_ns, delta1, delta2);
+
+  } else if (command == "end") {
+    run_until(time_ns / NANOSECONDS_PER_MILLISECOND);
+
+  } else {
+    throw std::runtime_error("invalid command: " + line);
+  }
+}
+
+void harness::run_until(uint64_t time_ms) {
+  uint64_t start = get_wall_clock_ns();
+  mock_iokit::run_until(TRACE_START_UPTIME_NS + time_ms * NANOSECONDS_PER_MILLISECOND);
+  timer_processing_time_ns_ += get_wall_clock_ns() - start;
+}
+
+#define PUSH_EVENT(DESCRIPTION, DISPATCH)                               \
+  {                                                                     \
+    uint64_t start = get_wall_clock_ns();                               \
+    if (TRACE_START_UPTIME_NS + time_ns > mock_iokit::get_uptime_ns()) { \
+      mock_iokit::run_until(TRACE_START_UPTIME_NS + time_ns);           \
+    }                                                                   \
+    timer_processing_time_ns_ += get_wall_clock_ns() - start;           \
+                                                                        \
+    input_events_.push_back(input_event(time_ns, DESCRIPTION));         \
+                                                                        \
+    start = get_wall_clock_ns();                                        \
+    DISPATCH;                                                           \
+    input_events_.back().processing_time_ns = get_wall_clock_ns() - start; \
+  }
+
+void harness::push_key(uint64_t time_ns, bool isdown, uint32_t key) {
+  std::string description = std::string(isdown ? "down " : "up ") + xml_loader_->get_name("KeyCode", key);
+
+  KeyCode keyCode(key);
+  unsigned int eventType = (isdown ? EventType::DOWN : EventType::UP).get();
+  if (keyCode.isModifier()) {
+    // Modifier keys are sent as EventType::MODIFY with updated flags like IOHIKeyboard.
+    unsigned int bits = keyCode.getModifierFlag().getRawBits();
+    if (isdown) {
+      flags_ |= bits;
+    } else {
+      flags_ &= ~bits;
+    }
+    eventType = EventType::MODIFY.get();
+  }
+
+  PUSH_EVENT(description, keyboard->dispatchKeyboardEvent(eventType, flags_, key, TRACE_START_UPTIME_NS + time_ns));
+}
+
+void harness::push_consumer(uint64_t time_ns, bool isdown, uint32_t key) {
+  std::string description = std::string(isdown ? "down " : "up ") + xml_loader_->get_name("ConsumerKeyCode", key);
+  unsigned int eventType = (isdown ? EventType::DOWN : EventType::UP).get();
+
+  PUSH_EVENT(description, keyboard->dispatchKeyboardSpecialEvent(eventType, flags_, key, TRACE_START_UPTIME_NS + time_ns));
+}
+
+void harness::push_button(uint64_t time_ns, bool isdown, uint32_t button) {
+  std::string description = std::string(isdown ? "down " : "up ") + xml_loader_->get_name("PointingButton", button);
+  if (isdown) {
+    buttons_ |= button;
+  } else {
+    buttons_ &= ~button;
+  }
+
+  PUSH_EVENT(description, pointing->dispatchRelativePointerEvent(buttons_, 0, 0, TRACE_START_UPTIME_NS + time_ns));
+}
+
+void harness::push_move(uint64_t time_ns, int dx, int dy) {
+  std::ostringstream os;
+  os << "move " << dx << " " << dy;
+
+  PUSH_EVENT(os.str(), pointing->dispatchRelativePointerEvent(buttons_, dx, dy, TRACE_START_UPTIME_NS + time_ns));
+}
+
+void harness::push_scroll(uint64_t time_ns, int delta1, int delta2) {
+  std::ostringstream os;
+  os << "scroll " << delta1 << " " << delta2;
+
+  PUSH_EVENT(os.str(), pointing->dispatchScrollWheelEvent(delta1, delta2, TRACE_START_UPTIME_NS + time_ns));
+}
+
+#undef PUSH_EVENT
+
+// ----------------------------------------------------------------------
+void harness::set_config_delta(const std::vector<std::pair<std::string, int>>& configurations) {
+  std::vector<BridgeSetConfigOne> delta;
+  for (const auto& it : configurations) {
+    BridgeSetConfigOne c;
+    c.isEssentialConfig = 0;
+    c.index = xml_loader_->get_config_index(it.first);
+    c.value = it.second;
+    delta.push_back(c);
+  }
+
+  {
+    GlobalLock::ScopedLock lk;
+    if (!RemapClassManager::set_config_delta(delta.empty() ? nullptr : &(delta[0]), delta.size() * sizeof(BridgeSetConfigOne))) {
+      throw std::runtime_error("set_config_delta failed");
+    }
+  }
+
+  // Apply the config in the refresh timer. (TimerWrapper has millisecond resolution.)
+  mock_iokit::run_until(mock_iokit::get_uptime_ns() + NANOSECONDS_PER_MILLISECOND);
+}
+
+void harness::reload_remapclasses(void) {
+  xml_loader_->reload();
+
+  auto& delta = xml_loader_->get_remapclasses_delta_vector();
+  if (delta.empty()) {
+    throw std::runtime_error("remapclasses delta is not available");
+  }
+
+  {
+    GlobalLock::ScopedLock lk;
+
+    uint64_t start = get_wall_clock_ns();
+    bool succeeded = RemapClassManager::apply_remapclasses_delta(&(delta[0]), delta.size() * sizeof(uint32_t));
+    remapclasses_delta_processing_time_ns_ = get_wall_clock_ns() - start;
+    if (!succeeded) {
+      throw std::runtime_error("apply_remapclasses_delta failed");
+    }
+    xml_loader_->set_remapclasses_initialize_vector_uploaded();
+
+    auto config = make_config_vector();
+    if (!RemapClassManager::set_config(&(config[0]), config.size() * sizeof(int32_t))) {
+      throw std::runtime_error("set_config failed");
+    }
+  }
+
+  mock_iokit::run_until(mock_iokit::get_uptime_ns() + NANOSECONDS_PER_MILLISECOND);
+}
+
+std::string harness::get_statusmessage(void) const {
+  GlobalLock::ScopedLock lk;
+  return CommonData::get_statusmessage(BRIDGE_USERCLIENT_STATUS_MESSAGE_EXTRA);
+}
+
+uint32_t harness::get_dropped_event_count(void) const {
+  GlobalLock::ScopedLock lk;
+  return EventInputQueue::droppedDeferredEventCount();
+}
+
+size_t harness::get_device_filter_id_count(void) const {
+  GlobalLock::ScopedLock lk;
+  return DeviceFilterTable::idCount();
+}
+
+void harness::set_sysctl(const std::string& name, int value) {
+  if (!mock_iokit::set_sysctl_int(name.c_str(), value)) {
+    throw std::runtime_error("Unknown sysctl: " + name);
+  }
+}
+
+std::vector<std::string> harness::get_remap_statistics(void) const {
+  std::vector<std::string> v;
+
+  std::vector<uint8_t> buffer(sizeof(BridgeRemapStatisticsHeader));
+  for (;;) {
+    {
+      GlobalLock::ScopedLock lk;
+      if (!RemapClassManager::get_statistics(BRIDGE_REMAP_STATISTICS_TYPE_ITEM, &(buffer[0]), buffer.size())) {
+        throw std::runtime_error("RemapClassManager::get_statistics failed");
+      }
+    }
+
+    auto header = reinterpret_cast<const BridgeRemapStatisticsHeader*>(&(buffer[0]));
+    if (header->count == header->total) break;
+
+    buffer.resize(sizeof(BridgeRemapStatisticsHeader) + sizeof(BridgeRemapStatistics) * header->total);
+  }
+
+  auto header = reinterpret_cast<const BridgeRemapStatisticsHeader*>(&(buffer[0]));
+  auto entries = reinterpret_cast<const BridgeRemapStatistics*>(&(buffer[0]) + sizeof(BridgeRemapStatisticsHeader));
+  for (uint32_t i = 0; i < header->count; ++i) {
+    const auto& e = entries[i];
+
+    std::ostringstream os;
+    os << xml_loader_->get_identifier(e.configindex) << " #" << e.itemindex
+       << " attempts:" << e.attempts
+       << " remaps:" << e.remaps
+       << " filtered:" << e.filtered;
+    v.push_back(os.str());
+  }
+
+  return v;
+}
+
+std::vector<std::string> harness::drain_event_trace(void) {
+  std::vector<std::string> v;
+
+  std::vector<uint8_t> buffer(sizeof(BridgeTraceHeader) + sizeof(BridgeTraceEntry) * 256);
+  for (;;) {
+    {
+      GlobalLock::ScopedLock lk;
+      if (!EventTrace::drain(&(buffer[0]), buffer.size())) {
+        throw std::runtime_error("EventTrace::drain failed");
+      }
+    }
+
+    auto header = reinterpret_cast<const BridgeTraceHeader*>(&(buffer[0]));
+    auto entries = reinterpret_cast<const BridgeTraceEntry*>(&(buffer[0]) + sizeof(BridgeTraceHeader));
+    if (header->count == 0) break;
+
+    for (uint32_t i = 0; i < header->count; ++i) {
+      const auto& e = entries[i];
+
+      std::string s;
+      switch (e.tag) {
+        case BRIDGE_TRACE_TAG_INPUT_PUSH:
+          s = "input_push";
+          break;
+        case BRIDGE_TRACE_TAG_INPUT_FIRE:
+          s = "input_fire";
+          break;
+        case BRIDGE_TRACE_TAG_OUTPUT_FIRE:
+          s = "output_fire";
+          break;
+        case BRIDGE_TRACE_TAG_INPUT_DROP:
+          s = "input_drop";
+          break;
+        case BRIDGE_TRACE_TAG_OUTPUT_DROP:
+          s = "output_drop";
+          break;
+        default:
+          s = "unknown";
+          break;
+      }
+
+      std::ostringstream os;
+      switch (e.event) {
+        case BRIDGE_TRACE_EVENT_KEYBOARD:
+          os << " " << event_type_to_string(e.eventType) << " " << key_to_string("KeyCode", e.value);
+          break;
+        case BRIDGE_TRACE_EVENT_UPDATE_FLAGS:
+          os << " flags " << flags_to_string(e.flags);
+          break;
+        case BRIDGE_TRACE_EVENT_CONSUMER:
+          os << " " << event_type_to_string(e.eventType) << " " << key_to_string("ConsumerKeyCode", e.value);
+          break;
+        case BRIDGE_TRACE_EVENT_RELATIVE_POINTER:
+          os << " pointer buttons:0x" << std::hex << e.value << std::dec << " dx:" << e.x << " dy:" << e.y;
+          break;
+        case BRIDGE_TRACE_EVENT_SCROLL_WHEEL:
+          os << " scroll " << e.x << " " << e.y;
+          break;
+        case BRIDGE_TRACE_EVENT_WAIT:
+          os << " wait " << e.value;
+          break;
+      }
+      v.push_back(s + os.str());
+    }
+  }
+
+  return v;
+}
+
+std::vector<std::string> harness::get_output_descriptions(void) const {
+  std::vector<std::string> v;
+  for (const auto& e : output_events_) {
+    v.push_back(e.description);
+  }
+  return v;
+}
+
+void harness::record_output(const std::string& description) {
+  if (!current_) return;
+
+  uint64_t uptime = mock_iokit::get_uptime_ns();
+  uint64_t time_ns = (uptime > TRACE_START_UPTIME_NS ? uptime - TRACE_START_UPTIME_NS : 0);
+  current_->output_events_.push_back(output_event(time_ns, description));
+}
+
+void harness::record_notification(uint32_t type, uint32_t option) {
+  std::ostringstream os;
+  os << "notification type:" << type << " option:" << option;
+  record_output(os.str());
+}
+
+std::vector<std::string> harness::get_latency_histograms(void) {
+  std::vector<std::string> v;
+
+  BridgeLatencyHistogram histograms[BRIDGE_LATENCY_CLASS__END__];
+  {
+    GlobalLock::ScopedLock lk;
+    if (!LatencyHistogram::get(BRIDGE_LATENCY_HISTOGRAM_OPTION_RESET, reinterpret_cast<uint8_t*>(histograms), sizeof(histograms))) {
+      throw std::runtime_error("LatencyHistogram::get failed");
+    }
+  }
+
+  const char* names[] = {
+      "keyboard",
+      "consumer",
+      "relative_pointer",
+      "scroll_wheel",
+  };
+  static_assert(sizeof(names) / sizeof(names[0]) == BRIDGE_LATENCY_CLASS__END__, "names");
+
+  for (uint32_t i = 0; i < BRIDGE_LATENCY_CLASS__END__; ++i) {
+    const auto& h = histograms[i];
+    if (h.count == 0) continue;
+
+    std::ostringstream os;
+    os << names[i]
+       << " count:" << h.count
+       << " sum_us:" << h.sum
+       << " max_us:" << h.max;
+    v.push_back(os.str());
+  }
+
+  return v;
+}
+
+std::vector<std::string> harness::drain_log(void) {
+  static const struct {
+    uint32_t id;
+    const char* format;
+  } formats[] = {
+#include "include.bridge_log_format_table.h"
+  };
+
+  std::vector<std::string> v;
+
+  std::vector<uint8_t> buffer(sizeof(BridgeLogHeader) + sizeof(BridgeLogEntry) * 256);
+  for (;;) {
+    {
+      GlobalLock::ScopedLock lk;
+      if (!BinaryLog::drain(&(buffer[0]), buffer.size())) {
+        throw std::runtime_error("BinaryLog::drain failed");
+      }
+    }
+
+    auto header = reinterpret_cast<const BridgeLogHeader*>(&(buffer[0]));
+    auto entries = reinterpret_cast<const BridgeLogEntry*>(&(buffer[0]) + sizeof(BridgeLogHeader));
+    if (header->count == 0) break;
+
+    for (uint32_t i = 0; i < header->count; ++i) {
+      const auto& e = entries[i];
+
+      const char* format = nullptr;
+      for (const auto& f : formats) {
+        if (f.id == e.formatId) {
+          format = f.format;
+          break;
+        }
+      }
+      if (!format) {
+        throw std::runtime_error("unknown format id");
+      }
+
+      char message[512];
+      pqrs_log_format_snprintf(message, sizeof(message), format, e.arguments, e.argc, e.strings, sizeof(e.strings));
+
+      std::string s;
+      switch (e.level) {
+        case BRIDGE_LOG_LEVEL_DEBUG:
+          s = "debug ";
+          break;
+        case BRIDGE_LOG_LEVEL_DEBUG_POINTING:
+          s = "debug_pointing ";
+          break;
+        case BRIDGE_LOG_LEVEL_DEVEL:
+          s = "devel ";
+          break;
+      }
+      s += message;
+      if (!s.empty() && s.back() == '\n') {
+        s.pop_back();
+      }
+      v.push_back(s);
+    }
+  }
+
+  return v;
+}
+}
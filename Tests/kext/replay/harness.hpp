@@ -0,0 +1,185 @@
+#pragma once
+
+// The replay harness runs the remap core (src/core/kext) in userspace.
+//
+// Input events are pushed into the hooked devices at their timestamps on the virtual clock.
+// Events which the kext sends to the original event actions are recorded with their timestamps.
+//
+// Trace format (one event per line, `#` starts a comment):
+//
+//   <time in milliseconds> down <symbol>      # KeyCode, ConsumerKeyCode or PointingButton
+//   <time in milliseconds> up <symbol>
+//   <time in milliseconds> move <dx> <dy>
+//   <time in milliseconds> scroll <delta1> <delta2>
+//   <time in milliseconds> end                # run timers until the time
+//
+// Timers run before an event only if the time advances.
+// Events which have the same time are pushed in a row like a burst of device callbacks.
+//
+// Example:
+//
+//   0 down KeyCode::A
+//   30 up KeyCode::A
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace replay {
+class xml_loader;
+
+class harness final {
+public:
+  class output_event final {
+  public:
+    output_event(uint64_t time_ns, const std::string& description) : time_ns(time_ns),
+                                                                     description(description) {}
+
+    uint64_t time_ns;
+    // eg. "down KeyCode::A", "modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L"
+    std::string description;
+  };
+
+  class input_event final {
+  public:
+    input_event(uint64_t time_ns, const std::string& description) : time_ns(time_ns),
+                                                                    description(description),
+                                                                    processing_time_ns(0) {}
+
+    uint64_t time_ns;
+    std::string description;
+    // Wall clock time of the event callback. (Timer callbacks are not included.)
+    uint64_t processing_time_ns;
+  };
+
+  // system_xml_directory is src/core/server/Resources because essential configurations must match the kext.
+  harness(const std::string& system_xml_directory, const std::string& private_xml_directory);
+  ~harness(void);
+
+  // Call before start or reload_remapclasses.
+  void enable(const std::string& identifier) { enabled_identifiers_.push_back(identifier); }
+  void disable(const std::string& identifier) {
+    enabled_identifiers_.erase(std::remove(enabled_identifiers_.begin(), enabled_identifiers_.end(), identifier),
+                               enabled_identifiers_.end());
+  }
+  void set_essential_configuration(const std::string& identifier, int value) {
+    essential_configurations_.push_back(std::make_pair(identifier, value));
+  }
+  // The keyboard is an external Apple keyboard by default.
+  // (A product name which starts with "Apple Internal " makes an internal keyboard.)
+  // Call before start.
+  void set_keyboard(uint32_t vendor_id, uint32_t product_id, const std::string& product_name) {
+    keyboard_vendor_id_ = vendor_id;
+    keyboard_product_id_ = product_id;
+    keyboard_product_name_ = product_name;
+  }
+
+  // Load remapclasses and connect a keyboard and a pointing device.
+  // Throws std::runtime_error if the kext rejects data.
+  void start(void);
+  void stop(void);
+
+  // Throws std::runtime_error if a line is invalid.
+  void replay(std::istream& trace);
+  void replay_line(const std::string& line);
+
+  // Fire timers until `time_ms`.
+  void run_until(uint64_t time_ms);
+
+  const std::vector<input_event>& get_input_events(void) const { return input_events_; }
+  const std::vector<output_event>& get_output_events(void) const { return output_events_; }
+  // Wall clock time of timer callbacks.
+  uint64_t get_timer_processing_time_ns(void) const { return timer_processing_time_ns_; }
+
+  // Return descriptions of output events. (for tests)
+  std::vector<std::string> get_output_descriptions(void) const;
+
+  // Change enabled states of remapclasses by BRIDGE_USERCLIENT_TYPE_SET_CONFIG_DELTA.
+  // (pairs of identifier and value)
+  // Call after start. The virtual clock advances 1 millisecond.
+  // Throws std::runtime_error if the kext rejects data.
+  void set_config_delta(const std::vector<std::pair<std::string, int>>& configurations);
+
+  // Reload xml files and send the difference of remapclasses by BRIDGE_USERCLIENT_TYPE_SET_REMAPCLASSES_DELTA.
+  // Then send the config in the same way as the server.
+  // Call after start. The virtual clock advances 1 millisecond.
+  // Throws std::runtime_error if the delta is not available or the kext rejects data.
+  void reload_remapclasses(void);
+  // Wall clock time of apply_remapclasses_delta in the last reload_remapclasses.
+  // (It includes the refresh of enabled remapclasses in the delta.)
+  uint64_t get_remapclasses_delta_processing_time_ns(void) const { return remapclasses_delta_processing_time_ns_; }
+
+  // The status message of enabled remapclasses. (BRIDGE_USERCLIENT_STATUS_MESSAGE_EXTRA)
+  std::string get_statusmessage(void) const;
+
+  // The number of events which are dropped in device callbacks because DeferredEventQueue is full.
+  uint32_t get_dropped_event_count(void) const;
+
+  // The number of ids in DeviceFilterTable. (including released ids)
+  size_t get_device_filter_id_count(void) const;
+
+  // Set a sysctl variable. (eg. set_sysctl("statistics", 1))
+  // Call after start. (Variables are registered in start and reset in stop.)
+  // Throws std::runtime_error if the variable is not found.
+  void set_sysctl(const std::string& name, int value);
+
+  // Return descriptions of BRIDGE_REMAP_STATISTICS_TYPE_ITEM entries.
+  // eg. "private.replay_keytokey #1 attempts:2 remaps:2 filtered:0"
+  std::vector<std::string> get_remap_statistics(void) const;
+
+  // Move entries from EventTrace and return descriptions of them.
+  // eg. "input_push down KeyCode::A", "output_fire keyboard up KeyCode::B"
+  std::vector<std::string> drain_event_trace(void);
+
+  // Move entries from BinaryLog and return formatted messages.
+  // eg. "debug KeyboardEventCallback [ caught]: eventType 10, ..."
+  std::vector<std::string> drain_log(void);
+
+  // Return descriptions of LatencyHistogram which have samples and reset them.
+  // Latencies are measured on the virtual clock.
+  // eg. "keyboard count:2 sum_us:0 max_us:0"
+  std::vector<std::string> get_latency_histograms(void);
+
+  void clear_events(void) {
+    input_events_.clear();
+    output_events_.clear();
+    timer_processing_time_ns_ = 0;
+  }
+
+  // ----------------------------------------
+  // Called from mock callbacks.
+  static void record_output(const std::string& description);
+  static void record_notification(uint32_t type, uint32_t option);
+
+private:
+  std::vector<int32_t> make_config_vector(void) const;
+
+  void push_key(uint64_t time_ns, bool isdown, uint32_t key);
+  void push_consumer(uint64_t time_ns, bool isdown, uint32_t key);
+  void push_button(uint64_t time_ns, bool isdown, uint32_t button);
+  void push_move(uint64_t time_ns, int dx, int dy);
+  void push_scroll(uint64_t time_ns, int delta1, int delta2);
+
+  static harness* current_;
+
+  xml_loader* xml_loader_;
+  std::vector<std::string> enabled_identifiers_;
+  std::vector<std::pair<std::string, int>> essential_configurations_;
+  bool started_;
+  uint32_t keyboard_vendor_id_;
+  uint32_t keyboard_product_id_;
+  std::string keyboard_product_name_;
+
+  std::vector<input_event> input_events_;
+  std::vector<output_event> output_events_;
+  uint64_t timer_processing_time_ns_;
+  uint64_t remapclasses_delta_processing_time_ns_;
+
+  // The state of the physical devices.
+  uint32_t flags_;
+  uint32_t buttons_;
+};
+}
@@ -0,0 +1,105 @@
+#include <IOKit/IOLib.h>
+#include <IOKit/IOTimerEventSource.h>
+#include <algorithm>
+#include <sys/sysctl.h>
+#include <vector>
+
+namespace {
+uint64_t uptime_ns = 0;
+bool iolog_enabled = false;
+
+// Registered sysctl oids.
+std::vector<sysctl_oid*>& sysctl_oids(void) {
+  static std::vector<sysctl_oid*> v;
+  return v;
+}
+
+// All IOTimerEventSources in creation order.
+std::vector<IOTimerEventSource*>& timers(void) {
+  static std::vector<IOTimerEventSource*> v;
+  return v;
+}
+}
+
+namespace mock_iokit {
+uint64_t get_uptime_ns(void) { return uptime_ns; }
+void set_uptime_ns(uint64_t ns) { uptime_ns = ns; }
+
+void set_iolog_enabled(bool enabled) { iolog_enabled = enabled; }
+bool get_iolog_enabled(void) { return iolog_enabled; }
+
+void sysctl_register_oid(struct sysctl_oid* oid) {
+  sysctl_oids().push_back(oid);
+}
+
+void sysctl_unregister_oid(struct sysctl_oid* oid) {
+  auto& v = sysctl_oids();
+  v.erase(std::remove(v.begin(), v.end(), oid), v.end());
+}
+
+bool set_sysctl_int(const char* name, int value) {
+  for (auto& oid : sysctl_oids()) {
+    if (oid->ptr && strcmp(oid->name, name) == 0) {
+      *(oid->ptr) = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+IOTimerEventSource* get_next_timer(void) {
+  IOTimerEventSource* next = nullptr;
+  for (auto& t : timers()) {
+    if (!t->isArmed()) continue;
+    // Timers which have the same deadline are fired in creation order.
+    if (!next || t->getDeadline() < next->getDeadline()) {
+      next = t;
+    }
+  }
+  return next;
+}
+
+void run_until(uint64_t ns) {
+  for (;;) {
+    IOTimerEventSource* t = get_next_timer();
+    if (!t) break;
+    if (t->getDeadline() > ns) break;
+
+    if (t->getDeadline() > uptime_ns) {
+      uptime_ns = t->getDeadline();
+    }
+    t->fire();
+  }
+
+  if (ns > uptime_ns) {
+    uptime_ns = ns;
+  }
+}
+}
+
+// ----------------------------------------------------------------------
+IOTimerEventSource* IOTimerEventSource::timerEventSource(OSObject* owner, Action action) {
+  auto p = new IOTimerEventSource;
+  p->owner_ = owner;
+  p->action_ = action;
+  timers().push_back(p);
+  return p;
+}
+
+IOReturn IOTimerEventSource::setTimeout(UInt32 interval, UInt32 scaleFactor) {
+  armed_ = true;
+  deadline_ = uptime_ns + static_cast<uint64_t>(interval) * scaleFactor;
+  return kIOReturnSuccess;
+}
+
+void IOTimerEventSource::fire(void) {
+  armed_ = false;
+  if (action_) {
+    action_(owner_, this);
+  }
+}
+
+void IOTimerEventSource::free(void) {
+  auto& v = timers();
+  v.erase(std::remove(v.begin(), v.end(), this), v.end());
+}
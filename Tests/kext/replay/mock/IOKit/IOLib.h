@@ -0,0 +1,306 @@
+#pragma once
+
+// A userspace substitute of IOKit for the replay harness.
+// Only interfaces which are used in src/core/kext are provided.
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mach/mach_types.h>
+#include <sys/types.h>
+
+#include "../strlcpy.h"
+
+typedef uint8_t UInt8;
+typedef int8_t SInt8;
+typedef uint16_t UInt16;
+typedef int16_t SInt16;
+typedef uint32_t UInt32;
+typedef int32_t SInt32;
+// UInt64 is unsigned long long in macOS. (The kext prints it with %lld.)
+typedef unsigned long long UInt64;
+typedef long long SInt64;
+
+typedef int IOReturn;
+typedef int32_t IOFixed;
+typedef uint32_t IOOptionBits;
+typedef uint32_t IOItemCount;
+typedef uint64_t AbsoluteTime;
+typedef uint64_t mach_vm_size_t;
+typedef uint64_t mach_vm_address_t;
+typedef uint64_t io_user_reference_t;
+typedef uint64_t OSAsyncReference64[8];
+typedef void* task_t;
+typedef unsigned long clock_sec_t;
+typedef unsigned int clock_usec_t;
+
+enum {
+  kIOReturnSuccess = 0,
+  kIOReturnError = 0x2bc,
+  kIOReturnNoMemory = 0x2bd,
+  kIOReturnNoResources = 0x2be,
+  kIOReturnBadArgument = 0x2c2,
+  kIOReturnExclusiveAccess = 0x2c5,
+  kIOReturnUnsupported = 0x2c7,
+  kIOReturnCannotLock = 0x2cc,
+  kIOReturnNotOpen = 0x2cd,
+  kIOReturnNotAttached = 0x2d5,
+};
+
+enum {
+  kNanosecondScale = 1,
+  kMicrosecondScale = 1000,
+  kMillisecondScale = 1000 * 1000,
+  kSecondScale = 1000 * 1000 * 1000,
+};
+
+#define KERN_SUCCESS 0
+
+
+inline int max(int a, int b) { return a > b ? a : b; }
+inline int min(int a, int b) { return a < b ? a : b; }
+
+// ----------------------------------------------------------------------
+// The virtual monotonic clock.
+//
+// The clock is advanced only by mock_iokit::run_until (IOTimerEventSource.h) or set_uptime_ns.
+// Then the kext code is deterministic.
+namespace mock_iokit {
+uint64_t get_uptime_ns(void);
+void set_uptime_ns(uint64_t ns);
+
+// IOLog is printed to stderr only if IOLog is enabled.
+void set_iolog_enabled(bool enabled);
+bool get_iolog_enabled(void);
+}
+
+#define AbsoluteTime_to_scalar(x) (*(uint64_t*)(x))
+
+inline void clock_get_uptime(uint64_t* result) { *result = mock_iokit::get_uptime_ns(); }
+inline void absolutetime_to_nanoseconds(uint64_t abstime, uint64_t* result) { *result = abstime; }
+inline void nanoseconds_to_absolutetime(uint64_t nanoseconds, uint64_t* result) { *result = nanoseconds; }
+inline void clock_get_system_microtime(clock_sec_t* secs, clock_usec_t* microsecs) {
+  uint64_t ns = mock_iokit::get_uptime_ns();
+  *secs = static_cast<clock_sec_t>(ns / 1000000000);
+  *microsecs = static_cast<clock_usec_t>((ns / 1000) % 1000000);
+}
+
+inline void IOLog(const char* format, ...) {
+  if (!mock_iokit::get_iolog_enabled()) return;
+
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+// The harness is single-threaded. (The workloop and event callbacks run in the harness thread.)
+inline void IOSleep(unsigned int) {}
+
+inline void* IOMalloc(size_t size) { return ::operator new(size); }
+inline void IOFree(void* p, size_t) { ::operator delete(p); }
+
+struct IOLock {
+  int locked;
+};
+inline IOLock* IOLockAlloc(void) { return new IOLock{0}; }
+inline void IOLockFree(IOLock* lock) { delete lock; }
+inline void IOLockLock(IOLock* lock) { ++(lock->locked); }
+inline void IOLockUnlock(IOLock* lock) { --(lock->locked); }
+
+inline int copyin(user_addr_t src, void* dst, size_t len) {
+  memcpy(dst, reinterpret_cast<const void*>(src), len);
+  return 0;
+}
+inline int copyout(const void* src, user_addr_t dst, size_t len) {
+  memcpy(reinterpret_cast<void*>(dst), src, len);
+  return 0;
+}
+
+// ----------------------------------------------------------------------
+// libkern
+
+class OSObject {
+public:
+  OSObject(void) : retainCount_(1) {}
+  virtual ~OSObject(void) {}
+
+  virtual bool init(void) { return true; }
+  virtual void free(void) {}
+
+  void retain(void) const { ++retainCount_; }
+  void release(void) const {
+    if (--retainCount_ == 0) {
+      const_cast<OSObject*>(this)->free();
+      delete this;
+    }
+  }
+
+private:
+  OSObject(const OSObject&);
+  OSObject& operator=(const OSObject&);
+
+  mutable int retainCount_;
+};
+
+#define OSDeclareDefaultStructors(className) \
+public:                                      \
+  className(void);                           \
+  virtual ~className(void);                  \
+                                             \
+private:
+
+#define OSDefineMetaClassAndStructors(className, superClassName) \
+  className::className(void) {}                                  \
+  className::~className(void) {}
+
+#define OSDynamicCast(type, inst) \
+  (dynamic_cast<type*>(const_cast<OSObject*>(static_cast<const OSObject*>(inst))))
+
+class OSString : public OSObject {
+public:
+  static OSString* withCString(const char* cstring) {
+    auto p = new OSString;
+    p->string_ = cstring ? cstring : "";
+    return p;
+  }
+
+  const char* getCStringNoCopy(void) const { return string_; }
+  bool isEqualTo(const char* cstring) const { return cstring && strcmp(string_, cstring) == 0; }
+
+private:
+  const char* string_;
+};
+
+class OSSymbol : public OSString {};
+
+class OSNumber : public OSObject {
+public:
+  static OSNumber* withNumber(unsigned long long value, unsigned int) {
+    auto p = new OSNumber;
+    p->value_ = value;
+    return p;
+  }
+
+  unsigned int unsigned32BitValue(void) const { return static_cast<unsigned int>(value_); }
+  unsigned long long unsigned64BitValue(void) const { return value_; }
+
+private:
+  unsigned long long value_;
+};
+
+class OSDictionary : public OSObject {};
+
+inline bool OSCompareAndSwap(UInt32 oldValue, UInt32 newValue, volatile UInt32* address) {
+  if (*address != oldValue) return false;
+  *address = newValue;
+  return true;
+}
+inline SInt32 OSIncrementAtomic(volatile SInt32* address) { return (*address)++; }
+inline SInt32 OSDecrementAtomic(volatile SInt32* address) { return (*address)--; }
+inline SInt32 OSAddAtomic(SInt32 amount, volatile SInt32* address) {
+  SInt32 old = *address;
+  *address += amount;
+  return old;
+}
+inline void OSMemoryBarrier(void) {}
+inline int cpu_number(void) { return 0; }
+
+// ----------------------------------------------------------------------
+// IORegistryEntry
+
+#define kIOServicePlane "IOService"
+
+class IORegistryEntry : public OSObject {
+public:
+  enum {
+    MAX_PROPERTIES = 8,
+  };
+
+  IORegistryEntry(void) : name_(""), propertiesCount_(0) {}
+
+  const char* getName(const void* plane = nullptr) const { return name_; }
+  void setName(const char* name) { name_ = name; }
+
+  OSObject* getProperty(const char* key) const {
+    for (int i = 0; i < propertiesCount_; ++i) {
+      if (strcmp(propertyKeys_[i], key) == 0) {
+        return propertyValues_[i];
+      }
+    }
+    return nullptr;
+  }
+  OSObject* copyProperty(const char* key) const {
+    OSObject* p = getProperty(key);
+    if (p) p->retain();
+    return p;
+  }
+  bool setProperty(const char* key, OSObject* value) {
+    if (propertiesCount_ >= MAX_PROPERTIES) return false;
+    propertyKeys_[propertiesCount_] = key;
+    propertyValues_[propertiesCount_] = value;
+    ++propertiesCount_;
+    return true;
+  }
+  bool setProperty(const char* key, const char* value) { return setProperty(key, OSString::withCString(value)); }
+  bool setProperty(const char* key, unsigned long long value, unsigned int numberOfBits) {
+    return setProperty(key, OSNumber::withNumber(value, numberOfBits));
+  }
+
+  IORegistryEntry* getParentEntry(const void* plane) const { return nullptr; }
+  static const void* getPlane(const char* name) { return nullptr; }
+
+  void free(void) override {
+    for (int i = 0; i < propertiesCount_; ++i) {
+      propertyValues_[i]->release();
+    }
+    propertiesCount_ = 0;
+  }
+
+private:
+  const char* name_;
+  const char* propertyKeys_[MAX_PROPERTIES];
+  OSObject* propertyValues_[MAX_PROPERTIES];
+  int propertiesCount_;
+};
+
+// ----------------------------------------------------------------------
+// IOWorkLoop
+
+class IOEventSource;
+
+class IOWorkLoop : public OSObject {
+public:
+  static IOWorkLoop* workLoop(void) { return new IOWorkLoop; }
+
+  IOReturn addEventSource(IOEventSource* eventSource);
+  IOReturn removeEventSource(IOEventSource* eventSource);
+};
+
+class IOEventSource : public OSObject {
+public:
+  IOEventSource(void) : workLoop_(nullptr) {}
+
+  IOWorkLoop* getWorkLoop(void) const { return workLoop_; }
+  void setWorkLoop(IOWorkLoop* workLoop) { workLoop_ = workLoop; }
+
+  void enable(void) {}
+  void disable(void) {}
+
+private:
+  IOWorkLoop* workLoop_;
+};
+
+inline IOReturn IOWorkLoop::addEventSource(IOEventSource* eventSource) {
+  if (!eventSource) return kIOReturnBadArgument;
+  eventSource->setWorkLoop(this);
+  return kIOReturnSuccess;
+}
+
+inline IOReturn IOWorkLoop::removeEventSource(IOEventSource* eventSource) {
+  if (!eventSource) return kIOReturnBadArgument;
+  eventSource->setWorkLoop(nullptr);
+  return kIOReturnSuccess;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <IOKit/IOLib.h>
+
+class IONotifier : public OSObject {
+public:
+  virtual void remove(void) {}
+};
+
+class IOService : public IORegistryEntry {
+public:
+  typedef bool (*IOServiceMatchingNotificationHandler)(void* target, void* refCon, IOService* newService, IONotifier* notifier);
+
+  virtual bool init(OSDictionary* dictionary = nullptr) { return true; }
+  virtual IOService* probe(IOService* provider, SInt32* score) { return this; }
+  virtual bool start(IOService* provider) { return true; }
+  virtual void stop(IOService* provider) {}
+  virtual bool terminate(IOOptionBits options = 0) { return true; }
+
+  virtual bool open(IOService* forClient, IOOptionBits options = 0, void* arg = nullptr) { return true; }
+  virtual void close(IOService* forClient, IOOptionBits options = 0) {}
+  virtual bool isOpen(const IOService* forClient = nullptr) const { return false; }
+  bool isInactive(void) const { return false; }
+
+  IOService* getProvider(void) const { return nullptr; }
+  IOWorkLoop* getWorkLoop(void) const { return nullptr; }
+  void registerService(void) {}
+};
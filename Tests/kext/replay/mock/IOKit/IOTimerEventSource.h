@@ -0,0 +1,43 @@
+#pragma once
+
+#include <IOKit/IOLib.h>
+
+// IOTimerEventSource on the virtual clock.
+//
+// Timers are fired only in mock_iokit::run_until.
+class IOTimerEventSource : public IOEventSource {
+public:
+  typedef void (*Action)(OSObject* owner, IOTimerEventSource* sender);
+
+  static IOTimerEventSource* timerEventSource(OSObject* owner, Action action);
+
+  IOReturn setTimeout(UInt32 interval, UInt32 scaleFactor);
+  IOReturn setTimeoutMS(UInt32 ms) { return setTimeout(ms, kMillisecondScale); }
+  IOReturn setTimeoutUS(UInt32 us) { return setTimeout(us, kMicrosecondScale); }
+  void cancelTimeout(void) { armed_ = false; }
+
+  bool isArmed(void) const { return armed_; }
+  uint64_t getDeadline(void) const { return deadline_; }
+
+  // Disarm and call the action.
+  void fire(void);
+
+  void free(void) override;
+
+private:
+  IOTimerEventSource(void) : owner_(nullptr), action_(nullptr), armed_(false), deadline_(0) {}
+
+  OSObject* owner_;
+  Action action_;
+  bool armed_;
+  uint64_t deadline_;
+};
+
+namespace mock_iokit {
+// Return the timer which expires first. (nullptr if no timer is armed.)
+IOTimerEventSource* get_next_timer(void);
+
+// Fire timers which expire until `ns` in order of their deadlines, and then set the clock to `ns`.
+// The clock is set to the deadline of each timer while the timer is fired.
+void run_until(uint64_t ns);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <IOKit/IOService.h>
+
+#define kIOClientPrivilegeLocalUser "local"
+
+struct IOExternalMethodArguments {
+  uint32_t version;
+  uint32_t selector;
+  void* asyncWakePort;
+  io_user_reference_t* asyncReference;
+  uint32_t asyncReferenceCount;
+  const uint64_t* scalarInput;
+  uint32_t scalarInputCount;
+  const void* structureInput;
+  uint32_t structureInputSize;
+  void* structureInputDescriptor;
+  uint64_t* scalarOutput;
+  uint32_t scalarOutputCount;
+  void* structureOutput;
+  uint32_t structureOutputSize;
+  void* structureOutputDescriptor;
+  uint32_t structureOutputDescriptorSize;
+};
+
+typedef IOReturn (*IOExternalMethodAction)(OSObject* target, void* reference, IOExternalMethodArguments* arguments);
+
+struct IOExternalMethodDispatch {
+  IOExternalMethodAction function;
+  uint32_t checkScalarInputCount;
+  uint32_t checkStructureInputSize;
+  uint32_t checkScalarOutputCount;
+  uint32_t checkStructureOutputSize;
+};
+
+class IOUserClient : public IOService {
+public:
+  virtual bool initWithTask(task_t owningTask, void* securityToken, UInt32 type) { return true; }
+  virtual IOReturn clientClose(void) { return kIOReturnSuccess; }
+  virtual IOReturn clientDied(void) { return kIOReturnSuccess; }
+  virtual bool didTerminate(IOService* provider, IOOptionBits options, bool* defer) { return true; }
+  virtual IOReturn externalMethod(uint32_t selector, IOExternalMethodArguments* arguments,
+                                  IOExternalMethodDispatch* dispatch, OSObject* target, void* reference) {
+    return kIOReturnUnsupported;
+  }
+
+  static IOReturn sendAsyncResult64(OSAsyncReference64 reference, IOReturn result, io_user_reference_t* args, UInt32 numArgs) {
+    return kIOReturnSuccess;
+  }
+  static IOReturn clientHasPrivilege(void* securityToken, const char* privilegeName) { return kIOReturnSuccess; }
+};
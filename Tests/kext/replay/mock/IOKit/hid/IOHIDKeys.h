@@ -0,0 +1,7 @@
+#pragma once
+
+#define kIOHIDVendorIDKey "VendorID"
+#define kIOHIDProductIDKey "ProductID"
+#define kIOHIDLocationIDKey "LocationID"
+#define kIOHIDManufacturerKey "Manufacturer"
+#define kIOHIDProductKey "Product"
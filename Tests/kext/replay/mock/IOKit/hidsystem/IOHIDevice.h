@@ -0,0 +1,5 @@
+#pragma once
+
+#include <IOKit/IOService.h>
+
+class IOHIDevice : public IOService {};
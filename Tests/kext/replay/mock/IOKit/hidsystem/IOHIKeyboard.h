@@ -0,0 +1,84 @@
+#pragma once
+
+#include <IOKit/hidsystem/IOHIDevice.h>
+
+typedef void (*KeyboardEventAction)(OSObject* target,
+                                    unsigned eventType,
+                                    unsigned flags,
+                                    unsigned key,
+                                    unsigned charCode,
+                                    unsigned charSet,
+                                    unsigned origCharCode,
+                                    unsigned origCharSet,
+                                    unsigned keyboardType,
+                                    bool repeat,
+                                    AbsoluteTime ts);
+typedef void (*KeyboardSpecialEventAction)(OSObject* target,
+                                           unsigned eventType,
+                                           unsigned flags,
+                                           unsigned key,
+                                           unsigned flavor,
+                                           UInt64 guid,
+                                           bool repeat,
+                                           AbsoluteTime ts);
+typedef void (*UpdateEventFlagsAction)(OSObject* target,
+                                       unsigned flags);
+
+// The real IOHIKeyboard calls actions with sender and refcon.
+typedef void (*KeyboardEventCallback)(OSObject* target,
+                                      unsigned eventType,
+                                      unsigned flags,
+                                      unsigned key,
+                                      unsigned charCode,
+                                      unsigned charSet,
+                                      unsigned origCharCode,
+                                      unsigned origCharSet,
+                                      unsigned keyboardType,
+                                      bool repeat,
+                                      AbsoluteTime ts,
+                                      OSObject* sender,
+                                      void* refcon);
+typedef void (*KeyboardSpecialEventCallback)(OSObject* target,
+                                             unsigned eventType,
+                                             unsigned flags,
+                                             unsigned key,
+                                             unsigned flavor,
+                                             UInt64 guid,
+                                             bool repeat,
+                                             AbsoluteTime ts,
+                                             OSObject* sender,
+                                             void* refcon);
+typedef void (*UpdateEventFlagsCallback)(OSObject* target,
+                                         unsigned flags,
+                                         OSObject* sender,
+                                         void* refcon);
+
+class IOHIKeyboard : public IOHIDevice {
+public:
+  IOHIKeyboard(void) : _keyboardEventTarget(nullptr),
+                       _keyboardEventAction(nullptr),
+                       _keyboardSpecialEventTarget(nullptr),
+                       _keyboardSpecialEventAction(nullptr),
+                       _updateEventFlagsTarget(nullptr),
+                       _updateEventFlagsAction(nullptr),
+                       alphaLock_(false),
+                       numLock_(false) {}
+
+  virtual bool alphaLock(void) { return alphaLock_; }
+  virtual void setAlphaLock(bool val) { alphaLock_ = val; }
+  virtual bool numLock(void) { return numLock_; }
+  virtual void setNumLock(bool val) { numLock_ = val; }
+  virtual unsigned eventFlags(void) { return 0; }
+
+protected:
+  OSObject* _keyboardEventTarget;
+  KeyboardEventAction _keyboardEventAction;
+  OSObject* _keyboardSpecialEventTarget;
+  KeyboardSpecialEventAction _keyboardSpecialEventAction;
+  OSObject* _updateEventFlagsTarget;
+  UpdateEventFlagsAction _updateEventFlagsAction;
+
+private:
+  bool alphaLock_;
+  bool numLock_;
+};
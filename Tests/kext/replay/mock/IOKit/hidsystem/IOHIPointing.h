@@ -0,0 +1,58 @@
+#pragma once
+
+#include <IOKit/hidsystem/IOHIDevice.h>
+
+typedef void (*RelativePointerEventAction)(OSObject* target,
+                                           int buttons,
+                                           int dx,
+                                           int dy,
+                                           AbsoluteTime ts);
+typedef void (*ScrollWheelEventAction)(OSObject* target,
+                                       short deltaAxis1,
+                                       short deltaAxis2,
+                                       short deltaAxis3,
+                                       IOFixed fixedDelta1,
+                                       IOFixed fixedDelta2,
+                                       IOFixed fixedDelta3,
+                                       SInt32 pointDelta1,
+                                       SInt32 pointDelta2,
+                                       SInt32 pointDelta3,
+                                       SInt32 options,
+                                       AbsoluteTime ts);
+
+// The real IOHIPointing calls actions with sender and refcon.
+typedef void (*RelativePointerEventCallback)(OSObject* target,
+                                             int buttons,
+                                             int dx,
+                                             int dy,
+                                             AbsoluteTime ts,
+                                             OSObject* sender,
+                                             void* refcon);
+typedef void (*ScrollWheelEventCallback)(OSObject* target,
+                                         short deltaAxis1,
+                                         short deltaAxis2,
+                                         short deltaAxis3,
+                                         IOFixed fixedDelta1,
+                                         IOFixed fixedDelta2,
+                                         IOFixed fixedDelta3,
+                                         SInt32 pointDelta1,
+                                         SInt32 pointDelta2,
+                                         SInt32 pointDelta3,
+                                         SInt32 options,
+                                         AbsoluteTime ts,
+                                         OSObject* sender,
+                                         void* refcon);
+
+class IOHIPointing : public IOHIDevice {
+public:
+  IOHIPointing(void) : _relativePointerEventTarget(nullptr),
+                       _relativePointerEventAction(nullptr),
+                       _scrollWheelEventTarget(nullptr),
+                       _scrollWheelEventAction(nullptr) {}
+
+protected:
+  OSObject* _relativePointerEventTarget;
+  RelativePointerEventAction _relativePointerEventAction;
+  OSObject* _scrollWheelEventTarget;
+  ScrollWheelEventAction _scrollWheelEventAction;
+};
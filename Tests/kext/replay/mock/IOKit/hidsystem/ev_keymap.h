@@ -0,0 +1,14 @@
+#pragma once
+
+#define NX_KEYTYPE_SOUND_UP 0
+#define NX_KEYTYPE_SOUND_DOWN 1
+#define NX_KEYTYPE_BRIGHTNESS_UP 2
+#define NX_KEYTYPE_BRIGHTNESS_DOWN 3
+#define NX_POWER_KEY 6
+#define NX_KEYTYPE_MUTE 7
+#define NX_KEYTYPE_PLAY 16
+#define NX_KEYTYPE_NEXT 17
+#define NX_KEYTYPE_PREVIOUS 18
+#define NX_KEYTYPE_ILLUMINATION_UP 21
+#define NX_KEYTYPE_ILLUMINATION_DOWN 22
+#define NX_KEYTYPE_ILLUMINATION_TOGGLE 23
@@ -0,0 +1,8 @@
+#pragma once
+
+// bridge.h includes mach/mach_types.h for user_addr_t and user_size_t.
+
+#include <cstdint>
+
+typedef uint64_t user_addr_t;
+typedef uint64_t user_size_t;
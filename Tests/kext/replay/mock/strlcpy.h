@@ -0,0 +1,23 @@
+#pragma once
+
+// glibc provides strlcpy and strlcat since 2.38.
+// (The kext and xml_compiler use them.)
+
+#include <cstring>
+
+#if defined(__GLIBC__) && !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = (len < size - 1) ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+inline size_t strlcat(char* dst, const char* src, size_t size) {
+  size_t dstlen = strnlen(dst, size);
+  if (dstlen == size) return size + strlen(src);
+  return dstlen + strlcpy(dst + dstlen, src, size - dstlen);
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+// sysctl variables are not exported in the replay harness.
+// The harness writes registered SYSCTL_INT variables through mock_iokit::set_sysctl_int.
+
+#include <sys/types.h>
+
+struct sysctl_oid {
+  const char* name;
+  int* ptr;
+};
+struct sysctl_oid_list {
+  int unused;
+};
+struct sysctl_req {
+  int unused;
+};
+
+#define SYSCTL_HANDLER_ARGS struct sysctl_oid *oidp, void *arg1, int arg2, struct sysctl_req *req
+
+#define SYSCTL_DECL(name) extern struct sysctl_oid_list sysctl_##name##_children
+#define SYSCTL_NODE(parent, nbr, name, access, handler, descr) \
+  struct sysctl_oid_list sysctl_##parent##_##name##_children;  \
+  struct sysctl_oid sysctl_##parent##_##name = {#name, nullptr}
+#define SYSCTL_INT(parent, nbr, name, access, ptr, val, descr) struct sysctl_oid sysctl_##parent##_##name = {#name, ptr}
+#define SYSCTL_PROC(parent, nbr, name, access, ptr, arg, handler, fmt, descr) struct sysctl_oid sysctl_##parent##_##name = {#name, nullptr}
+#define SYSCTL_STRING(parent, nbr, name, access, arg, len, descr) struct sysctl_oid sysctl_##parent##_##name = {#name, nullptr}
+
+#define OID_AUTO 0
+#define CTLFLAG_RW 0x1
+#define CTLFLAG_RD 0x2
+#define CTLFLAG_ANYBODY 0x4
+#define CTLTYPE_INT 0x8
+#define CTLTYPE_OPAQUE 0x10
+
+namespace mock_iokit {
+void sysctl_register_oid(struct sysctl_oid* oid);
+void sysctl_unregister_oid(struct sysctl_oid* oid);
+
+// Return false if the registered SYSCTL_INT is not found.
+bool set_sysctl_int(const char* name, int value);
+}
+
+inline void sysctl_register_oid(struct sysctl_oid* oid) { mock_iokit::sysctl_register_oid(oid); }
+inline void sysctl_unregister_oid(struct sysctl_oid* oid) { mock_iokit::sysctl_unregister_oid(oid); }
+inline int sysctl_handle_int(struct sysctl_oid*, void*, int, struct sysctl_req*) { return 0; }
+inline int sysctl_handle_opaque(struct sysctl_oid*, void*, int, struct sysctl_req*) { return 0; }
@@ -0,0 +1,102 @@
+// Replay a trace and print output events and processing time of input events.
+//
+// Usage:
+//   ./replay [-s system_xml_directory] [-p private_xml_directory]
+//            [-e identifier]... [-c identifier=value]... trace_file
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include "harness.hpp"
+
+namespace {
+void usage(void) {
+  std::cerr << "Usage: replay [-s system_xml_directory] [-p private_xml_directory] "
+            << "[-e identifier]... [-c identifier=value]... trace_file" << std::endl;
+  exit(1);
+}
+}
+
+int main(int argc, const char* argv[]) {
+  std::string system_xml_directory = "../../../src/core/server/Resources";
+  std::string private_xml_directory = "data/private_xml";
+  std::vector<std::string> enabled_identifiers;
+  std::vector<std::pair<std::string, int>> essential_configurations;
+  std::string trace_file;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "-p") == 0 ||
+        strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "-c") == 0) {
+      if (i + 1 >= argc) usage();
+      std::string option = argv[i];
+      std::string value = argv[++i];
+
+      if (option == "-s") {
+        system_xml_directory = value;
+      } else if (option == "-p") {
+        private_xml_directory = value;
+      } else if (option == "-e") {
+        enabled_identifiers.push_back(value);
+      } else {
+        auto pos = value.find('=');
+        if (pos == std::string::npos) usage();
+        essential_configurations.push_back(std::make_pair(value.substr(0, pos), atoi(value.c_str() + pos + 1)));
+      }
+    } else {
+      if (!trace_file.empty()) usage();
+      trace_file = argv[i];
+    }
+  }
+  if (trace_file.empty()) usage();
+
+  std::ifstream trace(trace_file);
+  if (!trace) {
+    std::cerr << "Cannot open " << trace_file << std::endl;
+    return 1;
+  }
+
+  try {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    for (const auto& it : enabled_identifiers) {
+      h.enable(it);
+    }
+    for (const auto& it : essential_configurations) {
+      h.set_essential_configuration(it.first, it.second);
+    }
+
+    h.start();
+    h.replay(trace);
+
+    std::cout << "# output events" << std::endl;
+    for (const auto& e : h.get_output_events()) {
+      std::cout << std::fixed << std::setprecision(3) << e.time_ns / 1000000.0 << " " << e.description << std::endl;
+    }
+
+    std::cout << std::endl
+              << "# processing time of input events (microseconds)" << std::endl;
+    uint64_t total = 0;
+    for (const auto& e : h.get_input_events()) {
+      std::cout << std::fixed << std::setprecision(3) << e.time_ns / 1000000.0 << " " << e.description
+                << " : " << e.processing_time_ns / 1000.0 << std::endl;
+      total += e.processing_time_ns;
+    }
+    std::cout << "total : " << total / 1000.0 << std::endl;
+    std::cout << "timer callbacks : " << h.get_timer_processing_time_ns() / 1000.0 << std::endl;
+
+    std::cout << std::endl
+              << "# input to output latency (virtual clock)" << std::endl;
+    for (const auto& it : h.get_latency_histograms()) {
+      std::cout << it << std::endl;
+    }
+
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
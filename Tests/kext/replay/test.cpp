@@ -0,0 +1,1077 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+#include "harness.hpp"
+
+namespace {
+const char* system_xml_directory = "../../../src/core/server/Resources";
+const char* private_xml_directory = "data/private_xml";
+
+std::vector<std::string> replay_trace(replay::harness& h, const char* trace) {
+  std::istringstream is(trace);
+  h.replay(is);
+  return h.get_output_descriptions();
+}
+
+// A private.xml in a temporary directory. (for reload_remapclasses)
+class temporary_private_xml final {
+public:
+  temporary_private_xml(void) {
+    char path[] = "/tmp/replay_private_xml.XXXXXX";
+    if (mkdtemp(path)) {
+      directory_ = path;
+    }
+  }
+  ~temporary_private_xml(void) {
+    std::remove(get_file_path().c_str());
+    rmdir(directory_.c_str());
+  }
+
+  const std::string& get_directory(void) const { return directory_; }
+  std::string get_file_path(void) const { return directory_ + "/private.xml"; }
+
+  // items are "<item>...</item>" strings.
+  void write(const std::vector<std::string>& items) const {
+    std::ofstream os(get_file_path().c_str());
+    os << "<?xml version=\"1.0\"?>\n<root>\n";
+    for (const auto& it : items) {
+      os << it << "\n";
+    }
+    os << "</root>\n";
+  }
+
+private:
+  std::string directory_;
+};
+
+std::string make_item(const std::string& identifier, const std::string& autogen) {
+  return "<item><name>" + identifier + "</name><identifier>" + identifier + "</identifier>"
+         "<autogen>" + autogen + "</autogen></item>";
+}
+
+std::vector<std::string> get_output_descriptions_without_notifications(const replay::harness& h) {
+  std::vector<std::string> v;
+  for (const auto& it : h.get_output_descriptions()) {
+    if (it.compare(0, 13, "notification ") != 0) {
+      v.push_back(it);
+    }
+  }
+  return v;
+}
+
+// "<time in milliseconds> <description>"
+std::vector<std::string> get_timed_output_descriptions(const replay::harness& h) {
+  std::vector<std::string> v;
+  for (const auto& e : h.get_output_events()) {
+    std::ostringstream os;
+    os << e.time_ns / 1000000 << " " << e.description;
+    v.push_back(os.str());
+  }
+  return v;
+}
+}
+
+TEST_CASE("passthrough", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+
+  std::vector<std::string> expected = {
+      "down KeyCode::A",
+      "up KeyCode::A",
+      "modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L",
+      "down KeyCode::B ModifierFlag::SHIFT_L",
+      "up KeyCode::B ModifierFlag::SHIFT_L",
+      "modify KeyCode::SHIFT_L",
+  };
+  REQUIRE(replay_trace(h,
+                 "0 down KeyCode::A\n"
+                 "10 up KeyCode::A\n"
+                 "20 down KeyCode::SHIFT_L\n"
+                 "30 down KeyCode::B\n"
+                 "40 up KeyCode::B\n"
+                 "50 up KeyCode::SHIFT_L\n"
+                 "100 end\n") == expected);
+
+  REQUIRE(h.get_input_events().size() == 6);
+  REQUIRE(h.get_input_events()[0].description == "down KeyCode::A");
+  REQUIRE(h.get_input_events()[5].time_ns == 50 * 1000 * 1000);
+}
+
+TEST_CASE("KeyToKey", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_keytokey");
+
+  std::vector<std::string> expected = {
+      "modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L",
+      "down KeyCode::B ModifierFlag::SHIFT_L",
+      "up KeyCode::B ModifierFlag::SHIFT_L",
+      "modify KeyCode::SHIFT_L",
+      "down KeyCode::C",
+      "up KeyCode::C",
+  };
+  REQUIRE(replay_trace(h,
+                 "0 down KeyCode::SHIFT_L\n"
+                 "10 down KeyCode::A\n"
+                 "40 up KeyCode::A\n"
+                 "50 up KeyCode::SHIFT_L\n"
+                 "60 down KeyCode::C\n"
+                 "90 up KeyCode::C\n"
+                 "1000 end\n") == expected);
+}
+
+TEST_CASE("SimultaneousKeyPresses", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_simultaneouskeypresses");
+
+  SECTION("simultaneous") {
+    // Events are sent after parameter.simultaneouskeypresses_delay.
+    std::vector<std::string> expected = {
+        "49 down KeyCode::RETURN",
+        "89 up KeyCode::RETURN",
+    };
+    replay_trace(h,
+           "0 down KeyCode::J\n"
+           "10 down KeyCode::K\n"
+           "40 up KeyCode::J\n"
+           "50 up KeyCode::K\n"
+           "1000 end\n");
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  SECTION("not target") {
+    // Keys which are not targets of SimultaneousKeyPresses are not delayed.
+    std::vector<std::string> expected = {
+        "0 down KeyCode::C",
+        "20 up KeyCode::C",
+    };
+    replay_trace(h,
+           "0 down KeyCode::C\n"
+           "20 up KeyCode::C\n"
+           "1000 end\n");
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  SECTION("timeout") {
+    // A target key is delayed until the simultaneous threshold.
+    replay_trace(h,
+           "0 down KeyCode::J\n"
+           "200 up KeyCode::J\n"
+           "1000 end\n");
+    auto& events = h.get_output_events();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].description == "down KeyCode::J");
+    REQUIRE(events[0].time_ns > 0);
+    REQUIRE(events[1].description == "up KeyCode::J");
+  }
+}
+
+TEST_CASE("wait_between_key_events", "[replay]") {
+  const char* trace =
+      "0 down KeyCode::F1\n"
+      "100 up KeyCode::F1\n"
+      "1000 end\n";
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_macro");
+
+    std::vector<std::string> expected = {
+        "0 down KeyCode::A",
+        "1 up KeyCode::A",
+        "2 down KeyCode::B",
+        "3 up KeyCode::B",
+        "4 down KeyCode::C",
+        "5 up KeyCode::C",
+    };
+    replay_trace(h, trace);
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_macro");
+    h.set_essential_configuration("parameter.wait_between_key_events", 0);
+
+    std::vector<std::string> expected = {
+        "0 down KeyCode::A",
+        "0 up KeyCode::A",
+        "0 down KeyCode::B",
+        "0 up KeyCode::B",
+        "0 down KeyCode::C",
+        "0 up KeyCode::C",
+    };
+    replay_trace(h, trace);
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+}
+
+TEST_CASE("wait_between_key_events policy", "[replay]") {
+  const char* trace =
+      "0 down KeyCode::F1\n"
+      "100 up KeyCode::F1\n"
+      "1000 end\n";
+
+  // Return the output times.
+  auto replay_times = [&trace](replay::harness& h) {
+    h.enable("private.replay_macro");
+    replay_trace(h, trace);
+    std::vector<uint64_t> v;
+    for (const auto& e : h.get_output_events()) {
+      v.push_back(e.time_ns / 1000000);
+    }
+    return v;
+  };
+
+  SECTION("device override") {
+    // The keyboard is 0x05ac, 0x0250.
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_vendor_id", 0x05ac);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_product_id", 0x0250);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_wait", 3);
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 3, 6, 9, 12, 15}));
+  }
+
+  SECTION("device override for another device") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_vendor_id", 0x05ac);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_product_id", 0x0251);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_wait", 3);
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 1, 2, 3, 4, 5}));
+  }
+
+  SECTION("known-safe internal keyboard") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_keyboard(0x05ac, 0x0262, "Apple Internal Keyboard / Trackpad");
+    h.set_essential_configuration("general.dont_wait_between_key_events_for_internal_keyboard", 1);
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 0, 0, 0, 0, 0}));
+  }
+
+  SECTION("internal keyboard without the setting") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_keyboard(0x05ac, 0x0262, "Apple Internal Keyboard / Trackpad");
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 1, 2, 3, 4, 5}));
+  }
+
+  SECTION("external keyboard is not known-safe") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_essential_configuration("general.dont_wait_between_key_events_for_internal_keyboard", 1);
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 1, 2, 3, 4, 5}));
+  }
+
+  SECTION("device override takes precedence over known-safe") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_keyboard(0x05ac, 0x0262, "Apple Internal Keyboard / Trackpad");
+    h.set_essential_configuration("general.dont_wait_between_key_events_for_internal_keyboard", 1);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_vendor_id", 0x05ac);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_product_id", 0x0262);
+    h.set_essential_configuration("parameter.wait_between_key_events_device_wait", 2);
+    REQUIRE(replay_times(h) == std::vector<uint64_t>({0, 2, 4, 6, 8, 10}));
+  }
+}
+
+TEST_CASE("macro emission benchmark", "[replay]") {
+  // private.replay_long_macro changes F2 to 26 key strokes (52 events).
+  // The emission time is the time from F2 down to the last output event.
+  const int count = 100;
+  std::ostringstream os;
+  for (int i = 0; i < count; ++i) {
+    os << i * 100 << " down KeyCode::F2\n"
+       << i * 100 + 1 << " up KeyCode::F2\n";
+  }
+  os << count * 100 << " end\n";
+  std::string trace = os.str();
+
+  struct result {
+    uint64_t emission_time_ms;
+    double wall_clock_ns;
+  };
+  auto measure = [&trace](bool internal_keyboard) {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_long_macro");
+    if (internal_keyboard) {
+      h.set_keyboard(0x05ac, 0x0262, "Apple Internal Keyboard / Trackpad");
+      h.set_essential_configuration("general.dont_wait_between_key_events_for_internal_keyboard", 1);
+    }
+    h.start();
+
+    auto begin = std::chrono::steady_clock::now();
+    replay_trace(h, trace.c_str());
+    auto end = std::chrono::steady_clock::now();
+
+    const auto& events = h.get_output_events();
+    REQUIRE(events.size() == count * 52);
+
+    result r;
+    // The first macro. (The virtual clock starts at the time of the first input event.)
+    r.emission_time_ms = (events[51].time_ns - events[0].time_ns) / 1000000;
+    r.wall_clock_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / static_cast<double>(count);
+    return r;
+  };
+
+  result waiting = measure(false);
+  result known_safe = measure(true);
+
+  std::cout << "macro emission (52 events): "
+            << "wait 1ms: " << waiting.emission_time_ms << " ms (" << waiting.wall_clock_ns << " ns/macro), "
+            << "known-safe: " << known_safe.emission_time_ms << " ms (" << known_safe.wall_clock_ns << " ns/macro)" << std::endl;
+
+  REQUIRE(waiting.emission_time_ms == 51);
+  REQUIRE(known_safe.emission_time_ms == 0);
+}
+
+TEST_CASE("invalid trace", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+
+  REQUIRE_THROWS(h.replay_line("0 down KeyCode::UNKNOWN_KEY"));
+  REQUIRE_THROWS(h.replay_line("0 press KeyCode::A"));
+  h.replay_line("10 end");
+  REQUIRE_THROWS(h.replay_line("5 down KeyCode::A"));
+  REQUIRE_NOTHROW(h.replay_line("# comment"));
+  REQUIRE_NOTHROW(h.replay_line(""));
+}
+
+TEST_CASE("EventTrace", "[replay]") {
+  // Events are not recorded by default.
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_keytokey");
+
+    replay_trace(h,
+                 "0 down KeyCode::A\n"
+                 "10 up KeyCode::A\n"
+                 "100 end\n");
+    REQUIRE(h.drain_event_trace().empty());
+  }
+
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_keytokey");
+  h.set_essential_configuration("general.enable_event_trace", 1);
+
+  replay_trace(h,
+               "0 down KeyCode::A\n"
+               "10 up KeyCode::A\n"
+               "100 end\n");
+
+  std::vector<std::string> expected = {
+      "input_push down KeyCode::A",
+      "input_fire down KeyCode::A",
+      "output_fire down KeyCode::B",
+      "input_push up KeyCode::A",
+      "input_fire up KeyCode::A",
+      "output_fire up KeyCode::B",
+  };
+  REQUIRE(h.drain_event_trace() == expected);
+
+  // Entries are moved by drain.
+  REQUIRE(h.drain_event_trace().empty());
+}
+
+TEST_CASE("RemapStatistics", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_keytokey");
+  h.enable("private.replay_filtered");
+  h.start();
+
+  // Statistics are not collected by default.
+  replay_trace(h,
+               "0 down KeyCode::A\n"
+               "10 up KeyCode::A\n"
+               "15 end\n");
+  REQUIRE(h.get_remap_statistics().empty());
+
+  h.set_sysctl("statistics", 1);
+  replay_trace(h,
+               "20 down KeyCode::A\n"
+               "30 up KeyCode::A\n"
+               "40 down KeyCode::C\n"
+               "50 up KeyCode::C\n"
+               "100 end\n");
+
+  std::vector<std::string> expected = {
+      "private.replay_keytokey #1 attempts:3 remaps:2 filtered:0",
+      "private.replay_filtered #1 attempts:0 remaps:0 filtered:2",
+  };
+  REQUIRE(h.get_remap_statistics() == expected);
+}
+
+TEST_CASE("LatencyHistogram", "[replay]") {
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_keytokey");
+    h.start();
+
+    replay_trace(h,
+                 "0 down KeyCode::A\n"
+                 "10 up KeyCode::A\n"
+                 "100 end\n");
+
+    // KeyToKey sends events at the same time as the input events.
+    std::vector<std::string> expected = {
+        "keyboard count:2 sum_us:0 max_us:0",
+    };
+    REQUIRE(h.get_latency_histograms() == expected);
+
+    // Histograms are reset by get_latency_histograms.
+    REQUIRE(h.get_latency_histograms().empty());
+  }
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_simultaneouskeypresses");
+    h.start();
+
+    replay_trace(h,
+                 "0 down KeyCode::J\n"
+                 "10 down KeyCode::K\n"
+                 "40 up KeyCode::J\n"
+                 "50 up KeyCode::K\n"
+                 "1000 end\n");
+
+    // RETURN is sent at 49 ms (measured from J down) and released at 89 ms (measured from K up).
+    std::vector<std::string> expected = {
+        "keyboard count:2 sum_us:88000 max_us:49000",
+    };
+    REQUIRE(h.get_latency_histograms() == expected);
+  }
+}
+
+TEST_CASE("BinaryLog", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_keytokey");
+  h.start();
+
+  // Nothing is recorded while debug is disabled.
+  replay_trace(h,
+               "0 down KeyCode::A\n"
+               "10 up KeyCode::A\n"
+               "15 end\n");
+  REQUIRE(h.drain_log().empty());
+
+  h.set_sysctl("debug", 1);
+  replay_trace(h,
+               "20 down KeyCode::A\n"
+               "30 up KeyCode::A\n"
+               "100 end\n");
+
+  std::vector<std::string> expected = {
+      "debug KeyboardEventCallback [ caught]: eventType 10, flags 0x00000000, key 0x0000, kbdType   0, repeat = 0",
+      "debug KeyboardEventCallback [sending]: eventType 10, flags 0x00000000, key 0x000b, kbdType   0, repeat = 0",
+      "debug KeyboardEventCallback [ caught]: eventType 11, flags 0x00000000, key 0x0000, kbdType   0, repeat = 0",
+      "debug KeyboardEventCallback [sending]: eventType 11, flags 0x00000000, key 0x000b, kbdType   0, repeat = 0",
+  };
+  REQUIRE(h.drain_log() == expected);
+
+  // Entries are moved by drain.
+  REQUIRE(h.drain_log().empty());
+}
+
+TEST_CASE("DeferredEventQueue", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.start();
+
+  // A burst of events from a keyboard and a pointing device.
+  // (More events than the queue size (64) of each device are pushed at the same time.)
+  std::ostringstream trace;
+  std::vector<std::string> expected;
+  for (int i = 1; i <= 100; ++i) {
+    trace << "10 down KeyCode::A\n"
+          << "10 move " << i << " 0\n"
+          << "10 up KeyCode::A\n"
+          << "10 move 0 " << i << "\n";
+
+    // Events after the queue is full are dropped in the device callbacks.
+    if (i <= 32) {
+      expected.push_back("down KeyCode::A");
+      expected.push_back("pointer buttons:0x0 dx:" + std::to_string(i) + " dy:0");
+      expected.push_back("up KeyCode::A");
+      expected.push_back("pointer buttons:0x0 dx:0 dy:" + std::to_string(i));
+    }
+  }
+  trace << "100 end\n";
+
+  REQUIRE(replay_trace(h, trace.str().c_str()) == expected);
+  REQUIRE(h.get_dropped_event_count() == 2 * (200 - 64));
+
+  // The following events are processed.
+  expected.push_back("down KeyCode::B");
+  expected.push_back("up KeyCode::B");
+  REQUIRE(replay_trace(h,
+                       "200 down KeyCode::B\n"
+                       "210 up KeyCode::B\n"
+                       "300 end\n") == expected);
+}
+
+TEST_CASE("coalesce relative pointer events", "[replay]") {
+  const char* trace =
+      "10 move 1 2\n"
+      "10 move 3 4\n"
+      "10 move 5 6\n"
+      "10 down PointingButton::LEFT\n"
+      "10 move 1 0\n"
+      "10 move 1 0\n"
+      "10 scroll 1 0\n"
+      "10 move 0 1\n"
+      "10 up PointingButton::LEFT\n"
+      "10 move -2 -3\n"
+      "10 move -4 -5\n"
+      "100 end\n";
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.start();
+
+    // Move events between barriers are merged and their sums are kept.
+    std::vector<std::string> expected = {
+        "pointer buttons:0x0 dx:9 dy:12",
+        "pointer buttons:0x4 dx:0 dy:0",
+        "pointer buttons:0x4 dx:2 dy:0",
+        "scroll 1 0",
+        "pointer buttons:0x4 dx:0 dy:1",
+        "pointer buttons:0x0 dx:0 dy:0",
+        "pointer buttons:0x0 dx:-6 dy:-8",
+    };
+    REQUIRE(replay_trace(h, trace) == expected);
+  }
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_essential_configuration("parameter.coalesce_relative_pointer_max_events", 2);
+    h.start();
+
+    std::vector<std::string> expected = {
+        "pointer buttons:0x0 dx:4 dy:6",
+        "pointer buttons:0x0 dx:5 dy:6",
+        "pointer buttons:0x4 dx:0 dy:0",
+        "pointer buttons:0x4 dx:2 dy:0",
+        "scroll 1 0",
+        "pointer buttons:0x4 dx:0 dy:1",
+        "pointer buttons:0x0 dx:0 dy:0",
+        "pointer buttons:0x0 dx:-6 dy:-8",
+    };
+    REQUIRE(replay_trace(h, trace) == expected);
+  }
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.set_essential_configuration("parameter.coalesce_relative_pointer_max_events", 1);
+    h.start();
+
+    std::vector<std::string> expected = {
+        "pointer buttons:0x0 dx:1 dy:2",
+        "pointer buttons:0x0 dx:3 dy:4",
+        "pointer buttons:0x0 dx:5 dy:6",
+        "pointer buttons:0x4 dx:0 dy:0",
+        "pointer buttons:0x4 dx:1 dy:0",
+        "pointer buttons:0x4 dx:1 dy:0",
+        "scroll 1 0",
+        "pointer buttons:0x4 dx:0 dy:1",
+        "pointer buttons:0x0 dx:0 dy:0",
+        "pointer buttons:0x0 dx:-2 dy:-3",
+        "pointer buttons:0x0 dx:-4 dy:-5",
+    };
+    REQUIRE(replay_trace(h, trace) == expected);
+  }
+
+  {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_macro");
+    h.set_essential_configuration("parameter.wait_between_key_events", 5);
+    h.start();
+
+    // Move events which are pushed while the output queue is waiting are merged in the output queue.
+    replay_trace(h,
+                 "10 down KeyCode::F1\n"
+                 "11 move 1 2\n"
+                 "12 move 3 4\n"
+                 "13 move 5 6\n"
+                 "14 up KeyCode::F1\n"
+                 "100 end\n");
+
+    std::vector<std::string> expected = {
+        "10 down KeyCode::A",
+        "15 up KeyCode::A",
+        "20 down KeyCode::B",
+        "25 up KeyCode::B",
+        "30 down KeyCode::C",
+        "35 up KeyCode::C",
+        "40 pointer buttons:0x0 dx:9 dy:12",
+    };
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+}
+
+TEST_CASE("DependingPressingPeriodKeyToKey", "[replay]") {
+  // Another key is pressed and released while Space is pressed.
+  const char* nested =
+      "0 down KeyCode::SPACE\n"
+      "50 down KeyCode::A\n"
+      "80 up KeyCode::A\n"
+      "120 up KeyCode::SPACE\n"
+      "1000 end\n";
+  // Space is released before another key is released.
+  const char* rolling =
+      "0 down KeyCode::SPACE\n"
+      "50 down KeyCode::A\n"
+      "80 up KeyCode::SPACE\n"
+      "100 up KeyCode::A\n"
+      "1000 end\n";
+
+  SECTION("default") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_holdingkeytokey");
+
+    // The short period is fixed by another key.
+    std::vector<std::string> expected = {
+        "50 down KeyCode::SPACE",
+        "51 down KeyCode::A",
+        "80 up KeyCode::A",
+        "120 up KeyCode::SPACE",
+    };
+    replay_trace(h, nested);
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  SECTION("holding threshold") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_holdingkeytokey");
+
+    std::vector<std::string> expected = {
+        "200 modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L",
+        "300 modify KeyCode::SHIFT_L",
+    };
+    replay_trace(h,
+                 "0 down KeyCode::SPACE\n"
+                 "300 up KeyCode::SPACE\n"
+                 "1000 end\n");
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  SECTION("Option::HOLD_ON_OTHER_KEY_PRESS") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_holdingkeytokey_hold_on_other_key_press");
+
+    // The long period is fixed by another key without waiting the holding threshold.
+    std::vector<std::string> expected = {
+        "50 modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L",
+        "60 down KeyCode::A ModifierFlag::SHIFT_L",
+        "80 up KeyCode::A ModifierFlag::SHIFT_L",
+        "120 modify KeyCode::SHIFT_L",
+    };
+    replay_trace(h, nested);
+    REQUIRE(get_timed_output_descriptions(h) == expected);
+  }
+
+  SECTION("Option::PERMISSIVE_HOLD") {
+    SECTION("nested") {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey_permissive_hold");
+
+      // Events are blocked by __BlockUntilKeyUp__ until A is released.
+      // Then the long period is fixed because A is released before Space.
+      std::vector<std::string> expected = {
+          "80 modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L",
+          "90 down KeyCode::A ModifierFlag::SHIFT_L",
+          "91 up KeyCode::A ModifierFlag::SHIFT_L",
+          "120 modify KeyCode::SHIFT_L",
+      };
+      replay_trace(h, nested);
+      REQUIRE(get_timed_output_descriptions(h) == expected);
+    }
+
+    SECTION("rolling") {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey_permissive_hold");
+
+      std::vector<std::string> expected = {
+          "80 down KeyCode::SPACE",
+          "81 up KeyCode::SPACE",
+          "82 down KeyCode::A",
+          "100 up KeyCode::A",
+      };
+      replay_trace(h, rolling);
+      REQUIRE(get_timed_output_descriptions(h) == expected);
+    }
+  }
+
+  SECTION("Option::UNINTERRUPTIBLE_BY_MODIFIER") {
+    const char* trace =
+        "0 down KeyCode::SPACE\n"
+        "50 down KeyCode::SHIFT_R\n"
+        "60 down KeyCode::A\n"
+        "80 up KeyCode::A\n"
+        "90 up KeyCode::SHIFT_R\n"
+        "300 up KeyCode::SPACE\n"
+        "1000 end\n";
+
+    {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey");
+
+      replay_trace(h, trace);
+      REQUIRE(get_timed_output_descriptions(h)[0] == "50 down KeyCode::SPACE");
+    }
+    {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey_uninterruptible_by_modifier");
+
+      // SHIFT_R does not fix the short period. A fixes it.
+      // (Space is sent without SHIFT_R because SHIFT_R is pressed after Space.)
+      std::vector<std::string> expected = {
+          "50 modify KeyCode::SHIFT_R ModifierFlag::SHIFT_R",
+          "60 modify KeyCode::SHIFT_R",
+          "70 down KeyCode::SPACE",
+          "80 modify KeyCode::SHIFT_R ModifierFlag::SHIFT_R",
+          "90 down KeyCode::A ModifierFlag::SHIFT_R",
+          "91 up KeyCode::A ModifierFlag::SHIFT_R",
+          "101 modify KeyCode::SHIFT_R",
+          "300 up KeyCode::SPACE",
+      };
+      replay_trace(h, trace);
+      REQUIRE(get_timed_output_descriptions(h) == expected);
+    }
+  }
+
+  SECTION("Option::ADAPTIVE_HOLDING_THRESHOLD") {
+    // Tap Space 4 times in 40 ms, then hold Space for 150 ms.
+    const char* trace =
+        "0 down KeyCode::SPACE\n"
+        "40 up KeyCode::SPACE\n"
+        "100 down KeyCode::SPACE\n"
+        "140 up KeyCode::SPACE\n"
+        "200 down KeyCode::SPACE\n"
+        "240 up KeyCode::SPACE\n"
+        "300 down KeyCode::SPACE\n"
+        "340 up KeyCode::SPACE\n"
+        "400 down KeyCode::SPACE\n"
+        "550 up KeyCode::SPACE\n"
+        "1000 end\n";
+
+    {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey");
+
+      replay_trace(h, trace);
+      auto actual = get_timed_output_descriptions(h);
+      REQUIRE(actual.back() == "551 up KeyCode::SPACE");
+    }
+    {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_holdingkeytokey_adaptive_holding_threshold");
+
+      // The holding threshold becomes 100 ms. (twice of 40 ms is limited to the half of 200 ms.)
+      replay_trace(h, trace);
+      auto actual = get_timed_output_descriptions(h);
+      REQUIRE(actual.size() == 10);
+      REQUIRE(actual[8] == "500 modify KeyCode::SHIFT_L ModifierFlag::SHIFT_L");
+      REQUIRE(actual[9] == "550 modify KeyCode::SHIFT_L");
+    }
+  }
+}
+
+TEST_CASE("config delta", "[replay]") {
+  const char* trace =
+      "10 down KeyCode::A\n"
+      "20 up KeyCode::A\n"
+      "30 down KeyCode::W\n"
+      "40 up KeyCode::W\n"
+      "1000 end\n";
+
+  SECTION("same as set_config") {
+    std::vector<std::string> expected;
+    {
+      replay::harness h(system_xml_directory, private_xml_directory);
+      h.enable("private.replay_config_delta");
+      h.enable("private.replay_config_delta_overlap");
+      expected = replay_trace(h, trace);
+    }
+
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_keytokey");
+    h.enable("private.replay_config_delta_overlap");
+    h.start();
+    h.set_config_delta({
+        {"private.replay_keytokey", 0},
+        {"private.replay_config_delta", 1},
+    });
+
+    REQUIRE(replay_trace(h, trace) == expected);
+    REQUIRE(expected == std::vector<std::string>({
+                                               "down KeyCode::A",
+                                               "up KeyCode::A",
+                                               "down KeyCode::A",
+                                               "up KeyCode::A",
+                                           }));
+  }
+
+  SECTION("disable while the key is pressed") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_keytokey");
+    h.start();
+
+    replay_trace(h, "0 down KeyCode::A\n"
+                    "5 end\n");
+    h.set_config_delta({{"private.replay_keytokey", 0}});
+    replay_trace(h,
+                 "10 up KeyCode::A\n"
+                 "20 down KeyCode::A\n"
+                 "30 up KeyCode::A\n"
+                 "1000 end\n");
+
+    // KeyUp is handled by the disabled remapclass.
+    REQUIRE(h.get_output_descriptions() == std::vector<std::string>({
+                                               "down KeyCode::B",
+                                               "up KeyCode::B",
+                                               "down KeyCode::A",
+                                               "up KeyCode::A",
+                                           }));
+  }
+
+  SECTION("status message") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.enable("private.replay_keytokey");
+    h.start();
+    REQUIRE(h.get_statusmessage() == "");
+
+    h.set_config_delta({{"private.replay_statusmessage", 1}});
+    REQUIRE(h.get_statusmessage() == "Replay ");
+
+    // Changes which do not have status messages keep the message.
+    h.set_config_delta({{"private.replay_keytokey", 0}});
+    REQUIRE(h.get_statusmessage() == "Replay ");
+
+    h.set_config_delta({{"private.replay_statusmessage", 0}});
+    REQUIRE(h.get_statusmessage() == "");
+  }
+
+  SECTION("empty delta") {
+    replay::harness h(system_xml_directory, private_xml_directory);
+    h.start();
+    REQUIRE_THROWS(h.set_config_delta({}));
+  }
+}
+
+TEST_CASE("remapclasses delta", "[replay]") {
+  temporary_private_xml private_xml;
+  REQUIRE(!private_xml.get_directory().empty());
+
+  // Classes which are not in the delta are placed before the changed class.
+  std::vector<std::string> items = {
+      make_item("private.delta_keytokey", "__KeyToKey__ KeyCode::A, KeyCode::B"),
+      make_item("private.delta_sticky", "__KeyToKey__ KeyCode::F5, KeyCode::VK_STICKY_SHIFT_L"),
+      make_item("private.delta_changed", "__KeyToKey__ KeyCode::C, KeyCode::D"),
+      make_item("private.delta_statusmessage", "__ShowStatusMessage__ Delta"),
+  };
+
+  SECTION("keep the runtime state of unchanged classes") {
+    const char* trace1 =
+        "0 down KeyCode::A\n"
+        "10 down KeyCode::F5\n"
+        "20 up KeyCode::F5\n"
+        "30 end\n";
+    const char* trace2 =
+        "40 up KeyCode::A\n"
+        "50 down KeyCode::X\n"
+        "60 up KeyCode::X\n"
+        "70 down KeyCode::C\n"
+        "80 up KeyCode::C\n"
+        "1000 end\n";
+
+    // Without reload.
+    std::vector<std::string> expected;
+    {
+      private_xml.write(items);
+      replay::harness h(system_xml_directory, private_xml.get_directory());
+      h.enable("private.delta_keytokey");
+      h.enable("private.delta_sticky");
+      h.enable("private.delta_changed");
+      h.start();
+      replay_trace(h, trace1);
+      replay_trace(h, trace2);
+      expected = get_output_descriptions_without_notifications(h);
+    }
+
+    private_xml.write(items);
+    replay::harness h(system_xml_directory, private_xml.get_directory());
+    h.enable("private.delta_keytokey");
+    h.enable("private.delta_sticky");
+    h.enable("private.delta_changed");
+    h.start();
+    replay_trace(h, trace1);
+
+    items[2] = make_item("private.delta_changed", "__KeyToKey__ KeyCode::C, KeyCode::E");
+    private_xml.write(items);
+    h.reload_remapclasses();
+
+    replay_trace(h, trace2);
+
+    // KeyUp of A is handled by the held item, and the sticky modifier is applied to X.
+    REQUIRE(expected.size() > 4);
+    REQUIRE(expected[0] == "down KeyCode::B");
+    std::replace(expected.begin(), expected.end(), std::string("down KeyCode::D"), std::string("down KeyCode::E"));
+    std::replace(expected.begin(), expected.end(), std::string("up KeyCode::D"), std::string("up KeyCode::E"));
+    REQUIRE(get_output_descriptions_without_notifications(h) == expected);
+  }
+
+  SECTION("remove a class which has a status message") {
+    private_xml.write(items);
+    replay::harness h(system_xml_directory, private_xml.get_directory());
+    h.enable("private.delta_keytokey");
+    h.enable("private.delta_statusmessage");
+    h.start();
+    REQUIRE(h.get_statusmessage() == "Delta ");
+
+    items.pop_back();
+    private_xml.write(items);
+    h.disable("private.delta_statusmessage");
+    h.reload_remapclasses();
+    REQUIRE(h.get_statusmessage() == "");
+
+    replay_trace(h,
+                 "10 down KeyCode::A\n"
+                 "20 up KeyCode::A\n"
+                 "1000 end\n");
+    REQUIRE(get_output_descriptions_without_notifications(h) == std::vector<std::string>({
+                                                                    "down KeyCode::B",
+                                                                    "up KeyCode::B",
+                                                                }));
+  }
+
+  SECTION("release device filters of replaced classes") {
+    auto make_device_only_item = [](int i) {
+      return "<item><name>private.delta_device_only</name><identifier>private.delta_device_only</identifier>"
+             "<device_only>DeviceVendor::RawValue::0x05ac, DeviceProduct::RawValue::" +
+             std::to_string(0x0250 + i % 2) +
+             "</device_only>"
+             "<autogen>__KeyToKey__ KeyCode::E, KeyCode::F</autogen></item>";
+    };
+
+    items.push_back(make_device_only_item(0));
+    private_xml.write(items);
+    replay::harness h(system_xml_directory, private_xml.get_directory());
+    h.enable("private.delta_device_only");
+    h.start();
+    size_t count = h.get_device_filter_id_count();
+
+    for (int i = 1; i <= 20; ++i) {
+      items.back() = make_device_only_item(i);
+      private_xml.write(items);
+      h.reload_remapclasses();
+      REQUIRE(h.get_device_filter_id_count() == count);
+    }
+
+    // The keyboard is 0x05ac, 0x0250.
+    REQUIRE(replay_trace(h,
+                         "100 down KeyCode::E\n"
+                         "110 up KeyCode::E\n"
+                         "1000 end\n") == std::vector<std::string>({
+                                              "down KeyCode::F",
+                                              "up KeyCode::F",
+                                          }));
+  }
+
+  SECTION("keep the order of status messages") {
+    items.push_back(make_item("private.delta_statusmessage2", "__ShowStatusMessage__ Second"));
+    items.push_back(make_item("private.delta_statusmessage3", "__ShowStatusMessage__ Third"));
+    private_xml.write(items);
+    replay::harness h(system_xml_directory, private_xml.get_directory());
+    h.enable("private.delta_statusmessage");
+    h.enable("private.delta_statusmessage3");
+    h.start();
+    REQUIRE(h.get_statusmessage() == "Delta Third ");
+
+    h.set_config_delta({{"private.delta_statusmessage2", 1}});
+    REQUIRE(h.get_statusmessage() == "Delta Second Third ");
+
+    h.set_config_delta({{"private.delta_statusmessage", 0}});
+    REQUIRE(h.get_statusmessage() == "Second Third ");
+
+    // reload_remapclasses sends the config of the harness.
+    h.enable("private.delta_statusmessage2");
+    h.disable("private.delta_statusmessage");
+    items[4] = make_item("private.delta_statusmessage2", "__ShowStatusMessage__ 2nd");
+    private_xml.write(items);
+    h.reload_remapclasses();
+    REQUIRE(h.get_statusmessage() == "2nd Third ");
+
+    h.set_config_delta({{"private.delta_statusmessage", 1}, {"private.delta_statusmessage3", 0}});
+    REQUIRE(h.get_statusmessage() == "Delta 2nd ");
+  }
+
+  SECTION("benchmark") {
+    // The cost of apply_remapclasses_delta depends on the size of the delta, not the number of remapclasses.
+    auto measure = [&private_xml](size_t count, size_t changed) {
+      std::vector<std::string> v;
+      for (size_t i = 0; i < count; ++i) {
+        v.push_back(make_item("private.delta_bench_" + std::to_string(i), "__KeyToKey__ KeyCode::A, KeyCode::B"));
+      }
+      private_xml.write(v);
+
+      replay::harness h(system_xml_directory, private_xml.get_directory());
+      h.enable("private.delta_bench_0");
+      h.start();
+
+      uint64_t nanoseconds = UINT64_MAX;
+      for (int n = 0; n < 5; ++n) {
+        const char* to = (n % 2 == 0 ? "KeyCode::C" : "KeyCode::B");
+        for (size_t i = 0; i < changed; ++i) {
+          v[i] = make_item("private.delta_bench_" + std::to_string(i), std::string("__KeyToKey__ KeyCode::A, ") + to);
+        }
+        private_xml.write(v);
+        h.reload_remapclasses();
+        nanoseconds = std::min(nanoseconds, h.get_remapclasses_delta_processing_time_ns());
+      }
+      return nanoseconds;
+    };
+
+    uint64_t small = measure(100, 1);
+    uint64_t large = measure(4000, 1);
+    uint64_t large_delta = measure(4000, 400);
+
+    std::cout << "remapclasses delta: "
+              << "1/100 classes: " << small << " ns, "
+              << "1/4000 classes: " << large << " ns, "
+              << "400/4000 classes: " << large_delta << " ns" << std::endl;
+
+    // (Loose bounds for noisy machines.)
+    REQUIRE(large < small * 3 + 20000);
+    REQUIRE(large * 10 < large_delta);
+  }
+}
+
+TEST_CASE("DeviceFilter", "[replay]") {
+  replay::harness h(system_xml_directory, private_xml_directory);
+  h.enable("private.replay_filtered");
+  h.enable("private.replay_device_only");
+  h.enable("private.replay_deviceexists_only");
+  h.enable("private.replay_deviceexists_other");
+
+  std::vector<std::string> expected = {
+      "down KeyCode::C",
+      "up KeyCode::C",
+      "down KeyCode::F",
+      "up KeyCode::F",
+      "down KeyCode::H",
+      "up KeyCode::H",
+      "down KeyCode::I",
+      "up KeyCode::I",
+  };
+  REQUIRE(replay_trace(h,
+                       "0 down KeyCode::C\n"
+                       "10 up KeyCode::C\n"
+                       "20 down KeyCode::E\n"
+                       "30 up KeyCode::E\n"
+                       "40 down KeyCode::G\n"
+                       "50 up KeyCode::G\n"
+                       "60 down KeyCode::I\n"
+                       "70 up KeyCode::I\n"
+                       "1000 end\n") == expected);
+}
@@ -0,0 +1,119 @@
+#include "xml_loader.hpp"
+#include "pqrs/xml_compiler.hpp"
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace replay {
+namespace {
+// checkbox.xml includes files by {{ ENV_Karabiner_Resources }} which is system_xml_directory.
+// Relative include paths are resolved from the including file, so system_xml_directory must be an absolute path.
+std::string make_absolute_path(const std::string& path) {
+  char buffer[PATH_MAX];
+  if (!realpath(path.c_str(), buffer)) {
+    throw std::runtime_error("directory is not found: " + path);
+  }
+  return buffer;
+}
+}
+
+xml_loader::xml_loader(const std::string& system_xml_directory, const std::string& private_xml_directory) {
+  xml_compiler_.reset(new pqrs::xml_compiler(make_absolute_path(system_xml_directory), private_xml_directory));
+  reload();
+}
+
+xml_loader::~xml_loader(void) {}
+
+void xml_loader::reload(void) {
+  xml_compiler_->reload();
+
+  auto& error = xml_compiler_->get_error_information();
+  if (error.get_count() > 0) {
+    throw std::runtime_error(error.get_message());
+  }
+}
+
+const std::vector<uint32_t>&
+xml_loader::get_remapclasses_initialize_vector(void) const {
+  return xml_compiler_->get_remapclasses_initialize_vector().get();
+}
+
+const std::vector<uint32_t>&
+xml_loader::get_remapclasses_delta_vector(void) const {
+  return xml_compiler_->get_remapclasses_delta_vector();
+}
+
+void xml_loader::set_remapclasses_initialize_vector_uploaded(void) {
+  xml_compiler_->set_remapclasses_initialize_vector_uploaded();
+}
+
+std::vector<int32_t>
+xml_loader::make_config_vector(const std::vector<std::string>& enabled_identifiers,
+                               const std::vector<std::pair<std::string, int>>& essential_configurations) const {
+  std::vector<int32_t> v;
+
+  // essential configurations
+  for (size_t i = 0;; ++i) {
+    auto essential_configuration = xml_compiler_->get_essential_configuration(i);
+    if (!essential_configuration) break;
+
+    int value = essential_configuration->get_default_value();
+    for (const auto& it : essential_configurations) {
+      if (it.first == essential_configuration->get_raw_identifier()) {
+        value = it.second;
+      }
+    }
+    v.push_back(value);
+  }
+
+  // remapclasses
+  size_t offset = v.size();
+  v.resize(offset + xml_compiler_->get_remapclasses_initialize_vector().get_config_count(), 0);
+
+  for (const auto& identifier : enabled_identifiers) {
+    v[offset + get_config_index(identifier)] = 1;
+  }
+
+  return v;
+}
+
+uint32_t
+xml_loader::get_config_index(const std::string& identifier) const {
+  auto config_index = xml_compiler_->get_config_index(identifier);
+  if (!config_index) {
+    throw std::runtime_error("unknown identifier: " + identifier);
+  }
+  return *config_index;
+}
+
+uint32_t
+xml_loader::get_symbol(const std::string& name) const {
+  auto value = xml_compiler_->get_symbol_map().get_optional(name);
+  if (!value) {
+    throw std::runtime_error("unknown symbol: " + name);
+  }
+  return *value;
+}
+
+std::string
+xml_loader::get_name(const std::string& type, uint32_t value) const {
+  auto name = xml_compiler_->get_symbol_map().get_name(type, value);
+  if (name) {
+    return *name;
+  }
+
+  std::ostringstream os;
+  os << type << "::0x" << std::hex << value;
+  return os.str();
+}
+
+std::string
+xml_loader::get_identifier(uint32_t configindex) const {
+  auto identifier = xml_compiler_->get_identifier(static_cast<int>(configindex));
+  if (identifier) {
+    return *identifier;
+  }
+  return "";
+}
+}
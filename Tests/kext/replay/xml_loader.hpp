@@ -0,0 +1,60 @@
+#pragma once
+
+// xml_loader compiles xml files by xml_compiler.
+//
+// This file is separated from harness.hpp because
+// xml_compiler (boost) and the kext (mock IOKit) cannot be included in the same translation unit.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pqrs {
+class xml_compiler;
+}
+
+namespace replay {
+class xml_loader final {
+public:
+  // Throws std::runtime_error if xml files have errors.
+  xml_loader(const std::string& system_xml_directory, const std::string& private_xml_directory);
+  ~xml_loader(void);
+
+  // Reload xml files.
+  // Throws std::runtime_error if xml files have errors.
+  void reload(void);
+
+  const std::vector<uint32_t>& get_remapclasses_initialize_vector(void) const;
+
+  // The delta from the remapclasses_initialize_vector which is marked as uploaded.
+  // It is empty if the delta is not available.
+  const std::vector<uint32_t>& get_remapclasses_delta_vector(void) const;
+  void set_remapclasses_initialize_vector_uploaded(void);
+
+  // Make a vector for RemapClassManager::set_config.
+  // (Essential configurations and enabled flags of remapclasses.)
+  //
+  // Unspecified essential configurations are set to their default values.
+  std::vector<int32_t> make_config_vector(const std::vector<std::string>& enabled_identifiers,
+                                          const std::vector<std::pair<std::string, int>>& essential_configurations) const;
+
+  // Throws std::runtime_error if the identifier is not found.
+  uint32_t get_config_index(const std::string& identifier) const;
+
+  // get_symbol("KeyCode::A") returns the value of KeyCode::A.
+  // Throws std::runtime_error if the symbol is not found.
+  uint32_t get_symbol(const std::string& name) const;
+
+  // get_name("KeyCode", 0) returns "KeyCode::A".
+  // Returns a hexadecimal string if the value is not found.
+  std::string get_name(const std::string& type, uint32_t value) const;
+
+  // Returns an empty string if configindex is not found.
+  std::string get_identifier(uint32_t configindex) const;
+
+private:
+  std::unique_ptr<pqrs::xml_compiler> xml_compiler_;
+};
+}
@@ -0,0 +1,83 @@
+#define CATCH_CONFIG_MAIN
+#include "../../include/catch.hpp"
+
+#include <string>
+#include <vector>
+#include "log_format.h"
+
+TEST_CASE("next_conversion", "[log_format]") {
+  const char* format = "a %d %% %7s 0x%08x %ld %lld %zu %p %c";
+  std::vector<int> expected = {
+      PQRS_LOG_FORMAT_ARGUMENT_INT,
+      PQRS_LOG_FORMAT_ARGUMENT_STRING,
+      PQRS_LOG_FORMAT_ARGUMENT_INT,
+      PQRS_LOG_FORMAT_ARGUMENT_LONG,
+      PQRS_LOG_FORMAT_ARGUMENT_LONG_LONG,
+      PQRS_LOG_FORMAT_ARGUMENT_LONG,
+      PQRS_LOG_FORMAT_ARGUMENT_POINTER,
+      PQRS_LOG_FORMAT_ARGUMENT_INT,
+  };
+
+  std::vector<int> actual;
+  const char* p = format;
+  const char* begin = nullptr;
+  int type = PQRS_LOG_FORMAT_ARGUMENT_NONE;
+  while ((p = pqrs_log_format_next_conversion(p, &begin, &type)) != nullptr) {
+    REQUIRE(*begin == '%');
+    actual.push_back(type);
+  }
+  REQUIRE(actual == expected);
+}
+
+TEST_CASE("no conversion", "[log_format]") {
+  REQUIRE(pqrs_log_format_next_conversion("", nullptr, nullptr) == nullptr);
+  REQUIRE(pqrs_log_format_next_conversion("abc %% def", nullptr, nullptr) == nullptr);
+  REQUIRE(pqrs_log_format_next_conversion("abc %", nullptr, nullptr) == nullptr);
+}
+
+TEST_CASE("snprintf", "[log_format]") {
+  char buffer[512];
+  const char strings[] = "caught\0name";
+
+  {
+    uint64_t arguments[] = {
+        0,
+        static_cast<uint64_t>(static_cast<int64_t>(-3)),
+        0x1234,
+        7,
+        123456789012345ULL,
+    };
+    pqrs_log_format_snprintf(buffer, sizeof(buffer),
+                             "[%7s]: %d 0x%08x %% %s %lld\n",
+                             arguments, 5, strings, sizeof(strings));
+    REQUIRE(std::string(buffer) == "[ caught]: -3 0x00001234 % name 123456789012345\n");
+  }
+
+  {
+    // Missing arguments.
+    uint64_t arguments[] = {1};
+    pqrs_log_format_snprintf(buffer, sizeof(buffer),
+                             "%d %d %%\n",
+                             arguments, 1, strings, sizeof(strings));
+    REQUIRE(std::string(buffer) == "1 %d %\n");
+  }
+
+  {
+    // Out of range string offset.
+    uint64_t arguments[] = {100};
+    pqrs_log_format_snprintf(buffer, sizeof(buffer),
+                             "(%s)",
+                             arguments, 1, strings, sizeof(strings));
+    REQUIRE(std::string(buffer) == "()");
+  }
+
+  {
+    // Truncated.
+    char small[8];
+    uint64_t arguments[] = {123456, 789};
+    pqrs_log_format_snprintf(small, sizeof(small),
+                             "%d %d",
+                             arguments, 2, strings, sizeof(strings));
+    REQUIRE(std::string(small) == "123456 ");
+  }
+}
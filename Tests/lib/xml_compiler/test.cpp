@@ -1,7 +1,16 @@
 #define CATCH_CONFIG_MAIN
 #include "../../include/catch.hpp"
 
+#include <atomic>
 #include <boost/property_tree/xml_parser.hpp>
+#include <chrono>
+#include <climits>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 #include "bridge.h"
 #include "pqrs/xml_compiler.hpp"
@@ -685,6 +694,298 @@ TEST_CASE("reload_bindings_clang", "[pqrs_xml_compiler]") {
   pqrs_xml_compiler_terminate(&p);
 }
 
+namespace {
+void check_number_values(const pqrs_xml_compiler_preferences_flat_tree* tree,
+                         const pqrs_xml_compiler_preferences_flat_node& node,
+                         const pqrs::xml_compiler::preferences_checkbox_node&) {
+  REQUIRE(std::string(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, node.base_unit)) == "");
+  REQUIRE(node.step == 1);
+}
+
+void check_number_values(const pqrs_xml_compiler_preferences_flat_tree* tree,
+                         const pqrs_xml_compiler_preferences_flat_node& node,
+                         const pqrs::xml_compiler::preferences_number_node& n) {
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, node.base_unit) == n.get_base_unit());
+  REQUIRE(node.step == n.get_step());
+
+  REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_default_value(&node) == n.get_default_value());
+  REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_step(&node) == n.get_step());
+  REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_base_unit(&node) == n.get_base_unit());
+}
+
+// Compare a flattened node with the original node tree and return the number of nodes.
+template <class T>
+size_t check_flat_node(const pqrs_xml_compiler_preferences_flat_tree* tree,
+                       uint32_t index,
+                       const pqrs::xml_compiler::preferences_node_tree<T>& node_tree) {
+  auto nodes = pqrs_xml_compiler_get_preferences_flat_tree_nodes(tree);
+  REQUIRE(index < tree->nodes_count);
+
+  auto& node = nodes[index];
+  auto& n = node_tree.get_node();
+  REQUIRE(node.index == index);
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, node.name) == n.get_name());
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, node.identifier) == n.get_identifier());
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, node.style) == n.get_style());
+  REQUIRE(node.default_value == n.get_default_value());
+  check_number_values(tree, node, n);
+
+  size_t children_count = 0;
+  if (node_tree.get_children()) {
+    children_count = node_tree.get_children()->size();
+  }
+  REQUIRE(node.children_count == children_count);
+
+  // The per-node API.
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(&node) == children_count);
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(&node, children_count) == nullptr);
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_name(&node) == n.get_name());
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_identifier(&node) == n.get_identifier());
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_style(&node) == n.get_style());
+
+  size_t count = 1;
+  uint32_t child = node.first_child;
+  for (size_t i = 0; i < children_count; ++i) {
+    REQUIRE(child != PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE);
+    REQUIRE(nodes[child].parent == index);
+    REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(&node, i) == &(nodes[child]));
+
+    count += check_flat_node(tree, child, *((*(node_tree.get_children()))[i]));
+    child = nodes[child].next_sibling;
+  }
+  REQUIRE(child == PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE);
+
+  return count;
+}
+}
+
+TEST_CASE("preferences_flat_tree", "[pqrs_xml_compiler]") {
+  pqrs_xml_compiler* p = nullptr;
+  REQUIRE(pqrs_xml_compiler_initialize(&p, "data/system_xml", "data/private_xml") == 0);
+
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree(p) == nullptr);
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(p) == nullptr);
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(nullptr) == 0);
+
+  pqrs_xml_compiler_reload(p, "checkbox.xml");
+
+  auto tree = pqrs_xml_compiler_get_preferences_flat_tree(p);
+  REQUIRE(tree != nullptr);
+  REQUIRE(tree->size == tree->strings_offset + tree->strings_size);
+  REQUIRE(tree->strings_offset == sizeof(*tree) + sizeof(pqrs_xml_compiler_preferences_flat_node) * tree->nodes_count);
+  // The string table ends with '\0'.
+  REQUIRE(reinterpret_cast<const char*>(tree)[tree->size - 1] == '\0');
+  REQUIRE(pqrs_xml_compiler_get_preferences_flat_tree_string(tree, tree->strings_size) == nullptr);
+
+  auto nodes = pqrs_xml_compiler_get_preferences_flat_tree_nodes(tree);
+  REQUIRE(pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(p) == &(nodes[tree->checkbox_root]));
+  REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_root(p) == &(nodes[tree->number_root]));
+  REQUIRE(nodes[tree->checkbox_root].parent == PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE);
+  REQUIRE(nodes[tree->number_root].parent == PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE);
+
+  // Rebuild trees from the flat tree and compare them with the original trees.
+  const pqrs::xml_compiler* xml_compiler = reinterpret_cast<const pqrs::xml_compiler*>(p);
+  size_t checkbox_count = check_flat_node(tree, tree->checkbox_root, xml_compiler->get_preferences_checkbox_node_tree());
+  size_t number_count = check_flat_node(tree, tree->number_root, xml_compiler->get_preferences_number_node_tree());
+  REQUIRE(checkbox_count > 1);
+  REQUIRE(number_count > 1);
+  REQUIRE(checkbox_count + number_count == tree->nodes_count);
+
+  {
+    auto number_root = pqrs_xml_compiler_get_preferences_number_node_tree_root(p);
+    auto child = pqrs_xml_compiler_get_preferences_number_node_tree_child(number_root, 0);
+    REQUIRE(std::string(pqrs_xml_compiler_get_preferences_number_node_tree_name(child)) == "[Key Repeat] Initial Wait");
+    REQUIRE(std::string(pqrs_xml_compiler_get_preferences_number_node_tree_identifier(child)) == "repeat.initial_wait");
+    REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_default_value(child) == 500);
+    REQUIRE(pqrs_xml_compiler_get_preferences_number_node_tree_step(child) == 100);
+    REQUIRE(std::string(pqrs_xml_compiler_get_preferences_number_node_tree_base_unit(child)) == "ms");
+  }
+
+  pqrs_xml_compiler_terminate(&p);
+}
+
+TEST_CASE("preferences_flat_tree benchmark", "[pqrs_xml_compiler]") {
+  // private.xml which has 100 groups of 50 items.
+  const int groups = 100;
+  const int items = 50;
+
+  char directory[] = "/tmp/xml_compiler_test.XXXXXX";
+  REQUIRE(mkdtemp(directory) != nullptr);
+  std::string private_xml_file_path = std::string(directory) + "/private.xml";
+  {
+    std::ofstream ofs(private_xml_file_path);
+    ofs << "<?xml version=\"1.0\"?>\n<root>\n";
+    for (int i = 0; i < groups; ++i) {
+      ofs << "<item><name>Group " << i << "</name>\n";
+      for (int j = 0; j < items; ++j) {
+        ofs << "<item><name>Item " << i << "-" << j << "</name>"
+            << "<appendix>appendix</appendix>"
+            << "<identifier>private.benchmark_" << i << "_" << j << "</identifier></item>\n";
+      }
+      ofs << "</item>\n";
+    }
+    ofs << "</root>\n";
+  }
+
+  pqrs::xml_compiler xml_compiler("data/system_xml", directory);
+  xml_compiler.reload();
+  unlink(private_xml_file_path.c_str());
+  rmdir(directory);
+
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+
+  const int loop = 100;
+  pqrs::xml_compiler::preferences_flat_tree flat_tree;
+
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loop; ++i) {
+    flat_tree.make(xml_compiler.get_preferences_checkbox_node_tree(),
+                   xml_compiler.get_preferences_number_node_tree());
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  auto tree = flat_tree.get();
+  REQUIRE(tree != nullptr);
+  REQUIRE(tree->nodes_count > static_cast<uint32_t>(groups * (items + 1)));
+
+  double microseconds = std::chrono::duration<double, std::micro>(end - begin).count() / loop;
+  std::cout << "preferences_flat_tree: " << tree->nodes_count << " nodes, "
+            << tree->size << " bytes in " << microseconds << " us" << std::endl;
+}
+
+TEST_CASE("reload benchmark", "[pqrs_xml_compiler]") {
+  // Traverse the shipped XML files. (Resources/symbol_map.xml is generated by src/bridge/generator/config.)
+  // We use the absolute path because ENV_Karabiner_Resources is expanded into include paths.
+  char system_xml_directory[PATH_MAX];
+  REQUIRE(realpath("../../../src/core/server/Resources", system_xml_directory) != nullptr);
+
+  pqrs::xml_compiler xml_compiler(system_xml_directory, "data/private_xml");
+
+  const int loop = 5;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loop; ++i) {
+    xml_compiler.reload();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+
+  auto tree = xml_compiler.get_preferences_flat_tree().get();
+  REQUIRE(tree != nullptr);
+  REQUIRE(tree->nodes_count > 1000);
+
+  double milliseconds = std::chrono::duration<double, std::milli>(end - begin).count() / loop;
+  std::cout << "reload: " << tree->nodes_count << " preferences nodes in " << milliseconds << " ms" << std::endl;
+}
+
+namespace {
+void collect_xml_files(std::vector<std::string>& out, const std::string& directory) {
+  DIR* dir = opendir(directory.c_str());
+  if (!dir) return;
+
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name == "." || name == "..") continue;
+
+    std::string path = directory + "/" + name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) continue;
+
+    if (S_ISDIR(st.st_mode)) {
+      collect_xml_files(out, path);
+    } else if (boost::ends_with(name, ".xml")) {
+      out.push_back(path);
+    }
+  }
+  closedir(dir);
+}
+
+// Remove <include> in order to measure only the traversal. (<include> reads another file.)
+void erase_include(boost::property_tree::ptree& pt) {
+  for (auto it = pt.begin(); it != pt.end();) {
+    if (it->first == "include") {
+      it = pt.erase(it);
+    } else {
+      erase_include(it->second);
+      ++it;
+    }
+  }
+}
+
+size_t traverse_extracted_ptree(const pqrs::xml_compiler::extracted_ptree& pt, size_t& known_tags) {
+  size_t count = 0;
+  for (const auto& it : pt) {
+    ++count;
+    if (it.get_tag() != pqrs::xml_compiler::tag_name::unknown) {
+      ++known_tags;
+    }
+    if (!it.children_empty()) {
+      count += traverse_extracted_ptree(it.children_extracted_ptree(), known_tags);
+    }
+  }
+  return count;
+}
+}
+
+TEST_CASE("extracted_ptree benchmark", "[pqrs_xml_compiler]") {
+  std::vector<std::string> files;
+  collect_xml_files(files, "../../../src/core/server/Resources");
+  REQUIRE(files.size() > 100);
+
+  std::vector<boost::property_tree::ptree> ptrees(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    boost::property_tree::read_xml(files[i], ptrees[i], boost::property_tree::xml_parser::trim_whitespace);
+    erase_include(ptrees[i]);
+  }
+
+  pqrs::xml_compiler xml_compiler("data/system_xml", "data/private_xml");
+  pqrs::string::replacement replacement;
+
+  const int loop = 20;
+  size_t count = 0;
+  size_t known_tags = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < loop; ++i) {
+    for (size_t j = 0; j < files.size(); ++j) {
+      count += traverse_extracted_ptree(pqrs::xml_compiler::extracted_ptree(xml_compiler, replacement, ptrees[j], files[j]),
+                                        known_tags);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+  REQUIRE(count > 0);
+  REQUIRE(known_tags > 0);
+
+  double milliseconds = std::chrono::duration<double, std::milli>(end - begin).count() / loop;
+  std::cout << "extracted_ptree: " << count / loop << " nodes in " << milliseconds << " ms" << std::endl;
+}
+
+TEST_CASE("extracted_ptree deep include", "[pqrs_xml_compiler]") {
+  // <include> in items nested deeper than the inline capacity of extracted_ptree::stack.
+  pqrs::xml_compiler xml_compiler("data/system_xml", "data/deep_include_xml");
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+
+  const int depth = 30;
+  auto node_tree = xml_compiler.get_preferences_checkbox_node_tree();
+  REQUIRE(node_tree.get_children() != nullptr);
+
+  // The items of private.xml precede the items of system_xml.
+  auto level = node_tree.get_children()->front();
+  for (int i = 1;; ++i) {
+    REQUIRE(level->get_node().get_name() == "level " + std::to_string(i));
+
+    auto children = level->get_children();
+    REQUIRE(children != nullptr);
+    REQUIRE(children->size() == (i < depth ? 2 : 1));
+    REQUIRE((*children)[0]->get_node().get_name() == "included " + std::to_string(i));
+
+    if (i == depth) break;
+    level = (*children)[1];
+  }
+}
+
 TEST_CASE("reload_invalid_xml", "[pqrs_xml_compiler]") {
   // ------------------------------------------------------------
   // invalid XML format
@@ -1217,6 +1518,405 @@ TEST_CASE("add_partial", "[pqrs_xml_compiler_remapclasses_initialize_vector]") {
   REQUIRE(v.get() == expected);
 }
 
+namespace {
+void make_remapclasses_initialize_vector(pqrs::xml_compiler::remapclasses_initialize_vector& v,
+                                         uint32_t count,
+                                         uint32_t item_count,
+                                         const std::vector<uint32_t>& changed_config_indexes) {
+  v.clear();
+  for (uint32_t i = 0; i < count; ++i) {
+    v.start(i, "remap.item");
+    for (uint32_t j = 0; j < item_count; ++j) {
+      bool changed = std::find(changed_config_indexes.begin(), changed_config_indexes.end(), i) != changed_config_indexes.end();
+      v.push_back(5);
+      v.push_back(BRIDGE_REMAPTYPE_KEYTOKEY);
+      v.push_back(BRIDGE_DATATYPE_KEYCODE);
+      v.push_back(j);
+      v.push_back(BRIDGE_DATATYPE_KEYCODE);
+      v.push_back(changed ? j + 1 : j);
+    }
+    v.end();
+  }
+  v.freeze();
+}
+
+uint32_t checksum(const std::vector<uint32_t>& v) {
+  uint32_t result = 0;
+  size_t offset = 1;
+  for (uint32_t i = 0; i < v[0]; ++i) {
+    result += bridge_remapclasses_initialize_vector_checksum(v[offset + 1], v.data() + offset + 2, v[offset] - 1);
+    offset += 1 + v[offset];
+  }
+  return result;
+}
+}
+
+TEST_CASE("make_delta", "[pqrs_xml_compiler_remapclasses_initialize_vector]") {
+  pqrs::xml_compiler::remapclasses_initialize_vector base;
+  base.clear();
+  base.start(0, "remap.zero");
+  base.push_back(2);
+  base.push_back(BRIDGE_REMAPTYPE_PASSTHROUGH);
+  base.push_back(0);
+  base.end();
+  base.start(1, "remap.one");
+  base.end();
+  base.start(2, "remap.two");
+  base.end();
+  base.freeze();
+
+  // no change
+  {
+    std::vector<uint32_t> delta;
+    REQUIRE(base.make_delta(delta, base.get()) == true);
+
+    std::vector<uint32_t> expected;
+    expected.push_back(3);
+    expected.push_back(3);
+    expected.push_back(checksum(base.get()));
+    expected.push_back(checksum(base.get()));
+    expected.push_back(0);
+    REQUIRE(delta == expected);
+  }
+
+  // replace, remove
+  {
+    pqrs::xml_compiler::remapclasses_initialize_vector v;
+    v.clear();
+    v.start(0, "remap.zero");
+    v.push_back(2);
+    v.push_back(BRIDGE_REMAPTYPE_PASSTHROUGH);
+    v.push_back(0);
+    v.end();
+    v.start(1, "remap.one");
+    v.push_back(1);
+    v.push_back(BRIDGE_REMAPTYPE_DROPALLKEYS);
+    v.end();
+    v.freeze();
+
+    std::vector<uint32_t> delta;
+    REQUIRE(v.make_delta(delta, base.get()) == true);
+
+    std::vector<uint32_t> expected;
+    expected.push_back(2);
+    expected.push_back(3);
+    expected.push_back(checksum(base.get()));
+    expected.push_back(checksum(v.get()));
+    expected.push_back(2);
+
+    expected.push_back(BRIDGE_REMAPCLASSES_DELTA_OPERATION_REPLACE);
+    expected.push_back(3);
+    expected.push_back(1);
+    expected.push_back(1);
+    expected.push_back(BRIDGE_REMAPTYPE_DROPALLKEYS);
+
+    expected.push_back(BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE);
+    expected.push_back(1);
+    expected.push_back(2);
+
+    REQUIRE(delta == expected);
+  }
+
+  // add
+  {
+    pqrs::xml_compiler::remapclasses_initialize_vector v;
+    v.clear();
+    v.start(3, "remap.three");
+    v.push_back(1);
+    v.push_back(BRIDGE_REMAPTYPE_DROPALLKEYS);
+    v.end();
+    v.start(0, "remap.zero");
+    v.push_back(2);
+    v.push_back(BRIDGE_REMAPTYPE_PASSTHROUGH);
+    v.push_back(0);
+    v.end();
+    v.freeze();
+
+    std::vector<uint32_t> delta;
+    REQUIRE(v.make_delta(delta, base.get()) == true);
+
+    std::vector<uint32_t> expected;
+    expected.push_back(4);
+    expected.push_back(3);
+    expected.push_back(checksum(base.get()));
+    expected.push_back(checksum(v.get()));
+    expected.push_back(1);
+
+    expected.push_back(BRIDGE_REMAPCLASSES_DELTA_OPERATION_ADD);
+    expected.push_back(3);
+    expected.push_back(3);
+    expected.push_back(1);
+    expected.push_back(BRIDGE_REMAPTYPE_DROPALLKEYS);
+
+    REQUIRE(delta == expected);
+  }
+
+  // virtual modifier is changed
+  {
+    pqrs::xml_compiler::remapclasses_initialize_vector v;
+    v.clear();
+    v.start(1, "remap.one");
+    v.push_back(3);
+    v.push_back(BRIDGE_MODIFIERNAME);
+    v.push_back(0x1000);
+    v.push_back(0x41);
+    v.end();
+    v.freeze();
+
+    std::vector<uint32_t> delta;
+    REQUIRE(v.make_delta(delta, base.get()) == false);
+    REQUIRE(delta.empty());
+  }
+
+  // broken base
+  {
+    std::vector<uint32_t> delta;
+    REQUIRE(base.make_delta(delta, std::vector<uint32_t>()) == false);
+
+    std::vector<uint32_t> broken(base.get());
+    broken.pop_back();
+    REQUIRE(base.make_delta(delta, broken) == false);
+  }
+}
+
+TEST_CASE("make_delta scalability", "[pqrs_xml_compiler_remapclasses_initialize_vector]") {
+  const uint32_t item_count = 10;
+  const uint32_t chunk_size = 2 + item_count * 6;
+
+  for (uint32_t count : {100, 1000, 10000}) {
+    pqrs::xml_compiler::remapclasses_initialize_vector base;
+    make_remapclasses_initialize_vector(base, count, item_count, std::vector<uint32_t>());
+
+    for (uint32_t changed : {0, 1, 10}) {
+      std::vector<uint32_t> changed_config_indexes;
+      for (uint32_t i = 0; i < changed; ++i) {
+        changed_config_indexes.push_back(i * (count / 10));
+      }
+
+      pqrs::xml_compiler::remapclasses_initialize_vector v;
+      make_remapclasses_initialize_vector(v, count, item_count, changed_config_indexes);
+
+      std::vector<uint32_t> delta;
+      REQUIRE(v.make_delta(delta, base.get()) == true);
+
+      // The amount of data which kext has to reload depends only on changed items.
+      REQUIRE(delta[4] == changed);
+      REQUIRE(delta.size() == 5 + changed * (1 + chunk_size));
+    }
+  }
+}
+
+TEST_CASE("remapclasses_delta_vector", "[pqrs_xml_compiler]") {
+  pqrs::xml_compiler xml_compiler("data/system_xml", "data/private_xml");
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+
+  // Nothing is uploaded yet.
+  REQUIRE(xml_compiler.get_remapclasses_delta_vector().empty());
+
+  xml_compiler.set_remapclasses_initialize_vector_uploaded();
+  {
+    const auto& delta = xml_compiler.get_remapclasses_delta_vector();
+    REQUIRE(delta.size() == 5);
+    REQUIRE(delta[0] == xml_compiler.get_remapclasses_initialize_vector().get_config_count());
+    REQUIRE(delta[1] == xml_compiler.get_remapclasses_initialize_vector().get_config_count());
+    REQUIRE(delta[2] == delta[3]);
+    REQUIRE(delta[4] == 0);
+  }
+
+  // Reloading the same files does not change any RemapClass.
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_remapclasses_delta_vector().size() == 5);
+
+  // bindings
+  {
+    pqrs_xml_compiler* p = nullptr;
+    REQUIRE(pqrs_xml_compiler_initialize(&p, "data/system_xml", "data/private_xml") == 0);
+    pqrs_xml_compiler_reload(p, "checkbox.xml");
+
+    REQUIRE(pqrs_xml_compiler_get_remapclasses_delta_vector_data(p) == nullptr);
+    REQUIRE(pqrs_xml_compiler_get_remapclasses_delta_vector_size(p) == 0);
+
+    pqrs_xml_compiler_set_remapclasses_initialize_vector_uploaded(p);
+    REQUIRE(pqrs_xml_compiler_get_remapclasses_delta_vector_data(p) != nullptr);
+    REQUIRE(pqrs_xml_compiler_get_remapclasses_delta_vector_size(p) == 5);
+
+    pqrs_xml_compiler_terminate(&p);
+  }
+}
+
+namespace {
+// Write private.xml which has `count` items. (The last item is duplicated if `broken`.)
+void write_snapshot_private_xml(const std::string& file_path, char variant, int count, bool broken) {
+  std::ofstream ofs(file_path);
+  ofs << "<?xml version=\"1.0\"?>\n<root>\n";
+  for (int i = 0; i < count; ++i) {
+    ofs << "<item><name>" << variant << i << "</name>"
+        << "<identifier>private.snapshot_" << variant << "_" << i << "</identifier>"
+        << "<autogen>__KeyToKey__ KeyCode::SPACE, KeyCode::TAB</autogen></item>\n";
+  }
+  if (broken) {
+    ofs << "<item><name>broken</name>"
+        << "<identifier>private.snapshot_" << variant << "_0</identifier></item>\n";
+  }
+  ofs << "</root>\n";
+}
+
+// Return the number of items of private.xml in the snapshot or -1 if the snapshot is inconsistent.
+int check_snapshot(const pqrs::xml_compiler::snapshot& snapshot) {
+  auto tree = snapshot.get_preferences_flat_tree().get();
+  if (!tree) return 0;
+
+  auto nodes = pqrs_xml_compiler_get_preferences_flat_tree_nodes(tree);
+  auto& root = nodes[tree->checkbox_root];
+
+  char variant = '\0';
+  int count = 0;
+  for (uint32_t i = 0; i < root.children_count; ++i) {
+    std::string identifier = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[root.first_child + i].identifier);
+    if (!boost::starts_with(identifier, "private.snapshot_")) continue;
+
+    // All items are the same variant.
+    char v = identifier[sizeof("private.snapshot_") - 1];
+    if (variant != '\0' && variant != v) return -1;
+    variant = v;
+
+    // Other members are also in the same snapshot.
+    auto config_index = snapshot.get_config_index(identifier);
+    if (!config_index) return -1;
+    auto raw_identifier = snapshot.get_identifier(*config_index);
+    if (!raw_identifier || *raw_identifier != identifier) return -1;
+
+    ++count;
+  }
+
+  if (snapshot.get_remapclasses_initialize_vector().get_config_count() < static_cast<uint32_t>(count)) return -1;
+
+  return count;
+}
+}
+
+TEST_CASE("snapshot", "[pqrs_xml_compiler]") {
+  char directory[] = "/tmp/xml_compiler_test.XXXXXX";
+  REQUIRE(mkdtemp(directory) != nullptr);
+  std::string private_xml_file_path = std::string(directory) + "/private.xml";
+
+  pqrs::xml_compiler xml_compiler("data/system_xml", directory);
+
+  // The empty snapshot before reload.
+  REQUIRE(xml_compiler.get_snapshot() != nullptr);
+  REQUIRE(check_snapshot(*(xml_compiler.get_snapshot())) == 0);
+
+  // The partial snapshot is published until a reload succeeds.
+  write_snapshot_private_xml(private_xml_file_path, 'a', 5, true);
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 1);
+  // (The broken item is also in the preferences tree.)
+  REQUIRE(check_snapshot(*(xml_compiler.get_snapshot())) == 6);
+
+  write_snapshot_private_xml(private_xml_file_path, 'a', 10, false);
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+
+  auto snapshot_a = xml_compiler.get_snapshot();
+  REQUIRE(check_snapshot(*snapshot_a) == 10);
+
+  // A failed reload keeps the data of the previous snapshot.
+  // The errors are in the published snapshot.
+  write_snapshot_private_xml(private_xml_file_path, 'b', 20, true);
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 1);
+  REQUIRE(xml_compiler.get_snapshot() != snapshot_a);
+  REQUIRE(xml_compiler.get_snapshot()->get_error_information().get_count() == 1);
+  REQUIRE(snapshot_a->get_error_information().get_count() == 0);
+  REQUIRE(check_snapshot(*(xml_compiler.get_snapshot())) == 10);
+  REQUIRE(xml_compiler.get_identifier(*(xml_compiler.get_config_index("private.snapshot_a_0"))) != boost::none);
+  REQUIRE(xml_compiler.get_config_index("private.snapshot_b_0") == boost::none);
+
+  // A successful reload publishes a new snapshot.
+  // The previous snapshot is still valid while it is held.
+  write_snapshot_private_xml(private_xml_file_path, 'b', 20, false);
+  xml_compiler.reload();
+  REQUIRE(xml_compiler.get_error_information().get_count() == 0);
+  REQUIRE(xml_compiler.get_snapshot() != snapshot_a);
+  REQUIRE(check_snapshot(*(xml_compiler.get_snapshot())) == 20);
+  REQUIRE(check_snapshot(*snapshot_a) == 10);
+
+  unlink(private_xml_file_path.c_str());
+  rmdir(directory);
+}
+
+TEST_CASE("snapshot stress", "[pqrs_xml_compiler]") {
+  char directory[] = "/tmp/xml_compiler_test.XXXXXX";
+  REQUIRE(mkdtemp(directory) != nullptr);
+  std::string private_xml_file_path = std::string(directory) + "/private.xml";
+
+  pqrs::xml_compiler xml_compiler("data/system_xml", directory);
+  write_snapshot_private_xml(private_xml_file_path, 'a', 10, false);
+  xml_compiler.reload();
+
+  // Readers query snapshots continuously while the main thread reloads.
+  std::atomic<bool> done(false);
+  std::atomic<int> queries(0);
+  std::atomic<int> inconsistencies(0);
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.push_back(std::thread([&]() {
+      while (!done) {
+        auto snapshot = xml_compiler.get_snapshot();
+        int count = check_snapshot(*snapshot);
+        if (count != 10 && count != 20) {
+          ++inconsistencies;
+        }
+
+        uint32_t appid = 0;
+        for (size_t index = 0; index < snapshot->get_app_vector_size(); ++index) {
+          snapshot->is_app_matched(appid, index, "com.apple.Terminal");
+        }
+        if (!snapshot->get_symbol_map().get_optional("KeyCode::VK_OPEN_URL_WEB_pqrs_org")) {
+          ++inconsistencies;
+        }
+
+        ++queries;
+      }
+    }));
+  }
+
+  const int reload_count = 30;
+  int failed = 0;
+  for (int i = 0; i < reload_count; ++i) {
+    // a, b, broken, a, b, broken, ...
+    switch (i % 3) {
+    case 0:
+      write_snapshot_private_xml(private_xml_file_path, 'a', 10, false);
+      break;
+    case 1:
+      write_snapshot_private_xml(private_xml_file_path, 'b', 20, false);
+      break;
+    case 2:
+      write_snapshot_private_xml(private_xml_file_path, 'c', 30, true);
+      break;
+    }
+    xml_compiler.reload();
+    if (xml_compiler.get_error_information().get_count() > 0) {
+      ++failed;
+    }
+  }
+
+  done = true;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  unlink(private_xml_file_path.c_str());
+  rmdir(directory);
+
+  REQUIRE(failed == reload_count / 3);
+  REQUIRE(queries > 0);
+  REQUIRE(inconsistencies == 0);
+}
+
 TEST_CASE("filter_vector", "[pqrs_xml_compiler_filter_vector]") {
   pqrs::xml_compiler::symbol_map s;
   s.add("ApplicationType", "APP1", 1);
@@ -0,0 +1,50 @@
+#!/usr/bin/ruby
+
+require "#{File.dirname(__FILE__)}/../lib/converter.rb"
+
+# Generate the format table of BinaryLog from IOLOG_DEBUG, IOLOG_DEBUG_POINTING and IOLOG_DEVEL in the kext.
+# The format id must be same as BinaryLog::formatId.
+
+def unescape(literal)
+  literal.gsub(/\\(.)/) do
+    case $1
+    when 'n' then "\n"
+    when 't' then "\t"
+    when '0' then "\0"
+    else $1
+    end
+  end
+end
+
+def fnv1a(string)
+  hash = 2166136261
+  string.each_byte do |b|
+    hash = ((hash ^ b) * 16777619) & 0xffffffff
+  end
+  hash
+end
+
+formats = {}
+
+Dir.glob('../../../core/kext/**/*.{cpp,hpp}').sort.each do |filename|
+  source = IO.read(filename, :encoding => 'UTF-8')
+  source.scan(/\bIOLOG_(?:DEBUG_POINTING|DEBUG|DEVEL)\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)/m) do |m|
+    literals = m[0].scan(/"((?:[^"\\]|\\.)*)"/).map { |l| l[0] }
+    literal = literals.join
+    id = fnv1a(unescape(literal))
+
+    if formats.key?(id) and formats[id] != literal then
+      raise "format id collision: #{formats[id]} #{literal}"
+    end
+    formats[id] = literal
+  end
+end
+
+filepath = '../../output/include.bridge_log_format_table.h.tmp'
+open(filepath, 'w') do |f|
+  formats.keys.sort.each do |id|
+    f << ("{ 0x%08x, \"%s\" },\n" % [id, formats[id]])
+  end
+end
+
+KarabinerBridge::Converter.update_file_if_needed(filepath)
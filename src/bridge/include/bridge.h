@@ -128,6 +128,13 @@ enum {
   BRIDGE_USERCLIENT_TYPE_GET_DEVICE_INFORMATION_CONSUMER,
   BRIDGE_USERCLIENT_TYPE_GET_DEVICE_INFORMATION_POINTING,
   BRIDGE_USERCLIENT_TYPE_UNSET_DEBUG_FLAGS,
+  BRIDGE_USERCLIENT_TYPE_SET_REMAPCLASSES_DELTA,
+  BRIDGE_USERCLIENT_TYPE_GET_TRACE,
+  BRIDGE_USERCLIENT_TYPE_GET_REMAP_STATISTICS,
+  BRIDGE_USERCLIENT_TYPE_GET_LATENCY_HISTOGRAMS,
+  BRIDGE_USERCLIENT_TYPE_GET_LOG,
+  // The data is an array of BridgeSetConfigOne. (only changed values)
+  BRIDGE_USERCLIENT_TYPE_SET_CONFIG_DELTA,
 };
 
 enum {
@@ -183,6 +190,174 @@ struct BridgeDeviceInformation {
 };
 enum { STATIC_ASSERT__sizeof_BridgeDeviceInformation = 1 / (sizeof(struct BridgeDeviceInformation) == 4 + 128 * 2 + 12) };
 
+// ------------------------------------------------------------
+// Event trace definitions.
+// (BRIDGE_USERCLIENT_TYPE_GET_TRACE)
+//
+// The buffer is a BridgeTraceHeader followed by BridgeTraceEntry array.
+// The kext fills entries from the oldest one and removes them from the trace ring.
+enum {
+  BRIDGE_TRACE_TAG_NONE,
+  BRIDGE_TRACE_TAG_INPUT_PUSH,   // An event is pushed into EventInputQueue.
+  BRIDGE_TRACE_TAG_INPUT_FIRE,   // An event is remapped. (EventInputQueue::doFire)
+  BRIDGE_TRACE_TAG_OUTPUT_FIRE,  // An event is sent to the original event action. (EventOutputQueue)
+  BRIDGE_TRACE_TAG_INPUT_DROP,   // An input event is dropped. (key repeat)
+  BRIDGE_TRACE_TAG_OUTPUT_DROP,  // An output event is canceled.
+};
+
+enum {
+  BRIDGE_TRACE_EVENT_NONE,
+  BRIDGE_TRACE_EVENT_KEYBOARD,         // value: KeyCode
+  BRIDGE_TRACE_EVENT_UPDATE_FLAGS,     // value: 0
+  BRIDGE_TRACE_EVENT_CONSUMER,         // value: ConsumerKeyCode
+  BRIDGE_TRACE_EVENT_RELATIVE_POINTER, // value: Buttons, x: dx, y: dy
+  BRIDGE_TRACE_EVENT_SCROLL_WHEEL,     // value: 0, x: deltaAxis1, y: deltaAxis2
+  BRIDGE_TRACE_EVENT_WAIT,             // value: milliseconds
+};
+
+struct BridgeTraceHeader {
+  uint32_t count; // The number of entries in this buffer.
+  uint32_t lost;  // The number of entries which were overwritten before they are read.
+};
+enum { STATIC_ASSERT__sizeof_BridgeTraceHeader = 1 / (sizeof(struct BridgeTraceHeader) == 8) };
+
+struct BridgeTraceEntry {
+  uint64_t timestamp; // uptime in nanoseconds (The HID timestamp for BRIDGE_TRACE_TAG_INPUT_*.)
+  uint64_t autogenId; // 0 if the event is not sent by autogen.
+  uint32_t sequence;
+  uint16_t tag;
+  uint16_t event;
+  uint32_t eventType;
+  uint32_t value;
+  uint32_t flags;
+  uint32_t device; // (vendor << 16) | product. 0 if the event is not sent by a device.
+  int32_t x;
+  int32_t y;
+};
+enum { STATIC_ASSERT__sizeof_BridgeTraceEntry = 1 / (sizeof(struct BridgeTraceEntry) == 48) };
+
+// ------------------------------------------------------------
+// Remap statistics definitions.
+// (BRIDGE_USERCLIENT_TYPE_GET_REMAP_STATISTICS)
+//
+// Statistics are collected while sysctl karabiner.statistics is enabled.
+// The option is BRIDGE_REMAP_STATISTICS_TYPE_*.
+// The buffer is a BridgeRemapStatisticsHeader followed by BridgeRemapStatistics array.
+enum {
+  BRIDGE_REMAP_STATISTICS_TYPE_NONE,
+  BRIDGE_REMAP_STATISTICS_TYPE_REMAPCLASS, // One entry per RemapClass. The array is indexed by configindex.
+  BRIDGE_REMAP_STATISTICS_TYPE_ITEM,       // One entry per item which has non-zero counters.
+};
+
+struct BridgeRemapStatisticsHeader {
+  uint32_t count; // The number of entries in this buffer.
+  uint32_t total; // The number of entries in kext. (Retry with the larger buffer if count < total.)
+};
+enum { STATIC_ASSERT__sizeof_BridgeRemapStatisticsHeader = 1 / (sizeof(struct BridgeRemapStatisticsHeader) == 8) };
+
+struct BridgeRemapStatistics {
+  uint64_t time; // The cumulative time of RemapFunc::remap in nanoseconds.
+  uint32_t configindex;
+  uint32_t itemindex; // 0 for BRIDGE_REMAP_STATISTICS_TYPE_REMAPCLASS. Items start at 1.
+  uint32_t attempts;  // The number of RemapFunc::remap calls.
+  uint32_t remaps;    // The number of events which are remapped by RemapFunc::remap.
+  uint32_t filtered;  // The number of events which are rejected by filters.
+  uint32_t reserved;
+};
+enum { STATIC_ASSERT__sizeof_BridgeRemapStatistics = 1 / (sizeof(struct BridgeRemapStatistics) == 32) };
+
+// ------------------------------------------------------------
+// Latency histogram definitions.
+// (BRIDGE_USERCLIENT_TYPE_GET_LATENCY_HISTOGRAMS)
+//
+// The latency is the time from the HID timestamp of an input event
+// to the time when an output event which is produced by the input event is sent.
+// (Output events which are produced by timers (eg. key repeat) are not recorded.)
+//
+// The buffer is BridgeLatencyHistogram[BRIDGE_LATENCY_CLASS__END__].
+enum {
+  BRIDGE_LATENCY_CLASS_KEYBOARD,
+  BRIDGE_LATENCY_CLASS_CONSUMER,
+  BRIDGE_LATENCY_CLASS_RELATIVE_POINTER,
+  BRIDGE_LATENCY_CLASS_SCROLL_WHEEL,
+  BRIDGE_LATENCY_CLASS__END__,
+};
+
+enum {
+  BRIDGE_LATENCY_HISTOGRAM_OPTION_NONE,
+  BRIDGE_LATENCY_HISTOGRAM_OPTION_RESET, // Clear histograms after they are copied.
+};
+
+// Buckets are log-linear in microseconds.
+// Each power of two range is divided into BRIDGE_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT linear buckets.
+//
+//   bucket s (s < 4):         [s, s + 1)
+//   bucket 4 * n + s (n > 0): [(4 + s) << (n - 1), (5 + s) << (n - 1))
+//
+// The last bucket holds latencies which are 2^21 microseconds or more.
+enum {
+  BRIDGE_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT = 4,
+  BRIDGE_LATENCY_HISTOGRAM_BUCKET_COUNT = 81,
+};
+
+struct BridgeLatencyHistogram {
+  uint64_t count;
+  uint64_t sum; // microseconds
+  uint64_t max; // microseconds
+  uint32_t buckets[BRIDGE_LATENCY_HISTOGRAM_BUCKET_COUNT];
+  uint32_t reserved;
+};
+enum { STATIC_ASSERT__sizeof_BridgeLatencyHistogram = 1 / (sizeof(struct BridgeLatencyHistogram) == 24 + 4 * 81 + 4) };
+
+// ------------------------------------------------------------
+// Log definitions.
+// (BRIDGE_USERCLIENT_TYPE_GET_LOG)
+//
+// IOLOG_DEBUG, IOLOG_DEBUG_POINTING and IOLOG_DEVEL record a format id and raw arguments.
+// Log readers format entries with the format table (src/bridge/output/include.bridge_log_format_table.h).
+//
+// The buffer is a BridgeLogHeader followed by BridgeLogEntry array.
+// The kext fills entries from the oldest one and removes them from the log ring.
+enum {
+  BRIDGE_LOG_LEVEL_NONE,
+  BRIDGE_LOG_LEVEL_DEBUG,
+  BRIDGE_LOG_LEVEL_DEBUG_POINTING,
+  BRIDGE_LOG_LEVEL_DEVEL,
+};
+
+enum {
+  BRIDGE_LOG_ARGUMENT_MAX = 12,
+  BRIDGE_LOG_STRINGS_SIZE = 40,
+};
+
+struct BridgeLogHeader {
+  uint32_t count; // The number of entries in this buffer.
+  uint32_t lost;  // The number of entries which were overwritten before they are read.
+};
+enum { STATIC_ASSERT__sizeof_BridgeLogHeader = 1 / (sizeof(struct BridgeLogHeader) == 8) };
+
+struct BridgeLogEntry {
+  uint64_t timestamp; // uptime in nanoseconds
+  uint32_t formatId;
+  uint32_t sequence;
+  uint8_t level;
+  uint8_t argc;
+  uint8_t reserved[6];
+  // Integer and pointer arguments are stored as is. (Signed integers are sign-extended.)
+  // String arguments are offsets in strings.
+  uint64_t arguments[BRIDGE_LOG_ARGUMENT_MAX];
+  // NUL-terminated string arguments. (They are truncated if strings is full.)
+  char strings[BRIDGE_LOG_STRINGS_SIZE];
+};
+enum { STATIC_ASSERT__sizeof_BridgeLogEntry = 1 / (sizeof(struct BridgeLogEntry) == 24 + 8 * 12 + 40) };
+
+enum {
+  BRIDGE_REMAPCLASSES_DELTA_OPERATION_NONE,
+  BRIDGE_REMAPCLASSES_DELTA_OPERATION_ADD,
+  BRIDGE_REMAPCLASSES_DELTA_OPERATION_REPLACE,
+  BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE,
+};
+
 // remapclasses_initialize_vector format:
 //
 // base:
@@ -224,3 +399,39 @@ enum { STATIC_ASSERT__sizeof_BridgeDeviceInformation = 1 / (sizeof(struct Bridge
 // Example of <remap>:
 //   { 5,BRIDGE_REMAPTYPE_KEYTOKEY,BRIDGE_DATATYPE_KEYCODE,0,BRIDGE_DATATYPE_KEYCODE,11 };
 //
+// --------------------
+//
+// remapclasses_delta format:
+//   (BRIDGE_USERCLIENT_TYPE_SET_REMAPCLASSES_DELTA)
+//
+// base:
+// { the_count_of_initialize_vector, base_count, base_checksum, new_checksum, the_count_of_operation, [<operation>] }
+//
+// <operation>
+//   { BRIDGE_REMAPCLASSES_DELTA_OPERATION_XXX, <initialize_vector> }
+//
+//   ADD:     configindex >= base_count.
+//   REPLACE: configindex < base_count.
+//   REMOVE:  configindex >= the_count_of_initialize_vector. (<initialize_vector> has no remap.)
+//
+// The delta is applied only if the loaded remapclasses match base_count and base_checksum.
+// The checksum of remapclasses is the sum of the checksums of all <initialize_vector>s.
+//
+// Example of <base>:
+//   Replace configindex 1044 and remove configindex 2321.
+//   { 2321, 2322, 0x12345678, 0x9abcdef0, 2,
+//     BRIDGE_REMAPCLASSES_DELTA_OPERATION_REPLACE,
+//     7,1044,5,BRIDGE_REMAPTYPE_KEYTOKEY,BRIDGE_DATATYPE_KEYCODE,0,BRIDGE_DATATYPE_KEYCODE,11,
+//     BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE,
+//     1,2321,
+//   }
+
+// FNV-1a hash of <initialize_vector> (configindex and the following values).
+static inline uint32_t bridge_remapclasses_initialize_vector_checksum(uint32_t configindex, const uint32_t* values, uint32_t count) {
+  uint32_t hash = 2166136261u;
+  hash = (hash ^ configindex) * 16777619u;
+  for (uint32_t i = 0; i < count; ++i) {
+    hash = (hash ^ values[i]) * 16777619u;
+  }
+  return hash;
+}
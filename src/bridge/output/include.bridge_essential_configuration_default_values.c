@@ -0,0 +1,68 @@
+500,
+83,
+10,
+10,
+1,
+0,
+0,
+1,
+16,
+8,
+30,
+40,
+300,
+0,
+1000,
+500,
+50,
+50,
+500,
+200,
+200,
+150,
+500,
+200,
+1,
+20,
+50,
+20,
+20,
+1,
+20,
+50,
+20,
+20,
+0,
+200,
+50,
+300,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
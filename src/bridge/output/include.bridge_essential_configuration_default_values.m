@@ -0,0 +1,68 @@
+@"repeat.initial_wait": @(500),
+@"repeat.wait": @(83),
+@"parameter.wait_before_and_after_a_modifier_key_event": @(10),
+@"parameter.wait_before_and_after_a_click_event": @(10),
+@"parameter.wait_between_key_events": @(1),
+@"parameter.wait_between_key_events_device_vendor_id": @(0),
+@"parameter.wait_between_key_events_device_product_id": @(0),
+@"parameter.wait_between_key_events_device_wait": @(1),
+@"parameter.coalesce_relative_pointer_max_events": @(16),
+@"parameter.coalesce_relative_pointer_max_interval": @(8),
+@"parameter.ignore_bouncing_threshold_for_keyboard": @(30),
+@"parameter.ignore_bouncing_threshold_for_mice": @(40),
+@"parameter.keytokey_delayed_action_timeout": @(300),
+@"parameter.keyoverlaidmodifier_initial_modifier_wait": @(0),
+@"parameter.keyoverlaidmodifier_timeout": @(1000),
+@"repeat.keyoverlaidmodifier_initial_wait": @(500),
+@"parameter.simultaneouskeypresses_delay": @(50),
+@"parameter.simultaneouskeypresses_pointingbutton_delay": @(50),
+@"parameter.doublepressmodifier_threshold": @(500),
+@"parameter.holdingkeytokey_wait": @(200),
+@"parameter.blockuntilkeyup_timeout": @(200),
+@"pointing.relative2scroll_rate": @(150),
+@"parameter.scrollwheeltokey_keyrepeat_wait": @(500),
+@"parameter.pointingrelativetokey_detection_interval": @(200),
+@"parameter.acceleration_of_pointer": @(1),
+@"parameter.maximum_speed_of_pointer": @(20),
+@"parameter.mousekey_high_speed_of_pointer": @(50),
+@"parameter.mousekey_initial_wait_of_pointer": @(20),
+@"parameter.mousekey_repeat_wait_of_pointer": @(20),
+@"parameter.acceleration_of_scroll": @(1),
+@"parameter.maximum_speed_of_scroll": @(20),
+@"parameter.mousekey_high_speed_of_scroll": @(50),
+@"parameter.mousekey_initial_wait_of_scroll": @(20),
+@"parameter.mousekey_repeat_wait_of_scroll": @(20),
+@"parameter.mousekey_acceleration_curve": @(0),
+@"parameter.mousekey_exponential_doubling_time": @(200),
+@"parameter.fixed_distance_magnification": @(50),
+@"parameter.fixed_distance_scroll_magnification": @(300),
+@"notsave.automatically_enable_keyboard_device": @(0),
+@"notsave.automatically_enable_pointing_device": @(0),
+@"general.dont_remap_internal": @(0),
+@"general.dont_remap_external": @(0),
+@"general.dont_remap_any_pointing": @(0),
+@"general.dont_remap_apple_keyboard": @(0),
+@"general.dont_remap_apple_pointing": @(0),
+@"general.dont_remap_non_apple_keyboard": @(0),
+@"general.dont_remap_non_apple_pointing": @(0),
+@"general.dont_remap_thirdvendor_keyboard": @(0),
+@"general.dont_remap_thirdvendor_pointing": @(0),
+@"general.disable_internal_keyboard_if_external_keyboard_exsits": @(0),
+@"general.treat_unifying_as_pointing_device": @(0),
+@"general.treat_bluetooth_usb_host_controller_broadcom_as_pointing_device": @(0),
+@"general.ignore_invalid_devices_from_external_keyboard": @(0),
+@"parameter.mouse_key_scroll_not_natural_direction": @(0),
+@"option.pointing_enable_scrollwheel_fixation": @(0),
+@"option.pointing_disable_momentum_scroll": @(0),
+@"option.pointing_reverse_vertical_scrolling": @(0),
+@"option.pointing_reverse_horizontal_scrolling": @(0),
+@"option.pointing_disable_vertical_scroll": @(0),
+@"option.pointing_disable_horizontal_scroll": @(0),
+@"general.ignore_bouncing_events": @(0),
+@"general.allow_devices_vendor_id_product_id_are_zero": @(0),
+@"general.allow_devices_multiple_same_key": @(0),
+@"general.keep_notsave_at_wake": @(0),
+@"general.passthrough_capslock_led_status": @(0),
+@"general.lazy_modifiers_with_mouse_event": @(0),
+@"general.dont_wait_between_key_events_for_internal_keyboard": @(0),
+@"general.enable_event_trace": @(0),
@@ -0,0 +1,71 @@
+enum {
+BRIDGE_ESSENTIAL_CONFIG_INDEX_repeat_initial_wait = 0,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_repeat_wait = 1,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_before_and_after_a_modifier_key_event = 2,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_before_and_after_a_click_event = 3,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events = 4,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_vendor_id = 5,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_product_id = 6,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_wait = 7,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_coalesce_relative_pointer_max_events = 8,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_coalesce_relative_pointer_max_interval = 9,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_ignore_bouncing_threshold_for_keyboard = 10,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_ignore_bouncing_threshold_for_mice = 11,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_keytokey_delayed_action_timeout = 12,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_keyoverlaidmodifier_initial_modifier_wait = 13,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_keyoverlaidmodifier_timeout = 14,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_repeat_keyoverlaidmodifier_initial_wait = 15,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_simultaneouskeypresses_delay = 16,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_simultaneouskeypresses_pointingbutton_delay = 17,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_doublepressmodifier_threshold = 18,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_holdingkeytokey_wait = 19,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_blockuntilkeyup_timeout = 20,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_pointing_relative2scroll_rate = 21,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_scrollwheeltokey_keyrepeat_wait = 22,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_pointingrelativetokey_detection_interval = 23,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_pointer = 24,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_pointer = 25,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_high_speed_of_pointer = 26,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_initial_wait_of_pointer = 27,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_repeat_wait_of_pointer = 28,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_scroll = 29,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_scroll = 30,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_high_speed_of_scroll = 31,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_initial_wait_of_scroll = 32,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_repeat_wait_of_scroll = 33,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_acceleration_curve = 34,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_exponential_doubling_time = 35,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_fixed_distance_magnification = 36,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_fixed_distance_scroll_magnification = 37,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_notsave_automatically_enable_keyboard_device = 38,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_notsave_automatically_enable_pointing_device = 39,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_internal = 40,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_external = 41,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_any_pointing = 42,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_apple_keyboard = 43,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_apple_pointing = 44,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_non_apple_keyboard = 45,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_non_apple_pointing = 46,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_thirdvendor_keyboard = 47,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_remap_thirdvendor_pointing = 48,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_disable_internal_keyboard_if_external_keyboard_exsits = 49,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_treat_unifying_as_pointing_device = 50,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_treat_bluetooth_usb_host_controller_broadcom_as_pointing_device = 51,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_ignore_invalid_devices_from_external_keyboard = 52,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mouse_key_scroll_not_natural_direction = 53,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_enable_scrollwheel_fixation = 54,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_disable_momentum_scroll = 55,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_reverse_vertical_scrolling = 56,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_reverse_horizontal_scrolling = 57,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_disable_vertical_scroll = 58,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_disable_horizontal_scroll = 59,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_ignore_bouncing_events = 60,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_allow_devices_vendor_id_product_id_are_zero = 61,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_allow_devices_multiple_same_key = 62,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_keep_notsave_at_wake = 63,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_passthrough_capslock_led_status = 64,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_lazy_modifiers_with_mouse_event = 65,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_wait_between_key_events_for_internal_keyboard = 66,
+BRIDGE_ESSENTIAL_CONFIG_INDEX_general_enable_event_trace = 67,
+BRIDGE_ESSENTIAL_CONFIG_INDEX__END__ = 68
+};
@@ -0,0 +1,68 @@
+@"repeat.initial_wait",
+@"repeat.wait",
+@"parameter.wait_before_and_after_a_modifier_key_event",
+@"parameter.wait_before_and_after_a_click_event",
+@"parameter.wait_between_key_events",
+@"parameter.wait_between_key_events_device_vendor_id",
+@"parameter.wait_between_key_events_device_product_id",
+@"parameter.wait_between_key_events_device_wait",
+@"parameter.coalesce_relative_pointer_max_events",
+@"parameter.coalesce_relative_pointer_max_interval",
+@"parameter.ignore_bouncing_threshold_for_keyboard",
+@"parameter.ignore_bouncing_threshold_for_mice",
+@"parameter.keytokey_delayed_action_timeout",
+@"parameter.keyoverlaidmodifier_initial_modifier_wait",
+@"parameter.keyoverlaidmodifier_timeout",
+@"repeat.keyoverlaidmodifier_initial_wait",
+@"parameter.simultaneouskeypresses_delay",
+@"parameter.simultaneouskeypresses_pointingbutton_delay",
+@"parameter.doublepressmodifier_threshold",
+@"parameter.holdingkeytokey_wait",
+@"parameter.blockuntilkeyup_timeout",
+@"pointing.relative2scroll_rate",
+@"parameter.scrollwheeltokey_keyrepeat_wait",
+@"parameter.pointingrelativetokey_detection_interval",
+@"parameter.acceleration_of_pointer",
+@"parameter.maximum_speed_of_pointer",
+@"parameter.mousekey_high_speed_of_pointer",
+@"parameter.mousekey_initial_wait_of_pointer",
+@"parameter.mousekey_repeat_wait_of_pointer",
+@"parameter.acceleration_of_scroll",
+@"parameter.maximum_speed_of_scroll",
+@"parameter.mousekey_high_speed_of_scroll",
+@"parameter.mousekey_initial_wait_of_scroll",
+@"parameter.mousekey_repeat_wait_of_scroll",
+@"parameter.mousekey_acceleration_curve",
+@"parameter.mousekey_exponential_doubling_time",
+@"parameter.fixed_distance_magnification",
+@"parameter.fixed_distance_scroll_magnification",
+@"notsave.automatically_enable_keyboard_device",
+@"notsave.automatically_enable_pointing_device",
+@"general.dont_remap_internal",
+@"general.dont_remap_external",
+@"general.dont_remap_any_pointing",
+@"general.dont_remap_apple_keyboard",
+@"general.dont_remap_apple_pointing",
+@"general.dont_remap_non_apple_keyboard",
+@"general.dont_remap_non_apple_pointing",
+@"general.dont_remap_thirdvendor_keyboard",
+@"general.dont_remap_thirdvendor_pointing",
+@"general.disable_internal_keyboard_if_external_keyboard_exsits",
+@"general.treat_unifying_as_pointing_device",
+@"general.treat_bluetooth_usb_host_controller_broadcom_as_pointing_device",
+@"general.ignore_invalid_devices_from_external_keyboard",
+@"parameter.mouse_key_scroll_not_natural_direction",
+@"option.pointing_enable_scrollwheel_fixation",
+@"option.pointing_disable_momentum_scroll",
+@"option.pointing_reverse_vertical_scrolling",
+@"option.pointing_reverse_horizontal_scrolling",
+@"option.pointing_disable_vertical_scroll",
+@"option.pointing_disable_horizontal_scroll",
+@"general.ignore_bouncing_events",
+@"general.allow_devices_vendor_id_product_id_are_zero",
+@"general.allow_devices_multiple_same_key",
+@"general.keep_notsave_at_wake",
+@"general.passthrough_capslock_led_status",
+@"general.lazy_modifiers_with_mouse_event",
+@"general.dont_wait_between_key_events_for_internal_keyboard",
+@"general.enable_event_trace",
@@ -0,0 +1,44 @@
+{ 0x08e329f1, "KeyboardEventCallback [%7s]: eventType %2d, flags 0x%08x, key 0x%04x, kbdType %3d, repeat = %d\n" },
+{ 0x10370b36, "FlagStatus %s: %d\n" },
+{ 0x1314f81a, "ListHookedDevice::totalPressingPhysicalKeysCountAll: %ld\n" },
+{ 0x1570853b, "ListHookedPointing::Item::replaceEventAction (RelativePointerEventCallback) device_:%p callback is null.\n" },
+{ 0x16649b64, "PressDownKeys::remove key:%d, keyboardType:%d\n" },
+{ 0x1ac019d9, "PressDownKeys::add key:%d, keyboardType:%d\n" },
+{ 0x2e92f65d, "KeyboardRepeat::set key:%d flags:0x%x\n" },
+{ 0x31797a48, "ListHookedConsumer::Item::~Item()\n" },
+{ 0x35dc130e, "An unknown modifier is pressed (KeyCode:0x%x, Flags:0x%x). Ignore it.\n" },
+{ 0x3744e812, "ListHookedPointing::Item::replaceEventAction (ScrollWheelEventCallback) device_:%p (%p -> %p)\n" },
+{ 0x3870cd23, "UpdateEventFlagsCallback [%7s]: flags 0x%08x\n" },
+{ 0x45ed894c, "LastSentEvent: %s:0x%04x, %s\n" },
+{ 0x4642a0a8, "HookedDevice::setDeviceType device_:%p, name:%s, deviceType_:%d\n" },
+{ 0x4dfb4f17, "HookedKeyboard::restoreEventAction (KeyboardEventCallback) device_:%p (%p -> %p)\n" },
+{ 0x5074767b, "HookedPointing::restoreEventAction (ScrollWheelEventCallback) device_:%p (%p -> %p)\n" },
+{ 0x51bcc4d8, "HookedPointing::restoreEventAction (RelativePointerEventCallback) device_:%p (%p -> %p)\n" },
+{ 0x5e42b4bd, "PressDownKeys::clear list_.size = %d\n" },
+{ 0x6c341702, "HookedKeyboard::restoreEventAction (UpdateEventFlagsCallback) device_:%p (%p -> %p)\n" },
+{ 0x6c4cf49c, "EventWatcher::on (list_.size:%d)\n" },
+{ 0x70277f84, "HookedKeyboard::replaceEventAction (UpdateEventFlagsCallback) device_:%p callback is null.\n" },
+{ 0x709e71fd, "ListHookedDevice::erase list_.size = %d\n" },
+{ 0x720f67f7, "Restarting refreshInProgressDevices_timer because some devices are in progress.\n" },
+{ 0x7c843491, "ListHookedKeyboard::Item::~Item()\n" },
+{ 0x807d024e, "ListHookedPointing::Item::replaceEventAction (ScrollWheelEventCallback) device_:%p callback is null.\n" },
+{ 0x85ee8e0d, "EventInputQueue::fire queue_.size = %d\n" },
+{ 0x88e7500d, "HookedConsumer::restoreEventAction device_:%p (%p -> %p)\n" },
+{ 0x893ce584, "KeyboardSpecialEventCallBack [%7s]: eventType %2d, flags 0x%08x, key 0x%04x, flavor %4d, guid %lld, repeat = %d\n" },
+{ 0x8997d102, "KeyboardRepeat::fire queue_.size = %d\n" },
+{ 0x91321c0d, "ListHookedDevice::push_back list_.size = %d\n" },
+{ 0x9229dbf7, "HookedKeyboard::replaceEventAction (KeyboardEventCallback) device_:%p callback is null.\n" },
+{ 0xaae97345, "HookedConsumer::replaceEventAction device_:%p callback is null.\n" },
+{ 0xafd55fc1, "HookedKeyboard::replaceEventAction (KeyboardEventCallback) device_:%p (%p -> %p)\n" },
+{ 0xbc71fac3, "HookedConsumer::replaceEventAction device_:%p (%p -> %p)\n" },
+{ 0xc488c2ef, "ScrollWheelEventCallback [%7s]: deltaAxis(%d,%d,%d), fixedDelta(%d,%d,%d), pointDelta(%d,%d,%d), options: %d\n" },
+{ 0xc679d1dd, "refreshInProgressDevices_timer_callback\n" },
+{ 0xcb0af23a, "EventInputQueue::resetInternalStateIfNeeded reset internal state.\n" },
+{ 0xcdd05cbe, "HookedDevice::setVendorProductLocation device_:%p, vendor:0x%04x, product:0x%04x location:0x%04x\n" },
+{ 0xce30356f, "KeyboardRepeat::set consumer key:%d flags:0x%x\n" },
+{ 0xd4211021, "RelativePointerEventCallBack [%7s]: buttons: 0x%08x, dx: %3d, dy: %3d\n" },
+{ 0xd9936754, "HookedKeyboard::replaceEventAction (UpdateEventFlagsCallback) device_:%p (%p -> %p)\n" },
+{ 0xe9c0c431, "%s newService:%p\n" },
+{ 0xebbec775, "ListHookedPointing::Item::replaceEventAction (RelativePointerEventCallback) device_:%p (%p -> %p)\n" },
+{ 0xf28dda67, "PressDownKeys::clear key:%d, keyboardType:%d\n" },
+{ 0xf8583ba2, "ListHookedPointing::Item::~Item()\n" },
@@ -0,0 +1 @@
+0x10f22f00
@@ -0,0 +1,3 @@
+// Please define other ApplicationType by appdef.xml.
+static const ApplicationType UNKNOWN;
+static const ApplicationType VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,26 @@
+static const ConsumerKeyCode BRIGHTNESS_DOWN;
+static const ConsumerKeyCode BRIGHTNESS_UP;
+static const ConsumerKeyCode KEYBOARDLIGHT_OFF;
+static const ConsumerKeyCode KEYBOARDLIGHT_LOW;
+static const ConsumerKeyCode KEYBOARDLIGHT_HIGH;
+static const ConsumerKeyCode MUSIC_PREV;
+static const ConsumerKeyCode MUSIC_PLAY;
+static const ConsumerKeyCode MUSIC_NEXT;
+// Kinesis Freestyle USB keyboard sends 18,17 at music prev,music next.
+static const ConsumerKeyCode MUSIC_PREV_18;
+static const ConsumerKeyCode MUSIC_PREV_0x12;
+static const ConsumerKeyCode MUSIC_NEXT_17;
+static const ConsumerKeyCode MUSIC_NEXT_0x11;
+static const ConsumerKeyCode VOLUME_MUTE;
+static const ConsumerKeyCode VOLUME_DOWN;
+static const ConsumerKeyCode VOLUME_UP;
+static const ConsumerKeyCode EJECT;
+static const ConsumerKeyCode POWER;
+static const ConsumerKeyCode NUMLOCK;
+static const ConsumerKeyCode VIDEO_MIRROR;
+// Virtual KeyCode
+static const ConsumerKeyCode VK__BEGIN__;
+// For KeyToConsumer
+static const ConsumerKeyCode VK_PSEUDO_KEY;
+static const ConsumerKeyCode VK_NONE;
+static const ConsumerKeyCode VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,19 @@
+// These items are needed in kernel extension.
+// Please define DeviceProduct by deviceproductdef.xml if it is not needed in kext.
+// Apple
+static const DeviceProduct APPLE_INTERNAL_KEYBOARD_TRACKPAD_0x0218;
+// Logitech
+static const DeviceProduct LOGITECH_CORDLESS_PRESENTER;
+static const DeviceProduct LOGITECH_USB_HEADSET;
+static const DeviceProduct Logitech_Bluetooth_Mouse_M555b;
+// Razer
+static const DeviceProduct Razer_DeathAdder_Chroma;
+// Mionix
+static const DeviceProduct Mionix_Naos_7000;
+// Microsoft
+static const DeviceProduct Microsoft_Sculpt_Touch_Mouse;
+static const DeviceProduct Microsoft_Designer_Bluetooth_Mouse;
+//
+static const DeviceProduct PSEUDO;
+static const DeviceProduct ANY;
+static const DeviceProduct VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,12 @@
+// These items are needed in kernel extension.
+// Please define DeviceVendor by devicevendordef.xml if it is not needed in kext.
+// Note: We use "APPLE_COMPUTER" instead of "APPLE".
+// Because "APPLE" will be replaced by preprocessor, and it causes a compile-error.
+static const DeviceVendor APPLE_COMPUTER;
+static const DeviceVendor Apple_Bluetooth;
+static const DeviceVendor PSEUDO;
+static const DeviceVendor LOGITECH;
+static const DeviceVendor Razer;
+static const DeviceVendor Mionix;
+static const DeviceVendor MICROSOFT;
+static const DeviceVendor VK__AUTOINDEX__BEGIN__;
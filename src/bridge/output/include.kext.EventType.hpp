@@ -0,0 +1,5 @@
+static const EventType NONE;
+static const EventType DOWN;
+static const EventType UP;
+static const EventType MODIFY;
+static const EventType VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,7 @@
+// These items are needed in kernel extension.
+// Please define others by inputsource.xml.
+static const InputSource NONE;
+static const InputSource ENGLISH;
+static const InputSource AINU;
+static const InputSource JAPANESE;
+static const InputSource VK__AUTOINDEX__BEGIN__;
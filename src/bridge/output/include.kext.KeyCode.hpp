@@ -0,0 +1,409 @@
+// ----------------------------------------
+// alphabet
+static const KeyCode A;
+static const KeyCode B;
+static const KeyCode C;
+static const KeyCode D;
+static const KeyCode E;
+static const KeyCode F;
+static const KeyCode G;
+static const KeyCode H;
+static const KeyCode I;
+static const KeyCode J;
+static const KeyCode K;
+static const KeyCode L;
+static const KeyCode M;
+static const KeyCode N;
+static const KeyCode O;
+static const KeyCode P;
+static const KeyCode Q;
+static const KeyCode R;
+static const KeyCode S;
+static const KeyCode T;
+static const KeyCode U;
+static const KeyCode V;
+static const KeyCode W;
+static const KeyCode X;
+static const KeyCode Y;
+static const KeyCode Z;
+// ----------------------------------------
+// number
+// for backward compatibility
+static const KeyCode KEY_0;
+static const KeyCode KEY_1;
+static const KeyCode KEY_2;
+static const KeyCode KEY_3;
+static const KeyCode KEY_4;
+static const KeyCode KEY_5;
+static const KeyCode KEY_6;
+static const KeyCode KEY_7;
+static const KeyCode KEY_8;
+static const KeyCode KEY_9;
+// ----------------------------------------
+// symbol
+// BACKQUOTE is also known as grave accent or backtick.
+static const KeyCode BACKQUOTE;
+static const KeyCode BACKSLASH;
+static const KeyCode BRACKET_LEFT;
+static const KeyCode BRACKET_RIGHT;
+static const KeyCode COMMA;
+static const KeyCode DOT;
+static const KeyCode EQUAL;
+static const KeyCode MINUS;
+static const KeyCode QUOTE;
+static const KeyCode SEMICOLON;
+static const KeyCode SLASH;
+// ----------------------------------------
+// keypad
+static const KeyCode KEYPAD_0;
+static const KeyCode KEYPAD_1;
+static const KeyCode KEYPAD_2;
+static const KeyCode KEYPAD_3;
+static const KeyCode KEYPAD_4;
+static const KeyCode KEYPAD_5;
+static const KeyCode KEYPAD_6;
+static const KeyCode KEYPAD_7;
+static const KeyCode KEYPAD_8;
+static const KeyCode KEYPAD_9;
+static const KeyCode KEYPAD_CLEAR;
+static const KeyCode KEYPAD_COMMA;
+static const KeyCode KEYPAD_DOT;
+static const KeyCode KEYPAD_EQUAL;
+static const KeyCode KEYPAD_MINUS;
+static const KeyCode KEYPAD_MULTIPLY;
+static const KeyCode KEYPAD_PLUS;
+static const KeyCode KEYPAD_SLASH;
+// ----------------------------------------
+// special
+static const KeyCode DELETE;
+static const KeyCode ENTER;
+static const KeyCode ENTER_POWERBOOK;
+static const KeyCode ESCAPE;
+static const KeyCode FORWARD_DELETE;
+static const KeyCode HELP;
+static const KeyCode RETURN;
+static const KeyCode SPACE;
+static const KeyCode TAB;
+// ----------------------------------------
+// function
+static const KeyCode F1;
+static const KeyCode F2;
+static const KeyCode F3;
+static const KeyCode F4;
+static const KeyCode F5;
+static const KeyCode F6;
+static const KeyCode F7;
+static const KeyCode F8;
+static const KeyCode F9;
+static const KeyCode F10;
+static const KeyCode F11;
+static const KeyCode F12;
+static const KeyCode F13;
+static const KeyCode F14;
+static const KeyCode F15;
+static const KeyCode F16;
+static const KeyCode F17;
+static const KeyCode F18;
+static const KeyCode F19;
+// ----------------------------------------
+// functional
+static const KeyCode BRIGHTNESS_DOWN;
+static const KeyCode BRIGHTNESS_UP;
+static const KeyCode DASHBOARD;
+static const KeyCode EXPOSE_ALL;
+static const KeyCode LAUNCHPAD;
+static const KeyCode MISSION_CONTROL;
+// ----------------------------------------
+// cursor
+static const KeyCode CURSOR_UP;
+static const KeyCode CURSOR_DOWN;
+static const KeyCode CURSOR_LEFT;
+static const KeyCode CURSOR_RIGHT;
+static const KeyCode PAGEUP;
+static const KeyCode PAGEDOWN;
+static const KeyCode HOME;
+static const KeyCode END;
+// ----------------------------------------
+// modifiers
+static const KeyCode CAPSLOCK;
+static const KeyCode COMMAND_L;
+static const KeyCode COMMAND_R;
+static const KeyCode CONTROL_L;
+static const KeyCode CONTROL_R;
+static const KeyCode FN;
+static const KeyCode OPTION_L;
+static const KeyCode OPTION_R;
+static const KeyCode SHIFT_L;
+static const KeyCode SHIFT_R;
+// ----------------------------------------
+// pc keyboard
+static const KeyCode PC_APPLICATION;
+static const KeyCode PC_BS;
+static const KeyCode PC_DEL;
+static const KeyCode PC_INSERT;
+static const KeyCode PC_KEYPAD_NUMLOCK;
+static const KeyCode PC_PAUSE;
+static const KeyCode PC_POWER;
+static const KeyCode PC_PRINTSCREEN;
+static const KeyCode PC_SCROLLLOCK;
+// ----------------------------------------
+// international
+static const KeyCode DANISH_DOLLAR;
+static const KeyCode DANISH_LESS_THAN;
+static const KeyCode FRENCH_DOLLAR;
+static const KeyCode FRENCH_EQUAL;
+static const KeyCode FRENCH_HAT;
+static const KeyCode FRENCH_MINUS;
+static const KeyCode FRENCH_RIGHT_PAREN;
+static const KeyCode GERMAN_CIRCUMFLEX;
+static const KeyCode GERMAN_LESS_THAN;
+static const KeyCode GERMAN_PC_LESS_THAN;
+static const KeyCode GERMAN_QUOTE;
+static const KeyCode GERMAN_A_UMLAUT;
+static const KeyCode GERMAN_O_UMLAUT;
+static const KeyCode GERMAN_U_UMLAUT;
+static const KeyCode ITALIAN_BACKSLASH;
+static const KeyCode ITALIAN_LESS_THAN;
+static const KeyCode JIS_ATMARK;
+static const KeyCode JIS_BRACKET_LEFT;
+static const KeyCode JIS_BRACKET_RIGHT;
+static const KeyCode JIS_COLON;
+static const KeyCode JIS_DAKUON;
+static const KeyCode JIS_EISUU;
+static const KeyCode JIS_HANDAKUON;
+static const KeyCode JIS_HAT;
+static const KeyCode JIS_KANA;
+static const KeyCode JIS_PC_HAN_ZEN;
+static const KeyCode JIS_UNDERSCORE;
+static const KeyCode JIS_YEN;
+static const KeyCode RUSSIAN_PARAGRAPH;
+static const KeyCode RUSSIAN_TILDE;
+static const KeyCode SPANISH_LESS_THAN;
+static const KeyCode SPANISH_ORDINAL_INDICATOR;
+static const KeyCode SWEDISH_LESS_THAN;
+static const KeyCode SWEDISH_SECTION;
+static const KeyCode SWISS_LESS_THAN;
+static const KeyCode SWISS_SECTION;
+static const KeyCode UK_SECTION;
+// ----------------------------------------
+// Reserved for user: 0x10000 - 0xFFFFFFF
+//
+// User can define own key code in private.xml:
+// <symbol_map type="KeyCode" name="PRIVATE_SIMULTANEOUS_WE" value="0x10001" />
+// <symbol_map type="KeyCode" name="PRIVATE_SIMULTANEOUS_ER" value="0x10002" />
+//
+// ----------------------------------------
+// Virtual KeyCode
+static const KeyCode VK__BEGIN__;
+static const KeyCode VK_NONE;
+// For ConsumerToKey, PointingButtonToKey
+static const KeyCode VK_PSEUDO_KEY;
+//
+static const KeyCode VK_WAIT_10MS;
+static const KeyCode VK_WAIT_50MS;
+static const KeyCode VK_WAIT_100MS;
+//
+static const KeyCode VK_LOCK_CAPSLOCK;
+static const KeyCode VK_LOCK_COMMAND_L;
+static const KeyCode VK_LOCK_COMMAND_R;
+static const KeyCode VK_LOCK_CONTROL_L;
+static const KeyCode VK_LOCK_CONTROL_R;
+static const KeyCode VK_LOCK_FN;
+static const KeyCode VK_LOCK_OPTION_L;
+static const KeyCode VK_LOCK_OPTION_R;
+static const KeyCode VK_LOCK_SHIFT_L;
+static const KeyCode VK_LOCK_SHIFT_R;
+static const KeyCode VK_LOCK_CAPSLOCK_FORCE_ON;
+static const KeyCode VK_LOCK_COMMAND_L_FORCE_ON;
+static const KeyCode VK_LOCK_COMMAND_R_FORCE_ON;
+static const KeyCode VK_LOCK_CONTROL_L_FORCE_ON;
+static const KeyCode VK_LOCK_CONTROL_R_FORCE_ON;
+static const KeyCode VK_LOCK_FN_FORCE_ON;
+static const KeyCode VK_LOCK_OPTION_L_FORCE_ON;
+static const KeyCode VK_LOCK_OPTION_R_FORCE_ON;
+static const KeyCode VK_LOCK_SHIFT_L_FORCE_ON;
+static const KeyCode VK_LOCK_SHIFT_R_FORCE_ON;
+static const KeyCode VK_LOCK_CAPSLOCK_FORCE_OFF;
+static const KeyCode VK_LOCK_COMMAND_L_FORCE_OFF;
+static const KeyCode VK_LOCK_COMMAND_R_FORCE_OFF;
+static const KeyCode VK_LOCK_CONTROL_L_FORCE_OFF;
+static const KeyCode VK_LOCK_CONTROL_R_FORCE_OFF;
+static const KeyCode VK_LOCK_FN_FORCE_OFF;
+static const KeyCode VK_LOCK_OPTION_L_FORCE_OFF;
+static const KeyCode VK_LOCK_OPTION_R_FORCE_OFF;
+static const KeyCode VK_LOCK_SHIFT_L_FORCE_OFF;
+static const KeyCode VK_LOCK_SHIFT_R_FORCE_OFF;
+static const KeyCode VK_LOCK_ALL_FORCE_OFF;
+//
+static const KeyCode VK_NEGATIVE_LOCK_CAPSLOCK;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_L;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_R;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_L;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_R;
+static const KeyCode VK_NEGATIVE_LOCK_FN;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_L;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_R;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_L;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_R;
+static const KeyCode VK_NEGATIVE_LOCK_CAPSLOCK_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_L_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_R_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_L_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_R_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_FN_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_L_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_R_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_L_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_R_FORCE_ON;
+static const KeyCode VK_NEGATIVE_LOCK_CAPSLOCK_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_L_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_COMMAND_R_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_L_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_CONTROL_R_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_FN_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_L_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_OPTION_R_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_L_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_SHIFT_R_FORCE_OFF;
+static const KeyCode VK_NEGATIVE_LOCK_ALL_FORCE_OFF;
+//
+static const KeyCode VK_STICKY_CAPSLOCK;
+static const KeyCode VK_STICKY_COMMAND_L;
+static const KeyCode VK_STICKY_COMMAND_R;
+static const KeyCode VK_STICKY_CONTROL_L;
+static const KeyCode VK_STICKY_CONTROL_R;
+static const KeyCode VK_STICKY_FN;
+static const KeyCode VK_STICKY_OPTION_L;
+static const KeyCode VK_STICKY_OPTION_R;
+static const KeyCode VK_STICKY_SHIFT_L;
+static const KeyCode VK_STICKY_SHIFT_R;
+static const KeyCode VK_STICKY_CAPSLOCK_FORCE_ON;
+static const KeyCode VK_STICKY_COMMAND_L_FORCE_ON;
+static const KeyCode VK_STICKY_COMMAND_R_FORCE_ON;
+static const KeyCode VK_STICKY_CONTROL_L_FORCE_ON;
+static const KeyCode VK_STICKY_CONTROL_R_FORCE_ON;
+static const KeyCode VK_STICKY_FN_FORCE_ON;
+static const KeyCode VK_STICKY_OPTION_L_FORCE_ON;
+static const KeyCode VK_STICKY_OPTION_R_FORCE_ON;
+static const KeyCode VK_STICKY_SHIFT_L_FORCE_ON;
+static const KeyCode VK_STICKY_SHIFT_R_FORCE_ON;
+static const KeyCode VK_STICKY_CAPSLOCK_FORCE_OFF;
+static const KeyCode VK_STICKY_COMMAND_L_FORCE_OFF;
+static const KeyCode VK_STICKY_COMMAND_R_FORCE_OFF;
+static const KeyCode VK_STICKY_CONTROL_L_FORCE_OFF;
+static const KeyCode VK_STICKY_CONTROL_R_FORCE_OFF;
+static const KeyCode VK_STICKY_FN_FORCE_OFF;
+static const KeyCode VK_STICKY_OPTION_L_FORCE_OFF;
+static const KeyCode VK_STICKY_OPTION_R_FORCE_OFF;
+static const KeyCode VK_STICKY_SHIFT_L_FORCE_OFF;
+static const KeyCode VK_STICKY_SHIFT_R_FORCE_OFF;
+// Manipulate sticky modifiers state of active modifiers.
+static const KeyCode VK_STICKY_ACTIVE_MODIFIERS_TOGGLE;
+static const KeyCode VK_STICKY_ACTIVE_MODIFIERS_FORCE_ON;
+static const KeyCode VK_STICKY_ACTIVE_MODIFIERS_FORCE_OFF;
+// Disable sticky modifiers.
+static const KeyCode VK_STICKY_ALL_FORCE_OFF;
+//
+static const KeyCode VK_LAZY_COMMAND_L;
+static const KeyCode VK_LAZY_COMMAND_R;
+static const KeyCode VK_LAZY_CONTROL_L;
+static const KeyCode VK_LAZY_CONTROL_R;
+static const KeyCode VK_LAZY_FN;
+static const KeyCode VK_LAZY_OPTION_L;
+static const KeyCode VK_LAZY_OPTION_R;
+static const KeyCode VK_LAZY_SHIFT_L;
+static const KeyCode VK_LAZY_SHIFT_R;
+//
+static const KeyCode VK_PARTIAL_KEYDOWN;
+static const KeyCode VK_PARTIAL_KEYUP;
+//
+static const KeyCode VK_CONSUMERKEY_BRIGHTNESS_DOWN;
+static const KeyCode VK_CONSUMERKEY_BRIGHTNESS_UP;
+static const KeyCode VK_CONSUMERKEY_KEYBOARDLIGHT_LOW;
+static const KeyCode VK_CONSUMERKEY_KEYBOARDLIGHT_HIGH;
+static const KeyCode VK_CONSUMERKEY_MUSIC_PREV;
+static const KeyCode VK_CONSUMERKEY_MUSIC_PLAY;
+static const KeyCode VK_CONSUMERKEY_MUSIC_NEXT;
+static const KeyCode VK_CONSUMERKEY_VOLUME_MUTE;
+static const KeyCode VK_CONSUMERKEY_VOLUME_DOWN;
+static const KeyCode VK_CONSUMERKEY_VOLUME_UP;
+static const KeyCode VK_CONSUMERKEY_EJECT;
+static const KeyCode VK_CONSUMERKEY_POWER;
+//
+static const KeyCode VK_MOUSEKEY_UP;
+static const KeyCode VK_MOUSEKEY_DOWN;
+static const KeyCode VK_MOUSEKEY_LEFT;
+static const KeyCode VK_MOUSEKEY_RIGHT;
+static const KeyCode VK_MOUSEKEY_DIAGONAL_NE;
+static const KeyCode VK_MOUSEKEY_DIAGONAL_NW;
+static const KeyCode VK_MOUSEKEY_DIAGONAL_SE;
+static const KeyCode VK_MOUSEKEY_DIAGONAL_SW;
+static const KeyCode VK_MOUSEKEY_SCROLL_UP;
+static const KeyCode VK_MOUSEKEY_SCROLL_DOWN;
+static const KeyCode VK_MOUSEKEY_SCROLL_LEFT;
+static const KeyCode VK_MOUSEKEY_SCROLL_RIGHT;
+static const KeyCode VK_MOUSEKEY_HIGHSPEED;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_UP;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_DOWN;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_LEFT;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_RIGHT;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_UP;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_DOWN;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_LEFT;
+static const KeyCode VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_RIGHT;
+static const KeyCode VK_MOUSEKEY_BUTTON_LEFT;
+static const KeyCode VK_MOUSEKEY_BUTTON_MIDDLE;
+static const KeyCode VK_MOUSEKEY_BUTTON_RIGHT;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON4;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON5;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON6;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON7;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON8;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON9;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON10;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON11;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON12;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON13;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON14;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON15;
+static const KeyCode VK_MOUSEKEY_BUTTON_BUTTON16;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_LEFT;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_MIDDLE;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_RIGHT;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON4;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON5;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON6;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON7;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON8;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON9;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON10;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON11;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON12;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON13;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON14;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON15;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_BUTTON16;
+static const KeyCode VK_MOUSEKEY_LOCK_BUTTON_ALL_FORCE_OFF;
+//
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_SOUND_UP;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_SOUND_DOWN;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_BRIGHTNESS_UP;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_BRIGHTNESS_DOWN;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_MUTE;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_PLAY;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_NEXT;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_PREVIOUS;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_UP;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_DOWN;
+static const KeyCode VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_TOGGLE;
+// You need to use KeyCode::VK_IOHIDPOSTEVENT_NX_POWER_KEY when you want to change a key to power button.
+static const KeyCode VK_IOHIDPOSTEVENT_NX_POWER_KEY;
+//
+static const KeyCode VK_IOHIKEYBOARD_TOGGLE_NUMLOCK;
+// For __KeyToKey__ Option::KEYTOKEY_DELAYED_ACTION_CANCELED_BY
+static const KeyCode VK_KEYTOKEY_DELAYED_ACTION_DROP_EVENT;
+//
+static const KeyCode VK_JIS_TOGGLE_EISUU_KANA;
+static const KeyCode VK_JIS_BACKSLASH;
+static const KeyCode VK_JIS_YEN;
+static const KeyCode VK__AUTOINDEX__BEGIN__;
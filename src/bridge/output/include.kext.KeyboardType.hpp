@@ -0,0 +1,15 @@
+static const KeyboardType MACBOOK;
+static const KeyboardType MACBOOK_COREDUO;
+static const KeyboardType MACBOOK_3_1;
+static const KeyboardType POWERBOOK_G4_TI;
+static const KeyboardType POWERBOOK_G4;
+static const KeyboardType POWERBOOK;
+static const KeyboardType LOGITECH_DI_NOVO_KEYBOARD;
+static const KeyboardType REALFORCE91UBK;
+static const KeyboardType JIS_MACBOOK;
+static const KeyboardType JIS_MACBOOK_2008;
+static const KeyboardType JIS_APPLE_USB_KEYBOARD;
+static const KeyboardType JIS_APPLE_USB_KEYBOARD_ALUMINUM;
+static const KeyboardType JIS_PC_USB_KEYBOARD;
+static const KeyboardType JIS_HAPPY_HACKING_KEYBOARD;
+static const KeyboardType VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,15 @@
+static const ModifierFlag ZERO;
+static const ModifierFlag CAPSLOCK;
+static const ModifierFlag SHIFT_L;
+static const ModifierFlag SHIFT_R;
+static const ModifierFlag CONTROL_L;
+static const ModifierFlag CONTROL_R;
+static const ModifierFlag OPTION_L;
+static const ModifierFlag OPTION_R;
+static const ModifierFlag COMMAND_L;
+static const ModifierFlag COMMAND_R;
+static const ModifierFlag NUMPAD;
+static const ModifierFlag FN;
+static const ModifierFlag NONE;
+// Please define other ModifierFlag by modifierdef.xml.
+static const ModifierFlag VK__AUTOINDEX__BEGIN__;
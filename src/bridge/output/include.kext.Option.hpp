@@ -0,0 +1,51 @@
+// Allow a setting to work in PassThrough Mode.
+static const Option IGNORE_PASSTHROUGH;
+// For __KeyOverlaidModifier__
+static const Option KEYOVERLAIDMODIFIER_REPEAT;
+static const Option KEYOVERLAIDMODIFIER_REPEAT_TOKEYS;
+// For __SimultaneousKeyPresses__
+static const Option SIMULTANEOUSKEYPRESSES_RAW;
+static const Option SIMULTANEOUSKEYPRESSES_POST_FROM_EVENTS_AS_RAW;
+static const Option SIMULTANEOUSKEYPRESSES_STRICT_KEY_ORDER;
+// Suppress keyboard repeat
+static const Option NOREPEAT;
+// Send a key sequence at keydown and keyup.
+static const Option KEYTOKEY_BEFORE_KEYDOWN;
+static const Option KEYTOKEY_AFTER_KEYUP;
+// Send keys at timeout.
+static const Option KEYTOKEY_DELAYED_ACTION;
+static const Option KEYTOKEY_DELAYED_ACTION_CANCELED_BY;
+static const Option KEYTOKEY_DELAYED_ACTION_CANCELED_DEFAULT;
+static const Option KEYTOKEY_DELAYED_ACTION_MILLISECONDS;
+// Increase modifier flags when key is pressed.
+static const Option KEYTOKEY_INCREASE_MODIFIER_FLAGS;
+// For __PointingRelativeToScroll__
+static const Option POINTINGRELATIVETOSCROLL_TOFLAGS;
+static const Option POINTINGRELATIVETOSCROLL_TOKEYS;
+// For __DropAllKeys__
+static const Option DROPALLKEYS_DROP_KEY;
+static const Option DROPALLKEYS_DROP_CONSUMERKEY;
+static const Option DROPALLKEYS_DROP_POINTINGBUTTON;
+// For __DropScrollWheel__
+static const Option DROPSCROLLWHEEL_DROP_HORIZONTAL_SCROLL;
+static const Option DROPSCROLLWHEEL_DROP_MOMENTUM_SCROLL;
+// For __FlipPointingRelative__
+static const Option FLIPPOINTINGRELATIVE_HORIZONTAL;
+static const Option FLIPPOINTINGRELATIVE_VERTICAL;
+// For __FlipScrollWheel__ and __PointingRelativeToScroll__
+static const Option FLIPSCROLLWHEEL_HORIZONTAL;
+static const Option FLIPSCROLLWHEEL_VERTICAL;
+static const Option FLIPSCROLLWHEEL_ROTATE;
+// For __KeyOverlaidModifier__ and __HoldingKeyToKey__
+static const Option UNINTERRUPTIBLE_BY_SCROLL_WHEEL;
+static const Option UNINTERRUPTIBLE_BY_MODIFIER;
+static const Option UNINTERRUPTIBLE_BY_POINTING_BUTTON;
+static const Option HOLD_ON_OTHER_KEY_PRESS;
+static const Option PERMISSIVE_HOLD;
+static const Option ADAPTIVE_HOLDING_THRESHOLD;
+// For __ForceNumLockOn__
+static const Option FORCENUMLOCKON_FORCE_OFF;
+// Identities of @begin, @end.
+static const Option USE_SEPARATOR;
+static const Option SEPARATOR;
+static const Option VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,34 @@
+static const PointingButton NONE;
+static const PointingButton RIGHT;
+static const PointingButton MIDDLE;
+static const PointingButton LEFT;
+static const PointingButton BUTTON4;
+static const PointingButton BUTTON5;
+static const PointingButton BUTTON6;
+static const PointingButton BUTTON7;
+static const PointingButton BUTTON8;
+static const PointingButton BUTTON9;
+static const PointingButton BUTTON10;
+static const PointingButton BUTTON11;
+static const PointingButton BUTTON12;
+static const PointingButton BUTTON13;
+static const PointingButton BUTTON14;
+static const PointingButton BUTTON15;
+static const PointingButton BUTTON16;
+static const PointingButton BUTTON17;
+static const PointingButton BUTTON18;
+static const PointingButton BUTTON19;
+static const PointingButton BUTTON20;
+static const PointingButton BUTTON21;
+static const PointingButton BUTTON22;
+static const PointingButton BUTTON23;
+static const PointingButton BUTTON24;
+static const PointingButton BUTTON25;
+static const PointingButton BUTTON26;
+static const PointingButton BUTTON27;
+static const PointingButton BUTTON28;
+static const PointingButton BUTTON29;
+static const PointingButton BUTTON30;
+static const PointingButton BUTTON31;
+static const PointingButton BUTTON32;
+static const PointingButton VK__AUTOINDEX__BEGIN__;
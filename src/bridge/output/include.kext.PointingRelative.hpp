@@ -0,0 +1,7 @@
+static const PointingRelative NONE;
+static const PointingRelative UP;
+static const PointingRelative DOWN;
+static const PointingRelative LEFT;
+static const PointingRelative RIGHT;
+static const PointingRelative ANY;
+static const PointingRelative VK__AUTOINDEX__BEGIN__;
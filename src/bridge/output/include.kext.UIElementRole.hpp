@@ -0,0 +1,3 @@
+// Please define other UIElementRole by uielementroledef.xml.
+static const UIElementRole UNKNOWN;
+static const UIElementRole VK__AUTOINDEX__BEGIN__;
@@ -0,0 +1,3 @@
+// Please define other WindowName by windownamedef.xml.
+static const WindowName UNKNOWN;
+static const WindowName VK__AUTOINDEX__BEGIN__;
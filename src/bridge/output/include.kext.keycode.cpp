@@ -0,0 +1,532 @@
+const ApplicationType ApplicationType::UNKNOWN(0);
+const ApplicationType ApplicationType::VK__AUTOINDEX__BEGIN__(1);
+const ConsumerKeyCode ConsumerKeyCode::BRIGHTNESS_DOWN(0x3);
+const ConsumerKeyCode ConsumerKeyCode::BRIGHTNESS_UP(0x2);
+const ConsumerKeyCode ConsumerKeyCode::KEYBOARDLIGHT_OFF(0x17);
+const ConsumerKeyCode ConsumerKeyCode::KEYBOARDLIGHT_LOW(0x16);
+const ConsumerKeyCode ConsumerKeyCode::KEYBOARDLIGHT_HIGH(0x15);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_PREV(0x14);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_PLAY(0x10);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_NEXT(0x13);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_PREV_18(0x12);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_PREV_0x12(0x12);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_NEXT_17(0x11);
+const ConsumerKeyCode ConsumerKeyCode::MUSIC_NEXT_0x11(0x11);
+const ConsumerKeyCode ConsumerKeyCode::VOLUME_MUTE(0x7);
+const ConsumerKeyCode ConsumerKeyCode::VOLUME_DOWN(0x1);
+const ConsumerKeyCode ConsumerKeyCode::VOLUME_UP(0x0);
+const ConsumerKeyCode ConsumerKeyCode::EJECT(0xe);
+const ConsumerKeyCode ConsumerKeyCode::POWER(0x6);
+const ConsumerKeyCode ConsumerKeyCode::NUMLOCK(0xa);
+const ConsumerKeyCode ConsumerKeyCode::VIDEO_MIRROR(0xf);
+const ConsumerKeyCode ConsumerKeyCode::VK__BEGIN__(0x10000000);
+const ConsumerKeyCode ConsumerKeyCode::VK_PSEUDO_KEY(0x10000001);
+const ConsumerKeyCode ConsumerKeyCode::VK_NONE(0x10000002);
+const ConsumerKeyCode ConsumerKeyCode::VK__AUTOINDEX__BEGIN__(0x10000003);
+const DeviceLocation DeviceLocation::ANY(0x0000);
+const DeviceLocation DeviceLocation::VK__AUTOINDEX__BEGIN__(0x0001);
+const DeviceProduct DeviceProduct::APPLE_INTERNAL_KEYBOARD_TRACKPAD_0x0218(0x0218);
+const DeviceProduct DeviceProduct::LOGITECH_CORDLESS_PRESENTER(0xc515);
+const DeviceProduct DeviceProduct::LOGITECH_USB_HEADSET(0x0a0b);
+const DeviceProduct DeviceProduct::Logitech_Bluetooth_Mouse_M555b(0xb009);
+const DeviceProduct DeviceProduct::Razer_DeathAdder_Chroma(0x0043);
+const DeviceProduct DeviceProduct::Mionix_Naos_7000(0x130c);
+const DeviceProduct DeviceProduct::Microsoft_Sculpt_Touch_Mouse(0x077c);
+const DeviceProduct DeviceProduct::Microsoft_Designer_Bluetooth_Mouse(0x0805);
+const DeviceProduct DeviceProduct::PSEUDO(0x0000);
+const DeviceProduct DeviceProduct::ANY(0x0000);
+const DeviceProduct DeviceProduct::VK__AUTOINDEX__BEGIN__(0x0001);
+const DeviceVendor DeviceVendor::APPLE_COMPUTER(0x05ac);
+const DeviceVendor DeviceVendor::Apple_Bluetooth(0x004c);
+const DeviceVendor DeviceVendor::PSEUDO(0x0000);
+const DeviceVendor DeviceVendor::LOGITECH(0x046d);
+const DeviceVendor DeviceVendor::Razer(0x1532);
+const DeviceVendor DeviceVendor::Mionix(0x22d4);
+const DeviceVendor DeviceVendor::MICROSOFT(0x045e);
+const DeviceVendor DeviceVendor::VK__AUTOINDEX__BEGIN__(0x045f);
+const EventType EventType::NONE(0);
+const EventType EventType::DOWN(10);
+const EventType EventType::UP(11);
+const EventType EventType::MODIFY(12);
+const EventType EventType::VK__AUTOINDEX__BEGIN__(13);
+const InputSource InputSource::NONE(0);
+const InputSource InputSource::ENGLISH(1);
+const InputSource InputSource::AINU(2);
+const InputSource InputSource::JAPANESE(3);
+const InputSource InputSource::VK__AUTOINDEX__BEGIN__(4);
+const KeyCode KeyCode::A(0x0);
+const KeyCode KeyCode::B(0xb);
+const KeyCode KeyCode::C(0x8);
+const KeyCode KeyCode::D(0x2);
+const KeyCode KeyCode::E(0xe);
+const KeyCode KeyCode::F(0x3);
+const KeyCode KeyCode::G(0x5);
+const KeyCode KeyCode::H(0x4);
+const KeyCode KeyCode::I(0x22);
+const KeyCode KeyCode::J(0x26);
+const KeyCode KeyCode::K(0x28);
+const KeyCode KeyCode::L(0x25);
+const KeyCode KeyCode::M(0x2e);
+const KeyCode KeyCode::N(0x2d);
+const KeyCode KeyCode::O(0x1f);
+const KeyCode KeyCode::P(0x23);
+const KeyCode KeyCode::Q(0xc);
+const KeyCode KeyCode::R(0xf);
+const KeyCode KeyCode::S(0x1);
+const KeyCode KeyCode::T(0x11);
+const KeyCode KeyCode::U(0x20);
+const KeyCode KeyCode::V(0x9);
+const KeyCode KeyCode::W(0xd);
+const KeyCode KeyCode::X(0x7);
+const KeyCode KeyCode::Y(0x10);
+const KeyCode KeyCode::Z(0x6);
+const KeyCode KeyCode::KEY_0(0x1d);
+const KeyCode KeyCode::KEY_1(0x12);
+const KeyCode KeyCode::KEY_2(0x13);
+const KeyCode KeyCode::KEY_3(0x14);
+const KeyCode KeyCode::KEY_4(0x15);
+const KeyCode KeyCode::KEY_5(0x17);
+const KeyCode KeyCode::KEY_6(0x16);
+const KeyCode KeyCode::KEY_7(0x1a);
+const KeyCode KeyCode::KEY_8(0x1c);
+const KeyCode KeyCode::KEY_9(0x19);
+const KeyCode KeyCode::BACKQUOTE(0x32);
+const KeyCode KeyCode::BACKSLASH(0x2a);
+const KeyCode KeyCode::BRACKET_LEFT(0x21);
+const KeyCode KeyCode::BRACKET_RIGHT(0x1e);
+const KeyCode KeyCode::COMMA(0x2b);
+const KeyCode KeyCode::DOT(0x2f);
+const KeyCode KeyCode::EQUAL(0x18);
+const KeyCode KeyCode::MINUS(0x1b);
+const KeyCode KeyCode::QUOTE(0x27);
+const KeyCode KeyCode::SEMICOLON(0x29);
+const KeyCode KeyCode::SLASH(0x2c);
+const KeyCode KeyCode::KEYPAD_0(0x52);
+const KeyCode KeyCode::KEYPAD_1(0x53);
+const KeyCode KeyCode::KEYPAD_2(0x54);
+const KeyCode KeyCode::KEYPAD_3(0x55);
+const KeyCode KeyCode::KEYPAD_4(0x56);
+const KeyCode KeyCode::KEYPAD_5(0x57);
+const KeyCode KeyCode::KEYPAD_6(0x58);
+const KeyCode KeyCode::KEYPAD_7(0x59);
+const KeyCode KeyCode::KEYPAD_8(0x5b);
+const KeyCode KeyCode::KEYPAD_9(0x5c);
+const KeyCode KeyCode::KEYPAD_CLEAR(0x47);
+const KeyCode KeyCode::KEYPAD_COMMA(0x5f);
+const KeyCode KeyCode::KEYPAD_DOT(0x41);
+const KeyCode KeyCode::KEYPAD_EQUAL(0x51);
+const KeyCode KeyCode::KEYPAD_MINUS(0x4e);
+const KeyCode KeyCode::KEYPAD_MULTIPLY(0x43);
+const KeyCode KeyCode::KEYPAD_PLUS(0x45);
+const KeyCode KeyCode::KEYPAD_SLASH(0x4b);
+const KeyCode KeyCode::DELETE(0x33);
+const KeyCode KeyCode::ENTER(0x4c);
+const KeyCode KeyCode::ENTER_POWERBOOK(0x34);
+const KeyCode KeyCode::ESCAPE(0x35);
+const KeyCode KeyCode::FORWARD_DELETE(0x75);
+const KeyCode KeyCode::HELP(0x72);
+const KeyCode KeyCode::RETURN(0x24);
+const KeyCode KeyCode::SPACE(0x31);
+const KeyCode KeyCode::TAB(0x30);
+const KeyCode KeyCode::F1(0x7a);
+const KeyCode KeyCode::F2(0x78);
+const KeyCode KeyCode::F3(0x63);
+const KeyCode KeyCode::F4(0x76);
+const KeyCode KeyCode::F5(0x60);
+const KeyCode KeyCode::F6(0x61);
+const KeyCode KeyCode::F7(0x62);
+const KeyCode KeyCode::F8(0x64);
+const KeyCode KeyCode::F9(0x65);
+const KeyCode KeyCode::F10(0x6d);
+const KeyCode KeyCode::F11(0x67);
+const KeyCode KeyCode::F12(0x6f);
+const KeyCode KeyCode::F13(0x69);
+const KeyCode KeyCode::F14(0x6b);
+const KeyCode KeyCode::F15(0x71);
+const KeyCode KeyCode::F16(0x6a);
+const KeyCode KeyCode::F17(0x40);
+const KeyCode KeyCode::F18(0x4f);
+const KeyCode KeyCode::F19(0x50);
+const KeyCode KeyCode::BRIGHTNESS_DOWN(0x91);
+const KeyCode KeyCode::BRIGHTNESS_UP(0x90);
+const KeyCode KeyCode::DASHBOARD(0x82);
+const KeyCode KeyCode::EXPOSE_ALL(0xa0);
+const KeyCode KeyCode::LAUNCHPAD(0x83);
+const KeyCode KeyCode::MISSION_CONTROL(0xa0);
+const KeyCode KeyCode::CURSOR_UP(0x7e);
+const KeyCode KeyCode::CURSOR_DOWN(0x7d);
+const KeyCode KeyCode::CURSOR_LEFT(0x7b);
+const KeyCode KeyCode::CURSOR_RIGHT(0x7c);
+const KeyCode KeyCode::PAGEUP(0x74);
+const KeyCode KeyCode::PAGEDOWN(0x79);
+const KeyCode KeyCode::HOME(0x73);
+const KeyCode KeyCode::END(0x77);
+const KeyCode KeyCode::CAPSLOCK(0x39);
+const KeyCode KeyCode::COMMAND_L(0x37);
+const KeyCode KeyCode::COMMAND_R(0x36);
+const KeyCode KeyCode::CONTROL_L(0x3b);
+const KeyCode KeyCode::CONTROL_R(0x3e);
+const KeyCode KeyCode::FN(0x3f);
+const KeyCode KeyCode::OPTION_L(0x3a);
+const KeyCode KeyCode::OPTION_R(0x3d);
+const KeyCode KeyCode::SHIFT_L(0x38);
+const KeyCode KeyCode::SHIFT_R(0x3c);
+const KeyCode KeyCode::PC_APPLICATION(0x6e);
+const KeyCode KeyCode::PC_BS(0x33);
+const KeyCode KeyCode::PC_DEL(0x75);
+const KeyCode KeyCode::PC_INSERT(0x72);
+const KeyCode KeyCode::PC_KEYPAD_NUMLOCK(0x47);
+const KeyCode KeyCode::PC_PAUSE(0x71);
+const KeyCode KeyCode::PC_POWER(0x7f);
+const KeyCode KeyCode::PC_PRINTSCREEN(0x69);
+const KeyCode KeyCode::PC_SCROLLLOCK(0x6b);
+const KeyCode KeyCode::DANISH_DOLLAR(0xa);
+const KeyCode KeyCode::DANISH_LESS_THAN(0x32);
+const KeyCode KeyCode::FRENCH_DOLLAR(0x1e);
+const KeyCode KeyCode::FRENCH_EQUAL(0x2c);
+const KeyCode KeyCode::FRENCH_HAT(0x21);
+const KeyCode KeyCode::FRENCH_MINUS(0x18);
+const KeyCode KeyCode::FRENCH_RIGHT_PAREN(0x1b);
+const KeyCode KeyCode::GERMAN_CIRCUMFLEX(0xa);
+const KeyCode KeyCode::GERMAN_LESS_THAN(0x32);
+const KeyCode KeyCode::GERMAN_PC_LESS_THAN(0x80);
+const KeyCode KeyCode::GERMAN_QUOTE(0x18);
+const KeyCode KeyCode::GERMAN_A_UMLAUT(0x27);
+const KeyCode KeyCode::GERMAN_O_UMLAUT(0x29);
+const KeyCode KeyCode::GERMAN_U_UMLAUT(0x21);
+const KeyCode KeyCode::ITALIAN_BACKSLASH(0xa);
+const KeyCode KeyCode::ITALIAN_LESS_THAN(0x32);
+const KeyCode KeyCode::JIS_ATMARK(0x21);
+const KeyCode KeyCode::JIS_BRACKET_LEFT(0x1e);
+const KeyCode KeyCode::JIS_BRACKET_RIGHT(0x2a);
+const KeyCode KeyCode::JIS_COLON(0x27);
+const KeyCode KeyCode::JIS_DAKUON(0x21);
+const KeyCode KeyCode::JIS_EISUU(0x66);
+const KeyCode KeyCode::JIS_HANDAKUON(0x1e);
+const KeyCode KeyCode::JIS_HAT(0x18);
+const KeyCode KeyCode::JIS_KANA(0x68);
+const KeyCode KeyCode::JIS_PC_HAN_ZEN(0x32);
+const KeyCode KeyCode::JIS_UNDERSCORE(0x5e);
+const KeyCode KeyCode::JIS_YEN(0x5d);
+const KeyCode KeyCode::RUSSIAN_PARAGRAPH(0xa);
+const KeyCode KeyCode::RUSSIAN_TILDE(0x32);
+const KeyCode KeyCode::SPANISH_LESS_THAN(0x32);
+const KeyCode KeyCode::SPANISH_ORDINAL_INDICATOR(0xa);
+const KeyCode KeyCode::SWEDISH_LESS_THAN(0x32);
+const KeyCode KeyCode::SWEDISH_SECTION(0xa);
+const KeyCode KeyCode::SWISS_LESS_THAN(0x32);
+const KeyCode KeyCode::SWISS_SECTION(0xa);
+const KeyCode KeyCode::UK_SECTION(0xa);
+const KeyCode KeyCode::VK__BEGIN__(0x10000000);
+const KeyCode KeyCode::VK_NONE(0x10000001);
+const KeyCode KeyCode::VK_PSEUDO_KEY(0x10000002);
+const KeyCode KeyCode::VK_WAIT_10MS(0x10000003);
+const KeyCode KeyCode::VK_WAIT_50MS(0x10000004);
+const KeyCode KeyCode::VK_WAIT_100MS(0x10000005);
+const KeyCode KeyCode::VK_LOCK_CAPSLOCK(0x10000006);
+const KeyCode KeyCode::VK_LOCK_COMMAND_L(0x10000007);
+const KeyCode KeyCode::VK_LOCK_COMMAND_R(0x10000008);
+const KeyCode KeyCode::VK_LOCK_CONTROL_L(0x10000009);
+const KeyCode KeyCode::VK_LOCK_CONTROL_R(0x10000010);
+const KeyCode KeyCode::VK_LOCK_FN(0x10000011);
+const KeyCode KeyCode::VK_LOCK_OPTION_L(0x10000012);
+const KeyCode KeyCode::VK_LOCK_OPTION_R(0x10000013);
+const KeyCode KeyCode::VK_LOCK_SHIFT_L(0x10000014);
+const KeyCode KeyCode::VK_LOCK_SHIFT_R(0x10000015);
+const KeyCode KeyCode::VK_LOCK_CAPSLOCK_FORCE_ON(0x10000016);
+const KeyCode KeyCode::VK_LOCK_COMMAND_L_FORCE_ON(0x10000017);
+const KeyCode KeyCode::VK_LOCK_COMMAND_R_FORCE_ON(0x10000018);
+const KeyCode KeyCode::VK_LOCK_CONTROL_L_FORCE_ON(0x10000019);
+const KeyCode KeyCode::VK_LOCK_CONTROL_R_FORCE_ON(0x10000020);
+const KeyCode KeyCode::VK_LOCK_FN_FORCE_ON(0x10000021);
+const KeyCode KeyCode::VK_LOCK_OPTION_L_FORCE_ON(0x10000022);
+const KeyCode KeyCode::VK_LOCK_OPTION_R_FORCE_ON(0x10000023);
+const KeyCode KeyCode::VK_LOCK_SHIFT_L_FORCE_ON(0x10000024);
+const KeyCode KeyCode::VK_LOCK_SHIFT_R_FORCE_ON(0x10000025);
+const KeyCode KeyCode::VK_LOCK_CAPSLOCK_FORCE_OFF(0x10000026);
+const KeyCode KeyCode::VK_LOCK_COMMAND_L_FORCE_OFF(0x10000027);
+const KeyCode KeyCode::VK_LOCK_COMMAND_R_FORCE_OFF(0x10000028);
+const KeyCode KeyCode::VK_LOCK_CONTROL_L_FORCE_OFF(0x10000029);
+const KeyCode KeyCode::VK_LOCK_CONTROL_R_FORCE_OFF(0x10000030);
+const KeyCode KeyCode::VK_LOCK_FN_FORCE_OFF(0x10000031);
+const KeyCode KeyCode::VK_LOCK_OPTION_L_FORCE_OFF(0x10000032);
+const KeyCode KeyCode::VK_LOCK_OPTION_R_FORCE_OFF(0x10000033);
+const KeyCode KeyCode::VK_LOCK_SHIFT_L_FORCE_OFF(0x10000034);
+const KeyCode KeyCode::VK_LOCK_SHIFT_R_FORCE_OFF(0x10000035);
+const KeyCode KeyCode::VK_LOCK_ALL_FORCE_OFF(0x10000036);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CAPSLOCK(0x10000037);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_L(0x10000038);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_R(0x10000039);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_L(0x10000040);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_R(0x10000041);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_FN(0x10000042);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_L(0x10000043);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_R(0x10000044);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_L(0x10000045);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_R(0x10000046);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CAPSLOCK_FORCE_ON(0x10000047);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_L_FORCE_ON(0x10000048);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_R_FORCE_ON(0x10000049);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_L_FORCE_ON(0x10000050);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_R_FORCE_ON(0x10000051);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_FN_FORCE_ON(0x10000052);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_L_FORCE_ON(0x10000053);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_R_FORCE_ON(0x10000054);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_L_FORCE_ON(0x10000055);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_R_FORCE_ON(0x10000056);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CAPSLOCK_FORCE_OFF(0x10000057);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_L_FORCE_OFF(0x10000058);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_COMMAND_R_FORCE_OFF(0x10000059);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_L_FORCE_OFF(0x10000060);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_CONTROL_R_FORCE_OFF(0x10000061);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_FN_FORCE_OFF(0x10000062);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_L_FORCE_OFF(0x10000063);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_OPTION_R_FORCE_OFF(0x10000064);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_L_FORCE_OFF(0x10000065);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_SHIFT_R_FORCE_OFF(0x10000066);
+const KeyCode KeyCode::VK_NEGATIVE_LOCK_ALL_FORCE_OFF(0x10000067);
+const KeyCode KeyCode::VK_STICKY_CAPSLOCK(0x10000068);
+const KeyCode KeyCode::VK_STICKY_COMMAND_L(0x10000069);
+const KeyCode KeyCode::VK_STICKY_COMMAND_R(0x10000070);
+const KeyCode KeyCode::VK_STICKY_CONTROL_L(0x10000071);
+const KeyCode KeyCode::VK_STICKY_CONTROL_R(0x10000072);
+const KeyCode KeyCode::VK_STICKY_FN(0x10000073);
+const KeyCode KeyCode::VK_STICKY_OPTION_L(0x10000074);
+const KeyCode KeyCode::VK_STICKY_OPTION_R(0x10000075);
+const KeyCode KeyCode::VK_STICKY_SHIFT_L(0x10000076);
+const KeyCode KeyCode::VK_STICKY_SHIFT_R(0x10000077);
+const KeyCode KeyCode::VK_STICKY_CAPSLOCK_FORCE_ON(0x10000078);
+const KeyCode KeyCode::VK_STICKY_COMMAND_L_FORCE_ON(0x10000079);
+const KeyCode KeyCode::VK_STICKY_COMMAND_R_FORCE_ON(0x10000080);
+const KeyCode KeyCode::VK_STICKY_CONTROL_L_FORCE_ON(0x10000081);
+const KeyCode KeyCode::VK_STICKY_CONTROL_R_FORCE_ON(0x10000082);
+const KeyCode KeyCode::VK_STICKY_FN_FORCE_ON(0x10000083);
+const KeyCode KeyCode::VK_STICKY_OPTION_L_FORCE_ON(0x10000084);
+const KeyCode KeyCode::VK_STICKY_OPTION_R_FORCE_ON(0x10000085);
+const KeyCode KeyCode::VK_STICKY_SHIFT_L_FORCE_ON(0x10000086);
+const KeyCode KeyCode::VK_STICKY_SHIFT_R_FORCE_ON(0x10000087);
+const KeyCode KeyCode::VK_STICKY_CAPSLOCK_FORCE_OFF(0x10000088);
+const KeyCode KeyCode::VK_STICKY_COMMAND_L_FORCE_OFF(0x10000089);
+const KeyCode KeyCode::VK_STICKY_COMMAND_R_FORCE_OFF(0x10000090);
+const KeyCode KeyCode::VK_STICKY_CONTROL_L_FORCE_OFF(0x10000091);
+const KeyCode KeyCode::VK_STICKY_CONTROL_R_FORCE_OFF(0x10000092);
+const KeyCode KeyCode::VK_STICKY_FN_FORCE_OFF(0x10000093);
+const KeyCode KeyCode::VK_STICKY_OPTION_L_FORCE_OFF(0x10000094);
+const KeyCode KeyCode::VK_STICKY_OPTION_R_FORCE_OFF(0x10000095);
+const KeyCode KeyCode::VK_STICKY_SHIFT_L_FORCE_OFF(0x10000096);
+const KeyCode KeyCode::VK_STICKY_SHIFT_R_FORCE_OFF(0x10000097);
+const KeyCode KeyCode::VK_STICKY_ACTIVE_MODIFIERS_TOGGLE(0x10000098);
+const KeyCode KeyCode::VK_STICKY_ACTIVE_MODIFIERS_FORCE_ON(0x10000099);
+const KeyCode KeyCode::VK_STICKY_ACTIVE_MODIFIERS_FORCE_OFF(0x10000100);
+const KeyCode KeyCode::VK_STICKY_ALL_FORCE_OFF(0x10000101);
+const KeyCode KeyCode::VK_LAZY_COMMAND_L(0x10000102);
+const KeyCode KeyCode::VK_LAZY_COMMAND_R(0x10000103);
+const KeyCode KeyCode::VK_LAZY_CONTROL_L(0x10000104);
+const KeyCode KeyCode::VK_LAZY_CONTROL_R(0x10000105);
+const KeyCode KeyCode::VK_LAZY_FN(0x10000106);
+const KeyCode KeyCode::VK_LAZY_OPTION_L(0x10000107);
+const KeyCode KeyCode::VK_LAZY_OPTION_R(0x10000108);
+const KeyCode KeyCode::VK_LAZY_SHIFT_L(0x10000109);
+const KeyCode KeyCode::VK_LAZY_SHIFT_R(0x10000110);
+const KeyCode KeyCode::VK_PARTIAL_KEYDOWN(0x10000111);
+const KeyCode KeyCode::VK_PARTIAL_KEYUP(0x10000112);
+const KeyCode KeyCode::VK_CONSUMERKEY_BRIGHTNESS_DOWN(0x10000113);
+const KeyCode KeyCode::VK_CONSUMERKEY_BRIGHTNESS_UP(0x10000114);
+const KeyCode KeyCode::VK_CONSUMERKEY_KEYBOARDLIGHT_LOW(0x10000115);
+const KeyCode KeyCode::VK_CONSUMERKEY_KEYBOARDLIGHT_HIGH(0x10000116);
+const KeyCode KeyCode::VK_CONSUMERKEY_MUSIC_PREV(0x10000117);
+const KeyCode KeyCode::VK_CONSUMERKEY_MUSIC_PLAY(0x10000118);
+const KeyCode KeyCode::VK_CONSUMERKEY_MUSIC_NEXT(0x10000119);
+const KeyCode KeyCode::VK_CONSUMERKEY_VOLUME_MUTE(0x10000120);
+const KeyCode KeyCode::VK_CONSUMERKEY_VOLUME_DOWN(0x10000121);
+const KeyCode KeyCode::VK_CONSUMERKEY_VOLUME_UP(0x10000122);
+const KeyCode KeyCode::VK_CONSUMERKEY_EJECT(0x10000123);
+const KeyCode KeyCode::VK_CONSUMERKEY_POWER(0x10000124);
+const KeyCode KeyCode::VK_MOUSEKEY_UP(0x10000125);
+const KeyCode KeyCode::VK_MOUSEKEY_DOWN(0x10000126);
+const KeyCode KeyCode::VK_MOUSEKEY_LEFT(0x10000127);
+const KeyCode KeyCode::VK_MOUSEKEY_RIGHT(0x10000128);
+const KeyCode KeyCode::VK_MOUSEKEY_DIAGONAL_NE(0x10000129);
+const KeyCode KeyCode::VK_MOUSEKEY_DIAGONAL_NW(0x10000130);
+const KeyCode KeyCode::VK_MOUSEKEY_DIAGONAL_SE(0x10000131);
+const KeyCode KeyCode::VK_MOUSEKEY_DIAGONAL_SW(0x10000132);
+const KeyCode KeyCode::VK_MOUSEKEY_SCROLL_UP(0x10000133);
+const KeyCode KeyCode::VK_MOUSEKEY_SCROLL_DOWN(0x10000134);
+const KeyCode KeyCode::VK_MOUSEKEY_SCROLL_LEFT(0x10000135);
+const KeyCode KeyCode::VK_MOUSEKEY_SCROLL_RIGHT(0x10000136);
+const KeyCode KeyCode::VK_MOUSEKEY_HIGHSPEED(0x10000137);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_UP(0x10000138);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_DOWN(0x10000139);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_LEFT(0x10000140);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_RIGHT(0x10000141);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_UP(0x10000142);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_DOWN(0x10000143);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_LEFT(0x10000144);
+const KeyCode KeyCode::VK_MOUSEKEY_FIXED_DISTANCE_SCROLL_RIGHT(0x10000145);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_LEFT(0x10000146);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_MIDDLE(0x10000147);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_RIGHT(0x10000148);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON4(0x10000149);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON5(0x10000150);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON6(0x10000151);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON7(0x10000152);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON8(0x10000153);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON9(0x10000154);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON10(0x10000155);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON11(0x10000156);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON12(0x10000157);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON13(0x10000158);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON14(0x10000159);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON15(0x10000160);
+const KeyCode KeyCode::VK_MOUSEKEY_BUTTON_BUTTON16(0x10000161);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_LEFT(0x10000162);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_MIDDLE(0x10000163);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_RIGHT(0x10000164);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON4(0x10000165);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON5(0x10000166);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON6(0x10000167);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON7(0x10000168);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON8(0x10000169);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON9(0x10000170);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON10(0x10000171);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON11(0x10000172);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON12(0x10000173);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON13(0x10000174);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON14(0x10000175);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON15(0x10000176);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_BUTTON16(0x10000177);
+const KeyCode KeyCode::VK_MOUSEKEY_LOCK_BUTTON_ALL_FORCE_OFF(0x10000178);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_SOUND_UP(0x10000179);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_SOUND_DOWN(0x10000180);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_BRIGHTNESS_UP(0x10000181);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_BRIGHTNESS_DOWN(0x10000182);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_MUTE(0x10000183);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_PLAY(0x10000184);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_NEXT(0x10000185);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_PREVIOUS(0x10000186);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_UP(0x10000187);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_DOWN(0x10000188);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_KEYTYPE_ILLUMINATION_TOGGLE(0x10000189);
+const KeyCode KeyCode::VK_IOHIDPOSTEVENT_NX_POWER_KEY(0x10000190);
+const KeyCode KeyCode::VK_IOHIKEYBOARD_TOGGLE_NUMLOCK(0x10000191);
+const KeyCode KeyCode::VK_KEYTOKEY_DELAYED_ACTION_DROP_EVENT(0x10000192);
+const KeyCode KeyCode::VK_JIS_TOGGLE_EISUU_KANA(0x10000193);
+const KeyCode KeyCode::VK_JIS_BACKSLASH(0x10000194);
+const KeyCode KeyCode::VK_JIS_YEN(0x10000195);
+const KeyCode KeyCode::VK__AUTOINDEX__BEGIN__(0x10000196);
+const KeyboardType KeyboardType::MACBOOK(37);
+const KeyboardType KeyboardType::MACBOOK_COREDUO(38);
+const KeyboardType KeyboardType::MACBOOK_3_1(44);
+const KeyboardType KeyboardType::POWERBOOK_G4_TI(201);
+const KeyboardType KeyboardType::POWERBOOK_G4(202);
+const KeyboardType KeyboardType::POWERBOOK(207);
+const KeyboardType KeyboardType::LOGITECH_DI_NOVO_KEYBOARD(41);
+const KeyboardType KeyboardType::REALFORCE91UBK(42);
+const KeyboardType KeyboardType::JIS_MACBOOK(43);
+const KeyboardType KeyboardType::JIS_MACBOOK_2008(45);
+const KeyboardType KeyboardType::JIS_APPLE_USB_KEYBOARD(36);
+const KeyboardType KeyboardType::JIS_APPLE_USB_KEYBOARD_ALUMINUM(48);
+const KeyboardType KeyboardType::JIS_PC_USB_KEYBOARD(42);
+const KeyboardType KeyboardType::JIS_HAPPY_HACKING_KEYBOARD(40);
+const KeyboardType KeyboardType::VK__AUTOINDEX__BEGIN__(41);
+const ModifierFlag ModifierFlag::ZERO(0);
+const ModifierFlag ModifierFlag::CAPSLOCK(1);
+const ModifierFlag ModifierFlag::SHIFT_L(2);
+const ModifierFlag ModifierFlag::SHIFT_R(3);
+const ModifierFlag ModifierFlag::CONTROL_L(4);
+const ModifierFlag ModifierFlag::CONTROL_R(5);
+const ModifierFlag ModifierFlag::OPTION_L(6);
+const ModifierFlag ModifierFlag::OPTION_R(7);
+const ModifierFlag ModifierFlag::COMMAND_L(8);
+const ModifierFlag ModifierFlag::COMMAND_R(9);
+const ModifierFlag ModifierFlag::NUMPAD(10);
+const ModifierFlag ModifierFlag::FN(11);
+const ModifierFlag ModifierFlag::NONE(12);
+const ModifierFlag ModifierFlag::VK__AUTOINDEX__BEGIN__(13);
+const Option Option::IGNORE_PASSTHROUGH(1);
+const Option Option::KEYOVERLAIDMODIFIER_REPEAT(2);
+const Option Option::KEYOVERLAIDMODIFIER_REPEAT_TOKEYS(3);
+const Option Option::SIMULTANEOUSKEYPRESSES_RAW(4);
+const Option Option::SIMULTANEOUSKEYPRESSES_POST_FROM_EVENTS_AS_RAW(5);
+const Option Option::SIMULTANEOUSKEYPRESSES_STRICT_KEY_ORDER(6);
+const Option Option::NOREPEAT(7);
+const Option Option::KEYTOKEY_BEFORE_KEYDOWN(8);
+const Option Option::KEYTOKEY_AFTER_KEYUP(9);
+const Option Option::KEYTOKEY_DELAYED_ACTION(10);
+const Option Option::KEYTOKEY_DELAYED_ACTION_CANCELED_BY(11);
+const Option Option::KEYTOKEY_DELAYED_ACTION_CANCELED_DEFAULT(12);
+const Option Option::KEYTOKEY_DELAYED_ACTION_MILLISECONDS(13);
+const Option Option::KEYTOKEY_INCREASE_MODIFIER_FLAGS(14);
+const Option Option::POINTINGRELATIVETOSCROLL_TOFLAGS(15);
+const Option Option::POINTINGRELATIVETOSCROLL_TOKEYS(16);
+const Option Option::DROPALLKEYS_DROP_KEY(17);
+const Option Option::DROPALLKEYS_DROP_CONSUMERKEY(18);
+const Option Option::DROPALLKEYS_DROP_POINTINGBUTTON(19);
+const Option Option::DROPSCROLLWHEEL_DROP_HORIZONTAL_SCROLL(20);
+const Option Option::DROPSCROLLWHEEL_DROP_MOMENTUM_SCROLL(21);
+const Option Option::FLIPPOINTINGRELATIVE_HORIZONTAL(22);
+const Option Option::FLIPPOINTINGRELATIVE_VERTICAL(23);
+const Option Option::FLIPSCROLLWHEEL_HORIZONTAL(24);
+const Option Option::FLIPSCROLLWHEEL_VERTICAL(25);
+const Option Option::FLIPSCROLLWHEEL_ROTATE(26);
+const Option Option::UNINTERRUPTIBLE_BY_SCROLL_WHEEL(27);
+const Option Option::UNINTERRUPTIBLE_BY_MODIFIER(28);
+const Option Option::UNINTERRUPTIBLE_BY_POINTING_BUTTON(29);
+const Option Option::HOLD_ON_OTHER_KEY_PRESS(30);
+const Option Option::PERMISSIVE_HOLD(31);
+const Option Option::ADAPTIVE_HOLDING_THRESHOLD(32);
+const Option Option::FORCENUMLOCKON_FORCE_OFF(33);
+const Option Option::USE_SEPARATOR(34);
+const Option Option::SEPARATOR(35);
+const Option Option::VK__AUTOINDEX__BEGIN__(36);
+const PointingButton PointingButton::NONE(0x00000000);
+const PointingButton PointingButton::RIGHT(0x00000001);
+const PointingButton PointingButton::MIDDLE(0x00000002);
+const PointingButton PointingButton::LEFT(0x00000004);
+const PointingButton PointingButton::BUTTON4(0x00000008);
+const PointingButton PointingButton::BUTTON5(0x00000010);
+const PointingButton PointingButton::BUTTON6(0x00000020);
+const PointingButton PointingButton::BUTTON7(0x00000040);
+const PointingButton PointingButton::BUTTON8(0x00000080);
+const PointingButton PointingButton::BUTTON9(0x00000100);
+const PointingButton PointingButton::BUTTON10(0x00000200);
+const PointingButton PointingButton::BUTTON11(0x00000400);
+const PointingButton PointingButton::BUTTON12(0x00000800);
+const PointingButton PointingButton::BUTTON13(0x00001000);
+const PointingButton PointingButton::BUTTON14(0x00002000);
+const PointingButton PointingButton::BUTTON15(0x00004000);
+const PointingButton PointingButton::BUTTON16(0x00008000);
+const PointingButton PointingButton::BUTTON17(0x00010000);
+const PointingButton PointingButton::BUTTON18(0x00020000);
+const PointingButton PointingButton::BUTTON19(0x00040000);
+const PointingButton PointingButton::BUTTON20(0x00080000);
+const PointingButton PointingButton::BUTTON21(0x00100000);
+const PointingButton PointingButton::BUTTON22(0x00200000);
+const PointingButton PointingButton::BUTTON23(0x00400000);
+const PointingButton PointingButton::BUTTON24(0x00800000);
+const PointingButton PointingButton::BUTTON25(0x01000000);
+const PointingButton PointingButton::BUTTON26(0x02000000);
+const PointingButton PointingButton::BUTTON27(0x04000000);
+const PointingButton PointingButton::BUTTON28(0x08000000);
+const PointingButton PointingButton::BUTTON29(0x10000000);
+const PointingButton PointingButton::BUTTON30(0x20000000);
+const PointingButton PointingButton::BUTTON31(0x40000000);
+const PointingButton PointingButton::BUTTON32(0x80000000);
+const PointingButton PointingButton::VK__AUTOINDEX__BEGIN__(0x80000001);
+const PointingRelative PointingRelative::NONE(1);
+const PointingRelative PointingRelative::UP(2);
+const PointingRelative PointingRelative::DOWN(3);
+const PointingRelative PointingRelative::LEFT(4);
+const PointingRelative PointingRelative::RIGHT(5);
+const PointingRelative PointingRelative::ANY(6);
+const PointingRelative PointingRelative::VK__AUTOINDEX__BEGIN__(7);
+const ScrollWheel ScrollWheel::NONE(1);
+const ScrollWheel ScrollWheel::UP(2);
+const ScrollWheel ScrollWheel::DOWN(3);
+const ScrollWheel ScrollWheel::LEFT(4);
+const ScrollWheel ScrollWheel::RIGHT(5);
+const ScrollWheel ScrollWheel::VK__AUTOINDEX__BEGIN__(6);
+const UIElementRole UIElementRole::UNKNOWN(0);
+const UIElementRole UIElementRole::VK__AUTOINDEX__BEGIN__(1);
+const WindowName WindowName::UNKNOWN(0);
+const WindowName WindowName::VK__AUTOINDEX__BEGIN__(1);
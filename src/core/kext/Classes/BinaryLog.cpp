@@ -0,0 +1,117 @@
+#include "diagnostic_macros.hpp"
+
+BEGIN_IOKIT_INCLUDE;
+#include <IOKit/IOLib.h>
+#include <stdarg.h>
+END_IOKIT_INCLUDE;
+
+#include "BinaryLog.hpp"
+#include "IOLogWrapper.hpp"
+#include "log_format.h"
+#include "strlcpy_utf8.hpp"
+
+namespace org_pqrs_Karabiner {
+BridgeLogEntry BinaryLog::ring_[BinaryLog::RING_SIZE];
+uint32_t BinaryLog::head_ = 0;
+uint32_t BinaryLog::tail_ = 0;
+
+void BinaryLog::initialize(void) {
+  head_ = 0;
+  tail_ = 0;
+}
+
+void BinaryLog::record(uint8_t level, uint32_t formatId, const char* format, ...) {
+  if (IOLogWrapper::suppressed()) return;
+
+  BridgeLogEntry& entry = ring_[head_ & (RING_SIZE - 1)];
+
+  // Store the absolute time here and convert it into nanoseconds in drain.
+  clock_get_uptime(&(entry.timestamp));
+  entry.formatId = formatId;
+  entry.sequence = head_;
+  entry.level = level;
+  entry.argc = 0;
+  entry.strings[0] = '\0';
+  entry.strings[BRIDGE_LOG_STRINGS_SIZE - 1] = '\0';
+
+  size_t stringsLength = 0;
+
+  va_list ap;
+  va_start(ap, format);
+
+  const char* p = format;
+  int type = PQRS_LOG_FORMAT_ARGUMENT_NONE;
+  while (entry.argc < BRIDGE_LOG_ARGUMENT_MAX &&
+         (p = pqrs_log_format_next_conversion(p, nullptr, &type)) != nullptr) {
+    uint64_t& argument = entry.arguments[entry.argc];
+
+    switch (type) {
+      case PQRS_LOG_FORMAT_ARGUMENT_INT:
+        argument = static_cast<uint64_t>(static_cast<int64_t>(va_arg(ap, int)));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_LONG:
+        argument = static_cast<uint64_t>(static_cast<int64_t>(va_arg(ap, long)));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_LONG_LONG:
+        argument = static_cast<uint64_t>(va_arg(ap, long long));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_POINTER:
+        argument = reinterpret_cast<uintptr_t>(va_arg(ap, void*));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_STRING: {
+        const char* string = va_arg(ap, const char*);
+        if (stringsLength < BRIDGE_LOG_STRINGS_SIZE - 1) {
+          argument = stringsLength;
+          pqrs::strlcpy_utf8::strlcpy(entry.strings + stringsLength,
+                                      string ? string : "(null)",
+                                      BRIDGE_LOG_STRINGS_SIZE - stringsLength);
+          stringsLength += strlen(entry.strings + stringsLength) + 1;
+        } else {
+          // Point the last NUL if strings is full.
+          argument = BRIDGE_LOG_STRINGS_SIZE - 1;
+        }
+        break;
+      }
+    }
+
+    ++(entry.argc);
+  }
+
+  va_end(ap);
+
+  ++head_;
+}
+
+bool BinaryLog::drain(uint8_t* buffer, size_t size) {
+  if (!buffer || size < sizeof(BridgeLogHeader)) {
+    IOLOG_ERROR("BinaryLog::drain too small buffer\n");
+    return false;
+  }
+
+  BridgeLogHeader* header = reinterpret_cast<BridgeLogHeader*>(buffer);
+  BridgeLogEntry* entries = reinterpret_cast<BridgeLogEntry*>(buffer + sizeof(BridgeLogHeader));
+  size_t capacity = (size - sizeof(BridgeLogHeader)) / sizeof(BridgeLogEntry);
+
+  // Skip overwritten entries.
+  header->lost = 0;
+  if (head_ - tail_ > RING_SIZE) {
+    header->lost = head_ - tail_ - RING_SIZE;
+    tail_ = head_ - RING_SIZE;
+  }
+
+  header->count = 0;
+  while (tail_ != head_ && header->count < capacity) {
+    BridgeLogEntry& entry = entries[header->count];
+    entry = ring_[tail_ & (RING_SIZE - 1)];
+
+    uint64_t nanoseconds = 0;
+    absolutetime_to_nanoseconds(entry.timestamp, &nanoseconds);
+    entry.timestamp = nanoseconds;
+
+    ++(header->count);
+    ++tail_;
+  }
+
+  return true;
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "bridge.h"
+
+namespace org_pqrs_Karabiner {
+// BinaryLog records IOLOG_DEBUG, IOLOG_DEBUG_POINTING and IOLOG_DEVEL into a fixed size ring.
+// The ring is read by BRIDGE_USERCLIENT_TYPE_GET_LOG.
+//
+// An entry is a format id and raw arguments. The format is not expanded in the kext.
+// Log readers format entries with the format table which is generated by src/bridge/generator/log_format.
+//
+// All methods must be called while GlobalLock is held.
+class BinaryLog final {
+public:
+  static void initialize(void);
+
+  // FNV-1a hash of format.
+  // make-code.rb in src/bridge/generator/log_format calculates the same value.
+  static constexpr uint32_t formatId(const char* format, uint32_t hash = 2166136261u) {
+    return *format ? formatId(format + 1, (hash ^ static_cast<uint8_t>(*format)) * 16777619u) : hash;
+  }
+
+  // Use IOLOG_* macros instead of calling record directly.
+  static void record(uint8_t level, uint32_t formatId, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+  // Move entries from the ring into buffer. (buffer is BridgeLogHeader followed by BridgeLogEntry array.)
+  // Return false if size is too small.
+  static bool drain(uint8_t* buffer, size_t size);
+
+private:
+  enum {
+    // The number of entries must be a power of 2.
+    RING_SIZE = 512,
+  };
+
+  static BridgeLogEntry ring_[RING_SIZE];
+  // The number of recorded entries. (entries are stored at ring_[head_ & (RING_SIZE - 1)].)
+  static uint32_t head_;
+  // The number of read entries.
+  static uint32_t tail_;
+};
+}
@@ -5,12 +5,14 @@
 
 namespace org_pqrs_Karabiner {
 AbsoluteTime CommonData::current_ts_;
+uint64_t CommonData::current_inputts_ = 0;
 KeyboardType CommonData::current_keyboardType_;
 DeviceIdentifier CommonData::current_deviceIdentifier_;
 Vector_WorkspaceAppId CommonData::current_workspaceAppIds_;
 Vector_WorkspaceInputSourceId CommonData::current_workspaceInputSourceIds_;
 WorkspaceUIElementRoleId CommonData::current_workspaceUIElementRoleId_;
 Vector_WorkspaceWindowNameId CommonData::current_workspaceWindowNameIds_;
+uint32_t CommonData::current_workspaceEpoch_ = 0;
 
 LastPressedPhysicalKey CommonData::current_lastpressedphysicalkey_;
 LastReleasedPhysicalKey CommonData::current_lastreleasedphysicalkey_;
@@ -32,6 +34,7 @@ void CommonData::setcurrent_workspaceIds(const uint32_t* ids, size_t count) {
   current_workspaceWindowNameIds_.clear();
   current_workspaceUIElementRoleId_ = WorkspaceUIElementRoleId(0);
   current_workspaceInputSourceIds_.clear();
+  ++current_workspaceEpoch_;
 
   for (int i = 0; i < static_cast<int>(count) - 1; i += 2) {
     uint32_t type = ids[i];
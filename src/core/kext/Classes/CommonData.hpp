@@ -19,6 +19,11 @@ public:
   static void setcurrent_ts(const AbsoluteTime& ts) { current_ts_ = ts; }
   static const AbsoluteTime& getcurrent_ts(void) { return current_ts_; }
 
+  // The HID timestamp of the input event which produced the output event being sent.
+  // (0 if no output event is being sent or the output event is produced by a timer.)
+  static void setcurrent_inputts(uint64_t inputts) { current_inputts_ = inputts; }
+  static uint64_t getcurrent_inputts(void) { return current_inputts_; }
+
   static void setcurrent_keyboardType(KeyboardType keyboardType) { current_keyboardType_ = keyboardType; }
   static KeyboardType getcurrent_keyboardType(void) { return current_keyboardType_; }
 
@@ -32,6 +37,8 @@ public:
   static const Vector_WorkspaceWindowNameId& getcurrent_workspaceWindowNameIds(void) { return current_workspaceWindowNameIds_; }
   static const WorkspaceUIElementRoleId getcurrent_workspaceUIElementRoleId(void) { return current_workspaceUIElementRoleId_; }
   static const Vector_WorkspaceInputSourceId& getcurrent_workspaceInputSourceIds(void) { return current_workspaceInputSourceIds_; }
+  // This value is incremented whenever workspace ids are changed.
+  static uint32_t getcurrent_workspaceEpoch(void) { return current_workspaceEpoch_; }
 
   static void setcurrent_lastpressedphysicalkey(const Params_Base& newval) {
     current_lastpressedphysicalkey_.update(newval);
@@ -79,12 +86,14 @@ public:
 
 private:
   static AbsoluteTime current_ts_;
+  static uint64_t current_inputts_;
   static KeyboardType current_keyboardType_;
   static DeviceIdentifier current_deviceIdentifier_;
   static Vector_WorkspaceAppId current_workspaceAppIds_;
   static Vector_WorkspaceInputSourceId current_workspaceInputSourceIds_;
   static WorkspaceUIElementRoleId current_workspaceUIElementRoleId_;
   static Vector_WorkspaceWindowNameId current_workspaceWindowNameIds_;
+  static uint32_t current_workspaceEpoch_;
   static LastPressedPhysicalKey current_lastpressedphysicalkey_;
   static LastReleasedPhysicalKey current_lastreleasedphysicalkey_;
   static LastSentEvent current_lastsentevent_;
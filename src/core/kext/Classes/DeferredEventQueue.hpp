@@ -0,0 +1,125 @@
+#pragma once
+
+#include "diagnostic_macros.hpp"
+
+BEGIN_IOKIT_INCLUDE;
+#include <IOKit/IOLib.h>
+END_IOKIT_INCLUDE;
+
+namespace org_pqrs_Karabiner {
+// DeferredEventQueue is a bounded queue of raw HID events which are not processed yet.
+//
+// Each hooked device has a DeferredEventQueue.
+// The event callback of the device (EventInputQueue::push_*) only copies raw arguments into a record,
+// and EventInputQueue::drainDeferredEvents processes records in EventInputQueue::fire_timer_callback.
+// The event callback drops the event if the queue is full. (It never processes records.)
+//
+// All methods must be called while GlobalLock is held.
+class DeferredEventQueue final {
+public:
+  class Record final {
+  public:
+    enum class Type {
+      KEYBOARD,
+      KEYBOARD_SPECIAL,
+      RELATIVE_POINTER,
+      SCROLL_WHEEL,
+    };
+
+    class Keyboard final {
+    public:
+      unsigned int eventType;
+      unsigned int flags;
+      unsigned int key;
+      unsigned int charCode;
+      unsigned int charSet;
+      unsigned int origCharCode;
+      unsigned int origCharSet;
+      unsigned int keyboardType;
+      bool repeat;
+    };
+
+    class KeyboardSpecial final {
+    public:
+      unsigned int eventType;
+      unsigned int flags;
+      unsigned int key;
+      unsigned int flavor;
+      UInt64 guid;
+      bool repeat;
+    };
+
+    class RelativePointer final {
+    public:
+      int buttons;
+      int dx;
+      int dy;
+    };
+
+    class ScrollWheel final {
+    public:
+      short deltaAxis1;
+      short deltaAxis2;
+      short deltaAxis3;
+      IOFixed fixedDelta1;
+      IOFixed fixedDelta2;
+      IOFixed fixedDelta3;
+      SInt32 pointDelta1;
+      SInt32 pointDelta2;
+      SInt32 pointDelta3;
+      SInt32 options;
+    };
+
+    Type type;
+    // Records of all devices are processed in the order of sequence.
+    uint32_t sequence;
+    AbsoluteTime ts;
+
+    union {
+      Keyboard keyboard;
+      KeyboardSpecial keyboardSpecial;
+      RelativePointer relativePointer;
+      ScrollWheel scrollWheel;
+    };
+  };
+
+  DeferredEventQueue(void) : head_(0), tail_(0) {}
+
+  bool empty(void) const { return head_ == tail_; }
+  bool full(void) const { return head_ - tail_ >= SIZE; }
+  uint32_t size(void) const { return head_ - tail_; }
+
+  // ----------------------------------------
+  // Event callbacks
+
+  // Return the record to be written. (nullptr if the queue is full.)
+  Record* back(void) {
+    if (full()) return nullptr;
+    return &(records_[head_ & (SIZE - 1)]);
+  }
+  void push_back(void) { ++head_; }
+
+  // ----------------------------------------
+  // drainDeferredEvents
+
+  // Return the oldest record. (nullptr if the queue is empty.)
+  const Record* front(void) const {
+    if (empty()) return nullptr;
+    return &(records_[tail_ & (SIZE - 1)]);
+  }
+  void pop_front(void) { ++tail_; }
+
+private:
+  enum {
+    // The number of records must be a power of 2.
+    SIZE = 64,
+  };
+
+  DeferredEventQueue(const DeferredEventQueue& rhs);            // Prevent copy-construction
+  DeferredEventQueue& operator=(const DeferredEventQueue& rhs); // Prevent assignment
+
+  Record records_[SIZE];
+  uint32_t head_;
+  uint32_t tail_;
+};
+}
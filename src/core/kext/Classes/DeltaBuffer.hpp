@@ -3,6 +3,9 @@
 namespace org_pqrs_Karabiner {
 // DeltaBuffer stores dx and dy of RelativePointerEvent in the short term
 // in order to calculate an average of pointer movement.
+//
+// The values are stored in a ring buffer and the sum is updated at push.
+// (push and sum do not depend on BUFFER_LENGTH.)
 
 class DeltaBuffer final {
 public:
@@ -14,8 +17,10 @@ public:
     for (int i = 0; i < BUFFER_LENGTH; ++i) {
       buffer_[i] = 0;
     }
+    head_ = 0;
     count_ = 0;
     sign_ = 0;
+    sum_ = 0;
   }
 
   void push(int newval) {
@@ -26,10 +31,14 @@ public:
       clear();
     }
 
-    for (int i = 0; i < BUFFER_LENGTH - 1; ++i) {
-      buffer_[i] = buffer_[i + 1];
+    // Replace the oldest value.
+    sum_ += newval - buffer_[head_];
+    buffer_[head_] = newval;
+
+    ++head_;
+    if (head_ >= BUFFER_LENGTH) {
+      head_ = 0;
     }
-    buffer_[BUFFER_LENGTH - 1] = newval;
 
     if (count_ < BUFFER_LENGTH) {
       ++count_;
@@ -48,11 +57,7 @@ public:
   }
 
   int sum(void) const {
-    int s = 0;
-    for (int i = 0; i < BUFFER_LENGTH; ++i) {
-      s += buffer_[i];
-    }
-    return s;
+    return sum_;
   }
 
 private:
@@ -61,7 +66,10 @@ private:
   };
 
   int buffer_[BUFFER_LENGTH];
+  // The index of the oldest value.
+  size_t head_;
   size_t count_;
   int sign_;
+  int sum_;
 };
 }
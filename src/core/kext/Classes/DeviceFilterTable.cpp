@@ -0,0 +1,176 @@
+#include "DeviceFilterTable.hpp"
+
+namespace org_pqrs_Karabiner {
+Vector_DeviceIdentifier DeviceFilterTable::targets_;
+DeviceFilterTable::Vector_Range DeviceFilterTable::ranges_;
+DeviceFilterTable::Vector_uint32_t DeviceFilterTable::freeIds_;
+size_t DeviceFilterTable::unusedTargetCount_ = 0;
+Vector_DeviceIdentifier DeviceFilterTable::devices_;
+DeviceFilterTable::Vector_uint32_t DeviceFilterTable::deviceBits_;
+DeviceFilterTable::Vector_uint32_t DeviceFilterTable::existsBits_;
+bool DeviceFilterTable::dirty_ = false;
+DeviceIdentifier DeviceFilterTable::current_;
+bool DeviceFilterTable::currentResolved_ = false;
+const DeviceFilterTable::Vector_uint32_t* DeviceFilterTable::currentBitsSource_ = nullptr;
+size_t DeviceFilterTable::currentOffset_ = 0;
+DeviceFilterTable::Vector_uint32_t DeviceFilterTable::currentBits_;
+
+uint32_t DeviceFilterTable::registerTargets(const Vector_DeviceIdentifier& targets) {
+  size_t begin = targets_.size();
+  for (size_t i = 0; i < targets.size(); ++i) {
+    targets_.push_back(targets[i]);
+  }
+
+  uint32_t id = 0;
+  if (freeIds_.empty()) {
+    ranges_.push_back(Range(begin, targets_.size()));
+    id = static_cast<uint32_t>(ranges_.size() - 1);
+  } else {
+    id = freeIds_.back();
+    freeIds_.pop_back();
+    ranges_[id] = Range(begin, targets_.size());
+  }
+
+  dirty_ = true;
+  return id;
+}
+
+void DeviceFilterTable::unregisterTargets(uint32_t id) {
+  // Ids are already released if clearTargets is called before filters are deleted.
+  if (id >= ranges_.size()) return;
+
+  Range& r = ranges_[id];
+  unusedTargetCount_ += r.end - r.begin;
+  r = Range();
+  freeIds_.push_back(id);
+
+  // Keep targets_ at most twice as large as the targets of registered ids.
+  if (unusedTargetCount_ * 2 > targets_.size()) {
+    compactTargets();
+  }
+
+  dirty_ = true;
+}
+
+void DeviceFilterTable::clearTargets(void) {
+  targets_.clear();
+  ranges_.clear();
+  freeIds_.clear();
+  unusedTargetCount_ = 0;
+  dirty_ = true;
+}
+
+void DeviceFilterTable::compactTargets(void) {
+  Vector_DeviceIdentifier targets;
+  targets.reserve(targets_.size() - unusedTargetCount_);
+
+  for (size_t id = 0; id < ranges_.size(); ++id) {
+    Range& r = ranges_[id];
+    size_t begin = targets.size();
+    for (size_t i = r.begin; i < r.end; ++i) {
+      targets.push_back(targets_[i]);
+    }
+    r = Range(begin, targets.size());
+  }
+
+  targets_ = targets;
+  unusedTargetCount_ = 0;
+}
+
+void DeviceFilterTable::clearDevices(void) {
+  devices_.clear();
+  dirty_ = true;
+}
+
+void DeviceFilterTable::addDevice(const DeviceIdentifier& deviceIdentifier) {
+  devices_.push_back(deviceIdentifier);
+  dirty_ = true;
+}
+
+void DeviceFilterTable::setCurrentDevice(const DeviceIdentifier& deviceIdentifier) {
+  current_ = deviceIdentifier;
+  currentResolved_ = false;
+}
+
+bool DeviceFilterTable::isCurrentDeviceMatched(uint32_t id) {
+  if (id >= ranges_.size()) return false;
+
+  update();
+
+  if (!currentResolved_) {
+    currentBitsSource_ = nullptr;
+    currentOffset_ = 0;
+
+    size_t words = wordCount();
+    for (size_t i = 0; i < devices_.size(); ++i) {
+      if (isSame(devices_[i], current_)) {
+        currentBitsSource_ = &deviceBits_;
+        currentOffset_ = i * words;
+        break;
+      }
+    }
+
+    if (!currentBitsSource_) {
+      currentBits_.clear();
+      resolve(current_, currentBits_);
+      currentBitsSource_ = &currentBits_;
+    }
+
+    currentResolved_ = true;
+  }
+
+  return test(*currentBitsSource_, currentOffset_, id);
+}
+
+bool DeviceFilterTable::exists(uint32_t id) {
+  if (id >= ranges_.size()) return false;
+
+  update();
+
+  return test(existsBits_, 0, id);
+}
+
+void DeviceFilterTable::resolve(const DeviceIdentifier& deviceIdentifier, Vector_uint32_t& bits) {
+  size_t offset = bits.size();
+  size_t words = wordCount();
+  bits.reserve(offset + words);
+  for (size_t i = 0; i < words; ++i) {
+    bits.push_back(0);
+  }
+
+  for (size_t id = 0; id < ranges_.size(); ++id) {
+    const Range& r = ranges_[id];
+    for (size_t i = r.begin; i < r.end; ++i) {
+      if (deviceIdentifier.isEqual(targets_[i])) {
+        bits[offset + id / BITS_PER_WORD] |= (1u << (id % BITS_PER_WORD));
+        break;
+      }
+    }
+  }
+}
+
+void DeviceFilterTable::update(void) {
+  if (!dirty_) return;
+
+  size_t words = wordCount();
+
+  deviceBits_.clear();
+  deviceBits_.reserve(devices_.size() * words);
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    resolve(devices_[i], deviceBits_);
+  }
+
+  existsBits_.clear();
+  existsBits_.reserve(words);
+  for (size_t w = 0; w < words; ++w) {
+    uint32_t v = 0;
+    for (size_t i = 0; i < devices_.size(); ++i) {
+      v |= deviceBits_[i * words + w];
+    }
+    existsBits_.push_back(v);
+  }
+
+  dirty_ = false;
+  currentResolved_ = false;
+}
+}
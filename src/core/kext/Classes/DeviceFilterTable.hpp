@@ -0,0 +1,98 @@
+#pragma once
+
+#include "KeyCode.hpp"
+#include "Vector.hpp"
+
+namespace org_pqrs_Karabiner {
+// DeviceFilterTable resolves DeviceIdentifiers against the targets of
+// <device_only>, <device_not>, <deviceexists_only> and <deviceexists_not>.
+//
+// Each DeviceFilter and DeviceExistsFilter registers its targets and gets an id.
+// The id is released when the filter is deleted, and it is reused by the next filter.
+// Hooked devices are resolved into bitsets of matched ids after devices or filters are changed.
+// Then filters test one bit instead of comparing DeviceIdentifiers for each event.
+class DeviceFilterTable final {
+public:
+  // Return the id of `targets`.
+  // (An id is matched if DeviceIdentifier::isEqual(target) is true for any target.)
+  static uint32_t registerTargets(const Vector_DeviceIdentifier& targets);
+  // Release the id of a deleted filter. (The id does not match any device after that.)
+  static void unregisterTargets(uint32_t id);
+  // Call when all filters are removed. (RemapClassManager)
+  static void clearTargets(void);
+
+  // The number of ids including released ones. (for tests)
+  static size_t idCount(void) { return ranges_.size(); }
+  // The number of stored targets including ones of released ids. (for tests)
+  static size_t targetCount(void) { return targets_.size(); }
+
+  // Call clearDevices and addDevice for all hooked devices when devices are connected or disconnected.
+  static void clearDevices(void);
+  static void addDevice(const DeviceIdentifier& deviceIdentifier);
+
+  // Set the device of the current event. (EventInputQueue)
+  static void setCurrentDevice(const DeviceIdentifier& deviceIdentifier);
+  // Return true if the device of the current event matches targets of `id`.
+  static bool isCurrentDeviceMatched(uint32_t id);
+  // Return true if a hooked device matches targets of `id`.
+  static bool exists(uint32_t id);
+
+private:
+  enum {
+    BITS_PER_WORD = 32,
+  };
+
+  class Range final {
+  public:
+    Range(void) : begin(0), end(0) {}
+    Range(size_t b, size_t e) : begin(b), end(e) {}
+
+    // [begin, end) in targets_
+    size_t begin;
+    size_t end;
+  };
+  DECLARE_VECTOR(Range);
+  DECLARE_VECTOR(uint32_t);
+
+  static size_t wordCount(void) { return (ranges_.size() + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+  static bool test(const Vector_uint32_t& bits, size_t offset, uint32_t id) {
+    return (bits[offset + id / BITS_PER_WORD] & (1u << (id % BITS_PER_WORD))) != 0;
+  }
+
+  static bool isSame(const DeviceIdentifier& a, const DeviceIdentifier& b) {
+    return a.getVendor() == b.getVendor() &&
+           a.getProduct() == b.getProduct() &&
+           a.getLocation() == b.getLocation();
+  }
+
+  // Append the bitset of `deviceIdentifier` to `bits`.
+  static void resolve(const DeviceIdentifier& deviceIdentifier, Vector_uint32_t& bits);
+  // Rebuild deviceBits_ and existsBits_ if devices or filters are changed.
+  static void update(void);
+  // Remove targets of released ids from targets_.
+  static void compactTargets(void);
+
+  static Vector_DeviceIdentifier targets_;
+  static Vector_Range ranges_;
+  // Released ids. (Their ranges are empty.)
+  static Vector_uint32_t freeIds_;
+  // The number of targets of released ids in targets_.
+  static size_t unusedTargetCount_;
+
+  static Vector_DeviceIdentifier devices_;
+  // The bitsets of devices_. (wordCount() words for each device.)
+  static Vector_uint32_t deviceBits_;
+  // The union of deviceBits_.
+  static Vector_uint32_t existsBits_;
+  static bool dirty_;
+
+  static DeviceIdentifier current_;
+  // The bitset of the current device is currentBitsSource_[currentOffset_ ...].
+  // (valid only if currentResolved_)
+  static bool currentResolved_;
+  static const Vector_uint32_t* currentBitsSource_;
+  static size_t currentOffset_;
+  // The bitset of the current device if it is not in devices_. (eg. a disconnected device)
+  static Vector_uint32_t currentBits_;
+};
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "IOLogWrapper.hpp"
+#include "KeyCode.hpp"
+#include "List.hpp"
+#include "Vector.hpp"
+
+namespace org_pqrs_Karabiner {
+// Hash tables for ListHookedDevice.
+//
+// get(device) and exists(deviceIdentifier) are called in the event path.
+// We use open addressing tables to avoid walking all devices in these methods.
+//
+// The tables are rebuilt when a device is connected or disconnected.
+// (call clear, reserve and add for all devices.)
+class DeviceIndex final {
+public:
+  DeviceIndex(void) : size_(0) {}
+
+  void clear(void) {
+    devices_.clear();
+    deviceIdentifiers_.clear();
+    size_ = 0;
+  }
+
+  // Prepare tables for `count` devices.
+  void reserve(size_t count) {
+    clear();
+
+    // Keep the load factor less than 0.5.
+    // (Each device is registered to deviceIdentifiers_ up to 4 times.)
+    fill(devices_, tableSize(count * 2));
+    fill(deviceIdentifiers_, tableSize(count * 8));
+  }
+
+  // We must call reserve before add.
+  void add(const void* device, List::Item* item, const DeviceIdentifier& deviceIdentifier) {
+    if (size_ * 2 >= devices_.size()) {
+      IOLOG_ERROR("DeviceIndex::add too many devices. (size_:%d)\n", static_cast<int>(size_));
+      return;
+    }
+    ++size_;
+
+    // ----------------------------------------
+    // devices_
+    {
+      size_t mask = devices_.size() - 1;
+      for (size_t i = hash(device) & mask;; i = (i + 1) & mask) {
+        DeviceEntry& e = devices_[i];
+        if (!e.item) {
+          e.device = device;
+          e.item = item;
+          break;
+        }
+        // The first item takes priority.
+        if (e.device == device) break;
+      }
+    }
+
+    // ----------------------------------------
+    // deviceIdentifiers_
+    //
+    // DeviceIdentifier::isEqual treats DeviceProduct::ANY and DeviceLocation::ANY as wildcard.
+    // We register all combinations in order to lookup a wildcard identifier by one probe sequence.
+    {
+      auto v = deviceIdentifier.getVendor();
+      auto p = deviceIdentifier.getProduct();
+      auto l = deviceIdentifier.getLocation();
+      addDeviceIdentifier(DeviceIdentifier(v, p, l));
+      addDeviceIdentifier(DeviceIdentifier(v, p, DeviceLocation::ANY));
+      addDeviceIdentifier(DeviceIdentifier(v, DeviceProduct::ANY, l));
+      addDeviceIdentifier(DeviceIdentifier(v, DeviceProduct::ANY, DeviceLocation::ANY));
+    }
+  }
+
+  List::Item* get(const void* device) const {
+    size_t size = devices_.size();
+    if (size == 0) return nullptr;
+
+    size_t mask = size - 1;
+    for (size_t i = hash(device) & mask;; i = (i + 1) & mask) {
+      const DeviceEntry& e = devices_[i];
+      if (!e.item) return nullptr;
+      if (e.device == device) return e.item;
+    }
+  }
+
+  bool exists(const DeviceIdentifier& deviceIdentifier) const {
+    size_t size = deviceIdentifiers_.size();
+    if (size == 0) return false;
+
+    size_t mask = size - 1;
+    for (size_t i = hash(deviceIdentifier) & mask;; i = (i + 1) & mask) {
+      const DeviceIdentifierEntry& e = deviceIdentifiers_[i];
+      if (!e.used) return false;
+      if (isSame(e.deviceIdentifier, deviceIdentifier)) return true;
+    }
+  }
+
+  size_t size(void) const { return size_; }
+
+private:
+  class DeviceEntry final {
+  public:
+    DeviceEntry(void) : device(nullptr), item(nullptr) {}
+
+    const void* device;
+    List::Item* item;
+  };
+  DECLARE_VECTOR(DeviceEntry);
+
+  class DeviceIdentifierEntry final {
+  public:
+    DeviceIdentifierEntry(void) : used(false) {}
+
+    bool used;
+    DeviceIdentifier deviceIdentifier;
+  };
+  DECLARE_VECTOR(DeviceIdentifierEntry);
+
+  static size_t tableSize(size_t n) {
+    size_t size = 16;
+    while (size < n) {
+      size *= 2;
+    }
+    return size;
+  }
+
+  static void fill(Vector_DeviceEntry& v, size_t size) {
+    v.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      v.push_back(DeviceEntry());
+    }
+  }
+
+  static void fill(Vector_DeviceIdentifierEntry& v, size_t size) {
+    v.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      v.push_back(DeviceIdentifierEntry());
+    }
+  }
+
+  static uint32_t hash(const void* device) {
+    uint64_t v = reinterpret_cast<uintptr_t>(device);
+    // Ignore low bits because IOHIDevice is aligned.
+    return static_cast<uint32_t>((v >> 4) ^ (v >> 32)) * 2654435761u;
+  }
+
+  static uint32_t hash(const DeviceIdentifier& deviceIdentifier) {
+    return (deviceIdentifier.getVendor().get() * 2654435761u) ^
+           (deviceIdentifier.getProduct().get() * 40503u) ^
+           (deviceIdentifier.getLocation().get() * 2246822519u);
+  }
+
+  static bool isSame(const DeviceIdentifier& a, const DeviceIdentifier& b) {
+    return a.getVendor() == b.getVendor() &&
+           a.getProduct() == b.getProduct() &&
+           a.getLocation() == b.getLocation();
+  }
+
+  void addDeviceIdentifier(const DeviceIdentifier& deviceIdentifier) {
+    size_t mask = deviceIdentifiers_.size() - 1;
+    for (size_t i = hash(deviceIdentifier) & mask;; i = (i + 1) & mask) {
+      DeviceIdentifierEntry& e = deviceIdentifiers_[i];
+      if (!e.used) {
+        e.used = true;
+        e.deviceIdentifier = deviceIdentifier;
+        return;
+      }
+      if (isSame(e.deviceIdentifier, deviceIdentifier)) return;
+    }
+  }
+
+  Vector_DeviceEntry devices_;
+  Vector_DeviceIdentifierEntry deviceIdentifiers_;
+  size_t size_;
+};
+}
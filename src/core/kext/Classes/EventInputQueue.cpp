@@ -3,6 +3,8 @@
 #include "CommonData.hpp"
 #include "Config.hpp"
 #include "Core.hpp"
+#include "DeviceFilterTable.hpp"
+#include "EventTrace.hpp"
 #include "EventWatcher.hpp"
 #include "FlagStatus.hpp"
 #include "GlobalLock.hpp"
@@ -21,7 +23,11 @@ namespace org_pqrs_Karabiner {
 List EventInputQueue::queue_;
 IntervalChecker EventInputQueue::ic_;
 TimerWrapper EventInputQueue::fire_timer_;
+uint32_t EventInputQueue::deferredSequence_ = 0;
+uint32_t EventInputQueue::droppedDeferredEventCount_ = 0;
+uint32_t EventInputQueue::reportedDroppedDeferredEventCount_ = 0;
 EventInputQueue::SerialNumber EventInputQueue::serialNumber_;
+uint64_t EventInputQueue::currentTimestamp_ = 0;
 
 List EventInputQueue::BlockUntilKeyUpHandler::blockedQueue_;
 List EventInputQueue::BlockUntilKeyUpHandler::pressingEvents_;
@@ -30,6 +36,9 @@ TimerWrapper EventInputQueue::BlockUntilKeyUpHandler::blockingTimeOut_timer_;
 void EventInputQueue::initialize(IOWorkLoop& workloop) {
   ic_.begin();
   fire_timer_.initialize(&workloop, nullptr, EventInputQueue::fire_timer_callback);
+  deferredSequence_ = 0;
+  droppedDeferredEventCount_ = 0;
+  reportedDroppedDeferredEventCount_ = 0;
   serialNumber_.reset();
 
   BlockUntilKeyUpHandler::initialize(workloop);
@@ -47,12 +56,29 @@ void EventInputQueue::enqueue_(const Params_Base& paramsBase,
                                bool retainFlagStatusTemporaryCount,
                                const DeviceIdentifier& deviceIdentifier,
                                const ListHookedDevice::WeakPointer_Item& device,
+                               uint64_t timestamp,
                                bool push_back,
                                bool isSimultaneousKeyPressesTarget) {
   // Because we handle the key repeat ourself, drop the key repeat.
-  if (paramsBase.isRepeat()) return;
+  if (paramsBase.isRepeat()) {
+    EventTrace::record(BRIDGE_TRACE_TAG_INPUT_DROP, paramsBase, deviceIdentifier, timestamp);
+    return;
+  }
 
-  Item* item = new Item(paramsBase, retainFlagStatusTemporaryCount, deviceIdentifier, device);
+  // Merge consecutive cursor move events in order to reduce remapping of high polling rate mice.
+  // Button, scroll wheel and key events are not merged and they separate cursor move events.
+  if (push_back) {
+    auto params = paramsBase.get_Params_RelativePointerEventCallback();
+    if (params) {
+      Item* back = static_cast<Item*>(queue_.safe_back());
+      if (back && back->coalesce(*params, device)) {
+        EventTrace::record(BRIDGE_TRACE_TAG_INPUT_PUSH, paramsBase, deviceIdentifier, timestamp);
+        return;
+      }
+    }
+  }
+
+  Item* item = new Item(paramsBase, retainFlagStatusTemporaryCount, deviceIdentifier, device, timestamp);
   if (item) {
     item->isSimultaneousKeyPressesTarget = isSimultaneousKeyPressesTarget;
     if (push_back) {
@@ -60,9 +86,38 @@ void EventInputQueue::enqueue_(const Params_Base& paramsBase,
     } else {
       queue_.push_front(item);
     }
+
+    EventTrace::record(BRIDGE_TRACE_TAG_INPUT_PUSH, paramsBase, deviceIdentifier, timestamp);
   }
 }
 
+bool EventInputQueue::Item::coalesce(const Params_RelativePointerEventCallback& params, const ListHookedDevice::WeakPointer_Item& device) {
+  if (!params.isMove()) return false;
+
+  auto current = getParamsBase().get_Params_RelativePointerEventCallback();
+  if (!current || !current->isMove()) return false;
+  if (current->buttons != params.buttons) return false;
+
+  if (enqueuedFrom != ENQUEUED_FROM_HARDWARE) return false;
+  if (deviceWeakPointer.expired() || !(deviceWeakPointer == device)) return false;
+
+  if (coalescedCount_ >= Config::get_coalesce_relative_pointer_max_events()) return false;
+  if (ic.getmillisec() >= Config::get_coalesce_relative_pointer_max_interval()) return false;
+
+  // Keep timestamp and ic of the first event in order to fire the item at the original time.
+  Params_RelativePointerEventCallback merged(current->buttons,
+                                             current->dx + params.dx,
+                                             current->dy + params.dy,
+                                             PointingButton::NONE, false);
+  const Params_Base* p = Params_Factory::copy(merged);
+  if (!p) return false;
+
+  delete p_;
+  p_ = p;
+  ++coalescedCount_;
+  return true;
+}
+
 namespace {
 unsigned int maxThreshold(unsigned int v1, unsigned int v2) {
   if (v1 > v2) {
@@ -73,11 +128,7 @@ unsigned int maxThreshold(unsigned int v1, unsigned int v2) {
 }
 }
 
-void EventInputQueue::setTimer(void) {
-  Item* front = static_cast<Item*>(queue_.safe_front());
-  if (!front) return;
-
-  // ----------------------------------------
+uint32_t EventInputQueue::calcTimeoutMS(Item* front) {
   uint32_t timeoutMS = 0;
 
   if (RemapClassManager::isSimultaneousKeyPressesEnabled() ||
@@ -102,7 +153,10 @@ void EventInputQueue::setTimer(void) {
       }
     }
 
-    if (RemapClassManager::isSimultaneousKeyPressesEnabled()) {
+    // We delay only events which are used in __SimultaneousKeyPresses__.
+    // Other events are fired immediately. (The order of events is kept because we fire events from the front of queue_.)
+    if (RemapClassManager::isSimultaneousKeyPressesEnabled() &&
+        RemapClassManager::getSimultaneousKeyPressesFromEvents().isTarget(paramsBase)) {
       if (is_key) {
         threshold = maxThreshold(threshold, Config::get_simultaneouskeypresses_delay());
       }
@@ -111,7 +165,11 @@ void EventInputQueue::setTimer(void) {
       }
     }
 
-    if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_ignore_bouncing_events)) {
+    // Bouncing events are removed as a pair of key up and the following key down.
+    // So we need to delay key up events only.
+    bool iskeydown = false;
+    if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_ignore_bouncing_events) &&
+        paramsBase.iskeydown(iskeydown) && !iskeydown) {
       if (is_key) {
         threshold = maxThreshold(threshold, Config::get_ignore_bouncing_threshold_for_keyboard());
       }
@@ -134,10 +192,39 @@ void EventInputQueue::setTimer(void) {
     }
   }
 
-  fire_timer_.setTimeoutMS(timeoutMS, false);
+  return timeoutMS;
+}
+
+void EventInputQueue::setTimer(void) {
+  Item* front = static_cast<Item*>(queue_.safe_front());
+  if (!front) return;
+
+  fire_timer_.setTimeoutMS(calcTimeoutMS(front), false);
 }
 
 // ======================================================================
+DeferredEventQueue::Record*
+EventInputQueue::backDeferredEvent(ListHookedDevice::Item& item) {
+  DeferredEventQueue::Record* record = item.getDeferredEventQueue().back();
+  if (!record) {
+    // Do not process records in the device callback.
+    // The event is dropped and fire_timer_callback reports it.
+    ++droppedDeferredEventCount_;
+  }
+  return record;
+}
+
+void EventInputQueue::pushDeferredEvent(ListHookedDevice::Item& item, DeferredEventQueue::Record& record) {
+  record.sequence = deferredSequence_;
+  ++deferredSequence_;
+
+  item.getDeferredEventQueue().push_back();
+
+  // Process the record in fire_timer_callback.
+  // (fire_timer_callback sets the timer again if the front item has to wait.)
+  fire_timer_.setTimeoutMS(0);
+}
+
 void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
                                                  unsigned int eventType,
                                                  unsigned int flags,
@@ -154,6 +241,38 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
   GlobalLock::ScopedLock lk;
   if (!lk) return;
 
+  IOHIKeyboard* device = OSDynamicCast(IOHIKeyboard, sender);
+  if (!device) return;
+
+  ListHookedKeyboard::Item* item = static_cast<ListHookedKeyboard::Item*>(ListHookedKeyboard::instance().get(device));
+  if (!item) return;
+
+  DeferredEventQueue::Record* record = backDeferredEvent(*item);
+  if (!record) return;
+
+  record->type = DeferredEventQueue::Record::Type::KEYBOARD;
+  record->ts = ts;
+  record->keyboard.eventType = eventType;
+  record->keyboard.flags = flags;
+  record->keyboard.key = key;
+  record->keyboard.charCode = charCode;
+  record->keyboard.charSet = charSet;
+  record->keyboard.origCharCode = origCharCode;
+  record->keyboard.origCharSet = origCharSet;
+  record->keyboard.keyboardType = keyboardType;
+  record->keyboard.repeat = repeat;
+
+  pushDeferredEvent(*item, *record);
+}
+
+void EventInputQueue::process_KeyboardEventCallback(ListHookedKeyboard::Item& item, const DeferredEventQueue::Record& record) {
+  unsigned int eventType = record.keyboard.eventType;
+  unsigned int flags = record.keyboard.flags;
+  unsigned int key = record.keyboard.key;
+  unsigned int keyboardType = record.keyboard.keyboardType;
+  bool repeat = record.keyboard.repeat;
+  AbsoluteTime ts = record.ts;
+
   Params_KeyboardEventCallBack::log(true, EventType(eventType), Flags(flags), KeyCode(key), KeyboardType(keyboardType), repeat);
 
   // ------------------------------------------------------------
@@ -187,20 +306,13 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
   Params_KeyboardEventCallBack params(EventType(eventType),
                                       newflags,
                                       newkey,
-                                      CharCode(charCode),
-                                      CharSet(charSet),
-                                      OrigCharCode(origCharCode),
-                                      OrigCharSet(origCharSet),
+                                      CharCode(record.keyboard.charCode),
+                                      CharSet(record.keyboard.charSet),
+                                      OrigCharCode(record.keyboard.origCharCode),
+                                      OrigCharSet(record.keyboard.origCharSet),
                                       newkeyboardtype,
                                       false);
 
-  // ------------------------------------------------------------
-  IOHIKeyboard* device = OSDynamicCast(IOHIKeyboard, sender);
-  if (!device) return;
-
-  ListHookedKeyboard::Item* item = static_cast<ListHookedKeyboard::Item*>(ListHookedKeyboard::instance().get(device));
-  if (!item) return;
-
   // ------------------------------------------------------------
   // Device Hacks
 
@@ -208,7 +320,7 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
   if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_disable_internal_keyboard_if_external_keyboard_exsits)) {
     if (ListHookedKeyboard::instance().isExternalDevicesConnected()) {
       ListHookedDevice::clearInternalKeyboardPressingPhysicalKeysCountAll();
-      if (item->isInternalDevice()) {
+      if (item.isInternalDevice()) {
         return;
       }
     }
@@ -228,7 +340,7 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
   //
   // *** LCP has 6 keys (Page Up, Page Down, a 'B' key, an 'Esc' key, and volume up / down keys). ***
   // *** So, we can drop CONTROL_L and SHIFT_L without a problem. ***
-  if ((item->getDeviceIdentifier()).isEqualVendorProduct(DeviceVendor::LOGITECH, DeviceProduct::LOGITECH_CORDLESS_PRESENTER)) {
+  if ((item.getDeviceIdentifier()).isEqualVendorProduct(DeviceVendor::LOGITECH, DeviceProduct::LOGITECH_CORDLESS_PRESENTER)) {
     if (params.key == KeyCode::CONTROL_L) return;
     if (params.key == KeyCode::SHIFT_L) return;
   }
@@ -238,7 +350,7 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
   //
   // As for some keypads, NumLock is off when it was connected.
   // We need to call setAlphaLock(true) to activate a device.
-  RemapClassManager::remap_forcenumlockon(item);
+  RemapClassManager::remap_forcenumlockon(&item);
 
   // ------------------------------------------------------------
   CommonData::setcurrent_ts(ts);
@@ -279,10 +391,10 @@ void EventInputQueue::push_KeyboardEventCallback(OSObject* target,
 
   // ------------------------------------------------------------
   bool retainFlagStatusTemporaryCount = false;
-  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
+  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
   bool push_back = true;
   bool isSimultaneousKeyPressesTarget = true;
-  enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp, push_back, isSimultaneousKeyPressesTarget);
+  enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts), push_back, isSimultaneousKeyPressesTarget);
 
   setTimer();
 }
@@ -321,6 +433,36 @@ void EventInputQueue::push_KeyboardSpecialEventCallback(OSObject* target,
   GlobalLock::ScopedLock lk;
   if (!lk) return;
 
+  IOHIKeyboard* device = OSDynamicCast(IOHIKeyboard, sender);
+  if (!device) return;
+
+  ListHookedConsumer::Item* item = static_cast<ListHookedConsumer::Item*>(ListHookedConsumer::instance().get(device));
+  if (!item) return;
+
+  DeferredEventQueue::Record* record = backDeferredEvent(*item);
+  if (!record) return;
+
+  record->type = DeferredEventQueue::Record::Type::KEYBOARD_SPECIAL;
+  record->ts = ts;
+  record->keyboardSpecial.eventType = eventType;
+  record->keyboardSpecial.flags = flags;
+  record->keyboardSpecial.key = key;
+  record->keyboardSpecial.flavor = flavor;
+  record->keyboardSpecial.guid = guid;
+  record->keyboardSpecial.repeat = repeat;
+
+  pushDeferredEvent(*item, *record);
+}
+
+void EventInputQueue::process_KeyboardSpecialEventCallback(ListHookedConsumer::Item& item, const DeferredEventQueue::Record& record) {
+  unsigned int eventType = record.keyboardSpecial.eventType;
+  unsigned int flags = record.keyboardSpecial.flags;
+  unsigned int key = record.keyboardSpecial.key;
+  unsigned int flavor = record.keyboardSpecial.flavor;
+  UInt64 guid = record.keyboardSpecial.guid;
+  bool repeat = record.keyboardSpecial.repeat;
+  AbsoluteTime ts = record.ts;
+
   Params_KeyboardSpecialEventCallback::log(true, EventType(eventType), Flags(flags), ConsumerKeyCode(key), flavor, guid, repeat);
 
   // ------------------------------------------------------------
@@ -329,13 +471,6 @@ void EventInputQueue::push_KeyboardSpecialEventCallback(OSObject* target,
                                              ConsumerKeyCode(key),
                                              flavor, guid, false);
 
-  // ------------------------------------------------------------
-  IOHIKeyboard* device = OSDynamicCast(IOHIKeyboard, sender);
-  if (!device) return;
-
-  ListHookedConsumer::Item* item = static_cast<ListHookedConsumer::Item*>(ListHookedConsumer::instance().get(device));
-  if (!item) return;
-
   // ------------------------------------------------------------
   // Device Hacks
 
@@ -343,7 +478,7 @@ void EventInputQueue::push_KeyboardSpecialEventCallback(OSObject* target,
   if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_disable_internal_keyboard_if_external_keyboard_exsits)) {
     if (ListHookedKeyboard::instance().isExternalDevicesConnected()) {
       ListHookedDevice::clearInternalKeyboardPressingPhysicalKeysCountAll();
-      if (item->isInternalDevice()) {
+      if (item.isInternalDevice()) {
         return;
       }
     }
@@ -354,13 +489,13 @@ void EventInputQueue::push_KeyboardSpecialEventCallback(OSObject* target,
 
   // ------------------------------------------------------------
   // Because we handle the key repeat ourself, drop the key repeat by hardware.
-  // Note: See comments in push_KeyboardEventCallback.
+  // Note: See comments in process_KeyboardEventCallback.
   if (repeat && eventType == 10) return;
 
   // ------------------------------------------------------------
   bool retainFlagStatusTemporaryCount = false;
-  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
-  enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp);
+  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
+  enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts));
 
   setTimer();
 }
@@ -376,26 +511,43 @@ void EventInputQueue::push_RelativePointerEventCallback(OSObject* target,
   GlobalLock::ScopedLock lk;
   if (!lk) return;
 
-  Params_RelativePointerEventCallback::log(true, Buttons(buttons_raw), dx, dy);
-
-  // ------------------------------------------------------------
-  Buttons buttons(buttons_raw);
-  Buttons justPressed;
-  Buttons justReleased;
-
   IOHIPointing* device = OSDynamicCast(IOHIPointing, sender);
   if (!device) return;
 
   ListHookedPointing::Item* item = static_cast<ListHookedPointing::Item*>(ListHookedPointing::instance().get(device));
   if (!item) return;
 
+  DeferredEventQueue::Record* record = backDeferredEvent(*item);
+  if (!record) return;
+
+  record->type = DeferredEventQueue::Record::Type::RELATIVE_POINTER;
+  record->ts = ts;
+  record->relativePointer.buttons = buttons_raw;
+  record->relativePointer.dx = dx;
+  record->relativePointer.dy = dy;
+
+  pushDeferredEvent(*item, *record);
+}
+
+void EventInputQueue::process_RelativePointerEventCallback(ListHookedPointing::Item& item, const DeferredEventQueue::Record& record) {
+  int dx = record.relativePointer.dx;
+  int dy = record.relativePointer.dy;
+  AbsoluteTime ts = record.ts;
+
+  Params_RelativePointerEventCallback::log(true, Buttons(record.relativePointer.buttons), dx, dy);
+
+  // ------------------------------------------------------------
+  Buttons buttons(record.relativePointer.buttons);
+  Buttons justPressed;
+  Buttons justReleased;
+
   // ------------------------------------------------------------
   CommonData::setcurrent_ts(ts);
 
   // ------------------------------------------------------------
-  justPressed = buttons.justPressed(item->get_previousbuttons());
-  justReleased = buttons.justReleased(item->get_previousbuttons());
-  item->set_previousbuttons(buttons);
+  justPressed = buttons.justPressed(item.get_previousbuttons());
+  justReleased = buttons.justReleased(item.get_previousbuttons());
+  item.set_previousbuttons(buttons);
 
   // ------------------------------------------------------------
   // divide an event into button and cursormove events.
@@ -404,14 +556,14 @@ void EventInputQueue::push_RelativePointerEventCallback(OSObject* target,
     if (justPressed.isOn(btn)) {
       Params_RelativePointerEventCallback params(buttons, 0, 0, btn, true);
       bool retainFlagStatusTemporaryCount = Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_lazy_modifiers_with_mouse_event);
-      ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
-      enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp);
+      ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
+      enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts));
     }
     if (justReleased.isOn(btn)) {
       Params_RelativePointerEventCallback params(buttons, 0, 0, btn, false);
       bool retainFlagStatusTemporaryCount = Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_lazy_modifiers_with_mouse_event);
-      ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
-      enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp);
+      ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
+      enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts));
     }
   }
   // If (dx == 0 && dy == 0), the event is either needless event or just pressing/releasing buttons event.
@@ -420,8 +572,8 @@ void EventInputQueue::push_RelativePointerEventCallback(OSObject* target,
   if (dx != 0 || dy != 0) {
     Params_RelativePointerEventCallback params(buttons, dx, dy, PointingButton::NONE, false);
     bool retainFlagStatusTemporaryCount = true;
-    ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
-    enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp);
+    ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
+    enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts));
   }
 
   setTimer();
@@ -444,6 +596,44 @@ void EventInputQueue::push_ScrollWheelEventCallback(OSObject* target,
   GlobalLock::ScopedLock lk;
   if (!lk) return;
 
+  IOHIPointing* device = OSDynamicCast(IOHIPointing, sender);
+  if (!device) return;
+
+  ListHookedPointing::Item* item = static_cast<ListHookedPointing::Item*>(ListHookedPointing::instance().get(device));
+  if (!item) return;
+
+  DeferredEventQueue::Record* record = backDeferredEvent(*item);
+  if (!record) return;
+
+  record->type = DeferredEventQueue::Record::Type::SCROLL_WHEEL;
+  record->ts = ts;
+  record->scrollWheel.deltaAxis1 = deltaAxis1;
+  record->scrollWheel.deltaAxis2 = deltaAxis2;
+  record->scrollWheel.deltaAxis3 = deltaAxis3;
+  record->scrollWheel.fixedDelta1 = fixedDelta1;
+  record->scrollWheel.fixedDelta2 = fixedDelta2;
+  record->scrollWheel.fixedDelta3 = fixedDelta3;
+  record->scrollWheel.pointDelta1 = pointDelta1;
+  record->scrollWheel.pointDelta2 = pointDelta2;
+  record->scrollWheel.pointDelta3 = pointDelta3;
+  record->scrollWheel.options = options;
+
+  pushDeferredEvent(*item, *record);
+}
+
+void EventInputQueue::process_ScrollWheelEventCallback(ListHookedPointing::Item& item, const DeferredEventQueue::Record& record) {
+  short deltaAxis1 = record.scrollWheel.deltaAxis1;
+  short deltaAxis2 = record.scrollWheel.deltaAxis2;
+  short deltaAxis3 = record.scrollWheel.deltaAxis3;
+  IOFixed fixedDelta1 = record.scrollWheel.fixedDelta1;
+  IOFixed fixedDelta2 = record.scrollWheel.fixedDelta2;
+  IOFixed fixedDelta3 = record.scrollWheel.fixedDelta3;
+  SInt32 pointDelta1 = record.scrollWheel.pointDelta1;
+  SInt32 pointDelta2 = record.scrollWheel.pointDelta2;
+  SInt32 pointDelta3 = record.scrollWheel.pointDelta3;
+  SInt32 options = record.scrollWheel.options;
+  AbsoluteTime ts = record.ts;
+
   Params_ScrollWheelEventCallback::log(true,
                                        deltaAxis1,
                                        deltaAxis2,
@@ -462,28 +652,77 @@ void EventInputQueue::push_ScrollWheelEventCallback(OSObject* target,
                                          pointDelta1, pointDelta2, pointDelta3,
                                          options);
 
-  // ------------------------------------------------------------
-  IOHIPointing* device = OSDynamicCast(IOHIPointing, sender);
-  if (!device) return;
-
-  ListHookedPointing::Item* item = static_cast<ListHookedPointing::Item*>(ListHookedPointing::instance().get(device));
-  if (!item) return;
-
   // ------------------------------------------------------------
   CommonData::setcurrent_ts(ts);
 
   // ------------------------------------------------------------
   bool retainFlagStatusTemporaryCount = Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_lazy_modifiers_with_mouse_event);
-  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(item));
-  enqueue_(params, retainFlagStatusTemporaryCount, item->getDeviceIdentifier(), wp);
+  ListHookedDevice::WeakPointer_Item wp(static_cast<ListHookedDevice::Item*>(&item));
+  enqueue_(params, retainFlagStatusTemporaryCount, item.getDeviceIdentifier(), wp, AbsoluteTime_to_scalar(&ts));
 
   setTimer();
 }
 
+// ======================================================================
+bool EventInputQueue::drainDeferredEvents(void) {
+  bool processed = false;
+
+  for (;;) {
+    ListHookedDevice::Item* item = ListHookedDevice::getOldestDeferredEventItemAll();
+    if (!item) return processed;
+
+    processed = true;
+
+    // Copy and release the record before processing it
+    // because the record slot might be reused by the following events.
+    DeferredEventQueue& queue = item->getDeferredEventQueue();
+    DeferredEventQueue::Record record = *(queue.front());
+    queue.pop_front();
+
+    switch (record.type) {
+    case DeferredEventQueue::Record::Type::KEYBOARD:
+      process_KeyboardEventCallback(*(static_cast<ListHookedKeyboard::Item*>(item)), record);
+      break;
+    case DeferredEventQueue::Record::Type::KEYBOARD_SPECIAL:
+      process_KeyboardSpecialEventCallback(*(static_cast<ListHookedConsumer::Item*>(item)), record);
+      break;
+    case DeferredEventQueue::Record::Type::RELATIVE_POINTER:
+      process_RelativePointerEventCallback(*(static_cast<ListHookedPointing::Item*>(item)), record);
+      break;
+    case DeferredEventQueue::Record::Type::SCROLL_WHEEL:
+      process_ScrollWheelEventCallback(*(static_cast<ListHookedPointing::Item*>(item)), record);
+      break;
+    }
+  }
+}
+
 // ======================================================================
 void EventInputQueue::fire_timer_callback(OSObject* /*notuse_owner*/, IOTimerEventSource* /*notuse_sender*/) {
   // IOLOG_DEVEL("EventInputQueue::fire queue_.size = %d\n", static_cast<int>(queue_.size()));
 
+  if (droppedDeferredEventCount_ != reportedDroppedDeferredEventCount_) {
+    IOLOG_ERROR("%d events are dropped because DeferredEventQueue is full.\n",
+                droppedDeferredEventCount_ - reportedDroppedDeferredEventCount_);
+    reportedDroppedDeferredEventCount_ = droppedDeferredEventCount_;
+  }
+
+  // Events which are recorded in device callbacks must be queued before we fire events.
+  if (drainDeferredEvents()) {
+    // process_* set the timer while draining.
+    // We set it again after the front item is fired in order to keep the order of timers of output events.
+    fire_timer_.cancelTimeout();
+
+    // push_* sets the timer before the front item reaches its threshold.
+    Item* front = static_cast<Item*>(queue_.safe_front());
+    if (front) {
+      uint32_t timeoutMS = calcTimeoutMS(front);
+      if (timeoutMS > 0) {
+        fire_timer_.setTimeoutMS(timeoutMS);
+        return;
+      }
+    }
+  }
+
   // ------------------------------------------------------------
   // Ignore key bouncing (chattering).
   if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_ignore_bouncing_events)) {
@@ -556,6 +795,7 @@ void EventInputQueue::fire_timer_callback(OSObject* /*notuse_owner*/, IOTimerEve
     }
 
     CommonData::setcurrent_deviceIdentifier(front->deviceIdentifier);
+    DeviceFilterTable::setCurrentDevice(front->deviceIdentifier);
     {
       auto params = (front->getParamsBase()).get_Params_KeyboardEventCallBack();
       if (params) {
@@ -632,6 +872,11 @@ void EventInputQueue::doFire(void) {
   Item* p = static_cast<Item*>(queue_.safe_front());
   if (!p) return;
 
+  EventTrace::record(BRIDGE_TRACE_TAG_INPUT_FIRE, p->getParamsBase(), p->deviceIdentifier, p->timestamp);
+
+  // Output events which are pushed while remapping inherit the timestamp.
+  currentTimestamp_ = p->timestamp;
+
   {
     auto params = (p->getParamsBase()).get_Params_KeyboardEventCallBack();
     if (params) {
@@ -722,6 +967,7 @@ void EventInputQueue::doFire(void) {
   bool iskeydown;
   bool isdownupevent = (p->getParamsBase()).iskeydown(iskeydown);
 
+  currentTimestamp_ = 0;
   queue_.pop_front();
 
   if (isdownupevent) {
@@ -729,6 +975,23 @@ void EventInputQueue::doFire(void) {
   }
 }
 
+bool EventInputQueue::isReleasedBefore(const Params_Base& paramsBase, const FromEvent& fromEvent) {
+  Item* front = static_cast<Item*>(queue_.safe_front());
+  if (!front) return false;
+
+  FromEvent current(paramsBase);
+  for (Item* p = static_cast<Item*>(front->getnext()); p; p = static_cast<Item*>(p->getnext())) {
+    if (current.isTargetUpEvent(p->getParamsBase())) {
+      return true;
+    }
+    if (fromEvent.isTargetUpEvent(p->getParamsBase())) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
 void EventInputQueue::resetInternalStateIfNeeded(void) {
   // Reset if all keys are released and EventInputQueue is empty.
   if (ListHookedDevice::totalPressingPhysicalKeysCountAll() == 0 &&
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "DeferredEventQueue.hpp"
 #include "FromEvent.hpp"
 #include "IntervalChecker.hpp"
 #include "KeyCode.hpp"
 #include "List.hpp"
+#include "ListHookedConsumer.hpp"
 #include "ListHookedDevice.hpp"
+#include "ListHookedKeyboard.hpp"
+#include "ListHookedPointing.hpp"
 #include "Params.hpp"
 #include "TimerWrapper.hpp"
 
@@ -24,6 +28,16 @@ public:
   static void terminate(void);
 
   static SerialNumber currentSerialNumber(void) { return serialNumber_; }
+  // The HID timestamp (absolute time) of the event which is being fired.
+  // (0 if no input event is being fired.)
+  static uint64_t currentTimestamp(void) { return currentTimestamp_; }
+  // The number of events which are dropped because DeferredEventQueue is full.
+  static uint32_t droppedDeferredEventCount(void) { return droppedDeferredEventCount_; }
+
+  // Return true if the up event of `paramsBase` (the event which is being fired) is already queued
+  // before the up event of `fromEvent`.
+  // (For example, when the events are released at once from __BlockUntilKeyUp__.)
+  static bool isReleasedBefore(const Params_Base& paramsBase, const FromEvent& fromEvent);
 
   class ScopedSerialNumberDecreaser {
   public:
@@ -32,6 +46,9 @@ public:
   };
 
   // ------------------------------------------------------------
+  // push_* callbacks only record raw events into DeferredEventQueue of the device.
+  // The records are processed in the order of arrival by drainDeferredEvents in fire_timer_callback.
+  // (Events are dropped if DeferredEventQueue of the device is full.)
   static void push_KeyboardEventCallback(OSObject* target,
                                          unsigned int eventType,
                                          unsigned int flags,
@@ -88,12 +105,14 @@ public:
   // ------------------------------------------------------------
   class Item final : public List::Item {
   public:
-    Item(const Params_Base& p, bool r, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device) : p_(Params_Factory::copy(p)),
-                                                                                                                       retainFlagStatusTemporaryCount(r),
-                                                                                                                       deviceIdentifier(di),
-                                                                                                                       deviceWeakPointer(device),
-                                                                                                                       isSimultaneousKeyPressesTarget(true),
-                                                                                                                       enqueuedFrom(ENQUEUED_FROM_HARDWARE) {
+    Item(const Params_Base& p, bool r, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device, uint64_t ts) : p_(Params_Factory::copy(p)),
+                                                                                                                                    retainFlagStatusTemporaryCount(r),
+                                                                                                                                    deviceIdentifier(di),
+                                                                                                                                    deviceWeakPointer(device),
+                                                                                                                                    timestamp(ts),
+                                                                                                                                    isSimultaneousKeyPressesTarget(true),
+                                                                                                                                    enqueuedFrom(ENQUEUED_FROM_HARDWARE),
+                                                                                                                                    coalescedCount_(1) {
       ic.begin();
     }
 
@@ -101,9 +120,11 @@ public:
                             retainFlagStatusTemporaryCount(rhs.retainFlagStatusTemporaryCount),
                             deviceIdentifier(rhs.deviceIdentifier),
                             deviceWeakPointer(rhs.deviceWeakPointer),
+                            timestamp(rhs.timestamp),
                             ic(rhs.ic),
                             isSimultaneousKeyPressesTarget(rhs.isSimultaneousKeyPressesTarget),
-                            enqueuedFrom(rhs.enqueuedFrom) {}
+                            enqueuedFrom(rhs.enqueuedFrom),
+                            coalescedCount_(rhs.coalescedCount_) {}
 
     virtual ~Item(void) {
       if (p_) {
@@ -113,9 +134,15 @@ public:
 
     const Params_Base& getParamsBase(void) const { return Params_Base::safe_dereference(p_); }
 
+    // Add dx and dy of a cursor move event into this item.
+    // Return false if the event cannot be merged. (eg. buttons or the device are different.)
+    bool coalesce(const Params_RelativePointerEventCallback& params, const ListHookedDevice::WeakPointer_Item& device);
+
     bool retainFlagStatusTemporaryCount;
     DeviceIdentifier deviceIdentifier;
     ListHookedDevice::WeakPointer_Item deviceWeakPointer;
+    // The HID timestamp. (absolute time)
+    uint64_t timestamp;
 
     IntervalChecker ic;
 
@@ -132,6 +159,8 @@ public:
     Item& operator=(const Item& rhs); // Prevent assignment
 
     const Params_Base* p_;
+    // The number of hardware events which are merged into this item.
+    uint32_t coalescedCount_;
   };
 
 private:
@@ -194,22 +223,40 @@ private:
 
   static uint32_t calcdelay(DelayType type);
 
+  // ------------------------------------------------------------
+  // Return nullptr if the queue is full. (The event is counted as dropped.)
+  static DeferredEventQueue::Record* backDeferredEvent(ListHookedDevice::Item& item);
+  static void pushDeferredEvent(ListHookedDevice::Item& item, DeferredEventQueue::Record& record);
+  // Return true if records are processed.
+  static bool drainDeferredEvents(void);
+
+  static void process_KeyboardEventCallback(ListHookedKeyboard::Item& item, const DeferredEventQueue::Record& record);
+  static void process_KeyboardSpecialEventCallback(ListHookedConsumer::Item& item, const DeferredEventQueue::Record& record);
+  static void process_RelativePointerEventCallback(ListHookedPointing::Item& item, const DeferredEventQueue::Record& record);
+  static void process_ScrollWheelEventCallback(ListHookedPointing::Item& item, const DeferredEventQueue::Record& record);
+
   // ------------------------------------------------------------
   static void enqueue_(const Params_Base& paramsBase,
-                       bool retainFlagStatusTemporaryCount, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device, bool push_back, bool isSimultaneousKeyPressesTarget);
+                       bool retainFlagStatusTemporaryCount, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device, uint64_t timestamp, bool push_back, bool isSimultaneousKeyPressesTarget);
   static void enqueue_(const Params_Base& paramsBase,
-                       bool retainFlagStatusTemporaryCount, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device) {
-    enqueue_(paramsBase, retainFlagStatusTemporaryCount, di, device, true, true);
+                       bool retainFlagStatusTemporaryCount, const DeviceIdentifier& di, const ListHookedDevice::WeakPointer_Item& device, uint64_t timestamp) {
+    enqueue_(paramsBase, retainFlagStatusTemporaryCount, di, device, timestamp, true, true);
   }
   static void fire_timer_callback(OSObject* owner, IOTimerEventSource* sender);
   static void doFire(void);
   static void resetInternalStateIfNeeded(void);
+  static uint32_t calcTimeoutMS(Item* front);
   static void setTimer(void);
 
   static List queue_;
   static IntervalChecker ic_;
   static TimerWrapper fire_timer_;
+  // The sequence number of the next DeferredEventQueue::Record.
+  static uint32_t deferredSequence_;
+  static uint32_t droppedDeferredEventCount_;
+  static uint32_t reportedDroppedDeferredEventCount_;
   // Increment at fire_timer_callback.
   static SerialNumber serialNumber_;
+  static uint64_t currentTimestamp_;
 };
 }
@@ -1,8 +1,10 @@
 #include "EventOutputQueue.hpp"
 #include "Config.hpp"
+#include "EventTrace.hpp"
 #include "ListHookedConsumer.hpp"
 #include "ListHookedKeyboard.hpp"
 #include "ListHookedPointing.hpp"
+#include "ModifierTransition.hpp"
 #include "PressDownKeys.hpp"
 #include "RemapClass.hpp"
 #include "VK_IOHIDPOSTEVENT.hpp"
@@ -43,6 +45,14 @@ void EventOutputQueue::push(const Params_KeyboardSpecialEventCallback& p, Autoge
   }
 }
 void EventOutputQueue::push(const Params_RelativePointerEventCallback& p, AutogenId autogenId) {
+  // Merge consecutive cursor move events.
+  // (Modifier changes are queued as keyboard events, so the merged events have the same flags.)
+  Item* back = static_cast<Item*>(queue_.safe_back());
+  if (back && back->coalesce(p, autogenId)) {
+    CommonData::setcurrent_lastsentevent(p);
+    return;
+  }
+
   PUSH_TO_OUTPUTQUEUE;
   if (p.buttons != Buttons(0)) {
     FlagStatus::globalFlagStatus().sticky_clear();
@@ -57,6 +67,33 @@ void EventOutputQueue::push(const Params_Wait& p, AutogenId autogenId) {
 }
 #undef PUSH_TO_OUTPUTQUEUE
 
+// ----------------------------------------------------------------------
+bool EventOutputQueue::Item::coalesce(const Params_RelativePointerEventCallback& params, AutogenId autogenId) {
+  if (!params.isMove()) return false;
+
+  auto current = getParamsBase().get_Params_RelativePointerEventCallback();
+  if (!current || !current->isMove()) return false;
+  if (current->buttons != params.buttons) return false;
+
+  if (canceled_) return false;
+  if (autogenId_ != autogenId) return false;
+
+  if (coalescedCount_ >= Config::get_coalesce_relative_pointer_max_events()) return false;
+  if (ic_.getmillisec() >= Config::get_coalesce_relative_pointer_max_interval()) return false;
+
+  Params_RelativePointerEventCallback merged(current->buttons,
+                                             current->dx + params.dx,
+                                             current->dy + params.dy,
+                                             PointingButton::NONE, false);
+  const Params_Base* p = Params_Factory::copy(merged);
+  if (!p) return false;
+
+  delete p_;
+  p_ = p;
+  ++coalescedCount_;
+  return true;
+}
+
 // ----------------------------------------------------------------------
 unsigned int
 EventOutputQueue::calcDelay(const Params_Base& paramsBase) {
@@ -113,6 +150,46 @@ unsigned int maxDelay(unsigned int v1, unsigned int v2) {
 }
 }
 
+unsigned int
+EventOutputQueue::getWaitBetweenKeyEvents(const ListHookedDevice::Item* target) {
+  // By default, we wait 1ms after key events in order to avoid changing key sequence order randomly.
+  // (If VMware Fusion's driver is installed, the wrong order issue will be happen.)
+  //
+  // The wait is decided by the device which the event is sent through.
+  // (target is nullptr if the event is not sent through a device. eg. VK_IOHIDPOSTEVENT)
+  //
+  // 1. The wait for a specific device.
+  // 2. Known-safe devices do not need the wait.
+  // 3. parameter.wait_between_key_events. (Users who do not need the wait can set 0.)
+
+  if (target) {
+    DeviceVendor vendor(Config::get_wait_between_key_events_device_vendor_id());
+    DeviceProduct product(Config::get_wait_between_key_events_device_product_id());
+    if (vendor != DeviceVendor(0) || product != DeviceProduct(0)) {
+      if (target->getDeviceIdentifier().isEqualVendorProduct(vendor, product)) {
+        return Config::get_wait_between_key_events_device_wait();
+      }
+    }
+
+    if (isKnownSafeTarget(*target)) {
+      return 0;
+    }
+  }
+
+  return Config::get_wait_between_key_events();
+}
+
+bool EventOutputQueue::isKnownSafeTarget(const ListHookedDevice::Item& target) {
+  // An internal keyboard is not affected by the wrong order issue unless VMware Fusion's driver is installed.
+  // We cannot detect the driver, so users tell it by general.dont_wait_between_key_events_for_internal_keyboard.
+  if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_dont_wait_between_key_events_for_internal_keyboard) &&
+      target.isInternalDevice()) {
+    return true;
+  }
+
+  return false;
+}
+
 void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSource* /* sender */) {
   // We need to cancelEventOutputQueueItems in fire_timer_callback
   // in order to cancel key repeat and __HoldingKeyToKey__ events.
@@ -124,6 +201,7 @@ void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSo
   p = static_cast<Item*>(queue_.safe_front());
   while (p) {
     if (p->isCanceled()) {
+      EventTrace::record(BRIDGE_TRACE_TAG_OUTPUT_DROP, p->getParamsBase(), p->getAutogenId());
       p = static_cast<Item*>(queue_.erase_and_delete(p));
     } else {
       p = static_cast<Item*>(p->getnext());
@@ -131,9 +209,32 @@ void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSo
   }
 
   // ------------------------------------------------------------
-  // Send key event.
-  p = static_cast<Item*>(queue_.safe_front());
-  if (!p) return;
+  // Send events.
+  //
+  // Events which do not need to wait are sent back-to-back in this callback.
+  // (We limit the number of events in order not to block the workloop for long time.)
+  for (int i = 0; i < MAX_EVENTS_PER_CALLBACK; ++i) {
+    unsigned int delay = fire();
+    if (queue_.empty()) return;
+
+    if (delay > 0) {
+      fire_timer_.setTimeoutMS(delay);
+      return;
+    }
+  }
+
+  fire_timer_.setTimeoutMS(0);
+}
+
+unsigned int
+EventOutputQueue::fire(void) {
+  Item* p = static_cast<Item*>(queue_.safe_front());
+  if (!p) return 0;
+
+  EventTrace::record(BRIDGE_TRACE_TAG_OUTPUT_FIRE, p->getParamsBase(), p->getAutogenId());
+
+  // ListHooked*::apply records the latency from the input event.
+  CommonData::setcurrent_inputts(p->getInputTimestamp());
 
   // Delay after modifier or click.
   unsigned int delay = calcDelay(p->getParamsBase());
@@ -142,35 +243,30 @@ void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSo
   {
     auto params = (p->getParamsBase()).get_Params_KeyboardEventCallBack();
     if (params) {
+      // Decide the wait before apply because apply unlocks GlobalLock and the device might be removed.
+      delay = maxDelay(delay, getWaitBetweenKeyEvents(ListHookedKeyboard::instance().get_replaced()));
+
       bool handled = VirtualKey::handleAfterEnqueued(*params);
       if (!handled) {
         ListHookedKeyboard::instance().apply(*params);
       }
-
-      // We need to wait at least 1ms in order to avoid changing key sequence order randomly.
-      // (If VMware Fusion's driver is installed, the wrong order issue will be happen.)
-      delay = maxDelay(delay, 1);
     }
   }
   {
     auto params = (p->getParamsBase()).get_Params_UpdateEventFlagsCallback();
     if (params) {
-      // We need to wait at least 1ms in order to avoid changing key sequence order randomly.
-      // (If VMware Fusion's driver is installed, the wrong order issue will be happen.)
-      delay = maxDelay(delay, 1);
+      delay = maxDelay(delay, getWaitBetweenKeyEvents(ListHookedKeyboard::instance().get_replaced()));
     }
   }
   {
     auto params = (p->getParamsBase()).get_Params_KeyboardSpecialEventCallback();
     if (params) {
+      delay = maxDelay(delay, getWaitBetweenKeyEvents(ListHookedConsumer::instance().get_replaced()));
+
       if (!ListHookedConsumer::instance().apply(*params)) {
         // If there is no consumer device, we send an event as a software key.
         VirtualKey::VK_IOHIDPOSTEVENT::post(*params);
       }
-
-      // We need to wait at least 1ms in order to avoid changing key sequence order randomly.
-      // (If VMware Fusion's driver is installed, the wrong order issue will be happen.)
-      delay = maxDelay(delay, 1);
     }
   }
   {
@@ -192,6 +288,7 @@ void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSo
     }
   }
 
+  CommonData::setcurrent_inputts(0);
   queue_.pop_front();
 
   // ----------------------------------------
@@ -199,10 +296,11 @@ void EventOutputQueue::fire_timer_callback(OSObject* /* owner */, IOTimerEventSo
 
   // Delay before modifier and click.
   Item* next = static_cast<Item*>(queue_.safe_front());
-  if (!next) return;
-  delay = maxDelay(delay, calcDelay(next->getParamsBase()));
+  if (next) {
+    delay = maxDelay(delay, calcDelay(next->getParamsBase()));
+  }
 
-  fire_timer_.setTimeoutMS(delay);
+  return delay;
 }
 
 // ======================================================================
@@ -220,63 +318,14 @@ void EventOutputQueue::FireModifiers::fire(AutogenId autogenId, PhysicalEventTyp
     }
   }
 
-  // ------------------------------------------------------------
-  // At first we handle KeyUp events and handle KeyDown events next.
-  // We need to end KeyDown at Command+Space to Option_L+Shift_L.
-  //
-  // When Option_L+Shift_L has a meaning (switch input language at Windows),
-  // it does not works well when the last is KeyUp of Command.
-
-  // ModifierFlag::NUMPAD handling.
-  // (We need to remove ModifierFlag::NUMPAD at first in order to strip NUMPAD flag from normal modifier key events.)
-  if (!toFlags.isOn(ModifierFlag::NUMPAD)) {
-    lastFlags_.remove(ModifierFlag::NUMPAD);
-  }
-
-  // ------------------------------------------------------------
-  // KeyUp
-  for (size_t i = 0; i < FlagStatus::globalFlagStatus().itemSize(); ++i) {
-    ModifierFlag flag = FlagStatus::globalFlagStatus().getFlag(i);
-
-    // Skipping invalid flags
-    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
-    // Skipping virtual modifiers.
-    if (flag.getRawBits() == 0) continue;
-
-    // ----------------------------------------
-    if (!lastFlags_.isOn(flag)) continue;
-    if (toFlags.isOn(flag)) continue;
-
-    lastFlags_.remove(flag);
-
-    Params_KeyboardEventCallBack params(EventType::MODIFY, lastFlags_, flag.getKeyCode(), keyboardType, false);
-    EventOutputQueue::push(params, autogenId);
-  }
-
-  // KeyDown
-  for (size_t i = 0; i < FlagStatus::globalFlagStatus().itemSize(); ++i) {
-    ModifierFlag flag = FlagStatus::globalFlagStatus().getFlag(i);
-
-    // Skipping invalid flags
-    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
-    // Skipping virtual modifiers.
-    if (flag.getRawBits() == 0) continue;
-
-    // ----------------------------------------
-    if (!toFlags.isOn(flag)) continue;
-    if (lastFlags_.isOn(flag)) continue;
-
-    lastFlags_.add(flag);
-
-    Params_KeyboardEventCallBack params(EventType::MODIFY, lastFlags_, flag.getKeyCode(), keyboardType, false);
+  // The sequence of modifier events is cached in ModifierTransition.
+  // (ModifierTransition handles the order of KeyUp and KeyDown and ModifierFlag::NUMPAD.)
+  const ModifierTransition& transition = ModifierTransition::get(lastFlags_, toFlags);
+  for (size_t i = 0; i < transition.size(); ++i) {
+    Params_KeyboardEventCallBack params(EventType::MODIFY, transition[i].flags, transition[i].key, keyboardType, false);
     EventOutputQueue::push(params, autogenId);
   }
-
-  // ModifierFlag::NUMPAD handling.
-  // (We need to add ModifierFlag::NUMPAD at last in order to strip NUMPAD flag from normal modifier key events.)
-  if (toFlags.isOn(ModifierFlag::NUMPAD)) {
-    lastFlags_.add(ModifierFlag::NUMPAD);
-  }
+  lastFlags_ = transition.getLastFlags();
 }
 
 // ======================================================================
@@ -486,24 +535,21 @@ void EventOutputQueue::FireScrollWheel::fire(const Params_ScrollWheelEventCallba
   EventOutputQueue::push(params, autogenId);
 }
 
+ScrollWheelDelta EventOutputQueue::FireScrollWheel::scrollWheelDelta1_;
+ScrollWheelDelta EventOutputQueue::FireScrollWheel::scrollWheelDelta2_;
+
 void EventOutputQueue::FireScrollWheel::fire(int delta1, int delta2, AutogenId autogenId, PhysicalEventType physicalEventType) {
   short deltaAxis1;
   short deltaAxis2;
-  IOFixed fixedDelta1;
-  IOFixed fixedDelta2;
-  SInt32 pointDelta1;
-  SInt32 pointDelta2;
+  int fixedDelta1;
+  int fixedDelta2;
+  int pointDelta1;
+  int pointDelta2;
 
   int relative2scroll_rate = Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_pointing_relative2scroll_rate);
 
-  deltaAxis1 = (delta1 * relative2scroll_rate) / 1024 / DELTA_SCALE;
-  deltaAxis2 = (delta2 * relative2scroll_rate) / 1024 / DELTA_SCALE;
-
-  fixedDelta1 = (delta1 * relative2scroll_rate) * (POINTING_FIXED_SCALE / 1024) / DELTA_SCALE;
-  fixedDelta2 = (delta2 * relative2scroll_rate) * (POINTING_FIXED_SCALE / 1024) / DELTA_SCALE;
-
-  pointDelta1 = (delta1 * POINTING_POINT_SCALE * relative2scroll_rate) / 1024 / DELTA_SCALE;
-  pointDelta2 = (delta2 * POINTING_POINT_SCALE * relative2scroll_rate) / 1024 / DELTA_SCALE;
+  scrollWheelDelta1_.convert(delta1, relative2scroll_rate, deltaAxis1, fixedDelta1, pointDelta1);
+  scrollWheelDelta2_.convert(delta2, relative2scroll_rate, deltaAxis2, fixedDelta2, pointDelta2);
 
   // see IOHIDSystem/IOHIDevicePrivateKeys.h about options.
   const int kScrollTypeContinuous_ = 0x0001;
@@ -7,7 +7,9 @@
 #include "IntervalChecker.hpp"
 #include "KeyCode.hpp"
 #include "List.hpp"
+#include "ListHookedDevice.hpp"
 #include "Params.hpp"
+#include "ScrollWheelDelta.hpp"
 #include "TimerWrapper.hpp"
 
 namespace org_pqrs_Karabiner {
@@ -55,13 +57,23 @@ public:
   class FireScrollWheel final {
   public:
     enum {
-      // see IOHIPointing.cpp in darwin.
-      POINTING_FIXED_SCALE = 65536, // (== << 16)
-      POINTING_POINT_SCALE = 10,    // (== SCROLL_WHEEL_TO_PIXEL_SCALE >> 16)
-      DELTA_SCALE = 128,
+      POINTING_FIXED_SCALE = ScrollWheelDelta::FIXED_SCALE,
+      POINTING_POINT_SCALE = ScrollWheelDelta::POINT_SCALE,
+      DELTA_SCALE = ScrollWheelDelta::DELTA_SCALE,
     };
     static void fire(const Params_ScrollWheelEventCallback& params, AutogenId autogenId, PhysicalEventType physicalEventType);
+    // delta1 and delta2 are multiplied by DELTA_SCALE.
     static void fire(int delta1, int delta2, AutogenId autogenId, PhysicalEventType physicalEventType);
+
+    // Discard fractions which are carried over by fire(delta1, delta2, ...).
+    static void clearRemainders(void) {
+      scrollWheelDelta1_.clear();
+      scrollWheelDelta2_.clear();
+    }
+
+  private:
+    static ScrollWheelDelta scrollWheelDelta1_;
+    static ScrollWheelDelta scrollWheelDelta2_;
   };
 
   class FireWait final {
@@ -74,7 +86,11 @@ public:
     Item(const Params_Base& p, AutogenId autogenId) : p_(Params_Factory::copy(p)),
                                                       autogenId_(autogenId),
                                                       eventInputQueueSerialNumber_(EventInputQueue::currentSerialNumber()),
-                                                      canceled_(false) {}
+                                                      inputTimestamp_(EventInputQueue::currentTimestamp()),
+                                                      canceled_(false),
+                                                      coalescedCount_(1) {
+      ic_.begin();
+    }
 
     virtual ~Item(void) {
       if (p_) {
@@ -85,9 +101,14 @@ public:
     const Params_Base& getParamsBase(void) const { return Params_Base::safe_dereference(p_); }
     AutogenId getAutogenId(void) const { return autogenId_; }
     EventInputQueue::SerialNumber getEventInputQueueSerialNumber(void) const { return eventInputQueueSerialNumber_; }
+    uint64_t getInputTimestamp(void) const { return inputTimestamp_; }
     bool isCanceled(void) const { return canceled_; }
     void cancel(void) { canceled_ = true; }
 
+    // Add dx and dy of a cursor move event into this item.
+    // Return false if the event cannot be merged.
+    bool coalesce(const Params_RelativePointerEventCallback& params, AutogenId autogenId);
+
   private:
     Item(const Item& rhs);            // Prevent copy-construction
     Item& operator=(const Item& rhs); // Prevent assignment
@@ -95,14 +116,27 @@ public:
     const Params_Base* p_;
     const AutogenId autogenId_;
     const EventInputQueue::SerialNumber eventInputQueueSerialNumber_;
+    // The HID timestamp of the input event which produced this event. (0 if the event is produced by a timer.)
+    const uint64_t inputTimestamp_;
     bool canceled_;
+    IntervalChecker ic_;
+    // The number of events which are merged into this item.
+    uint32_t coalescedCount_;
   };
 
   static const List& getQueue(void) { return queue_; }
 
 private:
+  enum {
+    MAX_EVENTS_PER_CALLBACK = 64,
+  };
+
   static void fire_timer_callback(OSObject* /* owner */, IOTimerEventSource* /* sender */);
+  // Send the front event and return the delay until the next event.
+  static unsigned int fire(void);
   static unsigned int calcDelay(const Params_Base& params);
+  static unsigned int getWaitBetweenKeyEvents(const ListHookedDevice::Item* target);
+  static bool isKnownSafeTarget(const ListHookedDevice::Item& target);
   static void push(const Params_KeyboardEventCallBack& p, AutogenId autogenId);
   static void push(const Params_KeyboardSpecialEventCallback& p, AutogenId autogenId);
   static void push(const Params_RelativePointerEventCallback& p, AutogenId autogenId);
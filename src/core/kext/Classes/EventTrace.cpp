@@ -0,0 +1,70 @@
+#include "diagnostic_macros.hpp"
+
+BEGIN_IOKIT_INCLUDE;
+#include <IOKit/IOLib.h>
+END_IOKIT_INCLUDE;
+
+#include "EventTrace.hpp"
+#include "IOLogWrapper.hpp"
+#include "Params.hpp"
+
+namespace org_pqrs_Karabiner {
+BridgeTraceEntry EventTrace::ring_[EventTrace::RING_SIZE];
+uint32_t EventTrace::head_ = 0;
+uint32_t EventTrace::tail_ = 0;
+
+void EventTrace::initialize(void) {
+  head_ = 0;
+  tail_ = 0;
+}
+
+void EventTrace::record_(uint32_t tag, const Params_Base& paramsBase, const DeviceIdentifier& deviceIdentifier, AutogenId autogenId, uint64_t timestamp) {
+  BridgeTraceEntry& entry = ring_[head_ & (RING_SIZE - 1)];
+
+  // Store the absolute time here and convert it into nanoseconds in drain.
+  if (timestamp == 0) {
+    clock_get_uptime(&timestamp);
+  }
+  entry.timestamp = timestamp;
+  entry.autogenId = autogenId;
+  entry.sequence = head_;
+  entry.tag = tag;
+  entry.device = (deviceIdentifier.getVendor().get() << 16) | (deviceIdentifier.getProduct().get() & 0xffff);
+  paramsBase.trace(entry);
+
+  ++head_;
+}
+
+bool EventTrace::drain(uint8_t* buffer, size_t size) {
+  if (!buffer || size < sizeof(BridgeTraceHeader)) {
+    IOLOG_ERROR("EventTrace::drain too small buffer\n");
+    return false;
+  }
+
+  BridgeTraceHeader* header = reinterpret_cast<BridgeTraceHeader*>(buffer);
+  BridgeTraceEntry* entries = reinterpret_cast<BridgeTraceEntry*>(buffer + sizeof(BridgeTraceHeader));
+  size_t capacity = (size - sizeof(BridgeTraceHeader)) / sizeof(BridgeTraceEntry);
+
+  // Skip overwritten entries.
+  header->lost = 0;
+  if (head_ - tail_ > RING_SIZE) {
+    header->lost = head_ - tail_ - RING_SIZE;
+    tail_ = head_ - RING_SIZE;
+  }
+
+  header->count = 0;
+  while (tail_ != head_ && header->count < capacity) {
+    BridgeTraceEntry& entry = entries[header->count];
+    entry = ring_[tail_ & (RING_SIZE - 1)];
+
+    uint64_t nanoseconds = 0;
+    absolutetime_to_nanoseconds(entry.timestamp, &nanoseconds);
+    entry.timestamp = nanoseconds;
+
+    ++(header->count);
+    ++tail_;
+  }
+
+  return true;
+}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Config.hpp"
+#include "KeyCode.hpp"
+#include "Types.hpp"
+#include "bridge.h"
+
+namespace org_pqrs_Karabiner {
+class Params_Base;
+
+// EventTrace records input and output events into a fixed size ring in binary.
+// The ring is read by BRIDGE_USERCLIENT_TYPE_GET_TRACE.
+//
+// Recording is disabled unless general.enable_event_trace is set.
+// When enabled, recording is a few stores and one virtual call (Params_Base::trace), and it does not allocate memory.
+// Old entries are overwritten if the ring is not read. (They are counted as lost entries.)
+//
+// All methods must be called while GlobalLock is held.
+class EventTrace final {
+public:
+  static void initialize(void);
+
+  static bool enabled(void) {
+    return Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_general_enable_event_trace);
+  }
+
+  // Input events. (timestamp is the HID timestamp of the event.)
+  static void record(uint32_t tag, const Params_Base& paramsBase, const DeviceIdentifier& deviceIdentifier, uint64_t timestamp) {
+    if (!enabled()) return;
+    record_(tag, paramsBase, deviceIdentifier, AutogenId(0), timestamp);
+  }
+  // Output events. (They are recorded at the current time.)
+  static void record(uint32_t tag, const Params_Base& paramsBase, AutogenId autogenId) {
+    if (!enabled()) return;
+    record_(tag, paramsBase, DeviceIdentifier(), autogenId, 0);
+  }
+
+  // Move entries from the ring into buffer. (buffer is BridgeTraceHeader followed by BridgeTraceEntry array.)
+  // Return false if size is too small.
+  static bool drain(uint8_t* buffer, size_t size);
+
+private:
+  // timestamp is an absolute time. (The current time is used if timestamp is 0.)
+  static void record_(uint32_t tag, const Params_Base& paramsBase, const DeviceIdentifier& deviceIdentifier, AutogenId autogenId, uint64_t timestamp);
+
+  enum {
+    // The number of entries must be a power of 2.
+    RING_SIZE = 2048,
+  };
+
+  static BridgeTraceEntry ring_[RING_SIZE];
+  // The number of recorded entries. (entries are stored at ring_[head_ & (RING_SIZE - 1)].)
+  static uint32_t head_;
+  // The number of read entries.
+  static uint32_t tail_;
+};
+}
@@ -458,7 +458,7 @@ void FlagStatus::updateStatusMessage(void) {
     int idx = indexes[i];
 
     static char previousMessage[BRIDGE_USERCLIENT_STATUS_MESSAGE_MAXLEN];
-    strlcat(previousMessage, CommonData::get_statusmessage(idx), sizeof(previousMessage));
+    strlcpy(previousMessage, CommonData::get_statusmessage(idx), sizeof(previousMessage));
 
     updateStatusMessage(idx);
 
@@ -164,6 +164,14 @@ public:
     if (type_ != Type::KEY) return ModifierFlag::ZERO;
     return key_.getModifierFlag();
   }
+  KeyCode getKeyCode(void) const {
+    if (type_ != Type::KEY) return KeyCode::VK_NONE;
+    return key_;
+  }
+  ConsumerKeyCode getConsumerKeyCode(void) const {
+    if (type_ != Type::CONSUMER_KEY) return ConsumerKeyCode::VK_NONE;
+    return consumer_;
+  }
   PointingButton getPointingButton(void) const {
     if (type_ != Type::POINTING_BUTTON) return PointingButton::NONE;
     return button_;
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "FromEvent.hpp"
+
+namespace org_pqrs_Karabiner {
+// A set of KeyCode, ConsumerKeyCode and PointingButton.
+//
+// EventInputQueue uses it to delay only events which are used in __SimultaneousKeyPresses__.
+// (Other events are fired immediately.)
+class FromEventBitmap final {
+public:
+  FromEventBitmap(void) { clear(); }
+
+  void clear(void) {
+    for (auto& v : keyCode_) {
+      v = 0;
+    }
+    for (auto& v : consumerKeyCode_) {
+      v = 0;
+    }
+    pointingButton_ = 0;
+    hasLargeKeyCode_ = false;
+    hasLargeConsumerKeyCode_ = false;
+  }
+
+  void add(const FromEvent& fromEvent) {
+    switch (fromEvent.getType()) {
+    case FromEvent::Type::KEY:
+      set(keyCode_, hasLargeKeyCode_, fromEvent.getKeyCode().get());
+      break;
+    case FromEvent::Type::CONSUMER_KEY:
+      set(consumerKeyCode_, hasLargeConsumerKeyCode_, fromEvent.getConsumerKeyCode().get());
+      break;
+    case FromEvent::Type::POINTING_BUTTON:
+      pointingButton_ |= fromEvent.getPointingButton().get();
+      break;
+    case FromEvent::Type::NONE:
+      break;
+    }
+  }
+
+  bool isTarget(const Params_Base& paramsBase) const {
+    FromEvent fromEvent(paramsBase);
+
+    switch (fromEvent.getType()) {
+    case FromEvent::Type::KEY:
+      return test(keyCode_, hasLargeKeyCode_, fromEvent.getKeyCode().get());
+    case FromEvent::Type::CONSUMER_KEY:
+      return test(consumerKeyCode_, hasLargeConsumerKeyCode_, fromEvent.getConsumerKeyCode().get());
+    case FromEvent::Type::POINTING_BUTTON:
+      return (pointingButton_ & fromEvent.getPointingButton().get()) != 0;
+    case FromEvent::Type::NONE:
+      return false;
+    }
+
+    return false;
+  }
+
+private:
+  enum {
+    // Physical KeyCode and ConsumerKeyCode are less than 256.
+    // We treat all larger values as target if a larger value is added.
+    BITMAP_SIZE = 256,
+  };
+
+  static void set(uint32_t (&bitmap)[BITMAP_SIZE / 32], bool& hasLargeValue, unsigned int value) {
+    if (value >= BITMAP_SIZE) {
+      hasLargeValue = true;
+    } else {
+      bitmap[value / 32] |= (1u << (value % 32));
+    }
+  }
+
+  static bool test(const uint32_t (&bitmap)[BITMAP_SIZE / 32], bool hasLargeValue, unsigned int value) {
+    if (value >= BITMAP_SIZE) {
+      return hasLargeValue;
+    } else {
+      return (bitmap[value / 32] & (1u << (value % 32))) != 0;
+    }
+  }
+
+  uint32_t keyCode_[BITMAP_SIZE / 32];
+  uint32_t consumerKeyCode_[BITMAP_SIZE / 32];
+  uint32_t pointingButton_;
+  bool hasLargeKeyCode_;
+  bool hasLargeConsumerKeyCode_;
+};
+}
@@ -6,31 +6,34 @@ BEGIN_IOKIT_INCLUDE;
 #include <IOKit/IOLib.h>
 END_IOKIT_INCLUDE;
 
+#include "BinaryLog.hpp"
 #include "Config.hpp"
 
-#define IOLOG_DEBUG(...)                                    \
-  {                                                         \
-    if (!org_pqrs_Karabiner::IOLogWrapper::suppressed()) {  \
-      if (Config::get_debug()) {                            \
-        IOLog("org.pqrs.Karabiner --Debug-- " __VA_ARGS__); \
-      }                                                     \
-    }                                                       \
+// IOLOG_DEBUG, IOLOG_DEBUG_POINTING and IOLOG_DEVEL are recorded into BinaryLog.
+// format must be a string literal because the format id is calculated at compile time.
+#define IOLOG_BINARY(level, format, ...)                                           \
+  {                                                                                \
+    constexpr uint32_t formatId = org_pqrs_Karabiner::BinaryLog::formatId(format); \
+    org_pqrs_Karabiner::BinaryLog::record(level, formatId, format, ##__VA_ARGS__); \
   }
-#define IOLOG_DEBUG_POINTING(...)                           \
-  {                                                         \
-    if (!org_pqrs_Karabiner::IOLogWrapper::suppressed()) {  \
-      if (Config::get_debug_pointing()) {                   \
-        IOLog("org.pqrs.Karabiner --Debug-- " __VA_ARGS__); \
-      }                                                     \
-    }                                                       \
+
+#define IOLOG_DEBUG(...)                                 \
+  {                                                      \
+    if (Config::get_debug()) {                           \
+      IOLOG_BINARY(BRIDGE_LOG_LEVEL_DEBUG, __VA_ARGS__); \
+    }                                                    \
+  }
+#define IOLOG_DEBUG_POINTING(...)                                 \
+  {                                                               \
+    if (Config::get_debug_pointing()) {                           \
+      IOLOG_BINARY(BRIDGE_LOG_LEVEL_DEBUG_POINTING, __VA_ARGS__); \
+    }                                                             \
   }
-#define IOLOG_DEVEL(...)                                    \
-  {                                                         \
-    if (!org_pqrs_Karabiner::IOLogWrapper::suppressed()) {  \
-      if (Config::get_debug_devel()) {                      \
-        IOLog("org.pqrs.Karabiner --Devel-- " __VA_ARGS__); \
-      }                                                     \
-    }                                                       \
+#define IOLOG_DEVEL(...)                                 \
+  {                                                      \
+    if (Config::get_debug_devel()) {                     \
+      IOLOG_BINARY(BRIDGE_LOG_LEVEL_DEVEL, __VA_ARGS__); \
+    }                                                    \
   }
 
 #define IOLOG_ERROR(...)                                   \
@@ -3,6 +3,9 @@
 
 namespace org_pqrs_Karabiner {
 KeyCodeModifierFlagPairs::Vector_Pair KeyCodeModifierFlagPairs::pairs_;
+KeyCodeModifierFlagPairs::Vector_KeyCodeTableEntry KeyCodeModifierFlagPairs::keyCodeTable_;
+Vector_int KeyCodeModifierFlagPairs::modifierFlagTable_;
+uint32_t KeyCodeModifierFlagPairs::generation_ = 0;
 
 void KeyCodeModifierFlagPairs::clearVirtualModifiers(void) {
   pairs_.clear();
@@ -34,6 +37,8 @@ void KeyCodeModifierFlagPairs::clearVirtualModifiers(void) {
   REGISTER_MODIFIER(SHIFT_R);
 #undef REGISTER_MODIFIER
 
+  rebuildTables();
+
   FlagStatus::globalFlagStatus().initialize();
 }
 
@@ -60,6 +65,68 @@ void KeyCodeModifierFlagPairs::registerVirtualModifier(ModifierFlag m,
                         vk_sticky_force_on,
                         vk_sticky_force_off));
 
+  rebuildTables();
+
   FlagStatus::globalFlagStatus().initialize();
 }
+
+void KeyCodeModifierFlagPairs::rebuildTables(void) {
+  ++generation_;
+
+  // ----------------------------------------
+  // keyCodeTable_
+  keyCodeTable_.clear();
+
+  // Keep the load factor less than 0.5.
+  size_t size = 16;
+  while (size < pairs_.size() * KeyCodeType::__END__ * 2) {
+    size *= 2;
+  }
+  keyCodeTable_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    keyCodeTable_.push_back(KeyCodeTableEntry());
+  }
+
+  for (size_t i = 0; i < pairs_.size(); ++i) {
+    for (int t = 0; t < KeyCodeType::__END__; ++t) {
+      auto type = static_cast<KeyCodeType::Value>(t);
+      KeyCode k = pairs_[i].getKeyCode(type);
+
+      for (size_t j = hash(k, type) & (size - 1);; j = (j + 1) & (size - 1)) {
+        KeyCodeTableEntry& e = keyCodeTable_[j];
+        if (e.empty()) {
+          e = KeyCodeTableEntry(static_cast<int>(i), type);
+          break;
+        }
+        // The first pair takes priority if the same KeyCode is registered in multiple pairs.
+        if (e.getType() == type && pairs_[e.getIndex()].getKeyCode(type) == k) {
+          break;
+        }
+      }
+    }
+  }
+
+  // ----------------------------------------
+  // modifierFlagTable_
+  modifierFlagTable_.clear();
+
+  size = 0;
+  for (size_t i = 0; i < pairs_.size(); ++i) {
+    unsigned int value = pairs_[i].getModifierFlag().get();
+    if (value < MODIFIERFLAG_TABLE_MAX_SIZE && value >= size) {
+      size = value + 1;
+    }
+  }
+  modifierFlagTable_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    modifierFlagTable_.push_back(-1);
+  }
+
+  for (size_t i = 0; i < pairs_.size(); ++i) {
+    unsigned int value = pairs_[i].getModifierFlag().get();
+    if (value < size && modifierFlagTable_[value] < 0) {
+      modifierFlagTable_[value] = static_cast<int>(i);
+    }
+  }
+}
 }
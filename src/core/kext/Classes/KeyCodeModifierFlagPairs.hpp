@@ -79,26 +79,86 @@ public:
                                       KeyCode vk_sticky_force_off);
 
   static const Vector_Pair& getPairs(void) { return pairs_; }
+  // The generation is incremented when pairs_ is changed.
+  static uint32_t getGeneration(void) { return generation_; }
 
   static KeyCode getKeyCode(ModifierFlag m, KeyCodeType::Value type) {
-    for (size_t i = 0; i < pairs_.size(); ++i) {
-      if (pairs_[i].getModifierFlag() == m) {
-        return pairs_[i].getKeyCode(type);
+    int index = findPairIndex(m);
+    if (index < 0) return KeyCode::VK_NONE;
+    return pairs_[index].getKeyCode(type);
+  }
+
+  static ModifierFlag getModifierFlag(KeyCode k, KeyCodeType::Value type) {
+    int index = findPairIndex(k, type);
+    if (index < 0) return ModifierFlag::ZERO;
+    return pairs_[index].getModifierFlag();
+  }
+
+private:
+  enum {
+    // ModifierFlag values are sequential numbers. (ModifierFlag::VK__AUTOINDEX__BEGIN__ and later are virtual modifiers.)
+    // We use linear search for larger values.
+    MODIFIERFLAG_TABLE_MAX_SIZE = 1024,
+  };
+
+  // An entry of keyCodeTable_.
+  class KeyCodeTableEntry final {
+  public:
+    KeyCodeTableEntry(void) : index_(-1), type_(KeyCodeType::__END__) {}
+    KeyCodeTableEntry(int index, KeyCodeType::Value type) : index_(index), type_(type) {}
+
+    bool empty(void) const { return index_ < 0; }
+    int getIndex(void) const { return index_; }
+    KeyCodeType::Value getType(void) const { return type_; }
+
+  private:
+    int index_;
+    KeyCodeType::Value type_;
+  };
+  DECLARE_VECTOR(KeyCodeTableEntry);
+
+  static uint32_t hash(KeyCode k, KeyCodeType::Value type) {
+    return k.get() * 2654435761u + static_cast<uint32_t>(type) * 40503u;
+  }
+
+  static void rebuildTables(void);
+
+  // Return the index of pairs_ or -1.
+  static int findPairIndex(KeyCode k, KeyCodeType::Value type) {
+    size_t size = keyCodeTable_.size();
+    if (size == 0) return -1;
+
+    // size is a power of 2 and keyCodeTable_ always has empty entries.
+    for (size_t i = hash(k, type) & (size - 1);; i = (i + 1) & (size - 1)) {
+      const KeyCodeTableEntry& e = keyCodeTable_[i];
+      if (e.empty()) return -1;
+      if (e.getType() == type && pairs_[e.getIndex()].getKeyCode(type) == k) {
+        return e.getIndex();
       }
     }
-    return KeyCode::VK_NONE;
   }
 
-  static ModifierFlag getModifierFlag(KeyCode k, KeyCodeType::Value type) {
+  static int findPairIndex(ModifierFlag m) {
+    if (m.get() < modifierFlagTable_.size()) {
+      return modifierFlagTable_[m.get()];
+    }
     for (size_t i = 0; i < pairs_.size(); ++i) {
-      if (pairs_[i].getKeyCode(type) == k) {
-        return pairs_[i].getModifierFlag();
+      if (pairs_[i].getModifierFlag() == m) {
+        return static_cast<int>(i);
       }
     }
-    return ModifierFlag::ZERO;
+    return -1;
   }
 
-private:
   static Vector_Pair pairs_;
+
+  // Lookup tables of pairs_. They are rebuilt when pairs_ is changed.
+  //
+  // keyCodeTable_: (KeyCode, KeyCodeType) -> index of pairs_ (open addressing).
+  // modifierFlagTable_: ModifierFlag value -> index of pairs_ or -1.
+  static Vector_KeyCodeTableEntry keyCodeTable_;
+  static Vector_int modifierFlagTable_;
+
+  static uint32_t generation_;
 };
 }
@@ -0,0 +1,67 @@
+#include "diagnostic_macros.hpp"
+
+BEGIN_IOKIT_INCLUDE;
+#include <IOKit/IOLib.h>
+END_IOKIT_INCLUDE;
+
+#include "IOLogWrapper.hpp"
+#include "LatencyHistogram.hpp"
+
+namespace org_pqrs_Karabiner {
+BridgeLatencyHistogram LatencyHistogram::histograms_[BRIDGE_LATENCY_CLASS__END__];
+
+void LatencyHistogram::initialize(void) {
+  memset(histograms_, 0, sizeof(histograms_));
+}
+
+void LatencyHistogram::record(uint32_t latencyClass, uint64_t inputTimestamp) {
+  if (inputTimestamp == 0) return;
+  if (latencyClass >= BRIDGE_LATENCY_CLASS__END__) return;
+
+  uint64_t now = 0;
+  clock_get_uptime(&now);
+  // The HID timestamp might be later than now if the device clock is not synchronized.
+  if (now < inputTimestamp) return;
+
+  uint64_t nanoseconds = 0;
+  absolutetime_to_nanoseconds(now - inputTimestamp, &nanoseconds);
+  uint64_t microseconds = nanoseconds / 1000;
+
+  BridgeLatencyHistogram& h = histograms_[latencyClass];
+  ++(h.count);
+  h.sum += microseconds;
+  if (h.max < microseconds) {
+    h.max = microseconds;
+  }
+  ++(h.buckets[getBucketIndex(microseconds)]);
+}
+
+bool LatencyHistogram::get(uint32_t option, uint8_t* buffer, size_t size) {
+  if (!buffer || size != sizeof(histograms_)) {
+    IOLOG_ERROR("LatencyHistogram::get wrong 'size' parameter\n");
+    return false;
+  }
+
+  memcpy(buffer, histograms_, sizeof(histograms_));
+
+  if (option == BRIDGE_LATENCY_HISTOGRAM_OPTION_RESET) {
+    initialize();
+  }
+  return true;
+}
+
+uint32_t LatencyHistogram::getBucketIndex(uint64_t microseconds) {
+  const uint32_t sub = BRIDGE_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT;
+  if (microseconds < sub) {
+    return static_cast<uint32_t>(microseconds);
+  }
+
+  // The position of the most significant bit. (>= 2)
+  uint32_t msb = 63 - __builtin_clzll(microseconds);
+  uint32_t index = (msb - 1) * sub + ((microseconds >> (msb - 2)) & (sub - 1));
+  if (index >= BRIDGE_LATENCY_HISTOGRAM_BUCKET_COUNT - 1) {
+    return BRIDGE_LATENCY_HISTOGRAM_BUCKET_COUNT - 1;
+  }
+  return index;
+}
+}
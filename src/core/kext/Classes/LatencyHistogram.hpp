@@ -0,0 +1,27 @@
+#pragma once
+
+#include "bridge.h"
+
+namespace org_pqrs_Karabiner {
+// LatencyHistogram records the latency from input events to output events.
+// The histograms are read by BRIDGE_USERCLIENT_TYPE_GET_LATENCY_HISTOGRAMS.
+//
+// All methods must be called while GlobalLock is held.
+class LatencyHistogram final {
+public:
+  static void initialize(void);
+
+  // Record the time from inputTimestamp (absolute time) to now.
+  // Do nothing if inputTimestamp is 0. (The output event is not produced by an input event.)
+  static void record(uint32_t latencyClass, uint64_t inputTimestamp);
+
+  // Copy histograms into buffer. (buffer is BridgeLatencyHistogram[BRIDGE_LATENCY_CLASS__END__].)
+  // option is BRIDGE_LATENCY_HISTOGRAM_OPTION_*.
+  static bool get(uint32_t option, uint8_t* buffer, size_t size);
+
+  static uint32_t getBucketIndex(uint64_t microseconds);
+
+private:
+  static BridgeLatencyHistogram histograms_[BRIDGE_LATENCY_CLASS__END__];
+};
+}
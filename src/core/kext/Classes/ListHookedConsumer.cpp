@@ -14,6 +14,7 @@ END_IOKIT_INCLUDE;
 #include "FlagStatus.hpp"
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
+#include "LatencyHistogram.hpp"
 #include "ListHookedConsumer.hpp"
 #include "Params.hpp"
 
@@ -202,6 +203,7 @@ void ListHookedConsumer::Item::disableNumLock(void) {
 bool ListHookedConsumer::apply(const Params_KeyboardSpecialEventCallback& params) {
   ListHookedConsumer::Item* p = static_cast<ListHookedConsumer::Item*>(get_replaced());
   if (p) {
+    LatencyHistogram::record(BRIDGE_LATENCY_CLASS_CONSUMER, CommonData::getcurrent_inputts());
     p->apply(params);
     return true;
   }
@@ -5,6 +5,7 @@ BEGIN_IOKIT_INCLUDE;
 END_IOKIT_INCLUDE;
 
 #include "Config.hpp"
+#include "DeviceFilterTable.hpp"
 #include "IOLogWrapper.hpp"
 #include "ListHookedConsumer.hpp"
 #include "ListHookedDevice.hpp"
@@ -16,6 +17,7 @@ END_IOKIT_INCLUDE;
 
 namespace org_pqrs_Karabiner {
 TimerWrapper ListHookedDevice::refreshInProgressDevices_timer_;
+size_t ListHookedDevice::pressingPhysicalKeysCountAll_ = 0;
 
 DEFINE_WEAKPOINTER_IN_CLASS(ListHookedDevice, Item);
 
@@ -162,6 +164,8 @@ bool ListHookedDevice::initialize(void) {
 
 void ListHookedDevice::terminate(void) {
   list_.clear();
+  index_.clear();
+  rebuildDeviceFilterTableAll();
 }
 
 void ListHookedDevice::push_back(ListHookedDevice::Item* newp) {
@@ -169,6 +173,7 @@ void ListHookedDevice::push_back(ListHookedDevice::Item* newp) {
 
   last_ = newp->device_;
   list_.push_back(newp);
+  rebuildIndex();
 
   IOLOG_DEVEL("ListHookedDevice::push_back list_.size = %d\n", static_cast<int>(list_.size()));
 
@@ -181,6 +186,7 @@ void ListHookedDevice::erase(IOHIDevice* p) {
   if (!item) return;
 
   list_.erase_and_delete(item);
+  rebuildIndex();
 
   IOLOG_DEVEL("ListHookedDevice::erase list_.size = %d\n", static_cast<int>(list_.size()));
 
@@ -191,11 +197,30 @@ ListHookedDevice::Item*
 ListHookedDevice::get(const IOHIDevice* device) {
   last_ = device;
 
+  return static_cast<Item*>(index_.get(device));
+}
+
+void ListHookedDevice::rebuildIndex(void) {
+  index_.reserve(list_.size());
+
   for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
-    if (p->device_ == device) return p;
+    index_.add(p->device_, p, p->deviceIdentifier_);
   }
 
-  return nullptr;
+  rebuildDeviceFilterTableAll();
+}
+
+void ListHookedDevice::addToDeviceFilterTable(void) const {
+  for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
+    DeviceFilterTable::addDevice(p->deviceIdentifier_);
+  }
+}
+
+void ListHookedDevice::rebuildDeviceFilterTableAll(void) {
+  DeviceFilterTable::clearDevices();
+  ListHookedKeyboard::instance().addToDeviceFilterTable();
+  ListHookedConsumer::instance().addToDeviceFilterTable();
+  ListHookedPointing::instance().addToDeviceFilterTable();
 }
 
 ListHookedDevice::Item*
@@ -230,15 +255,6 @@ bool ListHookedDevice::isInProgress(void) const {
   return false;
 }
 
-size_t ListHookedDevice::totalPressingPhysicalKeysCount(void) const {
-  size_t count = 0;
-  for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
-    count += (p->pressingPhysicalKeys_).count();
-  }
-
-  return count;
-}
-
 size_t ListHookedDevice::devicePressingPhysicalKeysCount(const IOHIDevice* device) {
   auto p = get(device);
   if (!p) {
@@ -250,18 +266,14 @@ size_t ListHookedDevice::devicePressingPhysicalKeysCount(const IOHIDevice* devic
 void ListHookedDevice::clearPressingPhysicalKeysCount(void) const {
   for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
     if (p->isInternalDevice()) {
+      pressingPhysicalKeysCountAll_ -= (p->pressingPhysicalKeys_).count();
       (p->pressingPhysicalKeys_).clear();
     }
   }
 }
 
 bool ListHookedDevice::exists(const DeviceIdentifier& deviceIdentifier) const {
-  for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
-    if (p->deviceIdentifier_.isEqual(deviceIdentifier)) {
-      return true;
-    }
-  }
-  return false;
+  return index_.exists(deviceIdentifier);
 }
 
 void ListHookedDevice::getDeviceInformation(BridgeDeviceInformation& out, size_t index) const {
@@ -313,6 +325,33 @@ void ListHookedDevice::getDeviceInformation(BridgeDeviceInformation& out, size_t
   out.isFound = 1;
 }
 
+namespace {
+// Compare sequences of DeferredEventQueue::Record considering wraparound.
+bool isOlderDeferredEventItem(ListHookedDevice::Item* item, ListHookedDevice::Item* than) {
+  if (!item) return false;
+  if (!than) return true;
+
+  uint32_t s1 = item->getDeferredEventQueue().front()->sequence;
+  uint32_t s2 = than->getDeferredEventQueue().front()->sequence;
+  return static_cast<int32_t>(s1 - s2) < 0;
+}
+}
+
+ListHookedDevice::Item*
+ListHookedDevice::getOldestDeferredEventItem(void) const {
+  Item* oldest = nullptr;
+
+  for (Item* p = static_cast<Item*>(list_.safe_front()); p; p = static_cast<Item*>(p->getnext())) {
+    if (p->getDeferredEventQueue().empty()) continue;
+
+    if (isOlderDeferredEventItem(p, oldest)) {
+      oldest = p;
+    }
+  }
+
+  return oldest;
+}
+
 void ListHookedDevice::initializeAll(IOWorkLoop& workloop) {
   ListHookedKeyboard::instance().initialize();
   ListHookedConsumer::instance().initialize();
@@ -336,11 +375,8 @@ void ListHookedDevice::refreshAll(void) {
 }
 
 size_t ListHookedDevice::totalPressingPhysicalKeysCountAll(void) {
-  size_t count = ListHookedKeyboard::instance().totalPressingPhysicalKeysCount() +
-                 ListHookedConsumer::instance().totalPressingPhysicalKeysCount() +
-                 ListHookedPointing::instance().totalPressingPhysicalKeysCount();
-  IOLOG_DEVEL("ListHookedDevice::totalPressingPhysicalKeysCountAll: %ld\n", count);
-  return count;
+  IOLOG_DEVEL("ListHookedDevice::totalPressingPhysicalKeysCountAll: %ld\n", pressingPhysicalKeysCountAll_);
+  return pressingPhysicalKeysCountAll_;
 }
 
 size_t ListHookedDevice::devicePressingPhysicalKeysCountAll(const IOHIDevice* device) {
@@ -361,6 +397,23 @@ bool ListHookedDevice::existsAll(const DeviceIdentifier& deviceIdentifier) {
          ListHookedPointing::instance().exists(deviceIdentifier);
 }
 
+ListHookedDevice::Item*
+ListHookedDevice::getOldestDeferredEventItemAll(void) {
+  Item* oldest = ListHookedKeyboard::instance().getOldestDeferredEventItem();
+
+  Item* p = ListHookedConsumer::instance().getOldestDeferredEventItem();
+  if (isOlderDeferredEventItem(p, oldest)) {
+    oldest = p;
+  }
+
+  p = ListHookedPointing::instance().getOldestDeferredEventItem();
+  if (isOlderDeferredEventItem(p, oldest)) {
+    oldest = p;
+  }
+
+  return oldest;
+}
+
 void ListHookedDevice::start_refreshInProgressDevices_timer(void) {
   refreshInProgressDevices_timer_.setTimeoutMS(REFRESH_INPROGRESS_DEVICES_TIMER_INTERVAL);
 }
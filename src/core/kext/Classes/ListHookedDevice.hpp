@@ -6,6 +6,8 @@ BEGIN_IOKIT_INCLUDE;
 #include <IOKit/hidsystem/IOHIDevice.h>
 END_IOKIT_INCLUDE;
 
+#include "DeferredEventQueue.hpp"
+#include "DeviceIndex.hpp"
 #include "KeyCode.hpp"
 #include "List.hpp"
 #include "PressingPhysicalKeys.hpp"
@@ -32,6 +34,8 @@ public:
     }
 
     virtual ~Item(void) {
+      pressingPhysicalKeysCountAll_ -= pressingPhysicalKeys_.count();
+
       WeakPointerManager_Item::remove(this);
     };
 
@@ -46,9 +50,13 @@ public:
 
     size_t pressingPhysicalKeysCount(void) const { return pressingPhysicalKeys_.count(); }
     void updatePressingPhysicalKeys(const Params_Base& paramsBase) {
+      pressingPhysicalKeysCountAll_ -= pressingPhysicalKeys_.count();
       pressingPhysicalKeys_.update(paramsBase);
+      pressingPhysicalKeysCountAll_ += pressingPhysicalKeys_.count();
     }
 
+    DeferredEventQueue& getDeferredEventQueue(void) { return deferredEventQueue_; }
+
   protected:
     IOHIDevice* device_;
     DeviceIdentifier deviceIdentifier_;
@@ -63,6 +71,9 @@ public:
 
     PressingPhysicalKeys pressingPhysicalKeys_;
 
+    // Raw events which are not processed yet.
+    DeferredEventQueue deferredEventQueue_;
+
     virtual bool refresh(void) = 0;
 
     void setDeviceIdentifier(void);
@@ -79,7 +90,6 @@ public:
   void refresh(void);
   bool isInProgress(void) const;
 
-  size_t totalPressingPhysicalKeysCount(void) const;
   size_t devicePressingPhysicalKeysCount(const IOHIDevice* device);
   void clearPressingPhysicalKeysCount(void) const;
 
@@ -87,6 +97,8 @@ public:
   ListHookedDevice::Item* get_replaced(void);
 
   bool exists(const DeviceIdentifier& deviceIdentifier) const;
+  // Return the item which has the oldest DeferredEventQueue record. (nullptr if there is no record.)
+  ListHookedDevice::Item* getOldestDeferredEventItem(void) const;
   void getDeviceInformation(BridgeDeviceInformation& out, size_t index) const;
 
   static void initializeAll(IOWorkLoop& workloop);
@@ -96,6 +108,7 @@ public:
   static size_t devicePressingPhysicalKeysCountAll(const IOHIDevice* device);
   static void clearInternalKeyboardPressingPhysicalKeysCountAll(void);
   static bool existsAll(const DeviceIdentifier& deviceIdentifier);
+  static ListHookedDevice::Item* getOldestDeferredEventItemAll(void);
 
   static void start_refreshInProgressDevices_timer(void);
   static void refreshInProgressDevices_timer_callback(OSObject* owner, IOTimerEventSource* sender);
@@ -111,6 +124,16 @@ private:
   enum {
     REFRESH_INPROGRESS_DEVICES_TIMER_INTERVAL = 1000,
   };
+
+  // Call after list_ is changed.
+  void rebuildIndex(void);
+  void addToDeviceFilterTable(void) const;
+  static void rebuildDeviceFilterTableAll(void);
+
+  DeviceIndex index_;
+
   static TimerWrapper refreshInProgressDevices_timer_;
+  // The sum of pressingPhysicalKeys_.count() of all devices in all lists.
+  static size_t pressingPhysicalKeysCountAll_;
 };
 }
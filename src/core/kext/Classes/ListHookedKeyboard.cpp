@@ -14,6 +14,7 @@ END_IOKIT_INCLUDE;
 #include "FlagStatus.hpp"
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
+#include "LatencyHistogram.hpp"
 #include "ListHookedKeyboard.hpp"
 #include "RemapClass.hpp"
 
@@ -306,6 +307,7 @@ void ListHookedKeyboard::Item::apply(const Params_UpdateEventFlagsCallback& para
 void ListHookedKeyboard::apply(const Params_KeyboardEventCallBack& params) {
   ListHookedKeyboard::Item* p = static_cast<ListHookedKeyboard::Item*>(get_replaced());
   if (p) {
+    LatencyHistogram::record(BRIDGE_LATENCY_CLASS_KEYBOARD, CommonData::getcurrent_inputts());
     p->apply(params);
   }
 }
@@ -14,6 +14,7 @@ END_IOKIT_INCLUDE;
 #include "FlagStatus.hpp"
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
+#include "LatencyHistogram.hpp"
 #include "ListHookedPointing.hpp"
 
 namespace org_pqrs_Karabiner {
@@ -223,6 +224,8 @@ void ListHookedPointing::Item::apply(const Params_ScrollWheelEventCallback& para
 }
 
 void ListHookedPointing::apply(const Params_RelativePointerEventCallback& params) {
+  LatencyHistogram::record(BRIDGE_LATENCY_CLASS_RELATIVE_POINTER, CommonData::getcurrent_inputts());
+
   // if all button are released, send event for all devices.
   if (params.buttons == Buttons(0) &&
       params.dx == 0 &&
@@ -244,6 +247,7 @@ void ListHookedPointing::apply(const Params_RelativePointerEventCallback& params
 void ListHookedPointing::apply(const Params_ScrollWheelEventCallback& params) {
   ListHookedPointing::Item* p = static_cast<ListHookedPointing::Item*>(get_replaced());
   if (p) {
+    LatencyHistogram::record(BRIDGE_LATENCY_CLASS_SCROLL_WHEEL, CommonData::getcurrent_inputts());
     p->apply(params);
   }
 }
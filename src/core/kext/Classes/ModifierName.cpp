@@ -2,6 +2,7 @@
 
 namespace org_pqrs_Karabiner {
 ModifierName::Vector_Item ModifierName::items_;
+Vector_int ModifierName::table_;
 
 void ModifierName::clearVirtualModifiers(void) {
   items_.clear();
@@ -17,25 +18,31 @@ void ModifierName::clearVirtualModifiers(void) {
   items_.push_back(Item(ModifierFlag::COMMAND_L, "command", "⌘"));
   items_.push_back(Item(ModifierFlag::COMMAND_R, "command", "⌘"));
   items_.push_back(Item(ModifierFlag::FN, "fn", "fn"));
+
+  rebuildTable();
 }
 
-const char*
-ModifierName::getName(ModifierFlag modifierFlag) {
+void ModifierName::rebuildTable(void) {
+  table_.clear();
+
+  size_t size = 0;
   for (size_t i = 0; i < items_.size(); ++i) {
-    if (modifierFlag == items_[i].getModifierFlag()) {
-      return items_[i].getName();
+    unsigned int value = items_[i].getModifierFlag().get();
+    if (value < TABLE_MAX_SIZE && value >= size) {
+      size = value + 1;
     }
   }
-  return nullptr;
-}
+  table_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    table_.push_back(-1);
+  }
 
-const char*
-ModifierName::getSymbol(ModifierFlag modifierFlag) {
+  // The first item takes priority if the same ModifierFlag is registered in multiple items.
   for (size_t i = 0; i < items_.size(); ++i) {
-    if (modifierFlag == items_[i].getModifierFlag()) {
-      return items_[i].getSymbol();
+    unsigned int value = items_[i].getModifierFlag().get();
+    if (value < size && table_[value] < 0) {
+      table_[value] = static_cast<int>(i);
     }
   }
-  return nullptr;
 }
 }
@@ -51,12 +51,44 @@ public:
 
   static void registerVirtualModifier(ModifierFlag modifierFlag, const char* name) {
     items_.push_back(Item(modifierFlag, name, name));
+    rebuildTable();
   }
 
-  static const char* getName(ModifierFlag modifierFlag);
-  static const char* getSymbol(ModifierFlag modifierFlag);
+  static const char* getName(ModifierFlag modifierFlag) {
+    int index = findItemIndex(modifierFlag);
+    if (index < 0) return nullptr;
+    return items_[index].getName();
+  }
+
+  static const char* getSymbol(ModifierFlag modifierFlag) {
+    int index = findItemIndex(modifierFlag);
+    if (index < 0) return nullptr;
+    return items_[index].getSymbol();
+  }
 
 private:
+  enum {
+    // We use linear search for larger ModifierFlag values.
+    TABLE_MAX_SIZE = 1024,
+  };
+
+  static void rebuildTable(void);
+
+  // Return the index of items_ or -1.
+  static int findItemIndex(ModifierFlag modifierFlag) {
+    if (modifierFlag.get() < table_.size()) {
+      return table_[modifierFlag.get()];
+    }
+    for (size_t i = 0; i < items_.size(); ++i) {
+      if (modifierFlag == items_[i].getModifierFlag()) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
   static Vector_Item items_;
+  // ModifierFlag value -> index of items_ or -1. (rebuilt when items_ is changed.)
+  static Vector_int table_;
 };
 }
@@ -0,0 +1,101 @@
+#include "ModifierTransition.hpp"
+#include "IOLogWrapper.hpp"
+#include "KeyCodeModifierFlagPairs.hpp"
+
+namespace org_pqrs_Karabiner {
+ModifierTransition ModifierTransition::cache_[CACHE_SIZE];
+
+bool ModifierTransition::push_back(KeyCode key, Flags flags) {
+  if (size_ >= MAX_EVENTS) {
+    IOLOG_ERROR("ModifierTransition::push_back too many events\n");
+    return false;
+  }
+
+  events_[size_].key = key;
+  events_[size_].flags = flags;
+  ++size_;
+  return true;
+}
+
+void ModifierTransition::make(Flags fromFlags, Flags toFlags) {
+  fromFlags_ = fromFlags;
+  toFlags_ = toFlags;
+  size_ = 0;
+  lastFlags_ = fromFlags;
+
+  if (fromFlags == toFlags) return;
+
+  // ------------------------------------------------------------
+  // At first we handle KeyUp events and handle KeyDown events next.
+  // We need to end KeyDown at Command+Space to Option_L+Shift_L.
+  //
+  // When Option_L+Shift_L has a meaning (switch input language at Windows),
+  // it does not works well when the last is KeyUp of Command.
+
+  // ModifierFlag::NUMPAD handling.
+  // (We need to remove ModifierFlag::NUMPAD at first in order to strip NUMPAD flag from normal modifier key events.)
+  if (!toFlags.isOn(ModifierFlag::NUMPAD)) {
+    lastFlags_.remove(ModifierFlag::NUMPAD);
+  }
+
+  auto& pairs = KeyCodeModifierFlagPairs::getPairs();
+
+  // ------------------------------------------------------------
+  // KeyUp
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    ModifierFlag flag = pairs[i].getModifierFlag();
+
+    // Skipping invalid flags
+    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
+    // Skipping virtual modifiers.
+    if (flag.getRawBits() == 0) continue;
+
+    // ----------------------------------------
+    if (!lastFlags_.isOn(flag)) continue;
+    if (toFlags.isOn(flag)) continue;
+
+    lastFlags_.remove(flag);
+
+    if (!push_back(flag.getKeyCode(), lastFlags_)) return;
+  }
+
+  // KeyDown
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    ModifierFlag flag = pairs[i].getModifierFlag();
+
+    // Skipping invalid flags
+    if (flag.getKeyCode() == KeyCode::VK_NONE) continue;
+    // Skipping virtual modifiers.
+    if (flag.getRawBits() == 0) continue;
+
+    // ----------------------------------------
+    if (!toFlags.isOn(flag)) continue;
+    if (lastFlags_.isOn(flag)) continue;
+
+    lastFlags_.add(flag);
+
+    if (!push_back(flag.getKeyCode(), lastFlags_)) return;
+  }
+
+  // ModifierFlag::NUMPAD handling.
+  // (We need to add ModifierFlag::NUMPAD at last in order to strip NUMPAD flag from normal modifier key events.)
+  if (toFlags.isOn(ModifierFlag::NUMPAD)) {
+    lastFlags_.add(ModifierFlag::NUMPAD);
+  }
+}
+
+const ModifierTransition& ModifierTransition::get(Flags fromFlags, Flags toFlags) {
+  uint32_t generation = KeyCodeModifierFlagPairs::getGeneration();
+
+  ModifierTransition& t = cache_[hash(fromFlags, toFlags) & (CACHE_SIZE - 1)];
+  if (!t.valid_ ||
+      t.generation_ != generation ||
+      !(t.fromFlags_ == fromFlags) ||
+      !(t.toFlags_ == toFlags)) {
+    t.make(fromFlags, toFlags);
+    t.generation_ = generation;
+    t.valid_ = true;
+  }
+  return t;
+}
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "KeyCode.hpp"
+
+namespace org_pqrs_Karabiner {
+// ModifierTransition is the sequence of modifier key events
+// which changes the sent flags from `fromFlags` to `toFlags`.
+// (EventOutputQueue::FireModifiers sends these events.)
+//
+// The sequence depends only on fromFlags, toFlags and KeyCodeModifierFlagPairs.
+// Therefore, the results are cached until KeyCodeModifierFlagPairs is changed.
+class ModifierTransition final {
+public:
+  enum {
+    // Each modifier is changed at most once in a transition.
+    MAX_EVENTS = 32,
+  };
+
+  class Event final {
+  public:
+    KeyCode key;
+    // The flags after this event.
+    Flags flags;
+  };
+
+  ModifierTransition(void) : generation_(0), valid_(false), size_(0) {}
+
+  // Calculate the transition without the cache.
+  void make(Flags fromFlags, Flags toFlags);
+
+  size_t size(void) const { return size_; }
+  const Event& operator[](size_t i) const { return events_[i]; }
+  // The sent flags after the transition.
+  Flags getLastFlags(void) const { return lastFlags_; }
+
+  // Return the cached transition. (The cache is filled at the first use.)
+  static const ModifierTransition& get(Flags fromFlags, Flags toFlags);
+
+private:
+  enum {
+    // The number of cache entries must be a power of 2.
+    CACHE_SIZE = 64,
+  };
+
+  static uint32_t hash(Flags fromFlags, Flags toFlags) {
+    return (fromFlags.get() * 2654435761u) ^ (toFlags.get() * 40503u);
+  }
+
+  bool push_back(KeyCode key, Flags flags);
+
+  Flags fromFlags_;
+  Flags toFlags_;
+  uint32_t generation_;
+  bool valid_;
+
+  Event events_[MAX_EVENTS];
+  size_t size_;
+  Flags lastFlags_;
+
+  static ModifierTransition cache_[CACHE_SIZE];
+};
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+namespace org_pqrs_Karabiner {
+// MouseKeyIntegrator converts the elapsed time of a mouse key into a distance of each axis.
+//
+// The speed is a function of the time since the mouse key is pressed (not the number of timer ticks),
+// and the distance is the integral of the speed.
+// Fractions which are not sent are carried over to the next call,
+// so the total distance does not depend on the timer interval or jitter.
+//
+// Speeds are expressed in units per period.
+// (The period is the repeat wait of mouse keys, so the meanings of existing parameters are kept.)
+
+class MouseKeyIntegrator final {
+public:
+  enum {
+    // Diagonal moves are multiplied by 1/sqrt(2) in order to keep the speed.
+    NORMALIZE_SCALE = 65536,
+    NORMALIZE_DIAGONAL = 46341, // (== NORMALIZE_SCALE / sqrt(2))
+
+    // The integration is capped at MAX_MILLISECONDS per call in order to avoid a jump after a stall.
+    MAX_MILLISECONDS = 1000,
+  };
+
+  class Parameters final {
+  public:
+    enum class Curve {
+      // speed = start
+      CONSTANT,
+      // speed = min(start + acceleration * t / period, maximum)
+      PIECEWISE_LINEAR,
+      // speed = min(start * 2^(t / doublingTime), maximum)
+      EXPONENTIAL,
+    };
+
+    Parameters(Curve c, int s, int a, int m, uint32_t p, uint32_t d) : curve(c),
+                                                                       start(s < 0 ? 0 : s),
+                                                                       acceleration(a < 0 ? 0 : a),
+                                                                       maximum(m < s ? s : m),
+                                                                       period(p < 1 ? 1 : p),
+                                                                       doublingTime(d < 1 ? 1 : d) {}
+
+    Curve curve;
+    int start;
+    int acceleration;
+    int maximum;
+    uint32_t period;
+    uint32_t doublingTime;
+  };
+
+  MouseKeyIntegrator(void) {
+    reset();
+  }
+
+  void reset(void) {
+    elapsed_ = 0;
+    period_ = 0;
+    magnitude_ = 0;
+    clearRemainders();
+  }
+
+  void clearRemainders(void) {
+    remainderX_ = 0;
+    remainderY_ = 0;
+    signX_ = 0;
+    signY_ = 0;
+  }
+
+  // The milliseconds which are already integrated.
+  uint32_t getElapsed(void) const { return elapsed_; }
+
+  // Integrate the speed from getElapsed() to `now` (milliseconds since reset).
+  // dx and dy are the direction (-1, 0, 1).
+  // Distances are multiplied by `magnitude`. (e.g., DELTA_SCALE for scroll wheel.)
+  void integrate(const Parameters& parameters, uint32_t now, int dx, int dy, int magnitude, int& outx, int& outy) {
+    outx = 0;
+    outy = 0;
+
+    if (now <= elapsed_) return;
+
+    uint32_t milliseconds = now - elapsed_;
+    if (milliseconds > MAX_MILLISECONDS) {
+      milliseconds = MAX_MILLISECONDS;
+    }
+
+    // sum of speed * period in each millisecond.
+    long long sum = 0;
+    for (uint32_t i = 0; i < milliseconds; ++i) {
+      sum += getScaledSpeed(parameters, elapsed_ + i);
+    }
+    elapsed_ = now;
+
+    // The unit of remainders depends on the period and magnitude.
+    if (period_ != parameters.period || magnitude_ != magnitude) {
+      period_ = parameters.period;
+      magnitude_ = magnitude;
+      clearRemainders();
+    }
+
+    int normalize = NORMALIZE_SCALE;
+    if (dx != 0 && dy != 0) {
+      normalize = NORMALIZE_DIAGONAL;
+    }
+
+    const long long period = parameters.period;
+    const long long denominator = period * period * NORMALIZE_SCALE;
+    const long long distance = sum * magnitude * normalize;
+
+    outx = divide(dx, distance, denominator, remainderX_, signX_);
+    outy = divide(dy, distance, denominator, remainderY_, signY_);
+  }
+
+  // speed * period at `t` milliseconds.
+  static long long getScaledSpeed(const Parameters& parameters, uint32_t t) {
+    const long long period = parameters.period;
+    const long long start = parameters.start * period;
+    const long long maximum = parameters.maximum * period;
+
+    long long speed = start;
+
+    switch (parameters.curve) {
+    case Parameters::Curve::CONSTANT:
+      return start;
+
+    case Parameters::Curve::PIECEWISE_LINEAR:
+      speed = start + static_cast<long long>(parameters.acceleration) * t;
+      break;
+
+    case Parameters::Curve::EXPONENTIAL:
+      speed = (start * pow2(static_cast<long long>(t) * FIXED_SCALE / parameters.doublingTime)) >> FIXED_SHIFT;
+      break;
+    }
+
+    if (speed > maximum) return maximum;
+    return speed;
+  }
+
+  // 2^x (x and the result are 16.16 fixed point)
+  static long long pow2(long long x) {
+    long long q = x >> FIXED_SHIFT;
+    long long r = x & (FIXED_SCALE - 1);
+    if (q > POW2_MAX_SHIFT) {
+      q = POW2_MAX_SHIFT;
+      r = 0;
+    }
+
+    // 2^r ~= 1 + r * (a + b * r) where a + b == 1 (error < 0.3%)
+    const long long a = 43024;
+    const long long b = FIXED_SCALE - a;
+    long long fraction = FIXED_SCALE + ((r * (a + ((b * r) >> FIXED_SHIFT))) >> FIXED_SHIFT);
+    return fraction << q;
+  }
+
+private:
+  enum {
+    FIXED_SHIFT = 16,
+    FIXED_SCALE = 1 << FIXED_SHIFT,
+    POW2_MAX_SHIFT = 24,
+  };
+
+  static int divide(int direction, long long distance, long long denominator, long long& remainder, int& sign) {
+    // Clear the carry when the direction is changed.
+    if (direction != sign) {
+      remainder = 0;
+      sign = direction;
+    }
+    if (direction == 0) return 0;
+
+    long long numerator = remainder + direction * distance;
+    long long value = numerator / denominator;
+    remainder = numerator - value * denominator;
+    return static_cast<int>(value);
+  }
+
+  uint32_t elapsed_;
+  uint32_t period_;
+  int magnitude_;
+  // in 1 / (period * period * NORMALIZE_SCALE) of units.
+  long long remainderX_;
+  long long remainderY_;
+  int signX_;
+  int signY_;
+};
+}
@@ -29,8 +29,21 @@ public:
   virtual bool isModifier(void) const { return false; }
   virtual bool isRepeat(void) const { return false; }
 
+  // Store the kind and values of the event into an EventTrace entry.
+  virtual void trace(BridgeTraceEntry& entry) const { setTraceEntry(entry, BRIDGE_TRACE_EVENT_NONE, 0, 0, 0, 0, 0); }
+
   static const Params_Base& emptyInstance(void);
   static const Params_Base& safe_dereference(const Params_Base* p) { return p == nullptr ? emptyInstance() : *p; }
+
+protected:
+  static void setTraceEntry(BridgeTraceEntry& entry, uint16_t event, uint32_t eventType, uint32_t value, uint32_t flags, int32_t x, int32_t y) {
+    entry.event = event;
+    entry.eventType = eventType;
+    entry.value = value;
+    entry.flags = flags;
+    entry.x = x;
+    entry.y = y;
+  }
 };
 
 // =================================================
@@ -60,6 +73,9 @@ public:
   }
   bool isModifier(void) const override { return key.isModifier(); }
   bool isRepeat(void) const override { return repeat; }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_KEYBOARD, eventType.get(), key.get(), flags.get(), 0, 0);
+  }
 
   // ----------------------------------------
   static void log(bool isCaught, EventType eventType, Flags flags, KeyCode key, KeyboardType keyboardType, bool repeat) {
@@ -90,6 +106,9 @@ public:
   ~Params_UpdateEventFlagsCallback(void) {}
 
   const Params_UpdateEventFlagsCallback* get_Params_UpdateEventFlagsCallback(void) const override { return this; }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_UPDATE_FLAGS, 0, 0, flags.get(), 0, 0);
+  }
 
   // ----------------------------------------
   static void log(bool isCaught, Flags flags) {
@@ -124,6 +143,9 @@ public:
     return true;
   }
   bool isRepeat(void) const override { return repeat; }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_CONSUMER, eventType.get(), key.get(), flags.get(), 0, 0);
+  }
 
   // ----------------------------------------
   static void log(bool isCaught, EventType eventType, Flags flags, ConsumerKeyCode key, unsigned int flavor, UInt64 guid, bool repeat) {
@@ -159,6 +181,15 @@ public:
     output = ex_isbuttondown;
     return true;
   }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_RELATIVE_POINTER, 0, buttons.get(), 0, dx, dy);
+  }
+
+  // Return true if the event is a cursor move without button changes.
+  // (Consecutive move events which have the same buttons are additive.)
+  bool isMove(void) const {
+    return ex_button == PointingButton::NONE && (dx != 0 || dy != 0);
+  }
 
   static void log(bool isCaught, Buttons buttons, int dx, int dy) {
     IOLOG_DEBUG_POINTING("RelativePointerEventCallBack [%7s]: buttons: 0x%08x, dx: %3d, dy: %3d\n",
@@ -194,6 +225,9 @@ public:
   ~Params_ScrollWheelEventCallback(void) {}
 
   const Params_ScrollWheelEventCallback* get_Params_ScrollWheelEventCallback(void) const override { return this; }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_SCROLL_WHEEL, 0, 0, 0, deltaAxis1, deltaAxis2);
+  }
 
   static void log(bool isCaught,
                   short deltaAxis1,
@@ -237,6 +271,9 @@ public:
   ~Params_Wait(void) {}
 
   const Params_Wait* get_Params_Wait(void) const override { return this; }
+  void trace(BridgeTraceEntry& entry) const override {
+    setTraceEntry(entry, BRIDGE_TRACE_EVENT_WAIT, 0, milliseconds, 0, 0, 0);
+  }
 
   const int milliseconds;
 };
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace org_pqrs_Karabiner {
+// ScrollWheelDelta converts a scroll delta of one axis into
+// deltaAxis (lines), fixedDelta (16.16 fixed point) and pointDelta (pixels) of ScrollWheelEvent.
+//
+// All values are derived from one fixed point value.
+// Fractions which are not sent are carried over to the next conversion,
+// so the sum of sent values is equal to the sum of input deltas.
+// (The carry is cleared when the scroll direction is changed.)
+
+class ScrollWheelDelta final {
+public:
+  enum {
+    // see IOHIPointing.cpp in darwin.
+    FIXED_SCALE = 65536, // (== << 16)
+    POINT_SCALE = 10,    // (== SCROLL_WHEEL_TO_PIXEL_SCALE >> 16)
+    // The input delta is multiplied by DELTA_SCALE in order to keep the precision of momentum scroll.
+    DELTA_SCALE = 128,
+    // The rate is a fraction of RATE_SCALE. (pointing.relative2scroll_rate)
+    RATE_SCALE = 1024,
+  };
+
+  ScrollWheelDelta(void) {
+    clear();
+  }
+
+  void clear(void) {
+    fixedRemainder_ = 0;
+    lineRemainder_ = 0;
+    pointRemainder_ = 0;
+    sign_ = 0;
+  }
+
+  void convert(int delta, int rate, short& deltaAxis, int& fixedDelta, int& pointDelta) {
+    int sign = 0;
+    if (delta > 0) sign = 1;
+    if (delta < 0) sign = -1;
+    if (sign != 0 && sign != sign_) {
+      clear();
+      sign_ = sign;
+    }
+
+    // fixedDelta = delta * rate / RATE_SCALE / DELTA_SCALE (in 16.16 fixed point)
+    const long long denominator = static_cast<long long>(RATE_SCALE) * DELTA_SCALE;
+    long long numerator = static_cast<long long>(delta) * rate * FIXED_SCALE + fixedRemainder_;
+    long long fixed = numerator / denominator;
+    fixedRemainder_ = numerator - fixed * denominator;
+
+    long long lines = lineRemainder_ + fixed;
+    long long line = lines / FIXED_SCALE;
+    lineRemainder_ = lines - line * FIXED_SCALE;
+
+    long long points = pointRemainder_ + fixed * POINT_SCALE;
+    long long point = points / FIXED_SCALE;
+    pointRemainder_ = points - point * FIXED_SCALE;
+
+    deltaAxis = static_cast<short>(clamp(line, SHORT_MIN, SHORT_MAX));
+    fixedDelta = static_cast<int>(clamp(fixed, INT_MIN_VALUE, INT_MAX_VALUE));
+    pointDelta = static_cast<int>(clamp(point, INT_MIN_VALUE, INT_MAX_VALUE));
+  }
+
+private:
+  enum {
+    SHORT_MIN = -32768,
+    SHORT_MAX = 32767,
+  };
+  static const long long INT_MIN_VALUE = -2147483647LL - 1;
+  static const long long INT_MAX_VALUE = 2147483647LL;
+
+  static long long clamp(long long v, long long minval, long long maxval) {
+    if (v < minval) return minval;
+    if (v > maxval) return maxval;
+    return v;
+  }
+
+  // in 1 / (RATE_SCALE * DELTA_SCALE) of fixedDelta
+  long long fixedRemainder_;
+  // in fixedDelta
+  long long lineRemainder_;
+  long long pointRemainder_;
+  int sign_;
+};
+}
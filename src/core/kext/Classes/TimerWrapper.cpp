@@ -3,61 +3,47 @@
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
 
-#define super OSObject
-OSDefineMetaClassAndStructors(org_pqrs_Karabiner_TimerWrapperObject, OSObject);
-
-org_pqrs_Karabiner_TimerWrapperObject*
-org_pqrs_Karabiner_TimerWrapperObject::timerEventSource(OSObject* owner, IOTimerEventSource::Action action) {
-  org_pqrs_Karabiner_TimerWrapperObject* p = new org_pqrs_Karabiner_TimerWrapperObject;
-
-  if (p && !p->init(owner, action)) {
-    if (p) p->release();
-    return nullptr;
-  }
-  return p;
-}
-
-bool org_pqrs_Karabiner_TimerWrapperObject::init(OSObject* owner, IOTimerEventSource::Action action) {
-  if (!super::init()) {
-    return false;
-  }
-
-  owner_ = owner;
-  action_ = action;
-  active_ = false;
-
-  return true;
-}
-
-void org_pqrs_Karabiner_TimerWrapperObject::free(void) {
-  super::free();
-  return;
-}
-
-#undef super
-
-// ================================================================================
 namespace org_pqrs_Karabiner {
-void TimerWrapper::initialize(IOWorkLoop* wl, OSObject* owner, IOTimerEventSource::Action func) {
-  if (timer_) terminate();
+namespace {
+const uint64_t NOT_ARMED = static_cast<uint64_t>(-1);
+}
 
-  if (!wl) return;
+IOWorkLoop* TimerWrapper::workloop_ = nullptr;
+IOTimerEventSource* TimerWrapper::timer_ = nullptr;
+TimerWrapper* TimerWrapper::wheel_[TimerWrapper::WHEEL_SIZE];
+size_t TimerWrapper::count_ = 0;
+uint64_t TimerWrapper::lastTick_ = 0;
+uint64_t TimerWrapper::armedTick_ = NOT_ARMED;
+uint64_t TimerWrapper::lastSequence_ = 0;
 
-  workloop_ = wl;
+void TimerWrapper::static_initialize(IOWorkLoop& workloop) {
+  if (timer_) static_terminate();
 
-  object_ = org_pqrs_Karabiner_TimerWrapperObject::timerEventSource(owner, func);
-  if (!object_) return;
+  for (auto& p : wheel_) {
+    p = nullptr;
+  }
+  count_ = 0;
+  lastTick_ = getUptimeUS() / 1000;
+  armedTick_ = NOT_ARMED;
 
-  timer_ = IOTimerEventSource::timerEventSource(object_, callback_);
+  // IOTimerEventSource requires an owner. We use workloop because callback_ does not use owner.
+  timer_ = IOTimerEventSource::timerEventSource(&workloop, callback_);
+  if (!timer_) {
+    IOLOG_ERROR("TimerWrapper timerEventSource failed\n");
+    return;
+  }
 
-  if (workloop_->addEventSource(timer_) != kIOReturnSuccess) {
+  if (workloop.addEventSource(timer_) != kIOReturnSuccess) {
     IOLOG_ERROR("TimerWrapper addEventSource failed\n");
     timer_->release();
     timer_ = nullptr;
+    return;
   }
+
+  workloop_ = &workloop;
 }
 
-void TimerWrapper::terminate(void) {
+void TimerWrapper::static_terminate(void) {
   if (timer_) {
     timer_->cancelTimeout();
     if (workloop_) {
@@ -68,57 +54,242 @@ void TimerWrapper::terminate(void) {
   }
   workloop_ = nullptr;
 
-  if (object_) {
-    object_->release();
-    object_ = nullptr;
+  for (auto& head : wheel_) {
+    while (head) {
+      TimerWrapper* p = head;
+      p->unlink();
+      p->active_ = false;
+    }
   }
+  count_ = 0;
+  armedTick_ = NOT_ARMED;
+}
+
+// ----------------------------------------------------------------------
+void TimerWrapper::initialize(IOWorkLoop* wl, OSObject* owner, IOTimerEventSource::Action func) {
+  if (action_) terminate();
+
+  if (!wl) return;
+
+  owner_ = owner;
+  action_ = func;
+}
+
+void TimerWrapper::terminate(void) {
+  cancelTimeout();
+
+  owner_ = nullptr;
+  action_ = nullptr;
 }
 
 IOReturn
 TimerWrapper::setTimeoutMS(UInt32 ms, bool overwrite) {
-  if (!object_) return kIOReturnError;
+  if (!action_) return kIOReturnError;
 
   if (!timer_) {
     return kIOReturnNoResources;
   }
-  if (!overwrite && object_->isActive()) {
+  if (!overwrite && active_) {
     return kIOReturnSuccess;
   }
 
-  UInt32 scale_factor = kMillisecondScale;
-  if (ms == 0) {
-    scale_factor = kNanosecondScale;
-    ms = 1;
+  // Round up the deadline in order not to fire timers earlier than ms.
+  // (ms == 0 means "fire as soon as possible".)
+  uint64_t now = getUptimeUS();
+  uint64_t deadline = now / 1000;
+  if (ms > 0) {
+    deadline = (now + static_cast<uint64_t>(ms) * 1000 + 999) / 1000;
   }
 
-  object_->setActive(true);
-  IOReturn retval = timer_->setTimeout(ms, scale_factor);
-  if (retval != kIOReturnSuccess) {
-    IOLOG_WARN("setTimeoutMS is failed\n");
-    object_->setActive(false);
+  if (list_) unlink();
+
+  deadline_ = deadline;
+  sequence_ = ++lastSequence_;
+  link(&(wheel_[deadline & (WHEEL_SIZE - 1)]));
+  active_ = true;
+
+  if (deadline < armedTick_) {
+    arm(deadline);
   }
-  return retval;
+
+  return kIOReturnSuccess;
 }
 
 void TimerWrapper::cancelTimeout(void) {
-  if (!object_) return;
+  if (list_) unlink();
+  active_ = false;
+}
 
-  if (timer_) {
+// ----------------------------------------------------------------------
+bool TimerWrapper::isEarlierThan(const TimerWrapper& other) const {
+  if (deadline_ != other.deadline_) {
+    return deadline_ < other.deadline_;
+  }
+  return sequence_ < other.sequence_;
+}
+
+void TimerWrapper::link(TimerWrapper** list) {
+  list_ = list;
+  prev_ = nullptr;
+  next_ = *list;
+  if (next_) {
+    next_->prev_ = this;
+  }
+  *list = this;
+  ++count_;
+}
+
+void TimerWrapper::linkInOrder(TimerWrapper** list, TimerWrapper** tail) {
+  // Search from tail because timers are usually added in order.
+  TimerWrapper* p = *tail;
+  while (p && isEarlierThan(*p)) {
+    p = p->prev_;
+  }
+
+  list_ = list;
+  prev_ = p;
+  if (p) {
+    next_ = p->next_;
+    p->next_ = this;
+  } else {
+    next_ = *list;
+    *list = this;
+  }
+  if (next_) {
+    next_->prev_ = this;
+  } else {
+    *tail = this;
+  }
+  ++count_;
+}
+
+void TimerWrapper::unlink(void) {
+  if (!list_) return;
+
+  if (prev_) {
+    prev_->next_ = next_;
+  } else {
+    *list_ = next_;
+  }
+  if (next_) {
+    next_->prev_ = prev_;
+  }
+
+  list_ = nullptr;
+  prev_ = nullptr;
+  next_ = nullptr;
+  --count_;
+
+  if (count_ == 0 && timer_) {
     timer_->cancelTimeout();
+    armedTick_ = NOT_ARMED;
+  }
+}
+
+uint64_t TimerWrapper::getUptimeUS(void) {
+  uint64_t abstime = 0;
+  uint64_t nanoseconds = 0;
+  clock_get_uptime(&abstime);
+  absolutetime_to_nanoseconds(abstime, &nanoseconds);
+  return nanoseconds / 1000;
+}
+
+void TimerWrapper::arm(uint64_t tick) {
+  if (!timer_) return;
+
+  armedTick_ = tick;
+
+  uint64_t now = getUptimeUS();
+  uint64_t target = tick * 1000;
+  if (target <= now) {
+    timer_->setTimeout(1, kNanosecondScale);
+  } else {
+    uint64_t interval = target - now;
+    if (interval > 0xffffffff) {
+      interval = 0xffffffff;
+    }
+    timer_->setTimeout(static_cast<UInt32>(interval), kMicrosecondScale);
+  }
+}
+
+// Return the earliest deadline in wheel_. (All timers in wheel_ must be later than fromTick.)
+uint64_t TimerWrapper::findNextDeadline(uint64_t fromTick) {
+  if (count_ == 0) return NOT_ARMED;
+
+  // Timers which expire in the next WHEEL_SIZE ticks are found by walking slots in order.
+  for (uint64_t tick = fromTick + 1; tick <= fromTick + WHEEL_SIZE; ++tick) {
+    for (TimerWrapper* p = wheel_[tick & (WHEEL_SIZE - 1)]; p; p = p->next_) {
+      if (p->deadline_ == tick) return tick;
+    }
+  }
+
+  // All timers are later than WHEEL_SIZE ticks.
+  uint64_t deadline = NOT_ARMED;
+  for (auto head : wheel_) {
+    for (TimerWrapper* p = head; p; p = p->next_) {
+      if (p->deadline_ < deadline) {
+        deadline = p->deadline_;
+      }
+    }
   }
-  object_->setActive(false);
+  return deadline;
 }
 
-void TimerWrapper::callback_(OSObject* owner, IOTimerEventSource* sender) {
+void TimerWrapper::callback_(OSObject* /* owner */, IOTimerEventSource* sender) {
   GlobalLock::ScopedLock lk;
   if (!lk) return;
 
-  org_pqrs_Karabiner_TimerWrapperObject* object = OSDynamicCast(org_pqrs_Karabiner_TimerWrapperObject, owner);
-  if (!object) return;
+  armedTick_ = NOT_ARMED;
 
-  if (object->isActive()) {
-    object->setActive(false);
-    (object->getaction())(object->getowner(), sender);
+  // ----------------------------------------
+  // Move expired timers to the expired list.
+  //
+  // Slots from lastTick_ to now are processed.
+  // (lastTick_ is included because timers with 0 ms timeout might be added after the last callback.)
+  uint64_t now = getUptimeUS() / 1000;
+  uint64_t begin = lastTick_;
+  if (now - begin >= WHEEL_SIZE) {
+    begin = now - WHEEL_SIZE + 1;
+  }
+  lastTick_ = now;
+
+  // (A slot is not sorted. The expired list is sorted by isEarlierThan.)
+  TimerWrapper* expired = nullptr;
+  TimerWrapper* expiredTail = nullptr;
+  for (uint64_t tick = begin; tick <= now; ++tick) {
+    TimerWrapper* p = wheel_[tick & (WHEEL_SIZE - 1)];
+    while (p) {
+      TimerWrapper* next = p->next_;
+      if (p->deadline_ <= now) {
+        p->unlink();
+        p->linkInOrder(&expired, &expiredTail);
+      }
+      p = next;
+    }
+  }
+
+  // Arm timer_ for remaining timers.
+  // (Timers which are set in actions re-arm timer_ by setTimeoutMS if needed.)
+  {
+    uint64_t deadline = findNextDeadline(now);
+    if (deadline != NOT_ARMED) {
+      arm(deadline);
+    }
+  }
+
+  // ----------------------------------------
+  // Fire expired timers.
+  //
+  // An action might cancel or reset other expired timers.
+  // In that case, the timer is removed from the expired list by unlink.
+  while (expired) {
+    TimerWrapper* p = expired;
+    p->unlink();
+    p->active_ = false;
+
+    if (p->action_) {
+      (p->action_)(p->owner_, sender);
+    }
   }
 }
 }
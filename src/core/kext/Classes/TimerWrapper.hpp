@@ -6,30 +6,31 @@ BEGIN_IOKIT_INCLUDE;
 #include <IOKit/IOTimerEventSource.h>
 END_IOKIT_INCLUDE;
 
-class org_pqrs_Karabiner_TimerWrapperObject final : public OSObject {
-  OSDeclareDefaultStructors(org_pqrs_Karabiner_TimerWrapperObject);
-
-public:
-  static org_pqrs_Karabiner_TimerWrapperObject* timerEventSource(OSObject* owner, IOTimerEventSource::Action action);
-  bool init(OSObject* owner, IOTimerEventSource::Action action);
-  void free(void) override;
-
-  OSObject* getowner(void) const { return owner_; }
-  IOTimerEventSource::Action getaction(void) const { return action_; }
-
-  bool isActive(void) const { return active_; }
-  void setActive(bool newval) { active_ = newval; }
-
-private:
-  OSObject* owner_;
-  IOTimerEventSource::Action action_;
-  bool active_;
-};
-
 namespace org_pqrs_Karabiner {
+// TimerWrapper is a handle of a timer.
+//
+// All TimerWrappers share one IOTimerEventSource.
+// Timeouts are managed by a hashed timer wheel at millisecond resolution and
+// timers which expire in the same tick are fired by one wakeup.
+// Expired timers are fired in order of their deadlines, and then in order of setTimeoutMS calls.
+//
+// All methods must be called while GlobalLock is held (or before GlobalLock is initialized).
 class TimerWrapper final {
 public:
-  TimerWrapper(void) : workloop_(nullptr), object_(nullptr), timer_(nullptr) {}
+  TimerWrapper(void) : owner_(nullptr),
+                       action_(nullptr),
+                       active_(false),
+                       deadline_(0),
+                       sequence_(0),
+                       list_(nullptr),
+                       prev_(nullptr),
+                       next_(nullptr) {}
+
+  // Create the shared IOTimerEventSource.
+  // Call static_initialize before TimerWrapper::initialize.
+  static void static_initialize(IOWorkLoop& workloop);
+  static void static_terminate(void);
+
   void initialize(IOWorkLoop* wl, OSObject* owner, IOTimerEventSource::Action func);
   void terminate(void);
 
@@ -37,16 +38,54 @@ public:
   IOReturn setTimeoutMS(UInt32 ms, bool overwrite = true);
   void cancelTimeout(void);
 
-  bool isActive(void) const {
-    if (!object_) return false;
-    return object_->isActive();
-  }
+  bool isActive(void) const { return active_; }
 
 private:
+  enum {
+    // The number of slots must be a power of 2.
+    WHEEL_SIZE = 256,
+  };
+
+  TimerWrapper(const TimerWrapper& rhs);            // Prevent copy-construction
+  TimerWrapper& operator=(const TimerWrapper& rhs); // Prevent assignment
+
   static void callback_(OSObject* owner, IOTimerEventSource* sender);
 
-  IOWorkLoop* workloop_;
-  org_pqrs_Karabiner_TimerWrapperObject* object_;
-  IOTimerEventSource* timer_;
+  static uint64_t getUptimeUS(void);
+  static void arm(uint64_t tick);
+  static uint64_t findNextDeadline(uint64_t fromTick);
+
+  // Return true if this timer must be fired before other.
+  bool isEarlierThan(const TimerWrapper& other) const;
+
+  void link(TimerWrapper** list);
+  // Insert into list which is sorted by isEarlierThan. (tail is the last entry of list.)
+  void linkInOrder(TimerWrapper** list, TimerWrapper** tail);
+  void unlink(void);
+
+  static IOWorkLoop* workloop_;
+  static IOTimerEventSource* timer_;
+  static TimerWrapper* wheel_[WHEEL_SIZE];
+  static size_t count_;
+  // The last tick which was processed in callback_.
+  static uint64_t lastTick_;
+  // The tick which timer_ will be fired at. (UINT64_MAX if timer_ is not armed.)
+  static uint64_t armedTick_;
+  // Incremented by each setTimeoutMS.
+  static uint64_t lastSequence_;
+
+  OSObject* owner_;
+  IOTimerEventSource::Action action_;
+  bool active_;
+
+  // in milliseconds (uptime)
+  uint64_t deadline_;
+  // lastSequence_ at setTimeoutMS.
+  uint64_t sequence_;
+
+  // A slot of wheel_ or the expired list in callback_.
+  TimerWrapper** list_;
+  TimerWrapper* prev_;
+  TimerWrapper* next_;
 };
 }
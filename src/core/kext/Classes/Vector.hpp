@@ -49,6 +49,12 @@ public:                                                                 \
     return *this;                                                       \
   }                                                                     \
                                                                         \
+  void pop_back(void) {                                                 \
+    if (size_ > 0) {                                                    \
+      --size_;                                                          \
+    }                                                                   \
+  }                                                                     \
+                                                                        \
   size_t size(void) const { return size_; }                             \
   size_t capacity(void) const { return capacity_; }                     \
   bool empty(void) const { return size_ == 0; }                         \
@@ -21,6 +21,7 @@ namespace {
 int sysctl_debug = 0;
 int sysctl_debug_pointing = 0;
 int sysctl_debug_devel = 0;
+int sysctl_statistics = 0;
 int sysctl_initialized = 0;
 }
 
@@ -43,6 +44,7 @@ SYSCTL_INT(_karabiner, OID_AUTO, initialized, CTLTYPE_INT, &(sysctl_initialized)
 SYSCTL_INT(_karabiner, OID_AUTO, debug, CTLTYPE_INT | CTLFLAG_RW, &(sysctl_debug), 0, "");
 SYSCTL_INT(_karabiner, OID_AUTO, debug_pointing, CTLTYPE_INT | CTLFLAG_RW, &(sysctl_debug_pointing), 0, "");
 SYSCTL_INT(_karabiner, OID_AUTO, debug_devel, CTLTYPE_INT | CTLFLAG_RW, &(sysctl_debug_devel), 0, "");
+SYSCTL_INT(_karabiner, OID_AUTO, statistics, CTLTYPE_INT | CTLFLAG_RW, &(sysctl_statistics), 0, "");
 
 // ----------------------------------------------------------------------
 void Config::sysctl_register(void) {
@@ -52,6 +54,7 @@ void Config::sysctl_register(void) {
   sysctl_register_oid(&sysctl__karabiner_debug);
   sysctl_register_oid(&sysctl__karabiner_debug_pointing);
   sysctl_register_oid(&sysctl__karabiner_debug_devel);
+  sysctl_register_oid(&sysctl__karabiner_statistics);
 }
 
 void Config::sysctl_unregister(void) {
@@ -61,6 +64,7 @@ void Config::sysctl_unregister(void) {
   sysctl_unregister_oid(&sysctl__karabiner_debug);
   sysctl_unregister_oid(&sysctl__karabiner_debug_pointing);
   sysctl_unregister_oid(&sysctl__karabiner_debug_devel);
+  sysctl_unregister_oid(&sysctl__karabiner_statistics);
 }
 
 void Config::set_initialized(bool newvalue) {
@@ -91,12 +95,14 @@ void Config::unset_debug_flags(void) {
   sysctl_debug = 0;
   sysctl_debug_devel = 0;
   sysctl_debug_pointing = 0;
+  sysctl_statistics = 0;
 }
 
 bool Config::get_initialized(void) { return sysctl_initialized; }
 bool Config::get_debug(void) { return sysctl_debug; }
 bool Config::get_debug_devel(void) { return sysctl_debug_devel; }
 bool Config::get_debug_pointing(void) { return sysctl_debug_pointing; }
+bool Config::get_statistics(void) { return sysctl_statistics; }
 
 void Config::load_essential_config_default(void) {
   for (int i = 0; i < BRIDGE_ESSENTIAL_CONFIG_INDEX__END__; ++i) {
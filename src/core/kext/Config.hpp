@@ -18,6 +18,8 @@ public:
   static bool get_debug(void);
   static bool get_debug_devel(void);
   static bool get_debug_pointing(void);
+  // Collect RemapClass statistics. (BRIDGE_USERCLIENT_TYPE_GET_REMAP_STATISTICS)
+  static bool get_statistics(void);
 
   // ----------------------------------------
   static void set_essential_config(const int32_t* newvalues, size_t num);
@@ -54,6 +56,30 @@ public:
     int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_before_and_after_a_click_event);
     return getvalue(v, 0, 1000);
   }
+  static unsigned int get_wait_between_key_events(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events);
+    return getvalue(v, 0, 1000);
+  }
+  static unsigned int get_wait_between_key_events_device_vendor_id(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_vendor_id);
+    return getvalue(v, 0, 0xffff);
+  }
+  static unsigned int get_wait_between_key_events_device_product_id(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_product_id);
+    return getvalue(v, 0, 0xffff);
+  }
+  static unsigned int get_wait_between_key_events_device_wait(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_wait_between_key_events_device_wait);
+    return getvalue(v, 0, 1000);
+  }
+  static unsigned int get_coalesce_relative_pointer_max_events(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_coalesce_relative_pointer_max_events);
+    return getvalue(v, 1, 1000);
+  }
+  static unsigned int get_coalesce_relative_pointer_max_interval(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_coalesce_relative_pointer_max_interval);
+    return getvalue(v, 0, 1000);
+  }
   static unsigned int get_keyoverlaidmodifier_initial_modifier_wait(void) {
     int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_keyoverlaidmodifier_initial_modifier_wait);
     return getvalue(v, 0);
@@ -110,6 +136,14 @@ public:
     int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_repeat_wait_of_scroll);
     return getvalue(v, 0);
   }
+  static unsigned int get_mousekey_acceleration_curve(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_acceleration_curve);
+    return getvalue(v, 0, 1);
+  }
+  static unsigned int get_mousekey_exponential_doubling_time(void) {
+    int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mousekey_exponential_doubling_time);
+    return getvalue(v, 1);
+  }
   static unsigned int get_fixed_distance_magnification(void) {
     int v = get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_fixed_distance_magnification);
     return getvalue(v, 0);
@@ -6,18 +6,21 @@ END_IOKIT_INCLUDE;
 
 #include <sys/errno.h>
 
+#include "BinaryLog.hpp"
 #include "ButtonStatus.hpp"
 #include "CommonData.hpp"
 #include "Config.hpp"
 #include "Core.hpp"
 #include "EventInputQueue.hpp"
 #include "EventOutputQueue.hpp"
+#include "EventTrace.hpp"
 #include "EventWatcher.hpp"
 #include "FromEvent.hpp"
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
 #include "KeyCodeModifierFlagPairs.hpp"
 #include "KeyboardRepeat.hpp"
+#include "LatencyHistogram.hpp"
 #include "ListHookedConsumer.hpp"
 #include "ListHookedKeyboard.hpp"
 #include "ListHookedPointing.hpp"
@@ -55,11 +58,16 @@ void start(void) {
   EventWatcher::initialize();
   PressDownKeys::initialize();
   ButtonStatus::initialize();
+  BinaryLog::initialize();
+  EventTrace::initialize();
+  LatencyHistogram::initialize();
 
   workLoop = IOWorkLoop::workLoop();
   if (!workLoop) {
     IOLOG_ERROR("IOWorkLoop::workLoop failed\n");
   } else {
+    TimerWrapper::static_initialize(*workLoop);
+
     ListHookedDevice::initializeAll(*workLoop);
 
     KeyboardRepeat::initialize(*workLoop);
@@ -98,6 +106,8 @@ void stop(void) {
   RemapFunc::PointingRelativeToScroll::static_terminate();
   ListHookedKeyboard::static_terminate();
 
+  TimerWrapper::static_terminate();
+
   if (workLoop) {
     workLoop->release();
     workLoop = nullptr;
@@ -59,6 +59,10 @@ public:
 #include "../../../src/bridge/output/include.kext.ModifierFlag.hpp"
 
 private:
+  // These classes use the value as an index of lookup tables.
+  friend class KeyCodeModifierFlagPairs;
+  friend class ModifierName;
+
   unsigned int get(void) const { return value_; }
   unsigned int value_;
 };
@@ -5,6 +5,8 @@ BEGIN_IOKIT_INCLUDE;
 END_IOKIT_INCLUDE;
 
 #include "CommonData.hpp"
+#include "Config.hpp"
+#include "DeviceFilterTable.hpp"
 #include "EventInputQueue.hpp"
 #include "IOLogWrapper.hpp"
 #include "KeyCodeModifierFlagPairs.hpp"
@@ -20,17 +22,20 @@ END_IOKIT_INCLUDE;
 #include "strlcpy_utf8.hpp"
 
 namespace org_pqrs_Karabiner {
-List RemapClass::ActiveItems::list_;
+uint32_t RemapClass::ActiveItems::generation_ = 0;
+
+RemapClass::Item::Item(RemapClass& parent, const uint32_t* vec, size_t length) : parent_(parent),
+                                                                                 type_(BRIDGE_REMAPTYPE_NONE),
+                                                                                 activeGeneration_(0) {
+  for (auto& c : activeCount_) {
+    c = 0;
+  }
 
-RemapClass::Item::Item(const RemapClass& parent, const uint32_t* vec, size_t length) : parent_(parent),
-                                                                                       type_(BRIDGE_REMAPTYPE_NONE) {
   auto autogenId = AutogenId((static_cast<uint64_t>(parent_.configindex_) << 32) | (parent.items_.size() + 1));
   processor_ = RemapFunc::RemapFuncFactory::create(vec, length, autogenId);
 }
 
 RemapClass::Item::~Item(void) {
-  ActiveItems::erase_all(this);
-
   if (processor_) {
     delete processor_;
     processor_ = nullptr;
@@ -76,25 +81,48 @@ void RemapClass::Item::remap(RemapParams& remapParams, bool passThroughEnabled)
     isalwayskeydown = true;
   }
 
+  bool statistics = Config::get_statistics();
+
   if (iskeydown) {
     if (passThroughEnabled && !isIgnorePassThrough()) return;
     if (!parent_.enabled()) return;
-    if (isblocked()) return;
+    if (isblocked()) {
+      if (statistics) ++(statistics_.filtered);
+      return;
+    }
   } else {
     // We ignore event if `this` is not processed at KeyDown.
-    if (!ActiveItems::find(this, ActiveItems::Item::Type::NORMAL)) return;
-    if (isblocked_keyup()) return;
+    if (!active(ActiveItems::Type::NORMAL)) return;
+    if (isblocked_keyup()) {
+      if (statistics) ++(statistics_.filtered);
+      return;
+    }
+  }
+
+  bool remapped = false;
+  if (statistics) {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    clock_get_uptime(&begin);
+    remapped = processor_->remap(remapParams);
+    clock_get_uptime(&end);
+
+    statistics_.time += end - begin;
+    ++(statistics_.attempts);
+    if (remapped) ++(statistics_.remaps);
+  } else {
+    remapped = processor_->remap(remapParams);
   }
 
-  if (!processor_->remap(remapParams)) {
+  if (!remapped) {
     return;
   }
 
   if (!isalwayskeydown) {
     if (iskeydown) {
-      ActiveItems::push_back(this, ActiveItems::Item::Type::NORMAL);
+      activate(ActiveItems::Type::NORMAL);
     } else {
-      ActiveItems::erase(this, ActiveItems::Item::Type::NORMAL);
+      deactivate(ActiveItems::Type::NORMAL);
     }
   }
 }
@@ -154,7 +182,7 @@ bool RemapClass::Item::remap_SimultaneousKeyPresses(bool iskeydown, bool passThr
     if (isblocked()) return false;
   } else {
     // We ignore event if `this` is not processed at KeyDown.
-    if (!ActiveItems::find(this, ActiveItems::Item::Type::SIMULTANEOUSBUTTONPRESSES)) return false;
+    if (!active(ActiveItems::Type::SIMULTANEOUSBUTTONPRESSES)) return false;
     if (isblocked_keyup()) return false;
   }
 
@@ -165,9 +193,9 @@ bool RemapClass::Item::remap_SimultaneousKeyPresses(bool iskeydown, bool passThr
 
   if (result == RemapSimultaneousKeyPressesResult::APPLIED) {
     if (iskeydown) {
-      ActiveItems::push_back(this, ActiveItems::Item::Type::SIMULTANEOUSBUTTONPRESSES);
+      activate(ActiveItems::Type::SIMULTANEOUSBUTTONPRESSES);
     } else {
-      ActiveItems::erase(this, ActiveItems::Item::Type::SIMULTANEOUSBUTTONPRESSES);
+      deactivate(ActiveItems::Type::SIMULTANEOUSBUTTONPRESSES);
     }
   }
   return true;
@@ -201,6 +229,42 @@ bool RemapClass::Item::isPassThroughEnabled(void) const {
   return true;
 }
 
+bool RemapClass::Item::isPassThroughCacheable(void) const {
+  for (size_t i = 0; i < filters_.size(); ++i) {
+    RemapFilter::RemapFilterBase* p = filters_[i];
+    if (p && !p->isDependingOnlyOnWorkspaceAndConfig()) return false;
+  }
+
+  return true;
+}
+
+void RemapClass::Item::activate(ActiveItems::Type t) {
+  uint32_t generation = ActiveItems::getGeneration();
+
+  if (activeGeneration_ != generation) {
+    activeGeneration_ = generation;
+    for (auto& c : activeCount_) {
+      c = 0;
+    }
+  }
+  if (parent_.activeGeneration_ != generation) {
+    parent_.activeGeneration_ = generation;
+    parent_.activeCount_ = 0;
+  }
+
+  ++activeCount_[static_cast<int>(t)];
+  ++(parent_.activeCount_);
+}
+
+void RemapClass::Item::deactivate(ActiveItems::Type t) {
+  if (!active(t)) return;
+
+  --activeCount_[static_cast<int>(t)];
+  if (parent_.activeCount_ > 0) {
+    --(parent_.activeCount_);
+  }
+}
+
 bool RemapClass::Item::isblocked(void) const {
   for (size_t i = 0; i < filters_.size(); ++i) {
     RemapFilter::RemapFilterBase* p = filters_[i];
@@ -223,20 +287,30 @@ bool RemapClass::Item::isblocked_keyup(void) const {
 int RemapClass::allocation_count_ = 0;
 
 RemapClass::RemapClass(const uint32_t* const initialize_vector, uint32_t vector_size, uint32_t configindex) : statusmessage_(nullptr),
+                                                                                                              statusmessage_length_(0),
                                                                                                               enabled_(false),
+                                                                                                              changed_(false),
                                                                                                               is_simultaneouskeypresses_(false),
-                                                                                                              configindex_(configindex) {
+                                                                                                              has_virtual_modifier_(false),
+                                                                                                              configindex_(configindex),
+                                                                                                              checksum_(0),
+                                                                                                              allocated_size_(0),
+                                                                                                              activeGeneration_(0),
+                                                                                                              activeCount_(0) {
   if (!initialize_vector) {
     IOLOG_ERROR("RemapClass::RemapClass invalid parameter.\n");
     return;
   }
 
+  checksum_ = bridge_remapclasses_initialize_vector_checksum(configindex, initialize_vector, vector_size);
+
   // ------------------------------------------------------------
   if (allocation_count_ + vector_size > MAX_ALLOCATION_COUNT) {
     IOLOG_ERROR("RemapClass::RemapClass too many allocation_count_.\n");
     return;
   }
   allocation_count_ += vector_size;
+  allocated_size_ = vector_size;
 
   // ------------------------------------------------------------
   // initialize items_ from vector
@@ -287,6 +361,7 @@ RemapClass::RemapClass(const uint32_t* const initialize_vector, uint32_t vector_
           statusmessage_ = new char[length];
         }
         pqrs::strlcpy_utf8::strlcpy(statusmessage_, reinterpret_cast<const char*>(p + 1), length);
+        statusmessage_length_ = strlen(statusmessage_);
 
       } else if (type == BRIDGE_MODIFIERNAME) {
         if (size < 3) {
@@ -295,6 +370,7 @@ RemapClass::RemapClass(const uint32_t* const initialize_vector, uint32_t vector_
         } else {
           unsigned int modifierFlag = p[1];
           ModifierName::registerVirtualModifier(ModifierFlag(modifierFlag), reinterpret_cast<const char*>(p + 2));
+          has_virtual_modifier_ = true;
         }
 
       } else if (type == BRIDGE_VK_MODIFIER) {
@@ -313,6 +389,7 @@ RemapClass::RemapClass(const uint32_t* const initialize_vector, uint32_t vector_
                                                             KeyCode(p[9]),   // VK_STICKY_*
                                                             KeyCode(p[10]),  // VK_STICKY_*_FORCE_ON
                                                             KeyCode(p[11])); // VK_STICKY_*_FORCE_OFF
+          has_virtual_modifier_ = true;
         }
 
       } else if (type == BRIDGE_VK_CONFIG) {
@@ -365,6 +442,9 @@ RemapClass::RemapClass(const uint32_t* const initialize_vector, uint32_t vector_
 }
 
 RemapClass::~RemapClass(void) {
+  VirtualKey::VK_CONFIG::remove_items(this);
+  VirtualKey::VK_DEFINED_IN_USERSPACE::remove_items(this);
+
   for (size_t i = 0; i < items_.size(); ++i) {
     Item* p = items_[i];
     if (p) {
@@ -374,147 +454,392 @@ RemapClass::~RemapClass(void) {
   if (statusmessage_) {
     delete[] statusmessage_;
   }
+
+  allocation_count_ -= allocated_size_;
 }
 
-void RemapClass::remap_setkeyboardtype(KeyboardType& keyboardType, bool passThroughEnabled) {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p) {
-      p->remap_setkeyboardtype(keyboardType, passThroughEnabled);
-    }
+void RemapClass::setEnabled(bool newval) {
+  if (enabled_ == newval) return;
+
+  enabled_ = newval;
+  if (!changed_) {
+    changed_ = true;
+    RemapClassManager::add_changed_remapclass(*this);
   }
 }
 
-void RemapClass::remap_forcenumlockon(ListHookedKeyboard::Item* item, bool passThroughEnabled) {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p) {
-      p->remap_forcenumlockon(item, passThroughEnabled);
-    }
-  }
+void RemapClass::log_allocation_count(void) {
+  IOLOG_INFO("RemapClass::allocation_count_ %d/%d (memory usage: %d%% of %dKB)\n",
+             allocation_count_,
+             MAX_ALLOCATION_COUNT,
+             allocation_count_ * 100 / MAX_ALLOCATION_COUNT,
+             static_cast<int>(MAX_ALLOCATION_COUNT * sizeof(uint32_t) / 1024));
 }
 
-void RemapClass::remap(RemapParams& remapParams, bool passThroughEnabled) {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p) {
-      // DependingPressingPeriodKeyToKey watches another key status.
-      // Therefore, we need to call 'p->remap(remapParams)' for all items.
-      p->remap(remapParams, passThroughEnabled);
-    }
-  }
+void RemapClass::reset_allocation_count(void) {
+  allocation_count_ = 0;
 }
 
-bool RemapClass::isTargetEventForBlockUntilKeyUp(const Params_Base& paramsBase, bool passThroughEnabled) {
-  bool isTargetEvent = false;
+// ================================================================================
+namespace RemapClassManager {
+TimerWrapper refresh_timer_;
 
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p) {
-      if (p->isTargetEventForBlockUntilKeyUp(paramsBase, passThroughEnabled)) {
-        isTargetEvent = true;
-      }
+char statusmessage_[BRIDGE_USERCLIENT_STATUS_MESSAGE_MAXLEN];
+char lastmessage_[BRIDGE_USERCLIENT_STATUS_MESSAGE_MAXLEN];
+bool isSimultaneousKeyPressesEnabled_ = false;
+FromEventBitmap simultaneousKeyPressesFromEvents_;
+
+Vector_RemapClassPointer remapclasses_;
+// Enabled RemapClasses and disabled RemapClasses which have active items. (sorted by configindex)
+Vector_RemapClassPointer enabled_remapclasses_;
+// RemapClasses which enabled state is changed after the last refresh_timer_callback.
+Vector_RemapClassPointer changed_remapclasses_;
+// refresh_timer_callback scans all RemapClasses if true. (remapclasses_ is replaced)
+bool full_refresh_needed_ = true;
+// Enabled RemapClasses which have a status message. (sorted by configindex)
+// statusmessage_ is the concatenation of their fragments. ("message ")
+Vector_RemapClassPointer statusmessage_remapclasses_;
+// The length of the concatenation without truncation.
+size_t statusmessage_fulllength_ = 0;
+// refresh_changed rebuilds simultaneousKeyPressesFromEvents_ if true.
+// (It is set when apply_remapclasses_delta deletes RemapClasses which are not in changed_remapclasses_.)
+bool simultaneouskeypresses_dirty_ = false;
+// The sum of RemapClass::get_checksum() in remapclasses_.
+uint32_t remapclasses_checksum_ = 0;
+
+List prepareTargetItems_;
+
+// The flattened items of enabled_remapclasses_.
+// Per-event functions scan this plan instead of walking RemapClass and Item.
+// (The plan is rebuilt in refresh_timer_callback.)
+class PlanItem final {
+public:
+  enum {
+    FLAG_SETKEYBOARDTYPE = 1 << 0,
+    FLAG_FORCENUMLOCKON = 1 << 1,
+    FLAG_BLOCKUNTILKEYUP = 1 << 2,
+    FLAG_SIMULTANEOUSKEYPRESSES = 1 << 3,
+    // DropAllKeys, DropKeyAfterRemap
+    FLAG_CANCELEVENTOUTPUTQUEUEITEMS = 1 << 4,
+    // PassThrough which filters depend only on workspace and configs.
+    FLAG_PASSTHROUGH_CACHEABLE = 1 << 5,
+    // PassThrough which filters depend on the current event. (<device_only>, <modifier_only>, etc.)
+    FLAG_PASSTHROUGH_UNCACHEABLE = 1 << 6,
+  };
+
+  PlanItem(void) : item(nullptr), flags(0) {}
+  PlanItem(RemapClass::Item* i, uint32_t f) : item(i), flags(f) {}
+
+  RemapClass::Item* item;
+  uint32_t flags;
+};
+DECLARE_VECTOR(PlanItem);
+
+Vector_PlanItem plan_;
+// The union of PlanItem::flags in plan_.
+uint32_t plan_flags_ = 0;
+
+// The cached result of FLAG_PASSTHROUGH_CACHEABLE items.
+// It is invalidated by refresh() and the workspace change.
+bool passThroughCacheValid_ = false;
+bool passThroughCacheEnabled_ = false;
+uint32_t passThroughCacheWorkspaceEpoch_ = 0;
+
+// ======================================================================
+static uint32_t
+get_plan_flags(const RemapClass::Item& item) {
+  switch (item.getProcessorType()) {
+  case BRIDGE_REMAPTYPE_SETKEYBOARDTYPE:
+    return PlanItem::FLAG_SETKEYBOARDTYPE;
+  case BRIDGE_REMAPTYPE_FORCENUMLOCKON:
+    return PlanItem::FLAG_FORCENUMLOCKON;
+  case BRIDGE_REMAPTYPE_BLOCKUNTILKEYUP:
+    return PlanItem::FLAG_BLOCKUNTILKEYUP;
+  case BRIDGE_REMAPTYPE_SIMULTANEOUSKEYPRESSES:
+    return PlanItem::FLAG_SIMULTANEOUSKEYPRESSES;
+  case BRIDGE_REMAPTYPE_DROPALLKEYS:
+  case BRIDGE_REMAPTYPE_DROPKEYAFTERREMAP:
+    return PlanItem::FLAG_CANCELEVENTOUTPUTQUEUEITEMS;
+  case BRIDGE_REMAPTYPE_PASSTHROUGH:
+    if (item.isPassThroughCacheable()) {
+      return PlanItem::FLAG_PASSTHROUGH_CACHEABLE;
+    } else {
+      return PlanItem::FLAG_PASSTHROUGH_UNCACHEABLE;
     }
+  default:
+    return 0;
   }
+}
 
-  return isTargetEvent;
+static void
+clear_plan(void) {
+  plan_.clear();
+  plan_flags_ = 0;
+  passThroughCacheValid_ = false;
 }
 
-bool RemapClass::remap_simultaneouskeypresses(bool iskeydown, bool passThroughEnabled) {
-  bool queue_changed = false;
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
+static void
+rebuild_plan(void) {
+  clear_plan();
+
+  size_t size = 0;
+  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
+    RemapClass* p = enabled_remapclasses_[i];
     if (p) {
-      if (p->remap_SimultaneousKeyPresses(iskeydown, passThroughEnabled)) {
-        queue_changed = true;
-      }
+      size += p->get_items().size();
     }
   }
+  plan_.reserve(size);
 
-  return queue_changed;
-}
+  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
+    RemapClass* p = enabled_remapclasses_[i];
+    if (!p) continue;
 
-void RemapClass::cancelEventOutputQueueItems(bool passThroughEnabled) {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p) {
-      p->cancelEventOutputQueueItems(passThroughEnabled);
+    const RemapClass::Vector_ItemPointer& items = p->get_items();
+    for (size_t j = 0; j < items.size(); ++j) {
+      RemapClass::Item* item = items[j];
+      if (!item) continue;
+
+      uint32_t flags = get_plan_flags(*item);
+      plan_.push_back(PlanItem(item, flags));
+      plan_flags_ |= flags;
     }
   }
 }
 
-bool RemapClass::hasActiveItem(void) const {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p && p->active()) return true;
+static void
+append_statusmessage(size_t& length, const char* message, size_t messagelength) {
+  // Truncate in the same way as strlcat.
+  size_t available = sizeof(statusmessage_) - 1 - length;
+  if (messagelength > available) {
+    messagelength = available;
   }
-  return false;
+  memcpy(statusmessage_ + length, message, messagelength);
+  length += messagelength;
 }
 
-bool RemapClass::isPassThroughEnabled(void) const {
-  for (size_t i = 0; i < items_.size(); ++i) {
-    Item* p = items_[i];
-    if (p && p->isPassThroughEnabled()) return true;
-  }
-  return false;
+static size_t
+get_statusmessage_fragment_length(const RemapClass& remapclass) {
+  return remapclass.get_statusmessage_length() + 1;
 }
 
-void RemapClass::log_allocation_count(void) {
-  IOLOG_INFO("RemapClass::allocation_count_ %d/%d (memory usage: %d%% of %dKB)\n",
-             allocation_count_,
-             MAX_ALLOCATION_COUNT,
-             allocation_count_ * 100 / MAX_ALLOCATION_COUNT,
-             static_cast<int>(MAX_ALLOCATION_COUNT * sizeof(uint32_t) / 1024));
-}
+// Concatenate fragments of statusmessage_remapclasses_.
+static void
+rebuild_statusmessage(void) {
+  size_t length = 0;
+  statusmessage_fulllength_ = 0;
 
-void RemapClass::reset_allocation_count(void) {
-  allocation_count_ = 0;
+  for (size_t i = 0; i < statusmessage_remapclasses_.size(); ++i) {
+    RemapClass* p = statusmessage_remapclasses_[i];
+
+    append_statusmessage(length, p->get_statusmessage(), p->get_statusmessage_length());
+    append_statusmessage(length, " ", 1);
+    statusmessage_fulllength_ += get_statusmessage_fragment_length(*p);
+  }
+
+  statusmessage_[length] = '\0';
 }
 
-// ================================================================================
-namespace RemapClassManager {
-TimerWrapper refresh_timer_;
+// Add or remove the fragment of remapclass without touching other fragments.
+// (remapclass contributes to statusmessage_ if it is enabled and has a status message.)
+static void
+update_statusmessage(RemapClass& remapclass, bool contributes) {
+  if (!remapclass.get_statusmessage()) return;
+
+  // Find the position of remapclass in statusmessage_remapclasses_.
+  size_t i = 0;
+  size_t offset = 0;
+  for (; i < statusmessage_remapclasses_.size(); ++i) {
+    RemapClass* p = statusmessage_remapclasses_[i];
+    if (p->get_configindex() >= remapclass.get_configindex()) break;
+    offset += get_statusmessage_fragment_length(*p);
+  }
 
-char statusmessage_[BRIDGE_USERCLIENT_STATUS_MESSAGE_MAXLEN];
-char lastmessage_[BRIDGE_USERCLIENT_STATUS_MESSAGE_MAXLEN];
-bool isSimultaneousKeyPressesEnabled_ = false;
+  bool contributed = (i < statusmessage_remapclasses_.size() &&
+                      statusmessage_remapclasses_[i] == &remapclass);
+  if (contributed == contributes) return;
 
-Vector_RemapClassPointer remapclasses_;
-Vector_RemapClassPointer enabled_remapclasses_;
+  size_t fragmentlength = get_statusmessage_fragment_length(remapclass);
+  size_t oldfulllength = statusmessage_fulllength_;
 
-List prepareTargetItems_;
+  if (contributes) {
+    statusmessage_remapclasses_.push_back(&remapclass);
+    for (size_t j = statusmessage_remapclasses_.size() - 1; j > i; --j) {
+      statusmessage_remapclasses_[j] = statusmessage_remapclasses_[j - 1];
+    }
+    statusmessage_remapclasses_[i] = &remapclass;
+    statusmessage_fulllength_ += fragmentlength;
+  } else {
+    for (size_t j = i + 1; j < statusmessage_remapclasses_.size(); ++j) {
+      statusmessage_remapclasses_[j - 1] = statusmessage_remapclasses_[j];
+    }
+    statusmessage_remapclasses_.pop_back();
+    statusmessage_fulllength_ -= fragmentlength;
+  }
 
-// ======================================================================
-static void
-refresh_timer_callback(OSObject* owner, IOTimerEventSource* sender) {
-  enabled_remapclasses_.clear();
+  // Fall back to rebuild_statusmessage if statusmessage_ is truncated.
+  if (oldfulllength > sizeof(statusmessage_) - 1 ||
+      statusmessage_fulllength_ > sizeof(statusmessage_) - 1) {
+    rebuild_statusmessage();
+    return;
+  }
 
-  // ----------------------------------------
-  statusmessage_[0] = '\0';
+  // Move the following fragments and the terminating null.
+  if (contributes) {
+    memmove(statusmessage_ + offset + fragmentlength, statusmessage_ + offset, oldfulllength - offset + 1);
+    memcpy(statusmessage_ + offset, remapclass.get_statusmessage(), fragmentlength - 1);
+    statusmessage_[offset + fragmentlength - 1] = ' ';
+  } else {
+    memmove(statusmessage_ + offset, statusmessage_ + offset + fragmentlength, oldfulllength - offset - fragmentlength + 1);
+  }
+}
 
+static void
+rebuild_simultaneouskeypresses(void) {
   isSimultaneousKeyPressesEnabled_ = false;
+  simultaneousKeyPressesFromEvents_.clear();
+
+  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
+    RemapClass* p = enabled_remapclasses_[i];
+    if (!p || !p->enabled()) continue;
+    if (!p->is_simultaneouskeypresses()) continue;
+
+    isSimultaneousKeyPressesEnabled_ = true;
+
+    const RemapClass::Vector_ItemPointer& items = p->get_items();
+    for (size_t j = 0; j < items.size(); ++j) {
+      if (items[j]) {
+        items[j]->getSimultaneousKeyPressesFromEvents(simultaneousKeyPressesFromEvents_);
+      }
+    }
+  }
+}
+
+void add_changed_remapclass(RemapClass& remapclass) {
+  changed_remapclasses_.push_back(&remapclass);
+}
+
+static void
+clear_changed_remapclasses(void) {
+  // Do not touch changed_remapclasses_ items when full_refresh_needed_ because they might be deleted.
+  if (!full_refresh_needed_) {
+    for (size_t i = 0; i < changed_remapclasses_.size(); ++i) {
+      RemapClass* p = changed_remapclasses_[i];
+      if (p) {
+        p->clearChanged();
+      }
+    }
+  }
+  changed_remapclasses_.clear();
+}
+
+static void
+refresh_all(void) {
+  enabled_remapclasses_.clear();
+  statusmessage_remapclasses_.clear();
 
   for (size_t i = 0; i < remapclasses_.size(); ++i) {
     RemapClass* p = remapclasses_[i];
     if (!p) continue;
 
+    p->clearChanged();
+
     if (p->enabled() || p->hasActiveItem()) {
       enabled_remapclasses_.push_back(p);
+    }
+    if (p->enabled() && p->get_statusmessage()) {
+      statusmessage_remapclasses_.push_back(p);
+    }
+  }
+  changed_remapclasses_.clear();
+  full_refresh_needed_ = false;
+  simultaneouskeypresses_dirty_ = false;
 
-      if (p->enabled()) {
-        const char* msg = p->get_statusmessage();
-        if (msg) {
-          strlcat(statusmessage_, msg, sizeof(statusmessage_));
-          strlcat(statusmessage_, " ", sizeof(statusmessage_));
-        }
+  rebuild_statusmessage();
+  rebuild_simultaneouskeypresses();
+}
 
-        if (p->is_simultaneouskeypresses()) {
-          isSimultaneousKeyPressesEnabled_ = true;
-        }
+// Sort by configindex.
+// (Insertion sort is enough because changes are usually sent in order of configindex.)
+static void
+sort_by_configindex(Vector_RemapClassPointer& v) {
+  for (size_t i = 1; i < v.size(); ++i) {
+    RemapClass* p = v[i];
+    size_t j = i;
+    for (; j > 0 && v[j - 1]->get_configindex() > p->get_configindex(); --j) {
+      v[j] = v[j - 1];
+    }
+    v[j] = p;
+  }
+}
+
+// Merge changed_remapclasses_ into enabled_remapclasses_.
+static void
+refresh_changed(void) {
+  bool simultaneousKeyPressesChanged = simultaneouskeypresses_dirty_;
+  simultaneouskeypresses_dirty_ = false;
+
+  sort_by_configindex(changed_remapclasses_);
+
+  for (size_t i = 0; i < changed_remapclasses_.size(); ++i) {
+    RemapClass* p = changed_remapclasses_[i];
+    p->clearChanged();
+
+    update_statusmessage(*p, p->enabled());
+
+    if (p->is_simultaneouskeypresses()) {
+      simultaneousKeyPressesChanged = true;
+    }
+  }
+
+  Vector_RemapClassPointer v;
+  v.reserve(enabled_remapclasses_.size() + changed_remapclasses_.size());
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < enabled_remapclasses_.size() || j < changed_remapclasses_.size()) {
+    RemapClass* p = nullptr;
+    if (j == changed_remapclasses_.size()) {
+      p = enabled_remapclasses_[i++];
+    } else if (i == enabled_remapclasses_.size()) {
+      p = changed_remapclasses_[j++];
+    } else {
+      uint32_t lhs = enabled_remapclasses_[i]->get_configindex();
+      uint32_t rhs = changed_remapclasses_[j]->get_configindex();
+      if (lhs < rhs) {
+        p = enabled_remapclasses_[i++];
+      } else if (lhs > rhs) {
+        p = changed_remapclasses_[j++];
+      } else {
+        p = enabled_remapclasses_[i++];
+        ++j;
       }
     }
+
+    // Remove disabled RemapClasses which do not have active items.
+    if (p->enabled() || p->hasActiveItem()) {
+      v.push_back(p);
+    }
+  }
+
+  enabled_remapclasses_ = v;
+  changed_remapclasses_.clear();
+
+  if (simultaneousKeyPressesChanged) {
+    rebuild_simultaneouskeypresses();
+  }
+}
+
+static void
+refresh_timer_callback(OSObject* owner, IOTimerEventSource* sender) {
+  if (full_refresh_needed_) {
+    refresh_all();
+  } else {
+    refresh_changed();
   }
 
+  rebuild_plan();
+
   if (strcmp(statusmessage_, lastmessage_) != 0) {
     pqrs::strlcpy_utf8::strlcpy(lastmessage_, statusmessage_, sizeof(lastmessage_));
 
@@ -540,8 +865,13 @@ clear_remapclasses(void) {
   ModifierName::clearVirtualModifiers();
   VirtualKey::VK_CONFIG::clear_items();
   VirtualKey::VK_DEFINED_IN_USERSPACE::clear_items();
+  DeviceFilterTable::clearTargets();
 
   enabled_remapclasses_.clear();
+  statusmessage_remapclasses_.clear();
+  clear_changed_remapclasses();
+  full_refresh_needed_ = true;
+  clear_plan();
   prepareTargetItems_.clear();
 
   for (size_t i = 0; i < remapclasses_.size(); ++i) {
@@ -551,6 +881,7 @@ clear_remapclasses(void) {
     }
   }
   remapclasses_.clear();
+  remapclasses_checksum_ = 0;
 }
 
 void terminate(void) {
@@ -650,11 +981,253 @@ bool load_remapclasses_initialize_vector(const uint32_t* const remapclasses_init
         IOLOG_ERROR("%s remapclasses_[i] == nullptr.\n", __FUNCTION__);
         goto error;
       }
+      remapclasses_checksum_ += remapclasses_[i]->get_checksum();
+    }
+  }
+
+  RemapClass::log_allocation_count();
+
+  return true;
+
+error:
+  clear_remapclasses();
+  return false;
+}
+
+static bool
+has_virtual_modifier(const uint32_t* vec, uint32_t length) {
+  const uint32_t* end = vec + length;
+  const uint32_t* p = vec;
+
+  while (p < end) {
+    uint32_t size = *p++;
+    if (size > 0 && p < end) {
+      if (p[0] == BRIDGE_VK_MODIFIER || p[0] == BRIDGE_MODIFIERNAME) {
+        return true;
+      }
+    }
+    p += size;
+  }
+  return false;
+}
+
+// Remove RemapClasses which are replaced or removed by the delta operations from v.
+// (v is sorted by configindex, and the operations are sorted by configindex.)
+static void
+remove_delta_targets(Vector_RemapClassPointer& v, const uint32_t* operations, uint32_t operation_count) {
+  const uint32_t* q = operations;
+  uint32_t i = 0;
+  size_t n = 0;
+
+  for (size_t k = 0; k < v.size(); ++k) {
+    RemapClass* p = v[k];
+    uint32_t configindex = p->get_configindex();
+
+    while (i < operation_count && q[2] < configindex) {
+      q += 2 + q[1];
+      ++i;
+    }
+    // RemapClasses in v are loaded ones. So the operation is REPLACE or REMOVE.
+    if (i < operation_count && q[2] == configindex) continue;
+
+    v[n] = p;
+    ++n;
+  }
+
+  while (v.size() > n) {
+    v.pop_back();
+  }
+}
+
+bool apply_remapclasses_delta(const uint32_t* const remapclasses_delta, mach_vm_size_t delta_size) {
+  // ------------------------------------------------------------
+  // Validate delta_size
+
+  if ((delta_size % sizeof(uint32_t)) != 0) {
+    IOLOG_ERROR("%s (delta_size %% sizeof(uint32_t)) != 0. (%d)\n", __FUNCTION__, static_cast<int>(delta_size));
+    return false;
+  }
+
+  // change delta_size to num of uint32_t.
+  delta_size /= sizeof(uint32_t);
+
+  if (delta_size < 5) {
+    IOLOG_ERROR("%s delta_size < 5. (%d)\n", __FUNCTION__, static_cast<int>(delta_size));
+    return false;
+  }
+  if (delta_size > RemapClass::MAX_ALLOCATION_COUNT) {
+    IOLOG_ERROR("%s too large delta_size. (%d)\n", __FUNCTION__, static_cast<int>(delta_size));
+    return false;
+  }
+
+  // ------------------------------------------------------------
+  const uint32_t* end = remapclasses_delta + delta_size;
+  const uint32_t* p = remapclasses_delta;
+  uint32_t count = *p++;
+  uint32_t base_count = *p++;
+  uint32_t base_checksum = *p++;
+  uint32_t new_checksum = *p++;
+  uint32_t operation_count = *p++;
+
+  if (count > RemapClass::MAX_CONFIG_COUNT) {
+    IOLOG_ERROR("%s too many count. (%d)\n", __FUNCTION__, count);
+    return false;
+  }
+
+  // The delta is made for other remapclasses. (e.g., kext is reloaded.)
+  if (base_count != remapclasses_.size() || base_checksum != remapclasses_checksum_) {
+    IOLOG_INFO("%s the delta does not match the loaded remapclasses.\n", __FUNCTION__);
+    return false;
+  }
+
+  // ------------------------------------------------------------
+  // (1) Validate all operations before we change remapclasses_.
+  {
+    const uint32_t* q = p;
+    uint32_t added = 0;
+    uint32_t removed = 0;
+    uint32_t last_configindex = 0;
+
+    for (uint32_t i = 0; i < operation_count; ++i) {
+      if (q + 3 > end) {
+        IOLOG_ERROR("%s delta_size mismatch.\n", __FUNCTION__);
+        return false;
+      }
+
+      uint32_t operation = q[0];
+      uint32_t size = q[1];
+      uint32_t configindex = q[2];
+
+      if (size == 0 || q + 2 + size > end) {
+        IOLOG_ERROR("%s invalid size. (configindex:%d, size:%d)\n", __FUNCTION__, configindex, size);
+        return false;
+      }
+
+      // Operations are sorted by configindex. (There are no duplicated operations.)
+      if (i > 0 && configindex <= last_configindex) {
+        IOLOG_ERROR("%s operations are not sorted. (configindex:%d)\n", __FUNCTION__, configindex);
+        return false;
+      }
+      last_configindex = configindex;
+
+      bool valid = false;
+      switch (operation) {
+      case BRIDGE_REMAPCLASSES_DELTA_OPERATION_ADD:
+        valid = (base_count <= configindex && configindex < count);
+        ++added;
+        break;
+      case BRIDGE_REMAPCLASSES_DELTA_OPERATION_REPLACE:
+        valid = (configindex < base_count && configindex < count);
+        break;
+      case BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE:
+        valid = (count <= configindex && configindex < base_count);
+        ++removed;
+        break;
+      }
+      if (!valid) {
+        IOLOG_ERROR("%s invalid operation. (operation:%d, configindex:%d)\n", __FUNCTION__, operation, configindex);
+        return false;
+      }
+
+      // Virtual modifiers cannot be unregistered one by one.
+      if (operation != BRIDGE_REMAPCLASSES_DELTA_OPERATION_ADD) {
+        RemapClass* oldp = remapclasses_[configindex];
+        if (!oldp || oldp->has_virtual_modifier()) {
+          IOLOG_INFO("%s virtual modifiers are changed. (configindex:%d)\n", __FUNCTION__, configindex);
+          return false;
+        }
+      }
+      if (operation != BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE) {
+        if (has_virtual_modifier(q + 3, size - 1)) {
+          IOLOG_INFO("%s virtual modifiers are changed. (configindex:%d)\n", __FUNCTION__, configindex);
+          return false;
+        }
+      }
+
+      q += 2 + size;
+    }
+
+    if (q != end) {
+      IOLOG_ERROR("%s delta_size mismatch.\n", __FUNCTION__);
+      return false;
+    }
+    if (added != (count > base_count ? count - base_count : 0) ||
+        removed != (base_count > count ? base_count - count : 0)) {
+      IOLOG_ERROR("%s count mismatch. (count:%d, base_count:%d)\n", __FUNCTION__, count, base_count);
+      return false;
+    }
+  }
+
+  // ------------------------------------------------------------
+  // (2) Apply operations.
+  //
+  // RemapClasses which are not in the delta are kept as is. (We do not scan them.)
+  // Their enabled state and active items are not changed.
+  //
+  // enabled_remapclasses_, changed_remapclasses_ and plan_ might have RemapClass* which will be deleted.
+  // We remove them before operations are applied.
+  remove_delta_targets(enabled_remapclasses_, p, operation_count);
+  sort_by_configindex(changed_remapclasses_);
+  remove_delta_targets(changed_remapclasses_, p, operation_count);
+  clear_plan();
+
+  remapclasses_.reserve(count);
+  for (uint32_t i = base_count; i < count; ++i) {
+    remapclasses_.push_back(nullptr);
+  }
+
+  for (uint32_t i = 0; i < operation_count; ++i) {
+    uint32_t operation = *p++;
+    uint32_t size = *p++;
+    uint32_t configindex = *p++;
+    --size;
+
+    bool enabled = false;
+    if (configindex < base_count) {
+      RemapClass* oldp = remapclasses_[configindex];
+      if (oldp) {
+        enabled = oldp->enabled();
+        update_statusmessage(*oldp, false);
+        if (oldp->is_simultaneouskeypresses()) {
+          simultaneouskeypresses_dirty_ = true;
+        }
+        remapclasses_checksum_ -= oldp->get_checksum();
+        delete oldp;
+      }
+      remapclasses_[configindex] = nullptr;
+    }
+
+    if (operation != BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE) {
+      RemapClass* newp = new RemapClass(p, size, configindex);
+      if (!newp) {
+        IOLOG_ERROR("%s newp == nullptr.\n", __FUNCTION__);
+        goto error;
+      }
+      // Keep the enabled state until the new config is set.
+      // (newp is added to changed_remapclasses_ if it is enabled.)
+      newp->setEnabled(enabled);
+      remapclasses_checksum_ += newp->get_checksum();
+      remapclasses_[configindex] = newp;
     }
+    p += size;
+  }
+
+  // Removed RemapClasses are placed at the end of remapclasses_.
+  // (All added RemapClasses are set because operations are validated in (1).)
+  while (remapclasses_.size() > count) {
+    remapclasses_.pop_back();
+  }
+
+  // (3) Making sure that the checksum matches.
+  if (remapclasses_checksum_ != new_checksum) {
+    IOLOG_ERROR("%s checksum mismatch.\n", __FUNCTION__);
+    goto error;
   }
 
   RemapClass::log_allocation_count();
 
+  refresh_timer_callback(nullptr, nullptr);
+
   return true;
 
 error:
@@ -714,7 +1287,50 @@ bool set_config_one(bool isEssentialConfig, uint32_t index, int32_t value) {
   return succeed;
 }
 
+bool set_config_delta(const BridgeSetConfigOne* const config_delta, mach_vm_size_t delta_size) {
+  // ------------------------------------------------------------
+  // check
+  if (!config_delta || (delta_size % sizeof(BridgeSetConfigOne)) != 0) {
+    IOLOG_ERROR("%s delta_size mismatch.\n", __FUNCTION__);
+    return false;
+  }
+
+  size_t count = delta_size / sizeof(BridgeSetConfigOne);
+  for (size_t i = 0; i < count; ++i) {
+    const BridgeSetConfigOne& c = config_delta[i];
+    if (c.isEssentialConfig) {
+      if (c.index >= BRIDGE_ESSENTIAL_CONFIG_INDEX__END__) {
+        IOLOG_ERROR("%s essential config index is invalid. (%d)\n", __FUNCTION__, static_cast<int>(c.index));
+        return false;
+      }
+    } else {
+      if (c.index >= remapclasses_.size() || !remapclasses_[c.index]) {
+        IOLOG_ERROR("%s index is invalid. (%d)\n", __FUNCTION__, static_cast<int>(c.index));
+        return false;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------
+  // apply
+  for (size_t i = 0; i < count; ++i) {
+    const BridgeSetConfigOne& c = config_delta[i];
+    if (c.isEssentialConfig) {
+      Config::set_essential_config_one(c.index, c.value);
+    } else {
+      remapclasses_[c.index]->setEnabled(c.value);
+    }
+  }
+
+  refresh();
+
+  return true;
+}
+
 void refresh(void) {
+  // Enabled status of RemapClasses are changed. (ConfigFilter and PassThrough depend on it.)
+  passThroughCacheValid_ = false;
+
   // We use timer to prevent deadlock of lock_. (refresh may be called in the "remap" method.)
   refresh_timer_.setTimeoutMS(0);
 }
@@ -722,46 +1338,78 @@ void refresh(void) {
 // ----------------------------------------------------------------------
 static bool
 isPassThroughEnabled(void) {
-  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
-    RemapClass* p = enabled_remapclasses_[i];
-    if (p && p->isPassThroughEnabled()) return true;
+  if (!(plan_flags_ & (PlanItem::FLAG_PASSTHROUGH_CACHEABLE | PlanItem::FLAG_PASSTHROUGH_UNCACHEABLE))) {
+    return false;
   }
-  return false;
-}
 
-#define CALL_REMAPCLASS_FUNC(FUNC, PARAMS)                      \
-  {                                                             \
-    for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) { \
-      RemapClass* p = enabled_remapclasses_[i];                 \
-      if (p) p->FUNC(PARAMS, passThroughEnabled);               \
-    }                                                           \
+  uint32_t workspaceEpoch = CommonData::getcurrent_workspaceEpoch();
+  if (!passThroughCacheValid_ || passThroughCacheWorkspaceEpoch_ != workspaceEpoch) {
+    passThroughCacheEnabled_ = false;
+    for (size_t i = 0; i < plan_.size(); ++i) {
+      if ((plan_[i].flags & PlanItem::FLAG_PASSTHROUGH_CACHEABLE) &&
+          plan_[i].item->isPassThroughEnabled()) {
+        passThroughCacheEnabled_ = true;
+        break;
+      }
+    }
+    passThroughCacheValid_ = true;
+    passThroughCacheWorkspaceEpoch_ = workspaceEpoch;
+  }
+
+  if (passThroughCacheEnabled_) return true;
+
+  if (plan_flags_ & PlanItem::FLAG_PASSTHROUGH_UNCACHEABLE) {
+    for (size_t i = 0; i < plan_.size(); ++i) {
+      if ((plan_[i].flags & PlanItem::FLAG_PASSTHROUGH_UNCACHEABLE) &&
+          plan_[i].item->isPassThroughEnabled()) {
+        return true;
+      }
+    }
   }
 
+  return false;
+}
+
 void remap_setkeyboardtype(KeyboardType& keyboardType) {
+  if (!(plan_flags_ & PlanItem::FLAG_SETKEYBOARDTYPE)) return;
+
   bool passThroughEnabled = isPassThroughEnabled();
-  CALL_REMAPCLASS_FUNC(remap_setkeyboardtype, keyboardType);
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    if (plan_[i].flags & PlanItem::FLAG_SETKEYBOARDTYPE) {
+      plan_[i].item->remap_setkeyboardtype(keyboardType, passThroughEnabled);
+    }
+  }
 }
 
 void remap_forcenumlockon(ListHookedKeyboard::Item* item) {
+  if (!(plan_flags_ & PlanItem::FLAG_FORCENUMLOCKON)) return;
+
   bool passThroughEnabled = isPassThroughEnabled();
-  CALL_REMAPCLASS_FUNC(remap_forcenumlockon, item);
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    if (plan_[i].flags & PlanItem::FLAG_FORCENUMLOCKON) {
+      plan_[i].item->remap_forcenumlockon(item, passThroughEnabled);
+    }
+  }
 }
 
 void remap(RemapParams& remapParams) {
   bool passThroughEnabled = isPassThroughEnabled();
-  CALL_REMAPCLASS_FUNC(remap, remapParams);
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    // DependingPressingPeriodKeyToKey watches another key status.
+    // Therefore, we need to call 'remap' for all items.
+    plan_[i].item->remap(remapParams, passThroughEnabled);
+  }
 }
 
-#undef CALL_REMAPCLASS_FUNC
-
 bool isTargetEventForBlockUntilKeyUp(const Params_Base& paramsBase) {
+  if (!(plan_flags_ & PlanItem::FLAG_BLOCKUNTILKEYUP)) return false;
+
   bool passThroughEnabled = isPassThroughEnabled();
   bool isTargetEvent = false;
 
-  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
-    RemapClass* p = enabled_remapclasses_[i];
-    if (p) {
-      if (p->isTargetEventForBlockUntilKeyUp(paramsBase, passThroughEnabled)) {
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    if (plan_[i].flags & PlanItem::FLAG_BLOCKUNTILKEYUP) {
+      if (plan_[i].item->isTargetEventForBlockUntilKeyUp(paramsBase, passThroughEnabled)) {
         isTargetEvent = true;
       }
     }
@@ -771,13 +1419,14 @@ bool isTargetEventForBlockUntilKeyUp(const Params_Base& paramsBase) {
 }
 
 bool remap_simultaneouskeypresses(bool iskeydown) {
+  if (!(plan_flags_ & PlanItem::FLAG_SIMULTANEOUSKEYPRESSES)) return false;
+
   bool passThroughEnabled = isPassThroughEnabled();
   bool queue_changed = false;
 
-  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
-    RemapClass* p = enabled_remapclasses_[i];
-    if (p) {
-      if (p->remap_simultaneouskeypresses(iskeydown, passThroughEnabled)) {
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    if (plan_[i].flags & PlanItem::FLAG_SIMULTANEOUSKEYPRESSES) {
+      if (plan_[i].item->remap_SimultaneousKeyPresses(iskeydown, passThroughEnabled)) {
         queue_changed = true;
       }
     }
@@ -787,12 +1436,13 @@ bool remap_simultaneouskeypresses(bool iskeydown) {
 }
 
 void cancelEventOutputQueueItems(void) {
+  if (!(plan_flags_ & PlanItem::FLAG_CANCELEVENTOUTPUTQUEUEITEMS)) return;
+
   bool passThroughEnabled = isPassThroughEnabled();
 
-  for (size_t i = 0; i < enabled_remapclasses_.size(); ++i) {
-    RemapClass* p = enabled_remapclasses_[i];
-    if (p) {
-      p->cancelEventOutputQueueItems(passThroughEnabled);
+  for (size_t i = 0; i < plan_.size(); ++i) {
+    if (plan_[i].flags & PlanItem::FLAG_CANCELEVENTOUTPUTQUEUEITEMS) {
+      plan_[i].item->cancelEventOutputQueueItems(passThroughEnabled);
     }
   }
 }
@@ -801,6 +1451,10 @@ bool isSimultaneousKeyPressesEnabled(void) {
   return isSimultaneousKeyPressesEnabled_;
 }
 
+const FromEventBitmap& getSimultaneousKeyPressesFromEvents(void) {
+  return simultaneousKeyPressesFromEvents_;
+}
+
 bool isEnabled(size_t configindex) {
   if (configindex >= remapclasses_.size()) {
     IOLOG_ERROR("RemapClass::isEnabled invalid configindex.\n");
@@ -813,6 +1467,82 @@ bool isEnabled(size_t configindex) {
   return p->enabled();
 }
 
+static void
+set_statistics(BridgeRemapStatistics& entry, uint32_t configindex, uint32_t itemindex, const RemapClass::Statistics& statistics) {
+  uint64_t nanoseconds = 0;
+  absolutetime_to_nanoseconds(statistics.time, &nanoseconds);
+
+  entry.time = nanoseconds;
+  entry.configindex = configindex;
+  entry.itemindex = itemindex;
+  entry.attempts = statistics.attempts;
+  entry.remaps = statistics.remaps;
+  entry.filtered = statistics.filtered;
+  entry.reserved = 0;
+}
+
+bool get_statistics(uint32_t type, uint8_t* buffer, size_t size) {
+  if (!buffer || size < sizeof(BridgeRemapStatisticsHeader)) {
+    IOLOG_ERROR("RemapClassManager::get_statistics too small buffer\n");
+    return false;
+  }
+
+  BridgeRemapStatisticsHeader* header = reinterpret_cast<BridgeRemapStatisticsHeader*>(buffer);
+  BridgeRemapStatistics* entries = reinterpret_cast<BridgeRemapStatistics*>(buffer + sizeof(BridgeRemapStatisticsHeader));
+  size_t capacity = (size - sizeof(BridgeRemapStatisticsHeader)) / sizeof(BridgeRemapStatistics);
+
+  header->count = 0;
+  header->total = 0;
+
+  switch (type) {
+  case BRIDGE_REMAP_STATISTICS_TYPE_REMAPCLASS:
+    for (size_t i = 0; i < remapclasses_.size(); ++i) {
+      RemapClass::Statistics statistics;
+
+      RemapClass* p = remapclasses_[i];
+      if (p) {
+        const RemapClass::Vector_ItemPointer& items = p->get_items();
+        for (size_t j = 0; j < items.size(); ++j) {
+          if (items[j]) {
+            statistics.add(items[j]->getStatistics());
+          }
+        }
+      }
+
+      if (header->count < capacity) {
+        set_statistics(entries[header->count], static_cast<uint32_t>(i), 0, statistics);
+        ++(header->count);
+      }
+      ++(header->total);
+    }
+    return true;
+
+  case BRIDGE_REMAP_STATISTICS_TYPE_ITEM:
+    for (size_t i = 0; i < remapclasses_.size(); ++i) {
+      RemapClass* p = remapclasses_[i];
+      if (!p) continue;
+
+      const RemapClass::Vector_ItemPointer& items = p->get_items();
+      for (size_t j = 0; j < items.size(); ++j) {
+        if (!items[j]) continue;
+
+        const RemapClass::Statistics& statistics = items[j]->getStatistics();
+        if (statistics.attempts == 0 && statistics.filtered == 0) continue;
+
+        if (header->count < capacity) {
+          set_statistics(entries[header->count], static_cast<uint32_t>(i), static_cast<uint32_t>(j + 1), statistics);
+          ++(header->count);
+        }
+        ++(header->total);
+      }
+    }
+    return true;
+  }
+
+  IOLOG_ERROR("RemapClassManager::get_statistics unknown type (%d)\n", type);
+  return false;
+}
+
 void registerPrepareTargetItem(RemapFunc::RemapFuncBase* processor) {
   unregisterPrepareTargetItem(processor);
   if (processor) {
@@ -14,75 +14,45 @@ public:
 
   class Item;
 
-  class ActiveItems final {
-    friend class Item;
-
+  // Counters which are collected while Config::get_statistics() is true.
+  class Statistics final {
   public:
-    class Item final : public List::Item {
-    public:
-      enum class Type {
-        NORMAL,
-        SIMULTANEOUSBUTTONPRESSES,
-      };
-
-      Item(const RemapClass::Item* p, Type t) : item_(p), type_(t) {}
-      ~Item(void) {}
-
-      const RemapClass::Item* getItem(void) const { return item_; }
-      Type getType(void) const { return type_; }
-
-    private:
-      const RemapClass::Item* item_;
-      Type type_;
-    };
+    Statistics(void) : time(0), attempts(0), remaps(0), filtered(0) {}
 
-    static Item* find(const RemapClass::Item* p, Item::Type t) {
-      for (Item* q = static_cast<Item*>(list_.safe_front()); q; q = static_cast<Item*>(q->getnext())) {
-        if (q->getItem() == p && q->getType() == t) {
-          return q;
-        }
-      }
-      return nullptr;
+    void add(const Statistics& other) {
+      time += other.time;
+      attempts += other.attempts;
+      remaps += other.remaps;
+      filtered += other.filtered;
     }
 
-    static void clear(void) {
-      list_.clear();
-    }
-
-    static void push_back(const RemapClass::Item* p, Item::Type t) {
-      list_.push_back(new Item(p, t));
-      if (list_.size() > 60000) {
-        IOLOG_WARN("RemapClass::ActiveItems too many item count: %ld\n", list_.size());
-      }
-    }
+    // The cumulative time of RemapFunc::remap. (absolute time)
+    uint64_t time;
+    uint32_t attempts;
+    uint32_t remaps;
+    uint32_t filtered;
+  };
 
-    static bool erase(const RemapClass::Item* p, Item::Type t) {
-      Item* q = find(p, t);
-      if (q) {
-        list_.erase_and_delete(q);
-        return true;
-      }
-      return false;
-    }
+  // The active state (processed at KeyDown and not yet processed at KeyUp) is stored in each Item.
+  // ActiveItems manages the generation of these states in order to clear all states in O(1).
+  class ActiveItems final {
+  public:
+    enum class Type {
+      NORMAL,
+      SIMULTANEOUSBUTTONPRESSES,
+      END_,
+    };
 
-    static void erase_all(const RemapClass::Item* p) {
-      Item* q = static_cast<Item*>(list_.safe_front());
-      while (q) {
-        if (q->getItem() == p) {
-          q = static_cast<Item*>(list_.erase_and_delete(q));
-        } else {
-          q = static_cast<Item*>(q->getnext());
-        }
-      }
-    }
+    static void clear(void) { ++generation_; }
+    static uint32_t getGeneration(void) { return generation_; }
 
   private:
-    static List list_;
+    static uint32_t generation_;
   };
 
   class Item final {
   public:
-    Item(const RemapClass& parent, const uint32_t* vec, size_t length);
+    Item(RemapClass& parent, const uint32_t* vec, size_t length);
     ~Item(void);
     void append_filter(const uint32_t* vec, size_t length);
 
@@ -99,12 +69,26 @@ public:
     //
     void remap_forcenumlockon(ListHookedKeyboard::Item* item, bool passThroughEnabled);
 
-    bool active(void) const {
-      return (ActiveItems::find(this, ActiveItems::Item::Type::NORMAL) ||
-              ActiveItems::find(this, ActiveItems::Item::Type::SIMULTANEOUSBUTTONPRESSES));
+    bool active(ActiveItems::Type t) const {
+      if (activeGeneration_ != ActiveItems::getGeneration()) return false;
+      return activeCount_[static_cast<int>(t)] > 0;
     }
 
     bool isPassThroughEnabled(void) const;
+    // Return true if isPassThroughEnabled is changed only when workspace or configs are changed.
+    bool isPassThroughCacheable(void) const;
+
+    void getSimultaneousKeyPressesFromEvents(FromEventBitmap& fromEvents) const {
+      if (!processor_) return;
+      processor_->getSimultaneousKeyPressesFromEvents(fromEvents);
+    }
+
+    uint32_t getProcessorType(void) const {
+      if (!processor_) return BRIDGE_REMAPTYPE_NONE;
+      return processor_->getType();
+    }
+
+    const Statistics& getStatistics(void) const { return statistics_; }
 
   private:
     bool isblocked(void) const;
@@ -118,12 +102,21 @@ public:
       return processor_->getIgnorePassThrough();
     }
 
-    const RemapClass& parent_;
+    void activate(ActiveItems::Type t);
+    void deactivate(ActiveItems::Type t);
+
+    RemapClass& parent_;
 
     uint32_t type_;
 
     RemapFunc::RemapFuncBase* processor_;
     RemapFilter::Vector_RemapFilterBasePointer filters_;
+
+    // activeCount_ is valid only if activeGeneration_ == ActiveItems::getGeneration().
+    uint32_t activeGeneration_;
+    uint32_t activeCount_[static_cast<int>(ActiveItems::Type::END_)];
+
+    Statistics statistics_;
   };
   typedef Item* ItemPointer;
   DECLARE_VECTOR(ItemPointer);
@@ -132,22 +125,23 @@ public:
   RemapClass(const uint32_t* const initialize_vector, uint32_t vector_size, uint32_t configindex);
   ~RemapClass(void);
 
-  void remap_setkeyboardtype(KeyboardType& keyboardType, bool passThroughEnabled);
-  void remap_forcenumlockon(ListHookedKeyboard::Item* item, bool passThroughEnabled);
-  void remap(RemapParams& remapParams, bool passThroughEnabled);
-
-  // for BlockUntilKeyUp
-  bool isTargetEventForBlockUntilKeyUp(const Params_Base& paramsBase, bool passThroughEnabled);
-  bool remap_simultaneouskeypresses(bool iskeydown, bool passThroughEnabled);
-  void cancelEventOutputQueueItems(bool passThroughEnabled);
+  const Vector_ItemPointer& get_items(void) const { return items_; }
   const char* get_statusmessage(void) const { return statusmessage_; }
+  size_t get_statusmessage_length(void) const { return statusmessage_length_; }
   bool enabled(void) const { return enabled_; }
-  void setEnabled(bool newval) { enabled_ = newval; }
+  // RemapClassManager::refresh applies only changed RemapClasses.
+  void setEnabled(bool newval);
   void toggleEnabled(void) { setEnabled(!enabled_); }
+  // true until RemapClassManager applies the enabled state.
+  bool changed(void) const { return changed_; }
+  void clearChanged(void) { changed_ = false; }
   bool is_simultaneouskeypresses(void) const { return is_simultaneouskeypresses_; }
   uint32_t get_configindex(void) const { return configindex_; }
-  bool hasActiveItem(void) const;
-  bool isPassThroughEnabled(void) const;
+  uint32_t get_checksum(void) const { return checksum_; }
+  bool has_virtual_modifier(void) const { return has_virtual_modifier_; }
+  bool hasActiveItem(void) const {
+    return activeGeneration_ == ActiveItems::getGeneration() && activeCount_ > 0;
+  }
 
   static void log_allocation_count(void);
   static void reset_allocation_count(void);
@@ -158,9 +152,18 @@ private:
 
   Vector_ItemPointer items_;
   char* statusmessage_;
+  size_t statusmessage_length_;
   bool enabled_;
+  bool changed_;
   bool is_simultaneouskeypresses_;
+  bool has_virtual_modifier_;
   uint32_t configindex_;
+  uint32_t checksum_;
+  uint32_t allocated_size_;
+
+  // The sum of Item::activeCount_. (valid only if activeGeneration_ == ActiveItems::getGeneration().)
+  uint32_t activeGeneration_;
+  uint32_t activeCount_;
 
   static int allocation_count_;
 };
@@ -173,12 +176,23 @@ void initialize(IOWorkLoop& workloop);
 void terminate(void);
 
 bool load_remapclasses_initialize_vector(const uint32_t* const remapclasses_initialize_vector, mach_vm_size_t vector_size);
+// Replace only changed RemapClasses. Unchanged RemapClasses keep their state.
+// Return false if the delta is not for the loaded remapclasses. (Load the whole vector in that case.)
+bool apply_remapclasses_delta(const uint32_t* const remapclasses_delta, mach_vm_size_t delta_size);
 bool set_config(const int32_t* const config_vector, mach_vm_size_t config_size);
 bool set_config_one(bool isEssentialConfig, uint32_t index, int32_t value);
+// Apply the array of BridgeSetConfigOne.
+// Nothing is applied if any entry is invalid.
+bool set_config_delta(const BridgeSetConfigOne* const config_delta, mach_vm_size_t delta_size);
 
 // call after setting enable/disable status is changed.
 // (PreferencesPane, VK_CONFIG)
+//
+// The cost of refresh depends on the number of enabled and changed RemapClasses,
+// not the number of all RemapClasses.
 void refresh(void);
+// Called by RemapClass::setEnabled.
+void add_changed_remapclass(RemapClass& remapclass);
 
 void remap_setkeyboardtype(KeyboardType& keyboardType);
 void remap_forcenumlockon(ListHookedKeyboard::Item* item);
@@ -199,9 +213,15 @@ bool remap_simultaneouskeypresses(bool iskeydown);
 void cancelEventOutputQueueItems(void);
 
 bool isSimultaneousKeyPressesEnabled(void);
+// Events which are used in enabled __SimultaneousKeyPresses__.
+const FromEventBitmap& getSimultaneousKeyPressesFromEvents(void);
 
 bool isEnabled(size_t configindex);
 
+// Fill buffer with BridgeRemapStatisticsHeader and BridgeRemapStatistics array.
+// (type is BRIDGE_REMAP_STATISTICS_TYPE_*.)
+bool get_statistics(uint32_t type, uint8_t* buffer, size_t size);
+
 class PrepareTargetItem final : public List::Item {
 public:
   PrepareTargetItem(RemapFunc::RemapFuncBase* p) : remapFuncBaseWeakPointer(p) {}
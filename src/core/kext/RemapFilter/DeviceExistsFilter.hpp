@@ -1,24 +1,31 @@
 #pragma once
 
-#include "CommonData.hpp"
+#include "DeviceFilterTable.hpp"
 #include "RemapFilterBase.hpp"
 
 namespace org_pqrs_Karabiner {
 namespace RemapFilter {
 class DeviceExistsFilter final : public RemapFilterBase {
 public:
-  DeviceExistsFilter(unsigned int type, const unsigned int* vec, size_t length) : RemapFilterBase(type) {
-    targets_.reserve(length / 3);
+  DeviceExistsFilter(unsigned int type, const unsigned int* vec, size_t length) : RemapFilterBase(type), id_(0) {
+    Vector_DeviceIdentifier targets;
+    targets.reserve(length / 3);
 
     for (int i = 0; i < static_cast<int>(length) - 2; i += 3) {
-      targets_.push_back(DeviceIdentifier(DeviceVendor(vec[i]),
-                                          DeviceProduct(vec[i + 1]),
-                                          DeviceLocation(vec[i + 2])));
+      targets.push_back(DeviceIdentifier(DeviceVendor(vec[i]),
+                                         DeviceProduct(vec[i + 1]),
+                                         DeviceLocation(vec[i + 2])));
     }
 
     if (length % 3 > 0) {
       IOLOG_WARN("Invalid length(%d) in BRIDGE_FILTERTYPE_DEVICEEXISTS_*\n", static_cast<int>(length));
     }
+
+    id_ = DeviceFilterTable::registerTargets(targets);
+  }
+
+  ~DeviceExistsFilter(void) {
+    DeviceFilterTable::unregisterTargets(id_);
   }
 
   bool isblocked(void) override {
@@ -27,11 +34,8 @@ public:
 
       bool isnot = (get_type() == BRIDGE_FILTERTYPE_DEVICEEXISTS_NOT);
 
-      for (size_t i = 0; i < targets_.size(); ++i) {
-        DeviceIdentifier& v = targets_[i];
-        if (ListHookedDevice::existsAll(v)) {
-          return isnot ? true : false;
-        }
+      if (DeviceFilterTable::exists(id_)) {
+        return isnot ? true : false;
       }
 
       return isnot ? false : true;
@@ -44,7 +48,8 @@ public:
   bool isblocked_keyup(void) override { return isblocked(); }
 
 private:
-  Vector_DeviceIdentifier targets_;
+  // The id in DeviceFilterTable.
+  uint32_t id_;
 };
 }
 }
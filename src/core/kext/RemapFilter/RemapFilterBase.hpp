@@ -49,6 +49,26 @@ public:
 
   unsigned int get_type(void) const { return type_; }
 
+  // Return true if the result of isblocked is changed only when workspace or configs are changed.
+  // (RemapClassManager caches the result of these filters.)
+  bool isDependingOnlyOnWorkspaceAndConfig(void) const {
+    switch (type_) {
+    case BRIDGE_FILTERTYPE_APPLICATION_NOT:
+    case BRIDGE_FILTERTYPE_APPLICATION_ONLY:
+    case BRIDGE_FILTERTYPE_CONFIG_NOT:
+    case BRIDGE_FILTERTYPE_CONFIG_ONLY:
+    case BRIDGE_FILTERTYPE_INPUTSOURCE_NOT:
+    case BRIDGE_FILTERTYPE_INPUTSOURCE_ONLY:
+    case BRIDGE_FILTERTYPE_UIELEMENTROLE_NOT:
+    case BRIDGE_FILTERTYPE_UIELEMENTROLE_ONLY:
+    case BRIDGE_FILTERTYPE_WINDOWNAME_NOT:
+    case BRIDGE_FILTERTYPE_WINDOWNAME_ONLY:
+      return true;
+    default:
+      return false;
+    }
+  }
+
 private:
   unsigned int type_;
 };
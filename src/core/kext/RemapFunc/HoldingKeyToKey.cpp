@@ -71,6 +71,8 @@ void HoldingKeyToKey::add(AddDataType datatype, AddValue newval) {
       } else if (datatype == BRIDGE_DATATYPE_OPTION && Option::KEYTOKEY_AFTER_KEYUP == Option(newval)) {
         indexType_ = INDEX_IS_KEYTOKEY_AFTER_KEYUP;
         dppkeytokey_.addBeforeAfterKeys(datatype, newval);
+      } else if (datatype == BRIDGE_DATATYPE_OPTION && DependingPressingPeriodKeyToKey::isResolutionOption(Option(newval))) {
+        dppkeytokey_.add(DependingPressingPeriodKeyToKey::KeyToKeyType::SHORT_PERIOD, datatype, newval);
       } else {
         addToDependingPressingPeriodKeyToKey(datatype, newval);
       }
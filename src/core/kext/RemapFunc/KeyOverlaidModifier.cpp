@@ -78,6 +78,8 @@ void KeyOverlaidModifier::add(AddDataType datatype, AddValue newval) {
     } else if (Option::KEYTOKEY_AFTER_KEYUP == option) {
       indexType_ = INDEX_IS_KEYTOKEY_AFTER_KEYUP;
       dppkeytokey_.addBeforeAfterKeys(datatype, newval);
+    } else if (DependingPressingPeriodKeyToKey::isResolutionOption(option)) {
+      dppkeytokey_.add(DependingPressingPeriodKeyToKey::KeyToKeyType::LONG_PERIOD, datatype, newval);
     } else {
       IOLOG_ERROR("KeyOverlaidModifier::add unknown option:%u\n", static_cast<unsigned int>(newval));
     }
@@ -12,7 +12,7 @@ END_IOKIT_INCLUDE;
 
 namespace org_pqrs_Karabiner {
 namespace RemapFunc {
-List PointingRelativeToScroll::queue_;
+PointingRelativeToScroll::DeltaQueue PointingRelativeToScroll::queue_;
 Vector_ModifierFlag PointingRelativeToScroll::currentFromModifierFlags_;
 Vector_ModifierFlag PointingRelativeToScroll::currentToModifierFlags_;
 bool PointingRelativeToScroll::currentFlipHorizontal_;
@@ -35,6 +35,7 @@ void PointingRelativeToScroll::cancelScroll(void) {
   timer_.cancelTimeout();
 
   queue_.clear();
+  EventOutputQueue::FireScrollWheel::clearRemainders();
 }
 
 void PointingRelativeToScroll::add(AddDataType datatype, AddValue newval) {
@@ -280,7 +281,7 @@ void PointingRelativeToScroll::toscroll(RemapParams& remapParams) {
   }
 
   absolute_distance_ += abs(chained_delta1_) + abs(chained_delta2_);
-  queue_.push_back(new Item(chained_delta1_ * EventOutputQueue::FireScrollWheel::DELTA_SCALE, chained_delta2_ * EventOutputQueue::FireScrollWheel::DELTA_SCALE));
+  queue_.push_back(chained_delta1_ * EventOutputQueue::FireScrollWheel::DELTA_SCALE, chained_delta2_ * EventOutputQueue::FireScrollWheel::DELTA_SCALE);
 
   currentFromModifierFlags_ = fromModifierFlags_;
   currentToModifierFlags_ = toModifierFlags_;
@@ -294,15 +295,7 @@ void PointingRelativeToScroll::timer_callback(OSObject* owner, IOTimerEventSourc
   // ----------------------------------------
   int delta1 = 0;
   int delta2 = 0;
-  {
-    Item* p = static_cast<Item*>(queue_.safe_front());
-    if (!p) return;
-
-    delta1 = p->delta1;
-    delta2 = p->delta2;
-
-    queue_.pop_front();
-  }
+  if (!queue_.pop_front(delta1, delta2)) return;
 
   // ----------------------------------------
   FlagStatus::globalFlagStatus().temporary_decrease(currentFromModifierFlags_);
@@ -327,7 +320,7 @@ void PointingRelativeToScroll::timer_callback(OSObject* owner, IOTimerEventSourc
   // ----------------------------------------
   if (!Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_option_pointing_disable_momentum_scroll)) {
     if (delta1 != 0 || delta2 != 0) {
-      queue_.push_back(new Item(delta1 / 2, delta2 / 2));
+      queue_.push_back(delta1 / 2, delta2 / 2);
     }
   }
 
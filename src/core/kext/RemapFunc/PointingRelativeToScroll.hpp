@@ -2,7 +2,6 @@
 
 #include "IntervalChecker.hpp"
 #include "KeyToKey.hpp"
-#include "List.hpp"
 #include "RemapFuncBase.hpp"
 #include "TimerWrapper.hpp"
 
@@ -44,13 +43,55 @@ private:
     SCROLL_INTERVAL_MS = 10,
   };
 
-  class Item final : public List::Item {
+  // Scroll deltas which will be sent at each SCROLL_INTERVAL_MS.
+  // The deltas are stored in a ring buffer in order to avoid an allocation per cursor move event.
+  class DeltaQueue final {
   public:
-    Item(int d1, int d2) : delta1(d1), delta2(d2) {}
-    virtual ~Item(void) {}
+    DeltaQueue(void) : head_(0), count_(0) {}
 
-    int delta1;
-    int delta2;
+    bool empty(void) const { return count_ == 0; }
+    void clear(void) { count_ = 0; }
+
+    // If the queue is full, the deltas are added to the last item in order to keep the total scroll amount.
+    void push_back(int delta1, int delta2) {
+      if (count_ >= QUEUE_SIZE) {
+        Item& last = items_[(head_ + count_ - 1) & (QUEUE_SIZE - 1)];
+        last.delta1 += delta1;
+        last.delta2 += delta2;
+        return;
+      }
+
+      Item& item = items_[(head_ + count_) & (QUEUE_SIZE - 1)];
+      item.delta1 = delta1;
+      item.delta2 = delta2;
+      ++count_;
+    }
+
+    // Return false if the queue is empty.
+    bool pop_front(int& delta1, int& delta2) {
+      if (count_ == 0) return false;
+
+      delta1 = items_[head_].delta1;
+      delta2 = items_[head_].delta2;
+      head_ = (head_ + 1) & (QUEUE_SIZE - 1);
+      --count_;
+      return true;
+    }
+
+  private:
+    enum {
+      // The number of items must be a power of 2.
+      QUEUE_SIZE = 64,
+    };
+
+    struct Item {
+      int delta1;
+      int delta2;
+    };
+
+    Item items_[QUEUE_SIZE];
+    size_t head_;
+    size_t count_;
   };
 
   void toscroll(RemapParams& remapParams);
@@ -98,7 +139,7 @@ private:
   int fixation_delta2_;
 
   // ----------
-  static List queue_;
+  static DeltaQueue queue_;
   static Vector_ModifierFlag currentFromModifierFlags_;
   static Vector_ModifierFlag currentToModifierFlags_;
   static bool currentFlipHorizontal_;
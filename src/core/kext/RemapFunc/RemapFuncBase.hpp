@@ -2,6 +2,7 @@
 
 #include "EventOutputQueue.hpp"
 #include "FromEvent.hpp"
+#include "FromEventBitmap.hpp"
 #include "IOLogWrapper.hpp"
 #include "KeyCode.hpp"
 #include "ListHookedKeyboard.hpp"
@@ -57,6 +58,8 @@ public:
   virtual RemapSimultaneousKeyPressesResult::Value remapSimultaneousKeyPresses(void) {
     return RemapSimultaneousKeyPressesResult::NOT_CHANGED;
   }
+  // Add events which remapSimultaneousKeyPresses watches.
+  virtual void getSimultaneousKeyPressesFromEvents(FromEventBitmap& fromEvents) const {}
   virtual bool remapSetKeyboardType(KeyboardType& keyboardType) { return false; }
   virtual bool remapForceNumLockOn(ListHookedKeyboard::Item* item) { return false; }
   virtual const FromEvent* getBlockUntilKeyUpFromEvent(void) const { return nullptr; }
@@ -144,6 +144,7 @@ SimultaneousKeyPresses::remapSimultaneousKeyPresses(void) {
   // backup device information.
   DeviceIdentifier frontDeviceIdentifier(front->deviceIdentifier);
   ListHookedDevice::WeakPointer_Item frontDevice(front->deviceWeakPointer);
+  uint64_t frontTimestamp = front->timestamp;
 
   // ------------------------------------------------------------
   // fire KeyUp event if needed.
@@ -180,7 +181,7 @@ SimultaneousKeyPresses::remapSimultaneousKeyPresses(void) {
       return RemapSimultaneousKeyPressesResult::QUEUE_CHANGED;
     }
 
-    push_remapped(false, deviceIdentifier, device);
+    push_remapped(false, deviceIdentifier, device, frontTimestamp);
     return RemapSimultaneousKeyPressesResult::APPLIED;
   }
 
@@ -277,12 +278,13 @@ scan:
                                     retainFlagStatusTemporaryCount,
                                     frontDeviceIdentifier,
                                     frontDevice,
+                                    (downKeys_[i].item)->timestamp,
                                     push_back,
                                     isSimultaneousKeyPressesTarget);
         }
         EventInputQueue::queue_.erase_and_delete(downKeys_[i].item);
       }
-      push_remapped(true, frontDeviceIdentifier, frontDevice);
+      push_remapped(true, frontDeviceIdentifier, frontDevice, frontTimestamp);
       return RemapSimultaneousKeyPressesResult::APPLIED;
     }
 
@@ -302,7 +304,7 @@ scan:
   return RemapSimultaneousKeyPressesResult::NOT_CHANGED;
 }
 
-void SimultaneousKeyPresses::push_remapped(bool isKeyDown, const DeviceIdentifier& deviceIdentifier, const ListHookedDevice::WeakPointer_Item& device) {
+void SimultaneousKeyPresses::push_remapped(bool isKeyDown, const DeviceIdentifier& deviceIdentifier, const ListHookedDevice::WeakPointer_Item& device, uint64_t timestamp) {
   EventType eventType = isKeyDown ? EventType::DOWN : EventType::UP;
 
   KeyCode key = virtualkey_;
@@ -322,7 +324,7 @@ void SimultaneousKeyPresses::push_remapped(bool isKeyDown, const DeviceIdentifie
   bool retainFlagStatusTemporaryCount = false;
   bool push_back = false;
   bool isSimultaneousKeyPressesTarget = false;
-  EventInputQueue::enqueue_(params, retainFlagStatusTemporaryCount, deviceIdentifier, device, push_back, isSimultaneousKeyPressesTarget);
+  EventInputQueue::enqueue_(params, retainFlagStatusTemporaryCount, deviceIdentifier, device, timestamp, push_back, isSimultaneousKeyPressesTarget);
 }
 
 bool SimultaneousKeyPresses::remap(RemapParams& remapParams) {
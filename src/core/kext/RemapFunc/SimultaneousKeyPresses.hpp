@@ -20,6 +20,11 @@ public:
 
   // This function changes Simultaneous key presses to KeyCode::VK_SIMULTANEOUSKEYPRESSES_xxx
   RemapSimultaneousKeyPressesResult::Value remapSimultaneousKeyPresses(void) override;
+  void getSimultaneousKeyPressesFromEvents(FromEventBitmap& fromEvents) const override {
+    for (size_t i = 0; i < fromInfo_.size(); ++i) {
+      fromEvents.add(fromInfo_[i].fromEvent());
+    }
+  }
   // This function changes KeyCode::VK_SIMULTANEOUSKEYPRESSES_xxx to remapped key/pointing events.
   bool remap(RemapParams& remapParams) override;
 
@@ -37,7 +42,7 @@ public:
   }
 
 private:
-  void push_remapped(bool isKeyDown, const DeviceIdentifier& deviceIdentifier, const ListHookedDevice::WeakPointer_Item& device);
+  void push_remapped(bool isKeyDown, const DeviceIdentifier& deviceIdentifier, const ListHookedDevice::WeakPointer_Item& device, uint64_t timestamp);
 
   class FromInfo;
 
@@ -187,7 +192,7 @@ private:
     bool isActive(ListHookedDevice::WeakPointer_Item& d) const { return ActiveFromInfos::find(this, d); }
     bool isActiveBySerialNumber(EventInputQueue::SerialNumber s) const { return ActiveFromInfos::find_by_serial_number(this, s); }
 
-    const FromEvent& fromEvent(void) { return fromEvent_; }
+    const FromEvent& fromEvent(void) const { return fromEvent_; }
 
   private:
     FromEvent fromEvent_;
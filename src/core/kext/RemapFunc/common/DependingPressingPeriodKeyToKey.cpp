@@ -6,6 +6,7 @@ END_IOKIT_INCLUDE;
 
 #include "Config.hpp"
 #include "DependingPressingPeriodKeyToKey.hpp"
+#include "EventInputQueue.hpp"
 #include "IOLogWrapper.hpp"
 #include "KeyboardRepeat.hpp"
 #include "RemapClass.hpp"
@@ -146,7 +147,12 @@ DependingPressingPeriodKeyToKey::DependingPressingPeriodKeyToKey(RemapFunc::Rema
                                                                                                                          beforeAfterKeys_(autogenId),
                                                                                                                          keyboardRepeatID_(0),
                                                                                                                          lastPhysicalEventType_(PhysicalEventType::DOWN),
-                                                                                                                         interruptibleByScrollWheel_(true) {
+                                                                                                                         interruptibleByScrollWheel_(true),
+                                                                                                                         interruptibleByModifier_(true),
+                                                                                                                         interruptibleByPointingButton_(true),
+                                                                                                                         holdOnOtherKeyPress_(false),
+                                                                                                                         permissiveHold_(false),
+                                                                                                                         adaptiveHoldingThreshold_(false) {
   for (size_t i = 0; i < KeyToKeyType::END_; ++i) {
     keytokey_[i].add(KeyCode::VK_PSEUDO_KEY);
   }
@@ -163,11 +169,33 @@ DependingPressingPeriodKeyToKey::~DependingPressingPeriodKeyToKey(void) {
   }
 }
 
+bool DependingPressingPeriodKeyToKey::isResolutionOption(Option option) {
+  return Option::UNINTERRUPTIBLE_BY_SCROLL_WHEEL == option ||
+         Option::UNINTERRUPTIBLE_BY_MODIFIER == option ||
+         Option::UNINTERRUPTIBLE_BY_POINTING_BUTTON == option ||
+         Option::HOLD_ON_OTHER_KEY_PRESS == option ||
+         Option::PERMISSIVE_HOLD == option ||
+         Option::ADAPTIVE_HOLDING_THRESHOLD == option;
+}
+
 void DependingPressingPeriodKeyToKey::add(KeyToKeyType::Value type, AddDataType datatype, AddValue newval) {
   if (type == KeyToKeyType::END_) return;
 
-  if (datatype == BRIDGE_DATATYPE_OPTION && Option::UNINTERRUPTIBLE_BY_SCROLL_WHEEL == Option(newval)) {
-    interruptibleByScrollWheel_ = false;
+  if (datatype == BRIDGE_DATATYPE_OPTION && isResolutionOption(Option(newval))) {
+    Option option(newval);
+    if (Option::UNINTERRUPTIBLE_BY_SCROLL_WHEEL == option) {
+      interruptibleByScrollWheel_ = false;
+    } else if (Option::UNINTERRUPTIBLE_BY_MODIFIER == option) {
+      interruptibleByModifier_ = false;
+    } else if (Option::UNINTERRUPTIBLE_BY_POINTING_BUTTON == option) {
+      interruptibleByPointingButton_ = false;
+    } else if (Option::HOLD_ON_OTHER_KEY_PRESS == option) {
+      holdOnOtherKeyPress_ = true;
+    } else if (Option::PERMISSIVE_HOLD == option) {
+      permissiveHold_ = true;
+    } else if (Option::ADAPTIVE_HOLDING_THRESHOLD == option) {
+      adaptiveHoldingThreshold_ = true;
+    }
   } else {
     keytokey_[type].add(datatype, newval);
   }
@@ -190,7 +218,16 @@ void DependingPressingPeriodKeyToKey::prepare(RemapParams& remapParams) {
     if (remapParams.paramsBase.iskeydown(iskeydown)) {
       if (iskeydown) {
         // another key is pressed.
-        dokeydown(remapParams);
+        switch (getInterruption(remapParams.paramsBase)) {
+        case Interruption::NONE:
+          break;
+        case Interruption::SHORT_PERIOD:
+          dokeydown(remapParams);
+          break;
+        case Interruption::LONG_PERIOD:
+          dolongperiod();
+          break;
+        }
       }
     }
   }
@@ -289,7 +326,9 @@ bool DependingPressingPeriodKeyToKey::remap(RemapParams& remapParams) {
         }
         manipulatePureFromModifierFlags(beforeAfterKeys_, Manipulation::INCREASE, true);
 
-        unsigned int ms = periodMS_.get(PeriodMS::Type::SHORT_PERIOD);
+        pressingPeriodIC_.begin();
+
+        unsigned int ms = getHoldingThreshold();
         if (ms == 0) {
           fire_timer_callback(nullptr, nullptr);
         } else {
@@ -313,6 +352,11 @@ bool DependingPressingPeriodKeyToKey::remap(RemapParams& remapParams) {
         ButtonStatus::increase(fromEvent_.getPointingButton());
         FlagStatus::globalFlagStatus().increase(fromEvent_.getModifierFlag());
 
+        // The key is released in (1) without other keys.
+        if (active_ && periodtype_ == PeriodType::NONE) {
+          tapStatistics_.add(pressingPeriodIC_.getmillisec());
+        }
+
         dokeydown(remapParams);
         dokeyup();
 
@@ -329,6 +373,47 @@ bool DependingPressingPeriodKeyToKey::remap(RemapParams& remapParams) {
   return false;
 }
 
+DependingPressingPeriodKeyToKey::Interruption
+DependingPressingPeriodKeyToKey::getInterruption(const Params_Base& paramsBase) const {
+  if (!active_) return Interruption::NONE;
+
+  if (!interruptibleByModifier_ && paramsBase.isModifier()) {
+    return Interruption::NONE;
+  }
+  if (!interruptibleByPointingButton_ && paramsBase.get_Params_RelativePointerEventCallback()) {
+    return Interruption::NONE;
+  }
+
+  // (2) is fired by fire_timer_ only if target_ == this.
+  if (periodtype_ == PeriodType::NONE && target_ == this) {
+    if (holdOnOtherKeyPress_) {
+      return Interruption::LONG_PERIOD;
+    }
+    if (permissiveHold_ && EventInputQueue::isReleasedBefore(paramsBase, fromEvent_)) {
+      return Interruption::LONG_PERIOD;
+    }
+  }
+
+  return Interruption::SHORT_PERIOD;
+}
+
+unsigned int
+DependingPressingPeriodKeyToKey::getHoldingThreshold(void) {
+  unsigned int ms = periodMS_.get(PeriodMS::Type::SHORT_PERIOD);
+
+  if (adaptiveHoldingThreshold_ && tapStatistics_.isReliable()) {
+    unsigned int adaptive = tapStatistics_.getAverage() * 2;
+    if (adaptive < ms / 2) {
+      adaptive = ms / 2;
+    }
+    if (adaptive < ms) {
+      ms = adaptive;
+    }
+  }
+
+  return ms;
+}
+
 void DependingPressingPeriodKeyToKey::manipulatePureFromModifierFlags(const KeyToKey& keytokey, Manipulation manipulation, bool force) {
   // already decreased.
   if (manipulation == Manipulation::DECREASE && isFromModifierDecreased_) {
@@ -422,6 +507,20 @@ void DependingPressingPeriodKeyToKey::dokeydown(RemapParams& remapParams) {
   }
 }
 
+void DependingPressingPeriodKeyToKey::dolongperiod(void) {
+  if (!active_) return;
+  active_ = false;
+
+  if (target_ != this) return;
+
+  fire_timer_.cancelTimeout();
+  fire_timer_callback(nullptr, nullptr);
+
+  // The interrupting key is pressed in (2).
+  // (EventWatcher::on is already called for the key before (2) observes events.)
+  EventWatcher::on();
+}
+
 void DependingPressingPeriodKeyToKey::dokeyup(void) {
   switch (periodtype_) {
   case PeriodType::SHORT_PERIOD: {
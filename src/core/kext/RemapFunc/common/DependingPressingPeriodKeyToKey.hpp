@@ -71,6 +71,28 @@ namespace RemapFunc {
 // (B) [Key Overlaid Modifier's Key Repeat] Initial Wait
 // (C) [Key Overlaid Modifier] Timeout
 //
+// ======================================================================
+// Resolution by other events in (1)
+//
+// By default, (1) is fixed when another key is pressed in (1).
+// These options change the resolution.
+//
+// Option::UNINTERRUPTIBLE_BY_SCROLL_WHEEL
+//   Scroll wheel events do not fix (1).
+// Option::UNINTERRUPTIBLE_BY_MODIFIER
+//   Modifier key events do not fix (1).
+// Option::UNINTERRUPTIBLE_BY_POINTING_BUTTON
+//   Pointing button events do not fix (1).
+// Option::HOLD_ON_OTHER_KEY_PRESS
+//   Change (1) to (2) immediately when another key is pressed.
+// Option::PERMISSIVE_HOLD
+//   Change (1) to (2) when another key is pressed and released before the key is released.
+//   (The order of key up events is known only if they are queued.
+//    Use it with __BlockUntilKeyUp__ for the key.)
+// Option::ADAPTIVE_HOLDING_THRESHOLD
+//   Shorten (A) depending on the pressing period of recent (1).
+//   (A) becomes twice of the average, and it is limited to from (A) / 2 to (A).
+//
 class DependingPressingPeriodKeyToKey final {
 public:
   class KeyToKeyType final {
@@ -159,6 +181,8 @@ public:
     }
   }
 
+  static bool isResolutionOption(Option option);
+
   void add(KeyToKeyType::Value type, AddDataType datatype, AddValue newval);
   void add(KeyToKeyType::Value type, KeyCode newval) {
     add(type, AddDataType(BRIDGE_DATATYPE_KEYCODE), AddValue(newval.get()));
@@ -196,9 +220,52 @@ private:
     INCREASE,
   };
 
+  enum class Interruption {
+    NONE,
+    SHORT_PERIOD,
+    LONG_PERIOD,
+  };
+
+  // The average pressing period of (1).
+  class TapStatistics final {
+  public:
+    TapStatistics(void) : average_(0), count_(0) {}
+
+    void add(uint32_t ms) {
+      if (ms > MAX_MS) {
+        ms = MAX_MS;
+      }
+      if (count_ == 0) {
+        average_ = ms * SCALE;
+      } else {
+        // exponential moving average (alpha == 1 / 4)
+        average_ += (static_cast<int>(ms * SCALE) - average_) / 4;
+      }
+      if (count_ < MIN_COUNT) {
+        ++count_;
+      }
+    }
+
+    bool isReliable(void) const { return count_ >= MIN_COUNT; }
+    uint32_t getAverage(void) const { return average_ / SCALE; }
+
+  private:
+    enum {
+      SCALE = 16,
+      MAX_MS = 10000,
+      MIN_COUNT = 4,
+    };
+
+    int average_;
+    int count_;
+  };
+
   void manipulatePureFromModifierFlags(const KeyToKey& keytokey, Manipulation manipulation, bool force = false);
   void dokeydown(RemapParams& remapParams);
   void dokeyup(void);
+  void dolongperiod(void);
+  Interruption getInterruption(const Params_Base& paramsBase) const;
+  unsigned int getHoldingThreshold(void);
   static void fire_timer_callback(OSObject* owner, IOTimerEventSource* sender);
 
   RemapFunc::RemapFuncBase* owner_;
@@ -225,6 +292,13 @@ private:
   PhysicalEventType lastPhysicalEventType_;
 
   bool interruptibleByScrollWheel_;
+  bool interruptibleByModifier_;
+  bool interruptibleByPointingButton_;
+  bool holdOnOtherKeyPress_;
+  bool permissiveHold_;
+  bool adaptiveHoldingThreshold_;
+  IntervalChecker pressingPeriodIC_;
+  TapStatistics tapStatistics_;
 };
 }
 }
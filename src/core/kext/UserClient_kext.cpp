@@ -7,10 +7,13 @@ END_IOKIT_INCLUDE;
 #include <sys/systm.h>
 #include <sys/types.h>
 
+#include "BinaryLog.hpp"
 #include "CommonData.hpp"
 #include "Config.hpp"
+#include "EventTrace.hpp"
 #include "GlobalLock.hpp"
 #include "IOLogWrapper.hpp"
+#include "LatencyHistogram.hpp"
 #include "ListHookedConsumer.hpp"
 #include "ListHookedKeyboard.hpp"
 #include "ListHookedPointing.hpp"
@@ -388,6 +391,16 @@ void USERCLIENT_KEXT_CLASSNAME::handle_synchronized_communication(uint32_t type,
     break;
   }
 
+  case BRIDGE_USERCLIENT_TYPE_SET_REMAPCLASSES_DELTA: {
+    const uint32_t* delta = reinterpret_cast<uint32_t*>(buffer);
+    if (delta) {
+      if (KEXT_NAMESPACE::RemapClassManager::apply_remapclasses_delta(delta, size)) {
+        *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+      }
+    }
+    break;
+  }
+
   case BRIDGE_USERCLIENT_TYPE_SET_CONFIG_ALL: {
     const int32_t* config = reinterpret_cast<int32_t*>(buffer);
     if (config) {
@@ -416,6 +429,18 @@ void USERCLIENT_KEXT_CLASSNAME::handle_synchronized_communication(uint32_t type,
     break;
   }
 
+  case BRIDGE_USERCLIENT_TYPE_SET_CONFIG_DELTA: {
+    const BridgeSetConfigOne* config_delta = reinterpret_cast<const BridgeSetConfigOne*>(buffer);
+    if (config_delta) {
+      if (KEXT_NAMESPACE::RemapClassManager::set_config_delta(config_delta, size)) {
+        *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+
+        KEXT_NAMESPACE::ListHookedDevice::refreshAll();
+      }
+    }
+    break;
+  }
+
   case BRIDGE_USERCLIENT_TYPE_SET_INITIALIZED: {
     if (size != sizeof(uint32_t)) {
       IOLOG_ERROR("BRIDGE_USERCLIENT_TYPE_SET_INITIALIZED wrong 'size' parameter\n");
@@ -467,6 +492,34 @@ void USERCLIENT_KEXT_CLASSNAME::handle_synchronized_communication(uint32_t type,
     break;
   }
 
+  case BRIDGE_USERCLIENT_TYPE_GET_TRACE: {
+    if (KEXT_NAMESPACE::EventTrace::drain(buffer, size)) {
+      *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+    }
+    break;
+  }
+
+  case BRIDGE_USERCLIENT_TYPE_GET_REMAP_STATISTICS: {
+    if (KEXT_NAMESPACE::RemapClassManager::get_statistics(option, buffer, size)) {
+      *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+    }
+    break;
+  }
+
+  case BRIDGE_USERCLIENT_TYPE_GET_LATENCY_HISTOGRAMS: {
+    if (KEXT_NAMESPACE::LatencyHistogram::get(option, buffer, size)) {
+      *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+    }
+    break;
+  }
+
+  case BRIDGE_USERCLIENT_TYPE_GET_LOG: {
+    if (KEXT_NAMESPACE::BinaryLog::drain(buffer, size)) {
+      *outputdata = BRIDGE_USERCLIENT_SYNCHRONIZED_COMMUNICATION_RETURN_SUCCESS;
+    }
+    break;
+  }
+
   case BRIDGE_USERCLIENT_TYPE_GET_DEVICE_INFORMATION_KEYBOARD:
   case BRIDGE_USERCLIENT_TYPE_GET_DEVICE_INFORMATION_CONSUMER:
   case BRIDGE_USERCLIENT_TYPE_GET_DEVICE_INFORMATION_POINTING: {
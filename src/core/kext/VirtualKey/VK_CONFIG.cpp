@@ -26,6 +26,18 @@ void VirtualKey::VK_CONFIG::add_item(RemapClass* remapclass,
   items_.push_back(Item(remapclass, keycode_toggle, keycode_force_on, keycode_force_off, keycode_sync_keydownup));
 }
 
+void VirtualKey::VK_CONFIG::remove_items(const RemapClass* remapclass) {
+  Vector_Item newitems;
+  for (size_t i = 0; i < items_.size(); ++i) {
+    if (items_[i].remapclass != remapclass) {
+      newitems.push_back(items_[i]);
+    }
+  }
+  if (newitems.size() != items_.size()) {
+    items_ = newitems;
+  }
+}
+
 void VirtualKey::VK_CONFIG::clear_items(void) {
   items_.clear();
 }
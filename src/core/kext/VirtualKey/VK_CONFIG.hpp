@@ -14,6 +14,7 @@ public:
                        unsigned int keycode_force_on,
                        unsigned int keycode_force_off,
                        unsigned int keycode_sync_keydownup);
+  static void remove_items(const RemapClass* remapclass);
   static void clear_items(void);
 
   static bool handle(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType);
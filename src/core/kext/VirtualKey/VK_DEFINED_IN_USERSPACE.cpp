@@ -22,6 +22,18 @@ void VirtualKey::VK_DEFINED_IN_USERSPACE::add_item(RemapClass* remapclass, unsig
   items_.push_back(Item(remapclass, keycode, notification_type));
 }
 
+void VirtualKey::VK_DEFINED_IN_USERSPACE::remove_items(const RemapClass* remapclass) {
+  Vector_Item newitems;
+  for (size_t i = 0; i < items_.size(); ++i) {
+    if (items_[i].remapclass != remapclass) {
+      newitems.push_back(items_[i]);
+    }
+  }
+  if (newitems.size() != items_.size()) {
+    items_ = newitems;
+  }
+}
+
 void VirtualKey::VK_DEFINED_IN_USERSPACE::clear_items(void) {
   items_.clear();
 }
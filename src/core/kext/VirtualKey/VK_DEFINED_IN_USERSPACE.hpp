@@ -14,6 +14,7 @@ public:
   static void terminate(void);
 
   static void add_item(RemapClass* remapclass, unsigned int keycode, uint32_t notification_type);
+  static void remove_items(const RemapClass* remapclass);
   static void clear_items(void);
 
   static bool handle(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType);
@@ -14,17 +14,21 @@ bool VirtualKey::VK_MOUSEKEY::move_down_;
 bool VirtualKey::VK_MOUSEKEY::move_left_;
 bool VirtualKey::VK_MOUSEKEY::move_right_;
 bool VirtualKey::VK_MOUSEKEY::move_up_;
-int VirtualKey::VK_MOUSEKEY::scale_;
+MouseKeyIntegrator VirtualKey::VK_MOUSEKEY::integrator_;
+IntervalChecker VirtualKey::VK_MOUSEKEY::ic_;
+uint32_t VirtualKey::VK_MOUSEKEY::integrationDelay_;
 bool VirtualKey::VK_MOUSEKEY::scrollmode_;
 bool VirtualKey::VK_MOUSEKEY::highspeed_;
 AutogenId VirtualKey::VK_MOUSEKEY::currentAutogenId_(0);
 PhysicalEventType VirtualKey::VK_MOUSEKEY::lastPhysicalEventType_(PhysicalEventType::DOWN);
 TimerWrapper VirtualKey::VK_MOUSEKEY::fire_timer_;
-int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::delta1_;
-int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::delta2_;
-int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::counter_;
+int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::direction1_;
+int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::direction2_;
+int VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::magnitude_;
 AutogenId VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::autogenId_(0);
 PhysicalEventType VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::physicalEventType_(PhysicalEventType::DOWN);
+MouseKeyIntegrator VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::integrator_;
+IntervalChecker VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::ic_;
 TimerWrapper VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::fire_timer_;
 
 void VirtualKey::VK_MOUSEKEY::initialize(IOWorkLoop& workloop) {
@@ -33,7 +37,8 @@ void VirtualKey::VK_MOUSEKEY::initialize(IOWorkLoop& workloop) {
   move_right_ = false;
   move_up_ = false;
 
-  scale_ = 1;
+  integrator_.reset();
+  integrationDelay_ = 0;
   scrollmode_ = false;
   highspeed_ = false;
   currentAutogenId_ = AutogenId(0);
@@ -45,9 +50,10 @@ void VirtualKey::VK_MOUSEKEY::initialize(IOWorkLoop& workloop) {
 }
 
 void VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::initialize(IOWorkLoop& workloop) {
-  delta1_ = 0;
-  delta2_ = 0;
-  counter_ = 0;
+  direction1_ = 0;
+  direction2_ = 0;
+  magnitude_ = 0;
+  integrator_.reset();
   autogenId_ = AutogenId(0);
   physicalEventType_ = PhysicalEventType::DOWN;
 
@@ -70,7 +76,8 @@ void VirtualKey::VK_MOUSEKEY::reset(void) {
   move_right_ = false;
   move_up_ = false;
 
-  scale_ = 1;
+  integrator_.reset();
+  integrationDelay_ = 0;
   scrollmode_ = false;
   highspeed_ = false;
   currentAutogenId_ = AutogenId(0);
@@ -270,6 +277,8 @@ bool VirtualKey::VK_MOUSEKEY::handle_button(const Params_KeyboardEventCallBack&
 }
 
 bool VirtualKey::VK_MOUSEKEY::handle_move(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType) {
+  bool moving = (calculate_dx() != 0 || calculate_dy() != 0);
+
   /*  */ if (params.key == KeyCode::VK_MOUSEKEY_UP) {
     if (params.repeat) return true;
     move_up_ = params.ex_iskeydown;
@@ -360,13 +369,21 @@ bool VirtualKey::VK_MOUSEKEY::handle_move(const Params_KeyboardEventCallBack& pa
   currentAutogenId_ = autogenId;
 
   if (calculate_dx() != 0 || calculate_dy() != 0) {
+    uint32_t initialWait = Config::get_mousekey_initial_wait_of_pointer();
+    uint32_t repeatWait = Config::get_mousekey_repeat_wait_of_pointer();
     if (scrollmode_) {
-      fire_timer_.setTimeoutMS(Config::get_mousekey_initial_wait_of_scroll());
-    } else {
-      fire_timer_.setTimeoutMS(Config::get_mousekey_initial_wait_of_pointer());
+      initialWait = Config::get_mousekey_initial_wait_of_scroll();
+      repeatWait = Config::get_mousekey_repeat_wait_of_scroll();
+    }
+
+    if (!moving) {
+      integrator_.reset();
+      ic_.begin();
+      integrationDelay_ = initialWait > repeatWait ? initialWait - repeatWait : 0;
     }
+
+    fire_timer_.setTimeoutMS(initialWait);
   } else {
-    scale_ = 1;
 
     // keep scrollmode_ & highspeed_.
     //
@@ -424,28 +441,42 @@ bool VirtualKey::VK_MOUSEKEY::handle_fixeddistancescroll(const Params_KeyboardEv
   }
 
   if (params.ex_iskeydown) {
-    int delta1 = fdy * Config::get_fixed_distance_scroll_magnification() * EventOutputQueue::FireScrollWheel::DELTA_SCALE;
-    int delta2 = fdx * Config::get_fixed_distance_scroll_magnification() * EventOutputQueue::FireScrollWheel::DELTA_SCALE;
-
     if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mouse_key_scroll_not_natural_direction)) {
-      delta1 = -delta1;
-      delta2 = -delta2;
+      fdx = -fdx;
+      fdy = -fdy;
     }
 
-    FixedDistanceScroll::set(delta1, delta2, autogenId, physicalEventType);
+    FixedDistanceScroll::set(fdy, fdx,
+                             Config::get_fixed_distance_scroll_magnification() * EventOutputQueue::FireScrollWheel::DELTA_SCALE,
+                             autogenId, physicalEventType);
   }
 
   return true;
 }
 
 void VirtualKey::VK_MOUSEKEY::FixedDistanceScroll::fire_timer_callback(OSObject* notuse_owner, IOTimerEventSource* notuse_sender) {
-  if (counter_ <= 0) {
+  if (integrator_.getElapsed() >= DURATION) {
     return;
   }
-  --counter_;
 
-  EventOutputQueue::FireScrollWheel::fire(delta1_, delta2_, autogenId_, physicalEventType_);
-  fire_timer_.setTimeoutMS(TIMER_INTERVAL);
+  uint32_t now = ic_.getmillisec();
+  if (now > DURATION) {
+    now = DURATION;
+  }
+
+  // Scroll at a constant speed. (`magnitude_` per DURATION)
+  MouseKeyIntegrator::Parameters parameters(MouseKeyIntegrator::Parameters::Curve::CONSTANT, 1, 0, 1, DURATION, 0);
+  int delta1 = 0;
+  int delta2 = 0;
+  integrator_.integrate(parameters, now, direction2_, direction1_, magnitude_, delta2, delta1);
+
+  if (delta1 != 0 || delta2 != 0) {
+    EventOutputQueue::FireScrollWheel::fire(delta1, delta2, autogenId_, physicalEventType_);
+  }
+
+  if (integrator_.getElapsed() < DURATION) {
+    fire_timer_.setTimeoutMS(TIMER_INTERVAL);
+  }
 }
 
 bool VirtualKey::VK_MOUSEKEY::handle_lock_button(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType) {
@@ -470,43 +501,57 @@ bool VirtualKey::VK_MOUSEKEY::handle_lock_button(const Params_KeyboardEventCallB
   return true;
 }
 
+MouseKeyIntegrator::Parameters
+VirtualKey::VK_MOUSEKEY::getParameters(void) {
+  uint32_t period = scrollmode_ ? Config::get_mousekey_repeat_wait_of_scroll() : Config::get_mousekey_repeat_wait_of_pointer();
+
+  if (highspeed_) {
+    int s = scrollmode_ ? Config::get_mousekey_high_speed_of_scroll() : Config::get_mousekey_high_speed_of_pointer();
+    return MouseKeyIntegrator::Parameters(MouseKeyIntegrator::Parameters::Curve::CONSTANT, s, 0, s, period, 0);
+  }
+
+  int max = scrollmode_ ? Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_scroll) : Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_pointer);
+
+  int acceleration = scrollmode_ ? Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_scroll) : Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_pointer);
+
+  MouseKeyIntegrator::Parameters::Curve curve = MouseKeyIntegrator::Parameters::Curve::PIECEWISE_LINEAR;
+  if (Config::get_mousekey_acceleration_curve() == 1) {
+    curve = MouseKeyIntegrator::Parameters::Curve::EXPONENTIAL;
+  }
+
+  return MouseKeyIntegrator::Parameters(curve, 1, acceleration, max, period, Config::get_mousekey_exponential_doubling_time());
+}
+
 void VirtualKey::VK_MOUSEKEY::fire_timer_callback(OSObject* notuse_owner, IOTimerEventSource* notuse_sender) {
+  uint32_t now = ic_.getmillisec();
+  now = now > integrationDelay_ ? now - integrationDelay_ : 0;
+
+  MouseKeyIntegrator::Parameters parameters = getParameters();
+
   if (!scrollmode_) {
-    int s = scale_;
-    if (highspeed_) s = Config::get_mousekey_high_speed_of_pointer();
+    int dx = 0;
+    int dy = 0;
+    integrator_.integrate(parameters, now, calculate_dx(), calculate_dy(), 1, dx, dy);
 
-    EventOutputQueue::FireRelativePointer::fire(currentAutogenId_, lastPhysicalEventType_, ButtonStatus::makeButtons(), calculate_dx() * s, calculate_dy() * s);
+    if (dx != 0 || dy != 0) {
+      EventOutputQueue::FireRelativePointer::fire(currentAutogenId_, lastPhysicalEventType_, ButtonStatus::makeButtons(), dx, dy);
+    }
 
   } else {
-    int s = scale_;
-    if (highspeed_) s = Config::get_mousekey_high_speed_of_scroll();
-
-    int delta1 = calculate_dy() * s * EventOutputQueue::FireScrollWheel::DELTA_SCALE;
-    int delta2 = calculate_dx() * s * EventOutputQueue::FireScrollWheel::DELTA_SCALE;
+    int delta1 = 0;
+    int delta2 = 0;
+    integrator_.integrate(parameters, now, calculate_dx(), calculate_dy(), EventOutputQueue::FireScrollWheel::DELTA_SCALE, delta2, delta1);
 
     if (Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_mouse_key_scroll_not_natural_direction)) {
       delta1 = -delta1;
       delta2 = -delta2;
     }
 
-    EventOutputQueue::FireScrollWheel::fire(delta1, delta2, currentAutogenId_, lastPhysicalEventType_);
-  }
-
-  int max = scrollmode_ ? Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_scroll) : Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_maximum_speed_of_pointer);
-
-  int acceleration = scrollmode_ ? Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_scroll) : Config::get_essential_config(BRIDGE_ESSENTIAL_CONFIG_INDEX_parameter_acceleration_of_pointer);
-  if (acceleration < 0) {
-    acceleration = 0;
-  }
-
-  if (scale_ < max) {
-    scale_ += acceleration;
+    if (delta1 != 0 || delta2 != 0) {
+      EventOutputQueue::FireScrollWheel::fire(delta1, delta2, currentAutogenId_, lastPhysicalEventType_);
+    }
   }
 
-  if (scrollmode_) {
-    fire_timer_.setTimeoutMS(Config::get_mousekey_repeat_wait_of_scroll());
-  } else {
-    fire_timer_.setTimeoutMS(Config::get_mousekey_repeat_wait_of_pointer());
-  }
+  fire_timer_.setTimeoutMS(parameters.period);
 }
 }
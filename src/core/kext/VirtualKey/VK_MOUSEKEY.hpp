@@ -1,5 +1,8 @@
 #pragma once
 
+#include "IntervalChecker.hpp"
+#include "MouseKeyIntegrator.hpp"
+
 namespace org_pqrs_Karabiner {
 namespace VirtualKey {
 class VK_MOUSEKEY final {
@@ -18,33 +21,39 @@ private:
     static void terminate(void);
     static void reset(void);
 
-    static void set(int d1, int d2, AutogenId a, PhysicalEventType p) {
-      delta1_ = d1 / MAX_COUNT;
-      delta2_ = d2 / MAX_COUNT;
-      counter_ = MAX_COUNT;
+    // Scroll `magnitude` in DURATION milliseconds.
+    static void set(int direction1, int direction2, int magnitude, AutogenId a, PhysicalEventType p) {
+      direction1_ = direction1;
+      direction2_ = direction2;
+      magnitude_ = magnitude;
       autogenId_ = a;
       physicalEventType_ = p;
 
+      integrator_.reset();
+      ic_.begin();
       fire_timer_.setTimeoutMS(TIMER_INTERVAL);
     }
 
   private:
     enum {
-      MAX_COUNT = 100,
+      DURATION = 100,
       TIMER_INTERVAL = 1,
     };
 
     static void fire_timer_callback(OSObject* notuse_owner, IOTimerEventSource* notuse_sender);
 
-    static int delta1_;
-    static int delta2_;
-    static int counter_;
+    static int direction1_;
+    static int direction2_;
+    static int magnitude_;
     static AutogenId autogenId_;
     static PhysicalEventType physicalEventType_;
+    static MouseKeyIntegrator integrator_;
+    static IntervalChecker ic_;
     static TimerWrapper fire_timer_;
   };
 
   static void fire_timer_callback(OSObject* notuse_owner, IOTimerEventSource* notuse_sender);
+  static MouseKeyIntegrator::Parameters getParameters(void);
 
   static bool handle_button(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType);
   static bool handle_move(const Params_KeyboardEventCallBack& params, AutogenId autogenId, PhysicalEventType physicalEventType);
@@ -64,7 +73,12 @@ private:
   static bool move_right_;
   static bool move_up_;
 
-  static int scale_;
+  // The integrator starts when a mouse key is pressed while no mouse key is pressed.
+  static MouseKeyIntegrator integrator_;
+  static IntervalChecker ic_;
+  // The first event is sent after the initial wait with the distance of one repeat wait.
+  // (The integration is delayed by the difference of them.)
+  static uint32_t integrationDelay_;
   static bool highspeed_;
   static bool scrollmode_;
   static AutogenId currentAutogenId_;
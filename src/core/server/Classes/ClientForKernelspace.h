@@ -12,6 +12,10 @@
 - (void)send_config_to_kext;
 - (void)set_config_one:(struct BridgeSetConfigOne*)bridgeSetConfigOne;
 - (NSArray*)device_information:(NSInteger)type;
+- (NSData*)event_trace;
+- (NSArray*)remap_statistics:(NSInteger)type;
+- (NSData*)latency_histograms:(BOOL)reset;
+- (NSArray*)kext_log;
 - (void)unset_debug_flags;
 
 @end
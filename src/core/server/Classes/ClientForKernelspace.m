@@ -9,6 +9,15 @@
 #import "WorkSpaceData.h"
 #import "XMLCompiler.h"
 #import "weakify.h"
+#include "../../../lib/log_format/log_format.h"
+
+// The format table of IOLOG_DEBUG, IOLOG_DEBUG_POINTING and IOLOG_DEVEL in the kext.
+static const struct {
+  uint32_t id;
+  const char* format;
+} logFormats_[] = {
+#include "../../../bridge/output/include.bridge_log_format_table.h"
+};
 
 @interface ClientForKernelspace ()
 
@@ -23,6 +32,10 @@
 @property UserClient_userspace* userClient_userspace;
 @property NSTimer* timer;
 @property int retryCounter;
+// The config vector which kext has. (nil if unknown)
+// send_config_to_kext sends only changed values by comparing with it.
+@property NSMutableData* sentConfig;
+@property NSUInteger sentEssentialConfigCount;
 
 @end
 
@@ -48,6 +61,8 @@
       if (![self.userClient_userspace synchronized_communication:&bridgestruct]) return;
 
       uint32_t configindex = option;
+      [self update_sent_config:NO index:configindex value:(int32_t)(enabled)];
+
       NSString* identifier = [self.xmlCompiler identifier:(int)(configindex)];
       if (identifier) {
         if ([self.preferencesModel setValue:enabled forIdentifier:identifier]) {
@@ -272,6 +287,16 @@ static void static_callback_NotificationFromKext(void* refcon, IOReturn result,
 }
 
 - (void)send_remapclasses_initialize_vector_to_kext {
+  // The enabled state of RemapClasses in kext is not known after reloading.
+  self.sentConfig = nil;
+
+  // Send only changed RemapClasses if kext has the previous vector.
+  // (Unchanged RemapClasses keep their state in kext.)
+  if ([self send_remapclasses_delta_to_kext]) {
+    [self.xmlCompiler remapclasses_initialize_vector_uploaded];
+    return;
+  }
+
   const uint32_t* p = [self.xmlCompiler remapclasses_initialize_vector_data];
   size_t size = [self.xmlCompiler remapclasses_initialize_vector_size] * sizeof(uint32_t);
 
@@ -282,7 +307,24 @@ static void static_callback_NotificationFromKext(void* refcon, IOReturn result,
   bridgestruct.data = (user_addr_t)(p);
   bridgestruct.size = size;
 
-  [self.userClient_userspace synchronized_communication:&bridgestruct];
+  if ([self.userClient_userspace synchronized_communication:&bridgestruct]) {
+    [self.xmlCompiler remapclasses_initialize_vector_uploaded];
+  }
+}
+
+- (BOOL)send_remapclasses_delta_to_kext {
+  const uint32_t* p = [self.xmlCompiler remapclasses_delta_vector_data];
+  size_t size = [self.xmlCompiler remapclasses_delta_vector_size] * sizeof(uint32_t);
+  if (!p || size == 0) return NO;
+
+  // --------------------
+  struct BridgeUserClientStruct bridgestruct;
+  bridgestruct.type = BRIDGE_USERCLIENT_TYPE_SET_REMAPCLASSES_DELTA;
+  bridgestruct.option = 0;
+  bridgestruct.data = (user_addr_t)(p);
+  bridgestruct.size = size;
+
+  return [self.userClient_userspace synchronized_communication:&bridgestruct];
 }
 
 - (void)send_config_to_kext {
@@ -358,16 +400,87 @@ static void static_callback_NotificationFromKext(void* refcon, IOReturn result,
     }
 
     // --------------------
+    NSData* config = [NSData dataWithBytesNoCopy:data length:size freeWhenDone:YES];
+
+    if ([self send_config_delta_to_kext:config essentialConfigCount:essential_config_count]) {
+      return;
+    }
+
     struct BridgeUserClientStruct bridgestruct;
     bridgestruct.type = BRIDGE_USERCLIENT_TYPE_SET_CONFIG_ALL;
     bridgestruct.option = 0;
-    bridgestruct.data = (user_addr_t)(data);
+    bridgestruct.data = (user_addr_t)([config bytes]);
     bridgestruct.size = size;
 
-    [self.userClient_userspace synchronized_communication:&bridgestruct];
+    if ([self.userClient_userspace synchronized_communication:&bridgestruct]) {
+      self.sentConfig = [config mutableCopy];
+      self.sentEssentialConfigCount = essential_config_count;
+    } else {
+      self.sentConfig = nil;
+    }
+  }
+}
 
-    free(data);
+// Send only values which are different from sentConfig.
+// (A profile change usually changes a few values.)
+// Return NO if sentConfig cannot be used. (Send the whole config in that case.)
+- (BOOL)send_config_delta_to_kext:(NSData*)config essentialConfigCount:(NSUInteger)essentialConfigCount {
+  if (!self.sentConfig ||
+      [self.sentConfig length] != [config length] ||
+      self.sentEssentialConfigCount != essentialConfigCount) {
+    return NO;
+  }
+
+  const int32_t* oldvalues = (const int32_t*)([self.sentConfig bytes]);
+  const int32_t* newvalues = (const int32_t*)([config bytes]);
+  NSUInteger count = [config length] / sizeof(int32_t);
+
+  NSMutableData* delta = [NSMutableData new];
+  for (NSUInteger i = 0; i < count; ++i) {
+    if (oldvalues[i] == newvalues[i]) continue;
+
+    struct BridgeSetConfigOne bridgeSetConfigOne;
+    if (i < essentialConfigCount) {
+      bridgeSetConfigOne.isEssentialConfig = 1;
+      bridgeSetConfigOne.index = (uint32_t)(i);
+    } else {
+      bridgeSetConfigOne.isEssentialConfig = 0;
+      bridgeSetConfigOne.index = (uint32_t)(i - essentialConfigCount);
+    }
+    bridgeSetConfigOne.value = newvalues[i];
+    [delta appendBytes:&bridgeSetConfigOne length:sizeof(bridgeSetConfigOne)];
+  }
+
+  if ([delta length] == 0) return YES;
+
+  struct BridgeUserClientStruct bridgestruct;
+  bridgestruct.type = BRIDGE_USERCLIENT_TYPE_SET_CONFIG_DELTA;
+  bridgestruct.option = 0;
+  bridgestruct.data = (user_addr_t)([delta bytes]);
+  bridgestruct.size = [delta length];
+
+  if (![self.userClient_userspace synchronized_communication:&bridgestruct]) {
+    return NO;
   }
+
+  self.sentConfig = [config mutableCopy];
+  return YES;
+}
+
+- (void)update_sent_config:(BOOL)isEssentialConfig index:(uint32_t)index value:(int32_t)value {
+  if (!self.sentConfig) return;
+
+  NSUInteger i = index;
+  if (!isEssentialConfig) {
+    i += self.sentEssentialConfigCount;
+  } else if (i >= self.sentEssentialConfigCount) {
+    return;
+  }
+
+  if (i >= [self.sentConfig length] / sizeof(int32_t)) return;
+
+  int32_t* values = (int32_t*)([self.sentConfig mutableBytes]);
+  values[i] = value;
 }
 
 - (void)set_config_one:(struct BridgeSetConfigOne*)bridgeSetConfigOne {
@@ -377,7 +490,13 @@ static void static_callback_NotificationFromKext(void* refcon, IOReturn result,
   bridgestruct.data = (user_addr_t)(bridgeSetConfigOne);
   bridgestruct.size = sizeof(*bridgeSetConfigOne);
 
-  [self.userClient_userspace synchronized_communication:&bridgestruct];
+  if ([self.userClient_userspace synchronized_communication:&bridgestruct]) {
+    [self update_sent_config:(bridgeSetConfigOne->isEssentialConfig != 0)
+                       index:bridgeSetConfigOne->index
+                       value:bridgeSetConfigOne->value];
+  } else {
+    self.sentConfig = nil;
+  }
 }
 
 - (void)set_initialized {
@@ -450,6 +569,136 @@ static void static_callback_NotificationFromKext(void* refcon, IOReturn result,
   return information;
 }
 
+- (NSData*)event_trace {
+  // The kext moves up to this number of entries per call.
+  // (Older entries are counted in BridgeTraceHeader.lost if the trace ring is overflowed.)
+  const size_t maxEntries = 2048;
+  NSMutableData* data = [NSMutableData dataWithLength:sizeof(struct BridgeTraceHeader) + sizeof(struct BridgeTraceEntry) * maxEntries];
+
+  struct BridgeUserClientStruct bridgestruct;
+  bridgestruct.type = BRIDGE_USERCLIENT_TYPE_GET_TRACE;
+  bridgestruct.option = 0;
+  bridgestruct.data = (user_addr_t)([data mutableBytes]);
+  bridgestruct.size = [data length];
+
+  if (![self.userClient_userspace synchronized_communication:&bridgestruct]) return nil;
+
+  const struct BridgeTraceHeader* header = [data bytes];
+  [data setLength:sizeof(struct BridgeTraceHeader) + sizeof(struct BridgeTraceEntry) * header->count];
+  return data;
+}
+
+- (NSArray*)remap_statistics:(NSInteger)type {
+  NSMutableArray* statistics = [NSMutableArray new];
+
+  size_t count = 1024;
+  for (;;) {
+    NSMutableData* data = [NSMutableData dataWithLength:sizeof(struct BridgeRemapStatisticsHeader) + sizeof(struct BridgeRemapStatistics) * count];
+
+    struct BridgeUserClientStruct bridgestruct;
+    bridgestruct.type = BRIDGE_USERCLIENT_TYPE_GET_REMAP_STATISTICS;
+    bridgestruct.option = (uint32_t)(type);
+    bridgestruct.data = (user_addr_t)([data mutableBytes]);
+    bridgestruct.size = [data length];
+
+    if (![self.userClient_userspace synchronized_communication:&bridgestruct]) return nil;
+
+    const struct BridgeRemapStatisticsHeader* header = [data bytes];
+    if (header->count < header->total) {
+      // Retry with the larger buffer.
+      count = header->total;
+      continue;
+    }
+
+    const struct BridgeRemapStatistics* entries = (const struct BridgeRemapStatistics*)((const uint8_t*)([data bytes]) + sizeof(struct BridgeRemapStatisticsHeader));
+    for (uint32_t i = 0; i < header->count; ++i) {
+      const struct BridgeRemapStatistics* e = entries + i;
+      if (e->attempts == 0 && e->filtered == 0) continue;
+
+      NSString* identifier = [self.xmlCompiler identifier:(int)(e->configindex)];
+      [statistics addObject:@{ @"identifier" : (identifier ? identifier : @""),
+                               @"item" : @(e->itemindex),
+                               @"attempts" : @(e->attempts),
+                               @"remaps" : @(e->remaps),
+                               @"filtered" : @(e->filtered),
+                               @"time" : @(e->time) }];
+    }
+    break;
+  }
+
+  return statistics;
+}
+
+- (NSData*)latency_histograms:(BOOL)reset {
+  NSMutableData* data = [NSMutableData dataWithLength:sizeof(struct BridgeLatencyHistogram) * BRIDGE_LATENCY_CLASS__END__];
+
+  struct BridgeUserClientStruct bridgestruct;
+  bridgestruct.type = BRIDGE_USERCLIENT_TYPE_GET_LATENCY_HISTOGRAMS;
+  bridgestruct.option = (reset ? BRIDGE_LATENCY_HISTOGRAM_OPTION_RESET : BRIDGE_LATENCY_HISTOGRAM_OPTION_NONE);
+  bridgestruct.data = (user_addr_t)([data mutableBytes]);
+  bridgestruct.size = [data length];
+
+  if (![self.userClient_userspace synchronized_communication:&bridgestruct]) return nil;
+
+  return data;
+}
+
+- (NSArray*)kext_log {
+  NSMutableArray* messages = [NSMutableArray new];
+
+  const size_t maxEntries = 512;
+  NSMutableData* data = [NSMutableData dataWithLength:sizeof(struct BridgeLogHeader) + sizeof(struct BridgeLogEntry) * maxEntries];
+
+  for (;;) {
+    struct BridgeUserClientStruct bridgestruct;
+    bridgestruct.type = BRIDGE_USERCLIENT_TYPE_GET_LOG;
+    bridgestruct.option = 0;
+    bridgestruct.data = (user_addr_t)([data mutableBytes]);
+    bridgestruct.size = [data length];
+
+    if (![self.userClient_userspace synchronized_communication:&bridgestruct]) return nil;
+
+    const struct BridgeLogHeader* header = [data bytes];
+    if (header->lost > 0) {
+      [messages addObject:[NSString stringWithFormat:@"(%u entries were lost)\n", header->lost]];
+    }
+    if (header->count == 0) break;
+
+    const struct BridgeLogEntry* entries = (const struct BridgeLogEntry*)((const uint8_t*)([data bytes]) + sizeof(struct BridgeLogHeader));
+    for (uint32_t i = 0; i < header->count; ++i) {
+      const struct BridgeLogEntry* e = entries + i;
+
+      const char* format = NULL;
+      for (size_t j = 0; j < sizeof(logFormats_) / sizeof(logFormats_[0]); ++j) {
+        if (logFormats_[j].id == e->formatId) {
+          format = logFormats_[j].format;
+          break;
+        }
+      }
+
+      char message[512];
+      if (format) {
+        pqrs_log_format_snprintf(message, sizeof(message), format, e->arguments, e->argc, e->strings, sizeof(e->strings));
+      } else {
+        snprintf(message, sizeof(message), "(unknown format id 0x%08x)\n", e->formatId);
+      }
+
+      NSString* level = @"--Debug--";
+      if (e->level == BRIDGE_LOG_LEVEL_DEVEL) {
+        level = @"--Devel--";
+      }
+
+      [messages addObject:[NSString stringWithFormat:@"%llu.%06llu %@ %s",
+                                                     e->timestamp / 1000000000,
+                                                     (e->timestamp / 1000) % 1000000,
+                                                     level,
+                                                     message]];
+    }
+  }
+
+  return messages;
+}
+
 - (void)unset_debug_flags {
   uint32_t dummy = 1;
   struct BridgeUserClientStruct bridgestruct;
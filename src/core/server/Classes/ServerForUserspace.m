@@ -196,6 +196,22 @@
   return [self.clientForKernelspace device_information:type];
 }
 
+- (NSData*)event_trace {
+  return [self.clientForKernelspace event_trace];
+}
+
+- (NSArray*)remap_statistics:(NSInteger)type {
+  return [self.clientForKernelspace remap_statistics:type];
+}
+
+- (NSData*)latency_histograms:(BOOL)reset {
+  return [self.clientForKernelspace latency_histograms:reset];
+}
+
+- (NSArray*)kext_log {
+  return [self.clientForKernelspace kext_log];
+}
+
 - (NSDictionary*)focused_uielement_information {
   return self.appDelegate.focusedUIElementInformation;
 }
@@ -18,6 +18,9 @@
 - (size_t)remapclasses_initialize_vector_size;
 - (const uint32_t*)remapclasses_initialize_vector_data;
 - (uint32_t)remapclasses_initialize_vector_config_count;
+- (void)remapclasses_initialize_vector_uploaded;
+- (size_t)remapclasses_delta_vector_size;
+- (const uint32_t*)remapclasses_delta_vector_data;
 
 - (uint32_t)keycode:(NSString*)name;
 - (NSString*)identifier:(uint32_t)config_index;
@@ -53,8 +53,11 @@
                                     "----------------------------------------"];
 }
 
-- (NSArray*)checkboxTreeChildren:(const pqrs_xml_compiler_preferences_checkbox_node_tree*)parent root:(BOOL)root {
-  size_t size = pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(parent);
+- (NSArray*)checkboxTreeChildren:(const pqrs_xml_compiler_preferences_flat_tree*)tree parent:(uint32_t)parent root:(BOOL)root {
+  const pqrs_xml_compiler_preferences_flat_node* nodes = pqrs_xml_compiler_get_preferences_flat_tree_nodes(tree);
+  if (!nodes) return nil;
+
+  size_t size = nodes[parent].children_count;
   if (size == 0) return nil;
 
   NSMutableArray* children = [NSMutableArray new];
@@ -81,41 +84,38 @@
     }
   }
 
-  for (size_t i = 0; i < size; ++i) {
-    const pqrs_xml_compiler_preferences_checkbox_node_tree* child = pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(parent, i);
-    if (!child) continue;
-
-    const char* name = pqrs_xml_compiler_get_preferences_checkbox_node_tree_name(child);
-    const char* style = pqrs_xml_compiler_get_preferences_checkbox_node_tree_style(child);
-    const char* identifier = pqrs_xml_compiler_get_preferences_checkbox_node_tree_identifier(child);
+  // Children are stored contiguously in the flat tree.
+  for (uint32_t child = nodes[parent].first_child; size > 0; --size, ++child) {
+    const char* name = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].name);
+    const char* style = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].style);
+    const char* identifier = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].identifier);
 
     CheckboxItem* node = [[CheckboxItem alloc] initWithName:name style:style identifier:identifier];
-    CheckboxTree* tree = [[CheckboxTree alloc] initWithItem:node children:[self checkboxTreeChildren:child root:NO]];
-    [children addObject:tree];
+    [children addObject:[[CheckboxTree alloc] initWithItem:node children:[self checkboxTreeChildren:tree parent:child root:NO]]];
   }
 
   return children;
 }
 
-- (NSArray*)parameterTreeChildren:(const pqrs_xml_compiler_preferences_number_node_tree*)parent {
-  size_t size = pqrs_xml_compiler_get_preferences_number_node_tree_children_count(parent);
+- (NSArray*)parameterTreeChildren:(const pqrs_xml_compiler_preferences_flat_tree*)tree parent:(uint32_t)parent {
+  const pqrs_xml_compiler_preferences_flat_node* nodes = pqrs_xml_compiler_get_preferences_flat_tree_nodes(tree);
+  if (!nodes) return nil;
+
+  size_t size = nodes[parent].children_count;
   if (size == 0) return nil;
 
   NSMutableArray* children = [NSMutableArray new];
 
-  for (size_t i = 0; i < size; ++i) {
-    const pqrs_xml_compiler_preferences_number_node_tree* child = pqrs_xml_compiler_get_preferences_number_node_tree_child(parent, i);
-    if (!child) continue;
-
-    const char* name = pqrs_xml_compiler_get_preferences_number_node_tree_name(child);
-    const char* identifier = pqrs_xml_compiler_get_preferences_number_node_tree_identifier(child);
-    int defaultValue = pqrs_xml_compiler_get_preferences_number_node_tree_default_value(child);
-    int step = pqrs_xml_compiler_get_preferences_number_node_tree_step(child);
-    const char* baseUnit = pqrs_xml_compiler_get_preferences_number_node_tree_base_unit(child);
+  // Children are stored contiguously in the flat tree.
+  for (uint32_t child = nodes[parent].first_child; size > 0; --size, ++child) {
+    const char* name = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].name);
+    const char* identifier = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].identifier);
+    int defaultValue = nodes[child].default_value;
+    int step = nodes[child].step;
+    const char* baseUnit = pqrs_xml_compiler_get_preferences_flat_tree_string(tree, nodes[child].base_unit);
 
     ParameterItem* node = [[ParameterItem alloc] initWithName:name identifier:identifier defaultValue:defaultValue step:step baseUnit:baseUnit];
-    ParameterTree* tree = [[ParameterTree alloc] initWithItem:node children:[self parameterTreeChildren:child]];
-    [children addObject:tree];
+    [children addObject:[[ParameterTree alloc] initWithItem:node children:[self parameterTreeChildren:tree parent:child]]];
   }
 
   return children;
@@ -219,14 +219,12 @@
 
     pqrs_xml_compiler_reload(self.pqrs_xml_compiler, checkbox_xml_file_name);
 
-    {
-      const pqrs_xml_compiler_preferences_checkbox_node_tree* root = pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(self.pqrs_xml_compiler);
-      self.checkboxTree = [[CheckboxTree alloc] initWithItem:nil children:[self checkboxTreeChildren:root root:YES]];
-    }
-    // build preferencepane_parameter
-    {
-      const pqrs_xml_compiler_preferences_number_node_tree* root = pqrs_xml_compiler_get_preferences_number_node_tree_root(self.pqrs_xml_compiler);
-      self.parameterTree = [[ParameterTree alloc] initWithItem:nil children:[self parameterTreeChildren:root]];
+    // Both trees are exported by one call.
+    const pqrs_xml_compiler_preferences_flat_tree* tree = pqrs_xml_compiler_get_preferences_flat_tree(self.pqrs_xml_compiler);
+    if (tree) {
+      self.checkboxTree = [[CheckboxTree alloc] initWithItem:nil children:[self checkboxTreeChildren:tree parent:tree->checkbox_root root:YES]];
+      // build preferencepane_parameter
+      self.parameterTree = [[ParameterTree alloc] initWithItem:nil children:[self parameterTreeChildren:tree parent:tree->number_root]];
     }
 
     errorMessage = [self preferencepane_error_message];
@@ -284,6 +282,28 @@
   return result;
 }
 
+- (void)remapclasses_initialize_vector_uploaded {
+  dispatch_sync(self.xmlCompilerReloadQueue, ^{
+    pqrs_xml_compiler_set_remapclasses_initialize_vector_uploaded(self.pqrs_xml_compiler);
+  });
+}
+
+- (size_t)remapclasses_delta_vector_size {
+  __block size_t result = 0;
+  dispatch_sync(self.xmlCompilerReloadQueue, ^{
+    result = pqrs_xml_compiler_get_remapclasses_delta_vector_size(self.pqrs_xml_compiler);
+  });
+  return result;
+}
+
+- (const uint32_t*)remapclasses_delta_vector_data {
+  __block const uint32_t* result = NULL;
+  dispatch_sync(self.xmlCompilerReloadQueue, ^{
+    result = pqrs_xml_compiler_get_remapclasses_delta_vector_data(self.pqrs_xml_compiler);
+  });
+  return result;
+}
+
 - (uint32_t)keycode:(NSString*)name {
   __block uint32_t result = 0;
   dispatch_sync(self.xmlCompilerReloadQueue, ^{
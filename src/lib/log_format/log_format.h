@@ -0,0 +1,171 @@
+#pragma once
+
+// Parse and format printf style formats of BridgeLogEntry.
+// This file is shared by the kext (BinaryLog) and log readers.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  PQRS_LOG_FORMAT_ARGUMENT_NONE,
+  PQRS_LOG_FORMAT_ARGUMENT_INT, // char and short are promoted to int.
+  PQRS_LOG_FORMAT_ARGUMENT_LONG,
+  PQRS_LOG_FORMAT_ARGUMENT_LONG_LONG,
+  PQRS_LOG_FORMAT_ARGUMENT_POINTER,
+  PQRS_LOG_FORMAT_ARGUMENT_STRING,
+};
+
+// Find the next conversion specification in format.
+// Return the pointer after the specification and set *begin (the position of '%') and *type.
+// Return NULL if format has no more specifications.
+//
+// Note: `*` width and precision are not supported.
+static inline const char* pqrs_log_format_next_conversion(const char* format, const char** begin, int* type) {
+  const char* p = format;
+
+  for (;;) {
+    while (*p != '\0' && *p != '%') {
+      ++p;
+    }
+    if (*p == '\0') return NULL;
+
+    const char* b = p;
+    ++p;
+
+    if (*p == '%') {
+      ++p;
+      continue;
+    }
+
+    // flags, width and precision
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '.' ||
+           ('0' <= *p && *p <= '9')) {
+      ++p;
+    }
+
+    // length modifier
+    int length = 0;
+    for (;; ++p) {
+      if (*p == 'h') continue;
+      if (*p == 'l') {
+        ++length;
+        continue;
+      }
+      if (*p == 'z' || *p == 't') {
+        length = 1;
+        continue;
+      }
+      if (*p == 'q' || *p == 'j') {
+        length = 2;
+        continue;
+      }
+      break;
+    }
+
+    int t = PQRS_LOG_FORMAT_ARGUMENT_NONE;
+    switch (*p) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+      case 'c':
+        t = (length == 0 ? PQRS_LOG_FORMAT_ARGUMENT_INT : (length == 1 ? PQRS_LOG_FORMAT_ARGUMENT_LONG : PQRS_LOG_FORMAT_ARGUMENT_LONG_LONG));
+        break;
+      case 'p':
+        t = PQRS_LOG_FORMAT_ARGUMENT_POINTER;
+        break;
+      case 's':
+        t = PQRS_LOG_FORMAT_ARGUMENT_STRING;
+        break;
+      case '\0':
+        return NULL;
+      default:
+        // Skip unknown conversions.
+        ++p;
+        continue;
+    }
+
+    ++p;
+    if (begin) *begin = b;
+    if (type) *type = t;
+    return p;
+  }
+}
+
+#ifndef KERNEL
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Format raw arguments like snprintf.
+// String arguments are offsets in strings.
+static inline void pqrs_log_format_snprintf(char* buffer, size_t size,
+                                            const char* format,
+                                            const uint64_t* arguments, size_t argc,
+                                            const char* strings, size_t strings_size) {
+  if (!buffer || size == 0) return;
+
+  buffer[0] = '\0';
+  size_t length = 0;
+  size_t i = 0;
+  const char* p = format;
+
+  while (length < size - 1) {
+    const char* begin = NULL;
+    int type = PQRS_LOG_FORMAT_ARGUMENT_NONE;
+    const char* next = pqrs_log_format_next_conversion(p, &begin, &type);
+
+    if (!next || i >= argc) {
+      // Copy the rest with unescaping "%%".
+      while (*p != '\0' && length < size - 1) {
+        if (p[0] == '%' && p[1] == '%') ++p;
+        buffer[length++] = *p++;
+      }
+      buffer[length] = '\0';
+      break;
+    }
+
+    // piece is the literal text and one conversion specification.
+    char piece[256];
+    size_t n = (size_t)(next - p);
+    if (n >= sizeof(piece)) n = sizeof(piece) - 1;
+    memcpy(piece, p, n);
+    piece[n] = '\0';
+
+    int written = 0;
+    uint64_t v = arguments[i];
+    switch (type) {
+      case PQRS_LOG_FORMAT_ARGUMENT_INT:
+        written = snprintf(buffer + length, size - length, piece, (int)(v));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_LONG:
+        written = snprintf(buffer + length, size - length, piece, (long)(v));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_LONG_LONG:
+        written = snprintf(buffer + length, size - length, piece, (long long)(v));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_POINTER:
+        written = snprintf(buffer + length, size - length, piece, (void*)(uintptr_t)(v));
+        break;
+      case PQRS_LOG_FORMAT_ARGUMENT_STRING:
+        written = snprintf(buffer + length, size - length, piece, (v < strings_size ? strings + v : ""));
+        break;
+    }
+
+    if (written > 0) {
+      length += (size_t)(written);
+      if (length > size - 1) length = size - 1;
+    }
+
+    ++i;
+    p = next;
+  }
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
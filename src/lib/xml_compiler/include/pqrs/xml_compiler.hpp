@@ -1,11 +1,12 @@
 #pragma once
 
 #include <cstdlib>
+#include <deque>
 #include <memory>
 #include <regex>
-#include <stack>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #pragma clang diagnostic push
@@ -22,6 +23,7 @@
 
 #include "pqrs/file_path.hpp"
 #include "pqrs/string.hpp"
+#include "pqrs/xml_compiler_bindings_clang.h"
 
 namespace pqrs {
 class xml_compiler final {
@@ -38,70 +40,115 @@ public:
 #include "pqrs/xml_compiler/detail/inputsource.hpp"
 #include "pqrs/xml_compiler/detail/loader_wrapper.hpp"
 #include "pqrs/xml_compiler/detail/modifier.hpp"
+#include "pqrs/xml_compiler/detail/preferences_flat_tree.hpp"
 #include "pqrs/xml_compiler/detail/preferences_node.hpp"
 #include "pqrs/xml_compiler/detail/remapclasses_initialize_vector.hpp"
 #include "pqrs/xml_compiler/detail/remapclasses_initialize_vector_prepare_loader.hpp"
 #include "pqrs/xml_compiler/detail/replacement.hpp"
+#include "pqrs/xml_compiler/detail/snapshot.hpp"
 #include "pqrs/xml_compiler/detail/symbol_map.hpp"
+#include "pqrs/xml_compiler/detail/tag_name.hpp"
 #include "pqrs/xml_compiler/detail/ui_element_role.hpp"
 #include "pqrs/xml_compiler/detail/url.hpp"
 #include "pqrs/xml_compiler/detail/window_name.hpp"
 
   xml_compiler(const std::string& system_xml_directory, const std::string& private_xml_directory) : system_xml_directory_(system_xml_directory),
-                                                                                                    private_xml_directory_(private_xml_directory) {}
+                                                                                                    private_xml_directory_(private_xml_directory),
+                                                                                                    reloaded_(false) {
+    // The empty snapshot until the first reload.
+    std::shared_ptr<snapshot> s(new snapshot());
+    s->remapclasses_initialize_vector_.freeze();
+    snapshot_ = s;
+  }
 
+  // reload and the methods which are not const must be called from one thread.
+  // The data of the previous snapshot is kept if reload fails. (get_error_information returns errors in that case.)
   void reload(const std::string& checkbox_xml_file_name);
   void reload(void) { reload("checkbox.xml"); }
 
   bool needs_reload(void) const;
 
+  // Return the current snapshot.
+  // It can be called from any thread and the snapshot is valid while it is held.
+  snapshot::ptr get_snapshot(void) const { return std::atomic_load(&snapshot_); }
+
+  // The following methods query the current snapshot.
+  //
+  // They must be called from the thread which calls reload.
+  // Returned references point into the current snapshot and become dangling after the next reload.
+  // (Other threads must hold get_snapshot() and query the snapshot.)
   const remapclasses_initialize_vector& get_remapclasses_initialize_vector(void) const {
-    return remapclasses_initialize_vector_;
+    return get_snapshot()->get_remapclasses_initialize_vector();
   }
 
+  // The delta from the remapclasses_initialize_vector which is uploaded into kext at last.
+  // It is empty if the delta is not available. (Upload the whole vector in that case.)
+  const std::vector<uint32_t>& get_remapclasses_delta_vector(void) const {
+    return remapclasses_delta_vector_;
+  }
+  void set_remapclasses_initialize_vector_uploaded(void);
+
   const error_information& get_error_information(void) const {
-    return error_information_;
+    return get_snapshot()->get_error_information();
   }
 
-  const symbol_map& get_symbol_map(void) const { return symbol_map_; }
+  const symbol_map& get_symbol_map(void) const { return get_snapshot()->get_symbol_map(); }
 
-  boost::optional<const std::string&> get_identifier(int config_index) const;
-  boost::optional<int> get_config_index(const std::string& identifier) const;
+  boost::optional<const std::string&> get_identifier(int config_index) const {
+    return get_snapshot()->get_identifier(config_index);
+  }
+  boost::optional<int> get_config_index(const std::string& identifier) const {
+    return get_snapshot()->get_config_index(identifier);
+  }
   boost::optional<const std::string&> override_bundle_identifier(const std::string& bundle_identifier,
                                                                  const std::string& window_name,
-                                                                 const std::string& ui_element_role) const;
-  size_t get_app_vector_size(void) const { return app_vector_.size(); }
-  size_t get_inputsource_vector_size(void) const { return inputsource_vector_.size(); }
-  size_t get_window_name_vector_size(void) const { return window_name_vector_.size(); }
-  bool is_app_matched(uint32_t& appid, size_t index, const std::string& application_identifier) const;
+                                                                 const std::string& ui_element_role) const {
+    return get_snapshot()->override_bundle_identifier(bundle_identifier, window_name, ui_element_role);
+  }
+  size_t get_app_vector_size(void) const { return get_snapshot()->get_app_vector_size(); }
+  size_t get_inputsource_vector_size(void) const { return get_snapshot()->get_inputsource_vector_size(); }
+  size_t get_window_name_vector_size(void) const { return get_snapshot()->get_window_name_vector_size(); }
+  bool is_app_matched(uint32_t& appid, size_t index, const std::string& application_identifier) const {
+    return get_snapshot()->is_app_matched(appid, index, application_identifier);
+  }
   bool is_inputsource_matched(uint32_t& inputsource,
                               size_t index,
                               const std::string& languagecode,
                               const std::string& inputsourceid,
-                              const std::string& inputmodeid) const;
-  bool is_window_name_matched(uint32_t& windownameid, size_t index, const std::string& window_name) const;
+                              const std::string& inputmodeid) const {
+    return get_snapshot()->is_inputsource_matched(inputsource, index, languagecode, inputsourceid, inputmodeid);
+  }
+  bool is_window_name_matched(uint32_t& windownameid, size_t index, const std::string& window_name) const {
+    return get_snapshot()->is_window_name_matched(windownameid, index, window_name);
+  }
   bool is_vk_change_inputsource_matched(uint32_t keycode,
                                         const std::string& languagecode,
                                         const std::string& inputsourceid,
-                                        const std::string& inputmodeid) const;
-  boost::optional<const std::string&> get_url(int keycode) const;
-  boost::optional<const std::string&> get_url_type(int keycode) const;
-  bool get_url_background(int keycode) const;
+                                        const std::string& inputmodeid) const {
+    return get_snapshot()->is_vk_change_inputsource_matched(keycode, languagecode, inputsourceid, inputmodeid);
+  }
+  boost::optional<const std::string&> get_url(int keycode) const { return get_snapshot()->get_url(keycode); }
+  boost::optional<const std::string&> get_url_type(int keycode) const { return get_snapshot()->get_url_type(keycode); }
+  bool get_url_background(int keycode) const { return get_snapshot()->get_url_background(keycode); }
 
   boost::optional<const essential_configuration&> get_essential_configuration(size_t index) const {
-    if (index >= essential_configurations_.size()) return boost::none;
-    return *(essential_configurations_[index]);
+    return get_snapshot()->get_essential_configuration(index);
   }
 
   const preferences_node_tree<preferences_checkbox_node>& get_preferences_checkbox_node_tree(void) const {
-    return preferences_checkbox_node_tree_;
+    return get_snapshot()->get_preferences_checkbox_node_tree();
   }
   const preferences_node_tree<preferences_number_node>& get_preferences_number_node_tree(void) const {
-    return preferences_number_node_tree_;
+    return get_snapshot()->get_preferences_number_node_tree();
+  }
+  const preferences_flat_tree& get_preferences_flat_tree(void) const {
+    return get_snapshot()->get_preferences_flat_tree();
   }
 
   // ----------------------------------------
-  bool debug_get_initialize_vector(std::vector<uint32_t>& out, const std::string& raw_identifier) const;
+  bool debug_get_initialize_vector(std::vector<uint32_t>& out, const std::string& raw_identifier) const {
+    return get_snapshot()->debug_get_initialize_vector(out, raw_identifier);
+  }
 
 private:
   void append_environments_to_replacement_(pqrs::string::replacement& r) const;
@@ -143,30 +190,30 @@ private:
     boost::replace_all(identifier, ".", "_");
   }
 
-  bool valid_identifier_(const std::string& identifier, const std::string& parent_tag_name) const;
+  bool valid_identifier_(const std::string& identifier, tag_name::type parent_tag) const;
+
+  void update_remapclasses_delta_vector_(void);
+
+  // The errors of the snapshot which is being built by reload.
+  error_information& error_information_(void) const { return new_snapshot_->error_information_; }
 
   const std::string system_xml_directory_;
   const std::string private_xml_directory_;
 
-  mutable error_information error_information_;
   mutable std::string replacement_warnings_;
 
   mutable std::vector<std::string> global_included_files_;
 
   pqrs::string::replacement replacement_;
-  symbol_map symbol_map_;
-  boost::unordered_map<uint32_t, std::shared_ptr<modifier>> modifier_map_;
-  std::vector<std::shared_ptr<app>> app_vector_;
-  std::vector<std::shared_ptr<bundle_identifier_override>> bundle_identifier_override_vector_;
-  std::vector<std::shared_ptr<window_name>> window_name_vector_;
-  boost::unordered_map<uint32_t, std::shared_ptr<inputsource>> vk_change_inputsource_map_;
-  std::vector<std::shared_ptr<inputsource>> inputsource_vector_;
-  boost::unordered_map<uint32_t, std::shared_ptr<url>> vk_open_url_map_;
-  boost::unordered_map<uint32_t, std::string> identifier_map_;
-  std::vector<std::shared_ptr<essential_configuration>> essential_configurations_;
-  remapclasses_initialize_vector remapclasses_initialize_vector_;
-
-  preferences_node_tree<preferences_checkbox_node> preferences_checkbox_node_tree_;
-  preferences_node_tree<preferences_number_node> preferences_number_node_tree_;
+
+  // The current snapshot. (Use std::atomic_load and std::atomic_store to access.)
+  snapshot::ptr snapshot_;
+  // The snapshot which is being built by reload. (nullptr while reload is not running.)
+  std::shared_ptr<snapshot> new_snapshot_;
+  // true if a reload has succeeded.
+  bool reloaded_;
+
+  std::vector<uint32_t> uploaded_remapclasses_initialize_vector_;
+  std::vector<uint32_t> remapclasses_delta_vector_;
 };
 }
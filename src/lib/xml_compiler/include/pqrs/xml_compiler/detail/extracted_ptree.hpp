@@ -1,5 +1,7 @@
 #pragma once
 
+#include "pqrs/xml_compiler/detail/tag_name.hpp"
+
 class extracted_ptree final {
 public:
   extracted_ptree(const xml_compiler& xml_compiler,
@@ -10,7 +12,7 @@ public:
                                                       pt_(pt),
                                                       local_included_files_ptr_(new std::deque<std::string>),
                                                       local_included_files_(*local_included_files_ptr_),
-                                                      stack_ptr_(new std::stack<stack_data>),
+                                                      stack_ptr_(new stack),
                                                       stack_(*stack_ptr_) {
     local_included_files_.push_back(xml_file_path);
   }
@@ -21,9 +23,12 @@ public:
          const extracted_ptree& extracted_ptree,
          const pqrs::string::replacement& replacement) : node_(node),
                                                          extracted_ptree_(extracted_ptree),
-                                                         replacement_(replacement) {}
+                                                         replacement_(replacement),
+                                                         tag_(tag_name::get(node.first)) {}
 
     const std::string& get_tag_name(void) const { return node_.first; }
+    // Loaders use get_tag instead of comparing get_tag_name.
+    tag_name::type get_tag(void) const { return tag_; }
     const std::string& get_data(void) const { return node_.second.data(); }
     boost::optional<std::string> get_optional(const std::string& path) const {
       return node_.second.get_optional<std::string>(path);
@@ -38,6 +43,7 @@ public:
     const boost::property_tree::ptree::value_type& node_;
     const extracted_ptree& extracted_ptree_;
     const pqrs::string::replacement& replacement_;
+    const tag_name::type tag_;
   };
 
   class stack_data final {
@@ -68,13 +74,77 @@ public:
     const std::shared_ptr<pqrs::string::replacement> replacement_ptr_;
   };
 
+  // The stack of stack_data.
+  // Entries are stored in inline storage up to inline_capacity
+  // in order to avoid heap allocations while we descend into children and <include>.
+  //
+  // References to entries must stay valid while other entries are pushed.
+  // (extract_include_ keeps a reference to top() while the nested traverse pushes entries.)
+  // Thus, overflow_ is std::deque instead of std::vector.
+  class stack final {
+  public:
+    stack(void) : size_(0) {}
+    ~stack(void) {
+      while (!empty()) {
+        pop();
+      }
+    }
+
+    bool empty(void) const { return size_ == 0; }
+    size_t size(void) const { return size_; }
+
+    stack_data& top(void) {
+      assert(!empty());
+      return at_(size_ - 1);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+      if (size_ < inline_capacity) {
+        new (&inline_[size_]) stack_data(std::forward<Args>(args)...);
+      } else {
+        overflow_.emplace_back(std::forward<Args>(args)...);
+      }
+      ++size_;
+    }
+
+    void pop(void) {
+      assert(!empty());
+      --size_;
+      if (size_ < inline_capacity) {
+        at_(size_).~stack_data();
+      } else {
+        overflow_.pop_back();
+      }
+    }
+
+  private:
+    stack(const stack&) = delete;
+    stack& operator=(const stack&) = delete;
+
+    enum {
+      inline_capacity = 16,
+    };
+
+    stack_data& at_(size_t index) {
+      if (index < inline_capacity) {
+        return *reinterpret_cast<stack_data*>(&inline_[index]);
+      }
+      return overflow_[index - inline_capacity];
+    }
+
+    std::aligned_storage<sizeof(stack_data), alignof(stack_data)>::type inline_[inline_capacity];
+    std::deque<stack_data> overflow_;
+    size_t size_;
+  };
+
   class extracted_ptree_iterator final : public boost::iterator_facade<extracted_ptree_iterator,
                                                                        const node,
                                                                        boost::forward_traversal_tag> {
   public:
     extracted_ptree_iterator(const extracted_ptree& extracted_ptree) : extracted_ptree_(extracted_ptree),
                                                                        stack_size_(0),
-                                                                       node_(nullptr) {
+                                                                       has_node_(false) {
       set_node_();
     }
 
@@ -82,19 +152,16 @@ public:
                              const pqrs::string::replacement& replacement,
                              const boost::property_tree::ptree& pt) : extracted_ptree_(extracted_ptree),
                                                                       stack_size_(extracted_ptree.stack_.size() + 1),
-                                                                      node_(nullptr) {
+                                                                      has_node_(false) {
       if (!pt.empty()) {
-        extracted_ptree_.stack_.push(stack_data(pt, replacement));
+        extracted_ptree_.stack_.emplace(pt, replacement);
         extract_include_();
       }
       set_node_();
     }
 
     ~extracted_ptree_iterator(void) {
-      if (node_) {
-        delete node_;
-        node_ = nullptr;
-      }
+      reset_node_();
 
       while (!ended_()) {
         auto& top = extracted_ptree_.stack_.top();
@@ -120,8 +187,8 @@ public:
     }
 
     const node& dereference(void) const {
-      assert(node_);
-      return *node_;
+      assert(has_node_);
+      return *reinterpret_cast<const node*>(&node_storage_);
     }
 
     bool equal(const extracted_ptree_iterator& other) const {
@@ -144,11 +211,15 @@ public:
       return false;
     }
 
-    void set_node_(void) {
-      if (node_) {
-        delete node_;
+    void reset_node_(void) {
+      if (has_node_) {
+        reinterpret_cast<node*>(&node_storage_)->~node();
+        has_node_ = false;
       }
-      node_ = nullptr;
+    }
+
+    void set_node_(void) {
+      reset_node_();
 
       if (ended_()) {
         return;
@@ -159,7 +230,8 @@ public:
         return;
       }
 
-      node_ = new node(*(top.it), extracted_ptree_, top.parent_replacement);
+      new (&node_storage_) node(*(top.it), extracted_ptree_, top.parent_replacement);
+      has_node_ = true;
     }
 
     void extract_include_(void) const {
@@ -192,7 +264,7 @@ public:
       {
         auto path = it.second.get_optional<std::string>("<xmlattr>.path");
         if (!path) {
-          xml_compiler.error_information_.set("`path` attribute is not found in <include>.");
+          xml_compiler.error_information_().set("`path` attribute is not found in <include>.");
         } else {
           assert(!extracted_ptree_.local_included_files_.empty());
           xml_file_path = xml_compiler.make_file_path(pqrs::file_path::dirname(extracted_ptree_.local_included_files_.back()),
@@ -215,7 +287,7 @@ public:
         // check local_included_files_
         for (const auto& i : extracted_ptree_.local_included_files_) {
           if (i == xml_file_path) {
-            xml_compiler.error_information_.set("An infinite include loop is detected:\n" + xml_file_path);
+            xml_compiler.error_information_().set("An infinite include loop is detected:\n" + xml_file_path);
             return;
           }
         }
@@ -235,7 +307,7 @@ public:
             auto root_node = pt_ptr->begin();
             const auto& root_children = root_node->second;
             if (!root_children.empty()) {
-              extracted_ptree_.stack_.push(stack_data(pt_ptr, replacement_ptr, root_children));
+              extracted_ptree_.stack_.emplace(pt_ptr, replacement_ptr, root_children);
               extracted_ptree_.local_included_files_.push_back(xml_file_path);
               extract_include_();
             }
@@ -271,7 +343,9 @@ public:
 
     const extracted_ptree& extracted_ptree_;
     const size_t stack_size_;
-    node* node_;
+    // The current node. (We do not allocate a node for each step.)
+    std::aligned_storage<sizeof(node), alignof(node)>::type node_storage_;
+    bool has_node_;
   };
 
   extracted_ptree_iterator begin(void) const {
@@ -301,6 +375,6 @@ private:
   std::deque<std::string>& local_included_files_;
 
   // shared_ptr for stack_.
-  std::shared_ptr<std::stack<stack_data>> stack_ptr_;
-  std::stack<stack_data>& stack_;
+  std::shared_ptr<stack> stack_ptr_;
+  stack& stack_;
 };
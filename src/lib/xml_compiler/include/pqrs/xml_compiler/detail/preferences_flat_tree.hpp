@@ -0,0 +1,34 @@
+#pragma once
+
+#include "pqrs/xml_compiler/detail/preferences_node.hpp"
+
+// The checkbox tree and the number tree in one contiguous buffer.
+// (See pqrs_xml_compiler_preferences_flat_tree about the layout.)
+class preferences_flat_tree final {
+public:
+  void clear(void) { buffer_.clear(); }
+
+  void make(const preferences_node_tree<preferences_checkbox_node>& checkbox_node_tree,
+            const preferences_node_tree<preferences_number_node>& number_node_tree);
+
+  // Return nullptr before make().
+  const pqrs_xml_compiler_preferences_flat_tree* get(void) const {
+    if (buffer_.empty()) return nullptr;
+    return reinterpret_cast<const pqrs_xml_compiler_preferences_flat_tree*>(&(buffer_[0]));
+  }
+
+  static const pqrs_xml_compiler_preferences_flat_node* get_nodes(const pqrs_xml_compiler_preferences_flat_tree& tree) {
+    return reinterpret_cast<const pqrs_xml_compiler_preferences_flat_node*>(&tree + 1);
+  }
+  static const char* get_string(const pqrs_xml_compiler_preferences_flat_tree& tree, uint32_t offset) {
+    if (offset >= tree.strings_size) return nullptr;
+    return reinterpret_cast<const char*>(&tree) + tree.strings_offset + offset;
+  }
+  // Return the tree which contains `node`.
+  static const pqrs_xml_compiler_preferences_flat_tree& get_tree(const pqrs_xml_compiler_preferences_flat_node& node) {
+    return *(reinterpret_cast<const pqrs_xml_compiler_preferences_flat_tree*>(&node - node.index) - 1);
+  }
+
+private:
+  std::vector<char> buffer_;
+};
@@ -29,9 +29,21 @@ public:
 
   void freeze(void);
 
+  // Make a delta (remapclasses_delta format in bridge.h) which transforms `base` into this vector.
+  // Return false if the delta is not available.
+  // (`base` is broken or virtual modifiers are changed.)
+  bool make_delta(std::vector<uint32_t>& out, const std::vector<uint32_t>& base) const;
+
 private:
   void cleanup_(void);
 
+  // offsets[configindex] == the offset of <initialize_vector> in v.
+  static bool get_offsets_(std::vector<size_t>& offsets, const std::vector<uint32_t>& v);
+  static uint32_t get_checksum_(const std::vector<uint32_t>& v, size_t offset);
+  static bool is_equal_(const std::vector<uint32_t>& v1, size_t offset1,
+                        const std::vector<uint32_t>& v2, size_t offset2);
+  static bool has_virtual_modifier_(const std::vector<uint32_t>& v, size_t offset);
+
   enum {
     INDEX_OF_CONFIG_COUNT = 0,
   };
@@ -61,7 +73,7 @@ public:
                                                                                                        symbol_map_cache_option_use_separator_(symbol_map_.get("Option::USE_SEPARATOR")) {}
 
   void traverse(const extracted_ptree& pt,
-                const std::string& parent_tag_name);
+                tag_name::type parent_tag);
 
 private:
   void traverse_autogen_(const extracted_ptree& pt,
@@ -22,16 +22,16 @@ public:
                                                                                                   preferences_node_tree_(preferences_node_tree),
                                                                                                   root_preferences_node_tree_(preferences_node_tree) {}
 
-  void traverse(const extracted_ptree& pt, const std::string& parent_tag_name) {
+  void traverse(const extracted_ptree& pt, tag_name::type parent_tag) {
     for (const auto& it : pt) {
       // Hack for speed improvement.
       // We can stop traversing when we met <autogen>.
-      if (it.get_tag_name() == "autogen") {
+      if (it.get_tag() == tag_name::autogen) {
         continue;
       }
 
       // traverse
-      if (it.get_tag_name() == "item") {
+      if (it.get_tag() == tag_name::item) {
         assert(preferences_node_tree_);
         std::shared_ptr<preferences_node_tree_t> ptr(new preferences_node_tree_t());
         assert(ptr);
@@ -40,7 +40,7 @@ public:
         preferences_node_tree_ = ptr.get();
         {
           if (!it.children_empty()) {
-            traverse(it.children_extracted_ptree(), it.get_tag_name());
+            traverse(it.children_extracted_ptree(), it.get_tag());
           }
         }
         preferences_node_tree_ = saved_preferences_node_tree;
@@ -53,13 +53,13 @@ public:
 
       } else {
         assert(preferences_node_tree_);
-        if (parent_tag_name == "item") {
+        if (parent_tag == tag_name::item) {
           preferences_node_tree_->handle_item_child(it);
         }
 
-        if (it.get_tag_name() == "identifier") {
+        if (it.get_tag() == tag_name::identifier) {
           auto raw_identifier = boost::trim_copy(it.get_data());
-          if (xml_compiler_.valid_identifier_(raw_identifier, parent_tag_name)) {
+          if (xml_compiler_.valid_identifier_(raw_identifier, parent_tag)) {
             auto identifier = raw_identifier;
             normalize_identifier_(identifier);
 
@@ -97,7 +97,7 @@ public:
         }
 
         if (!it.children_empty()) {
-          traverse(it.children_extracted_ptree(), it.get_tag_name());
+          traverse(it.children_extracted_ptree(), it.get_tag());
         }
       }
     }
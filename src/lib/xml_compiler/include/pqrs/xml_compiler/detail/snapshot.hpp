@@ -0,0 +1,100 @@
+#pragma once
+
+#include "pqrs/xml_compiler/detail/app.hpp"
+#include "pqrs/xml_compiler/detail/bundle_identifier_override.hpp"
+#include "pqrs/xml_compiler/detail/error_information.hpp"
+#include "pqrs/xml_compiler/detail/essential_configuration.hpp"
+#include "pqrs/xml_compiler/detail/inputsource.hpp"
+#include "pqrs/xml_compiler/detail/modifier.hpp"
+#include "pqrs/xml_compiler/detail/preferences_flat_tree.hpp"
+#include "pqrs/xml_compiler/detail/preferences_node.hpp"
+#include "pqrs/xml_compiler/detail/remapclasses_initialize_vector.hpp"
+#include "pqrs/xml_compiler/detail/symbol_map.hpp"
+#include "pqrs/xml_compiler/detail/url.hpp"
+#include "pqrs/xml_compiler/detail/window_name.hpp"
+
+// The compiled state of one reload.
+//
+// xml_compiler::reload builds a new snapshot and publishes it.
+// If the reload failed, a copy of the previous snapshot which has the errors is published instead.
+// (A partial snapshot is published if no reload has succeeded yet.)
+// A published snapshot is never modified. Readers in other threads hold it by get_snapshot()
+// and can query it while the next reload is running.
+class snapshot final {
+  friend class xml_compiler;
+
+public:
+  typedef std::shared_ptr<const snapshot> ptr;
+
+  // A new snapshot is filled by xml_compiler::reload.
+  // (remapclasses_initialize_vector_ is frozen when the reload is finished.)
+  snapshot(void) { remapclasses_initialize_vector_.clear(); }
+
+  // The errors of the reload which published this snapshot.
+  const error_information& get_error_information(void) const { return error_information_; }
+
+  const remapclasses_initialize_vector& get_remapclasses_initialize_vector(void) const {
+    return remapclasses_initialize_vector_;
+  }
+
+  const symbol_map& get_symbol_map(void) const { return symbol_map_; }
+
+  boost::optional<const std::string&> get_identifier(int config_index) const;
+  boost::optional<int> get_config_index(const std::string& identifier) const;
+  boost::optional<const std::string&> override_bundle_identifier(const std::string& bundle_identifier,
+                                                                 const std::string& window_name,
+                                                                 const std::string& ui_element_role) const;
+  size_t get_app_vector_size(void) const { return app_vector_.size(); }
+  size_t get_inputsource_vector_size(void) const { return inputsource_vector_.size(); }
+  size_t get_window_name_vector_size(void) const { return window_name_vector_.size(); }
+  bool is_app_matched(uint32_t& appid, size_t index, const std::string& application_identifier) const;
+  bool is_inputsource_matched(uint32_t& inputsource,
+                              size_t index,
+                              const std::string& languagecode,
+                              const std::string& inputsourceid,
+                              const std::string& inputmodeid) const;
+  bool is_window_name_matched(uint32_t& windownameid, size_t index, const std::string& window_name) const;
+  bool is_vk_change_inputsource_matched(uint32_t keycode,
+                                        const std::string& languagecode,
+                                        const std::string& inputsourceid,
+                                        const std::string& inputmodeid) const;
+  boost::optional<const std::string&> get_url(int keycode) const;
+  boost::optional<const std::string&> get_url_type(int keycode) const;
+  bool get_url_background(int keycode) const;
+
+  boost::optional<const essential_configuration&> get_essential_configuration(size_t index) const {
+    if (index >= essential_configurations_.size()) return boost::none;
+    return *(essential_configurations_[index]);
+  }
+
+  const preferences_node_tree<preferences_checkbox_node>& get_preferences_checkbox_node_tree(void) const {
+    return preferences_checkbox_node_tree_;
+  }
+  const preferences_node_tree<preferences_number_node>& get_preferences_number_node_tree(void) const {
+    return preferences_number_node_tree_;
+  }
+  const preferences_flat_tree& get_preferences_flat_tree(void) const {
+    return preferences_flat_tree_;
+  }
+
+  bool debug_get_initialize_vector(std::vector<uint32_t>& out, const std::string& raw_identifier) const;
+
+private:
+  error_information error_information_;
+
+  symbol_map symbol_map_;
+  boost::unordered_map<uint32_t, std::shared_ptr<modifier>> modifier_map_;
+  std::vector<std::shared_ptr<app>> app_vector_;
+  std::vector<std::shared_ptr<bundle_identifier_override>> bundle_identifier_override_vector_;
+  std::vector<std::shared_ptr<window_name>> window_name_vector_;
+  boost::unordered_map<uint32_t, std::shared_ptr<inputsource>> vk_change_inputsource_map_;
+  std::vector<std::shared_ptr<inputsource>> inputsource_vector_;
+  boost::unordered_map<uint32_t, std::shared_ptr<url>> vk_open_url_map_;
+  boost::unordered_map<uint32_t, std::string> identifier_map_;
+  std::vector<std::shared_ptr<essential_configuration>> essential_configurations_;
+  remapclasses_initialize_vector remapclasses_initialize_vector_;
+
+  preferences_node_tree<preferences_checkbox_node> preferences_checkbox_node_tree_;
+  preferences_node_tree<preferences_number_node> preferences_number_node_tree_;
+  preferences_flat_tree preferences_flat_tree_;
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+// Tag names which loaders handle.
+// Loaders switch on tag_name::type instead of comparing strings at every node.
+class tag_name final {
+public:
+  enum type {
+    unknown,
+
+    appdef,
+    appendix,
+    appname,
+    autogen,
+    background,
+    bundleidentifieroverridedef,
+    bundleidentifiers,
+    config_not,
+    config_only,
+    device_not,
+    device_only,
+    deviceexists_not,
+    deviceexists_only,
+    devicelocationdef,
+    deviceproductdef,
+    devicevendordef,
+    elapsedtimesincelastpressed_greaterthan,
+    elapsedtimesincelastpressed_lessthan,
+    elapsedtimesincelastreleased_greaterthan,
+    elapsedtimesincelastreleased_lessthan,
+    equal,
+    identifier,
+    include,
+    inputmode_not,
+    inputmode_only,
+    inputmodedetail_not,
+    inputmodedetail_only,
+    inputmodeid_equal,
+    inputmodeid_prefix,
+    inputsource_not,
+    inputsource_only,
+    inputsourcedef,
+    inputsourcedetail_not,
+    inputsourcedetail_only,
+    inputsourceid_equal,
+    inputsourceid_prefix,
+    item,
+    languagecode,
+    lastpressedphysicalkey_not,
+    lastpressedphysicalkey_only,
+    lastreleasedphysicalkey_not,
+    lastreleasedphysicalkey_only,
+    lastsentevent_not,
+    lastsentevent_only,
+    locationid,
+    locationname,
+    modifier_not,
+    modifier_only,
+    modifierdef,
+    modifierlocked_not,
+    modifierlocked_only,
+    modifierstuck_not,
+    modifierstuck_only,
+    name,
+    newbundleidentifier,
+    not_, // <not>
+    only,
+    prefix,
+    pressingphysicalkeys_greaterthan,
+    pressingphysicalkeys_lessthan,
+    productid,
+    productname,
+    regex,
+    replacementdef,
+    replacementname,
+    replacementvalue,
+    suffix,
+    symbol_map,
+    uielementrole_not,
+    uielementrole_only,
+    uielementroledef,
+    uielementroles,
+    url,
+    vendorid,
+    vendorname,
+    vkchangeinputsourcedef,
+    vkopenurldef,
+    windowname_not,
+    windowname_only,
+    windownamedef,
+    windownames,
+  };
+
+  // Return tag_name::unknown if `name` is not a known tag name.
+  static type get(const std::string& name) {
+    static const map_t map = make_map_();
+
+    auto it = map.find(name);
+    if (it == map.end()) {
+      return unknown;
+    }
+    return it->second;
+  }
+
+private:
+  // FNV-1a. (Tag names are short, so a simple hash is faster than boost::hash.)
+  class hash {
+  public:
+    size_t operator()(const std::string& s) const {
+      uint32_t h = 2166136261u;
+      for (const auto& c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+      }
+      return h;
+    }
+  };
+  typedef boost::unordered_map<std::string, type, hash> map_t;
+
+  static map_t make_map_(void) {
+    map_t map;
+
+    map["appdef"] = appdef;
+    map["appendix"] = appendix;
+    map["appname"] = appname;
+    map["autogen"] = autogen;
+    map["background"] = background;
+    map["bundleidentifieroverridedef"] = bundleidentifieroverridedef;
+    map["bundleidentifiers"] = bundleidentifiers;
+    map["config_not"] = config_not;
+    map["config_only"] = config_only;
+    map["device_not"] = device_not;
+    map["device_only"] = device_only;
+    map["deviceexists_not"] = deviceexists_not;
+    map["deviceexists_only"] = deviceexists_only;
+    map["devicelocationdef"] = devicelocationdef;
+    map["deviceproductdef"] = deviceproductdef;
+    map["devicevendordef"] = devicevendordef;
+    map["elapsedtimesincelastpressed_greaterthan"] = elapsedtimesincelastpressed_greaterthan;
+    map["elapsedtimesincelastpressed_lessthan"] = elapsedtimesincelastpressed_lessthan;
+    map["elapsedtimesincelastreleased_greaterthan"] = elapsedtimesincelastreleased_greaterthan;
+    map["elapsedtimesincelastreleased_lessthan"] = elapsedtimesincelastreleased_lessthan;
+    map["equal"] = equal;
+    map["identifier"] = identifier;
+    map["include"] = include;
+    map["inputmode_not"] = inputmode_not;
+    map["inputmode_only"] = inputmode_only;
+    map["inputmodedetail_not"] = inputmodedetail_not;
+    map["inputmodedetail_only"] = inputmodedetail_only;
+    map["inputmodeid_equal"] = inputmodeid_equal;
+    map["inputmodeid_prefix"] = inputmodeid_prefix;
+    map["inputsource_not"] = inputsource_not;
+    map["inputsource_only"] = inputsource_only;
+    map["inputsourcedef"] = inputsourcedef;
+    map["inputsourcedetail_not"] = inputsourcedetail_not;
+    map["inputsourcedetail_only"] = inputsourcedetail_only;
+    map["inputsourceid_equal"] = inputsourceid_equal;
+    map["inputsourceid_prefix"] = inputsourceid_prefix;
+    map["item"] = item;
+    map["languagecode"] = languagecode;
+    map["lastpressedphysicalkey_not"] = lastpressedphysicalkey_not;
+    map["lastpressedphysicalkey_only"] = lastpressedphysicalkey_only;
+    map["lastreleasedphysicalkey_not"] = lastreleasedphysicalkey_not;
+    map["lastreleasedphysicalkey_only"] = lastreleasedphysicalkey_only;
+    map["lastsentevent_not"] = lastsentevent_not;
+    map["lastsentevent_only"] = lastsentevent_only;
+    map["locationid"] = locationid;
+    map["locationname"] = locationname;
+    map["modifier_not"] = modifier_not;
+    map["modifier_only"] = modifier_only;
+    map["modifierdef"] = modifierdef;
+    map["modifierlocked_not"] = modifierlocked_not;
+    map["modifierlocked_only"] = modifierlocked_only;
+    map["modifierstuck_not"] = modifierstuck_not;
+    map["modifierstuck_only"] = modifierstuck_only;
+    map["name"] = name;
+    map["newbundleidentifier"] = newbundleidentifier;
+    map["not"] = not_;
+    map["only"] = only;
+    map["prefix"] = prefix;
+    map["pressingphysicalkeys_greaterthan"] = pressingphysicalkeys_greaterthan;
+    map["pressingphysicalkeys_lessthan"] = pressingphysicalkeys_lessthan;
+    map["productid"] = productid;
+    map["productname"] = productname;
+    map["regex"] = regex;
+    map["replacementdef"] = replacementdef;
+    map["replacementname"] = replacementname;
+    map["replacementvalue"] = replacementvalue;
+    map["suffix"] = suffix;
+    map["symbol_map"] = symbol_map;
+    map["uielementrole_not"] = uielementrole_not;
+    map["uielementrole_only"] = uielementrole_only;
+    map["uielementroledef"] = uielementroledef;
+    map["uielementroles"] = uielementroles;
+    map["url"] = url;
+    map["vendorid"] = vendorid;
+    map["vendorname"] = vendorname;
+    map["vkchangeinputsourcedef"] = vkchangeinputsourcedef;
+    map["vkopenurldef"] = vkopenurldef;
+    map["windowname_not"] = windowname_not;
+    map["windowname_only"] = windowname_only;
+    map["windownamedef"] = windownamedef;
+    map["windownames"] = windownames;
+
+    return map;
+  }
+};
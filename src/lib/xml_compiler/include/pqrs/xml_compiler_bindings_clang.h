@@ -55,8 +55,53 @@ bool pqrs_xml_compiler_get_url_background(const pqrs_xml_compiler* p, uint32_t k
 const uint32_t* pqrs_xml_compiler_get_remapclasses_initialize_vector_data(const pqrs_xml_compiler* p);
 size_t pqrs_xml_compiler_get_remapclasses_initialize_vector_size(const pqrs_xml_compiler* p);
 uint32_t pqrs_xml_compiler_get_remapclasses_initialize_vector_config_count(const pqrs_xml_compiler* p);
+void pqrs_xml_compiler_set_remapclasses_initialize_vector_uploaded(pqrs_xml_compiler* p);
+const uint32_t* pqrs_xml_compiler_get_remapclasses_delta_vector_data(const pqrs_xml_compiler* p);
+size_t pqrs_xml_compiler_get_remapclasses_delta_vector_size(const pqrs_xml_compiler* p);
 
 // ------------------------------------------------------------
+// The checkbox tree and the number tree are flattened into one contiguous buffer at reload.
+//
+// Layout: [pqrs_xml_compiler_preferences_flat_tree][pqrs_xml_compiler_preferences_flat_node * nodes_count][string table]
+//
+// * Children of a node are stored contiguously. (nodes[first_child] ... nodes[first_child + children_count - 1])
+// * Strings are byte offsets into the string table. Each string is terminated by '\0'.
+// * The buffer contains only offsets and indices. It is valid until the next pqrs_xml_compiler_reload.
+
+#define PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE 0xffffffff
+
+typedef struct {
+  uint32_t index;
+  uint32_t parent;
+  uint32_t first_child;
+  uint32_t next_sibling;
+  uint32_t children_count;
+
+  uint32_t name;
+  uint32_t identifier;
+  uint32_t style;
+  uint32_t base_unit;
+  int32_t default_value;
+  int32_t step;
+} pqrs_xml_compiler_preferences_flat_node;
+
+typedef struct {
+  // The size of the whole buffer in bytes.
+  uint32_t size;
+  uint32_t checkbox_root;
+  uint32_t number_root;
+  uint32_t nodes_count;
+  // The offset of the string table from the top of the buffer.
+  uint32_t strings_offset;
+  uint32_t strings_size;
+} pqrs_xml_compiler_preferences_flat_tree;
+
+const pqrs_xml_compiler_preferences_flat_tree* pqrs_xml_compiler_get_preferences_flat_tree(const pqrs_xml_compiler* p);
+const pqrs_xml_compiler_preferences_flat_node* pqrs_xml_compiler_get_preferences_flat_tree_nodes(const pqrs_xml_compiler_preferences_flat_tree* p);
+const char* pqrs_xml_compiler_get_preferences_flat_tree_string(const pqrs_xml_compiler_preferences_flat_tree* p, uint32_t offset);
+
+// ------------------------------------------------------------
+// The per-node API. (A node tree is a pqrs_xml_compiler_preferences_flat_node in the flat tree.)
 const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(const pqrs_xml_compiler* p);
 size_t pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(const pqrs_xml_compiler_preferences_checkbox_node_tree* p);
 const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(const pqrs_xml_compiler_preferences_checkbox_node_tree* p, size_t index);
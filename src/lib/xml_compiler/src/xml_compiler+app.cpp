@@ -44,7 +44,7 @@ bool xml_compiler::app::is_rules_matched(const std::string& identifier) const {
 // ============================================================
 void xml_compiler::app_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "appdef") {
+    if (it.get_tag() != tag_name::appdef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -53,23 +53,23 @@ void xml_compiler::app_loader::traverse(const extracted_ptree& pt) const {
       if (!newapp) continue;
 
       for (const auto& child : it.children_extracted_ptree()) {
-        if (child.get_tag_name() == "appname") {
+        if (child.get_tag() == tag_name::appname) {
           newapp->set_name(pqrs::string::remove_whitespaces_copy(child.get_data()));
-        } else if (child.get_tag_name() == "equal") {
+        } else if (child.get_tag() == tag_name::equal) {
           newapp->add_rule_equal(boost::trim_copy(child.get_data()));
-        } else if (child.get_tag_name() == "prefix") {
+        } else if (child.get_tag() == tag_name::prefix) {
           newapp->add_rule_prefix(boost::trim_copy(child.get_data()));
-        } else if (child.get_tag_name() == "suffix") {
+        } else if (child.get_tag() == tag_name::suffix) {
           newapp->add_rule_suffix(boost::trim_copy(child.get_data()));
         }
       }
 
       if (!newapp->get_name()) {
-        xml_compiler_.error_information_.set("No <appname> within <appdef>.");
+        xml_compiler_.error_information_().set("No <appname> within <appdef>.");
         continue;
       }
       if (newapp->get_name()->empty()) {
-        xml_compiler_.error_information_.set("Empty <appname> within <appdef>.");
+        xml_compiler_.error_information_().set("Empty <appname> within <appdef>.");
         continue;
       }
 
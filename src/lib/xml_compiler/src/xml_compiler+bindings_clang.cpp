@@ -244,128 +244,163 @@ pqrs_xml_compiler_get_remapclasses_initialize_vector_config_count(const pqrs_xml
   return (xml_compiler->get_remapclasses_initialize_vector()).get_config_count();
 }
 
-// ------------------------------------------------------------
-namespace {
-const pqrs::xml_compiler::preferences_node_tree<pqrs::xml_compiler::preferences_checkbox_node>* cast_to_preferences_checkbox_node_tree(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
-  return reinterpret_cast<const pqrs::xml_compiler::preferences_node_tree<pqrs::xml_compiler::preferences_checkbox_node>*>(p);
+void pqrs_xml_compiler_set_remapclasses_initialize_vector_uploaded(pqrs_xml_compiler* p) {
+  pqrs::xml_compiler* xml_compiler = reinterpret_cast<pqrs::xml_compiler*>(p);
+  if (!xml_compiler) return;
+
+  xml_compiler->set_remapclasses_initialize_vector_uploaded();
 }
+
+const uint32_t*
+pqrs_xml_compiler_get_remapclasses_delta_vector_data(const pqrs_xml_compiler* p) {
+  const pqrs::xml_compiler* xml_compiler = reinterpret_cast<const pqrs::xml_compiler*>(p);
+  if (!xml_compiler) return nullptr;
+
+  const auto& v = xml_compiler->get_remapclasses_delta_vector();
+  if (v.empty()) return nullptr;
+  return &(v[0]);
 }
 
-const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(const pqrs_xml_compiler* p) {
+size_t
+pqrs_xml_compiler_get_remapclasses_delta_vector_size(const pqrs_xml_compiler* p) {
+  const pqrs::xml_compiler* xml_compiler = reinterpret_cast<const pqrs::xml_compiler*>(p);
+  if (!xml_compiler) return 0;
+
+  return (xml_compiler->get_remapclasses_delta_vector()).size();
+}
+
+// ------------------------------------------------------------
+const pqrs_xml_compiler_preferences_flat_tree* pqrs_xml_compiler_get_preferences_flat_tree(const pqrs_xml_compiler* p) {
   const pqrs::xml_compiler* xml_compiler = reinterpret_cast<const pqrs::xml_compiler*>(p);
   if (!xml_compiler) return nullptr;
 
-  return reinterpret_cast<const pqrs_xml_compiler_preferences_checkbox_node_tree*>(&(xml_compiler->get_preferences_checkbox_node_tree()));
+  return (xml_compiler->get_preferences_flat_tree()).get();
 }
 
-size_t pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
-  auto node_tree = cast_to_preferences_checkbox_node_tree(p);
-  if (!node_tree) return 0;
+const pqrs_xml_compiler_preferences_flat_node* pqrs_xml_compiler_get_preferences_flat_tree_nodes(const pqrs_xml_compiler_preferences_flat_tree* p) {
+  if (!p) return nullptr;
 
-  auto children = node_tree->get_children();
-  if (!children) return 0;
+  return pqrs::xml_compiler::preferences_flat_tree::get_nodes(*p);
+}
 
-  return children->size();
+const char* pqrs_xml_compiler_get_preferences_flat_tree_string(const pqrs_xml_compiler_preferences_flat_tree* p, uint32_t offset) {
+  if (!p) return nullptr;
+
+  return pqrs::xml_compiler::preferences_flat_tree::get_string(*p, offset);
 }
 
-const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(const pqrs_xml_compiler_preferences_checkbox_node_tree* p, size_t index) {
-  auto node_tree = cast_to_preferences_checkbox_node_tree(p);
-  if (!node_tree) return nullptr;
+// ------------------------------------------------------------
+namespace {
+const pqrs_xml_compiler_preferences_flat_node* cast_to_flat_node(const void* p) {
+  return reinterpret_cast<const pqrs_xml_compiler_preferences_flat_node*>(p);
+}
 
-  auto children = node_tree->get_children();
-  if (!children) return nullptr;
-  if (index >= children->size()) return nullptr;
+const pqrs_xml_compiler_preferences_flat_node* get_flat_tree_root(const pqrs_xml_compiler* p, bool checkbox) {
+  auto tree = pqrs_xml_compiler_get_preferences_flat_tree(p);
+  if (!tree) return nullptr;
 
-  return reinterpret_cast<const pqrs_xml_compiler_preferences_checkbox_node_tree*>(((*children)[index]).get());
+  auto nodes = pqrs::xml_compiler::preferences_flat_tree::get_nodes(*tree);
+  return nodes + (checkbox ? tree->checkbox_root : tree->number_root);
 }
 
-const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_name(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
-  auto node_tree = cast_to_preferences_checkbox_node_tree(p);
-  if (!node_tree) return nullptr;
+size_t get_flat_node_children_count(const pqrs_xml_compiler_preferences_flat_node* node) {
+  if (!node) return 0;
 
-  return (node_tree->get_node()).get_name().c_str();
+  return node->children_count;
 }
 
-const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_style(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
-  auto node_tree = cast_to_preferences_checkbox_node_tree(p);
-  if (!node_tree) return nullptr;
+const pqrs_xml_compiler_preferences_flat_node* get_flat_node_child(const pqrs_xml_compiler_preferences_flat_node* node, size_t index) {
+  if (!node) return nullptr;
+  if (index >= node->children_count) return nullptr;
 
-  return (node_tree->get_node()).get_style().c_str();
+  // nodes[0] is (node - node->index).
+  return node - node->index + node->first_child + index;
 }
 
-const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_identifier(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
-  auto node_tree = cast_to_preferences_checkbox_node_tree(p);
-  if (!node_tree) return nullptr;
+const char* get_flat_node_string(const pqrs_xml_compiler_preferences_flat_node* node, uint32_t offset) {
+  if (!node) return nullptr;
 
-  return (node_tree->get_node()).get_identifier().c_str();
+  return pqrs::xml_compiler::preferences_flat_tree::get_string(pqrs::xml_compiler::preferences_flat_tree::get_tree(*node), offset);
+}
 }
 
-// ------------------------------------------------------------
-namespace {
-const pqrs::xml_compiler::preferences_node_tree<pqrs::xml_compiler::preferences_number_node>* cast_to_preferences_number_node_tree(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  return reinterpret_cast<const pqrs::xml_compiler::preferences_node_tree<pqrs::xml_compiler::preferences_number_node>*>(p);
+const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_root(const pqrs_xml_compiler* p) {
+  return get_flat_tree_root(p, true);
 }
+
+size_t pqrs_xml_compiler_get_preferences_checkbox_node_tree_children_count(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
+  return get_flat_node_children_count(cast_to_flat_node(p));
 }
 
-const pqrs_xml_compiler_preferences_number_node_tree* pqrs_xml_compiler_get_preferences_number_node_tree_root(const pqrs_xml_compiler* p) {
-  const pqrs::xml_compiler* xml_compiler = reinterpret_cast<const pqrs::xml_compiler*>(p);
-  if (!xml_compiler) return nullptr;
+const pqrs_xml_compiler_preferences_checkbox_node_tree* pqrs_xml_compiler_get_preferences_checkbox_node_tree_child(const pqrs_xml_compiler_preferences_checkbox_node_tree* p, size_t index) {
+  return get_flat_node_child(cast_to_flat_node(p), index);
+}
 
-  return reinterpret_cast<const pqrs_xml_compiler_preferences_number_node_tree*>(&(xml_compiler->get_preferences_number_node_tree()));
+const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_name(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
+
+  return get_flat_node_string(node, node->name);
 }
 
-size_t pqrs_xml_compiler_get_preferences_number_node_tree_children_count(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return 0;
+const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_style(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
 
-  auto children = node_tree->get_children();
-  if (!children) return 0;
+  return get_flat_node_string(node, node->style);
+}
 
-  return children->size();
+const char* pqrs_xml_compiler_get_preferences_checkbox_node_tree_identifier(const pqrs_xml_compiler_preferences_checkbox_node_tree* p) {
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
+
+  return get_flat_node_string(node, node->identifier);
 }
 
-const pqrs_xml_compiler_preferences_number_node_tree* pqrs_xml_compiler_get_preferences_number_node_tree_child(const pqrs_xml_compiler_preferences_number_node_tree* p, size_t index) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return nullptr;
+// ------------------------------------------------------------
+const pqrs_xml_compiler_preferences_number_node_tree* pqrs_xml_compiler_get_preferences_number_node_tree_root(const pqrs_xml_compiler* p) {
+  return get_flat_tree_root(p, false);
+}
 
-  auto children = node_tree->get_children();
-  if (!children) return nullptr;
-  if (index >= children->size()) return nullptr;
+size_t pqrs_xml_compiler_get_preferences_number_node_tree_children_count(const pqrs_xml_compiler_preferences_number_node_tree* p) {
+  return get_flat_node_children_count(cast_to_flat_node(p));
+}
 
-  return reinterpret_cast<const pqrs_xml_compiler_preferences_number_node_tree*>(((*children)[index]).get());
+const pqrs_xml_compiler_preferences_number_node_tree* pqrs_xml_compiler_get_preferences_number_node_tree_child(const pqrs_xml_compiler_preferences_number_node_tree* p, size_t index) {
+  return get_flat_node_child(cast_to_flat_node(p), index);
 }
 
 const char* pqrs_xml_compiler_get_preferences_number_node_tree_name(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return nullptr;
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
 
-  return (node_tree->get_node()).get_name().c_str();
+  return get_flat_node_string(node, node->name);
 }
 
 const char* pqrs_xml_compiler_get_preferences_number_node_tree_identifier(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return nullptr;
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
 
-  return (node_tree->get_node()).get_identifier().c_str();
+  return get_flat_node_string(node, node->identifier);
 }
 
 int pqrs_xml_compiler_get_preferences_number_node_tree_default_value(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return 0;
+  auto node = cast_to_flat_node(p);
+  if (!node) return 0;
 
-  return (node_tree->get_node()).get_default_value();
+  return node->default_value;
 }
 
 int pqrs_xml_compiler_get_preferences_number_node_tree_step(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return 1;
+  auto node = cast_to_flat_node(p);
+  if (!node) return 1;
 
-  return (node_tree->get_node()).get_step();
+  return node->step;
 }
 
 const char* pqrs_xml_compiler_get_preferences_number_node_tree_base_unit(const pqrs_xml_compiler_preferences_number_node_tree* p) {
-  auto node_tree = cast_to_preferences_number_node_tree(p);
-  if (!node_tree) return nullptr;
+  auto node = cast_to_flat_node(p);
+  if (!node) return nullptr;
 
-  return (node_tree->get_node()).get_base_unit().c_str();
+  return get_flat_node_string(node, node->base_unit);
 }
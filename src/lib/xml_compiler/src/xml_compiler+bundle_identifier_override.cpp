@@ -83,7 +83,7 @@ bool xml_compiler::bundle_identifier_override::is_rules_matched(const std::strin
 // ============================================================
 void xml_compiler::bundle_identifier_override_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "bundleidentifieroverridedef") {
+    if (it.get_tag() != tag_name::bundleidentifieroverridedef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -96,11 +96,11 @@ void xml_compiler::bundle_identifier_override_loader::traverse(const extracted_p
                           bundle_identifier_override::rule_target::end);
 
       if (!new_bundle_identifier_override->get_new_bundle_identifier()) {
-        xml_compiler_.error_information_.set("No <newbundleidentifier> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("No <newbundleidentifier> within <bundleidentifieroverridedef>.");
         continue;
       }
       if (new_bundle_identifier_override->get_new_bundle_identifier()->empty()) {
-        xml_compiler_.error_information_.set("Empty <newbundleidentifier> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("Empty <newbundleidentifier> within <bundleidentifieroverridedef>.");
         continue;
       }
 
@@ -113,37 +113,37 @@ void xml_compiler::bundle_identifier_override_loader::traverse_definition(const
                                                                           std::shared_ptr<bundle_identifier_override> new_bundle_identifier_override,
                                                                           bundle_identifier_override::rule_target current_rule_target) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() == "newbundleidentifier") {
+    if (it.get_tag() == tag_name::newbundleidentifier) {
       new_bundle_identifier_override->set_new_bundle_identifier(boost::trim_copy(it.get_data()));
 
-    } else if (it.get_tag_name() == "bundleidentifiers") {
+    } else if (it.get_tag() == tag_name::bundleidentifiers) {
       traverse_definition(it.children_extracted_ptree(), new_bundle_identifier_override, bundle_identifier_override::rule_target::bundle_identifiers);
-    } else if (it.get_tag_name() == "windownames") {
+    } else if (it.get_tag() == tag_name::windownames) {
       traverse_definition(it.children_extracted_ptree(), new_bundle_identifier_override, bundle_identifier_override::rule_target::window_names);
-    } else if (it.get_tag_name() == "uielementroles") {
+    } else if (it.get_tag() == tag_name::uielementroles) {
       traverse_definition(it.children_extracted_ptree(), new_bundle_identifier_override, bundle_identifier_override::rule_target::ui_element_roles);
 
-    } else if (it.get_tag_name() == "equal") {
+    } else if (it.get_tag() == tag_name::equal) {
       if (current_rule_target == bundle_identifier_override::rule_target::end) {
-        xml_compiler_.error_information_.set("Orphan <equal> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("Orphan <equal> within <bundleidentifieroverridedef>.");
       } else {
         new_bundle_identifier_override->add_rule_equal(current_rule_target, boost::trim_copy(it.get_data()));
       }
-    } else if (it.get_tag_name() == "prefix") {
+    } else if (it.get_tag() == tag_name::prefix) {
       if (current_rule_target == bundle_identifier_override::rule_target::end) {
-        xml_compiler_.error_information_.set("Orphan <prefix> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("Orphan <prefix> within <bundleidentifieroverridedef>.");
       } else {
         new_bundle_identifier_override->add_rule_prefix(current_rule_target, boost::trim_copy(it.get_data()));
       }
-    } else if (it.get_tag_name() == "suffix") {
+    } else if (it.get_tag() == tag_name::suffix) {
       if (current_rule_target == bundle_identifier_override::rule_target::end) {
-        xml_compiler_.error_information_.set("Orphan <suffix> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("Orphan <suffix> within <bundleidentifieroverridedef>.");
       } else {
         new_bundle_identifier_override->add_rule_suffix(current_rule_target, boost::trim_copy(it.get_data()));
       }
-    } else if (it.get_tag_name() == "regex") {
+    } else if (it.get_tag() == tag_name::regex) {
       if (current_rule_target == bundle_identifier_override::rule_target::end) {
-        xml_compiler_.error_information_.set("Orphan <regex> within <bundleidentifieroverridedef>.");
+        xml_compiler_.error_information_().set("Orphan <regex> within <bundleidentifieroverridedef>.");
       } else {
         new_bundle_identifier_override->add_rule_regex(current_rule_target, boost::trim_copy(it.get_data()));
       }
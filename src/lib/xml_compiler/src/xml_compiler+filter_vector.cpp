@@ -6,78 +6,114 @@
 namespace pqrs {
 void xml_compiler::filter_vector::traverse(const extracted_ptree& pt) {
   for (const auto& it : pt) {
-    /*  */ if (it.get_tag_name() == "not") {
-      add_(BRIDGE_FILTERTYPE_APPLICATION_NOT, "ApplicationType::", it.get_data());
-    } else if (it.get_tag_name() == "only") {
-      add_(BRIDGE_FILTERTYPE_APPLICATION_ONLY, "ApplicationType::", it.get_data());
-    } else if (it.get_tag_name() == "windowname_not") {
-      add_(BRIDGE_FILTERTYPE_WINDOWNAME_NOT, "WindowName::", it.get_data());
-    } else if (it.get_tag_name() == "windowname_only") {
-      add_(BRIDGE_FILTERTYPE_WINDOWNAME_ONLY, "WindowName::", it.get_data());
-    } else if (it.get_tag_name() == "uielementrole_not") {
-      add_(BRIDGE_FILTERTYPE_UIELEMENTROLE_NOT, "UIElementRole::", it.get_data());
-    } else if (it.get_tag_name() == "uielementrole_only") {
-      add_(BRIDGE_FILTERTYPE_UIELEMENTROLE_ONLY, "UIElementRole::", it.get_data());
-    } else if (it.get_tag_name() == "config_not") {
-      add_(BRIDGE_FILTERTYPE_CONFIG_NOT, "ConfigIndex::", it.get_data());
-    } else if (it.get_tag_name() == "config_only") {
-      add_(BRIDGE_FILTERTYPE_CONFIG_ONLY, "ConfigIndex::", it.get_data());
-    } else if (it.get_tag_name() == "device_not") {
-      add_(BRIDGE_FILTERTYPE_DEVICE_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "device_only") {
-      add_(BRIDGE_FILTERTYPE_DEVICE_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "deviceexists_not") {
-      add_(BRIDGE_FILTERTYPE_DEVICEEXISTS_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "deviceexists_only") {
-      add_(BRIDGE_FILTERTYPE_DEVICEEXISTS_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "elapsedtimesincelastpressed_greaterthan") {
-      add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTPRESSED_GREATERTHAN, "", it.get_data());
-    } else if (it.get_tag_name() == "elapsedtimesincelastpressed_lessthan") {
-      add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTPRESSED_LESSTHAN, "", it.get_data());
-    } else if (it.get_tag_name() == "elapsedtimesincelastreleased_greaterthan") {
-      add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTRELEASED_GREATERTHAN, "", it.get_data());
-    } else if (it.get_tag_name() == "elapsedtimesincelastreleased_lessthan") {
-      add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTRELEASED_LESSTHAN, "", it.get_data());
-    } else if (it.get_tag_name() == "modifier_not") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "modifier_only") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "modifierlocked_not") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_LOCKED_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "modifierlocked_only") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_LOCKED_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "modifierstuck_not") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_STUCK_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "modifierstuck_only") {
-      add_(BRIDGE_FILTERTYPE_MODIFIER_STUCK_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "inputsource_not" ||
-               it.get_tag_name() == "inputmode_not" ||
-               it.get_tag_name() == "inputsourcedetail_not" ||
-               it.get_tag_name() == "inputmodedetail_not") {
-      // We allow "inputmode_*", "inputmodedetail_*", "inputsourcedetail_*" for compatibility.
-      add_(BRIDGE_FILTERTYPE_INPUTSOURCE_NOT, "InputSource::", it.get_data());
-    } else if (it.get_tag_name() == "inputsource_only" ||
-               it.get_tag_name() == "inputmode_only" ||
-               it.get_tag_name() == "inputsourcedetail_only" ||
-               it.get_tag_name() == "inputmodedetail_only") {
-      // We allow "inputmode_*", "inputmodedetail_*", "inputsourcedetail_*" for compatibility.
-      add_(BRIDGE_FILTERTYPE_INPUTSOURCE_ONLY, "InputSource::", it.get_data());
-    } else if (it.get_tag_name() == "lastpressedphysicalkey_not") {
-      add_(BRIDGE_FILTERTYPE_LASTPRESSEDPHYSICALKEY_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "lastpressedphysicalkey_only") {
-      add_(BRIDGE_FILTERTYPE_LASTPRESSEDPHYSICALKEY_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "lastreleasedphysicalkey_not") {
-      add_(BRIDGE_FILTERTYPE_LASTRELEASEDPHYSICALKEY_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "lastreleasedphysicalkey_only") {
-      add_(BRIDGE_FILTERTYPE_LASTRELEASEDPHYSICALKEY_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "lastsentevent_not") {
-      add_(BRIDGE_FILTERTYPE_LASTSENTEVENT_NOT, "", it.get_data());
-    } else if (it.get_tag_name() == "lastsentevent_only") {
-      add_(BRIDGE_FILTERTYPE_LASTSENTEVENT_ONLY, "", it.get_data());
-    } else if (it.get_tag_name() == "pressingphysicalkeys_greaterthan") {
-      add_(BRIDGE_FILTERTYPE_PRESSINGPHYSICALKEYS_GREATERTHAN, "Count::RawValue::", it.get_data());
-    } else if (it.get_tag_name() == "pressingphysicalkeys_lessthan") {
-      add_(BRIDGE_FILTERTYPE_PRESSINGPHYSICALKEYS_LESSTHAN, "Count::RawValue::", it.get_data());
+    switch (it.get_tag()) {
+      case tag_name::not_:
+        add_(BRIDGE_FILTERTYPE_APPLICATION_NOT, "ApplicationType::", it.get_data());
+        break;
+      case tag_name::only:
+        add_(BRIDGE_FILTERTYPE_APPLICATION_ONLY, "ApplicationType::", it.get_data());
+        break;
+      case tag_name::windowname_not:
+        add_(BRIDGE_FILTERTYPE_WINDOWNAME_NOT, "WindowName::", it.get_data());
+        break;
+      case tag_name::windowname_only:
+        add_(BRIDGE_FILTERTYPE_WINDOWNAME_ONLY, "WindowName::", it.get_data());
+        break;
+      case tag_name::uielementrole_not:
+        add_(BRIDGE_FILTERTYPE_UIELEMENTROLE_NOT, "UIElementRole::", it.get_data());
+        break;
+      case tag_name::uielementrole_only:
+        add_(BRIDGE_FILTERTYPE_UIELEMENTROLE_ONLY, "UIElementRole::", it.get_data());
+        break;
+      case tag_name::config_not:
+        add_(BRIDGE_FILTERTYPE_CONFIG_NOT, "ConfigIndex::", it.get_data());
+        break;
+      case tag_name::config_only:
+        add_(BRIDGE_FILTERTYPE_CONFIG_ONLY, "ConfigIndex::", it.get_data());
+        break;
+      case tag_name::device_not:
+        add_(BRIDGE_FILTERTYPE_DEVICE_NOT, "", it.get_data());
+        break;
+      case tag_name::device_only:
+        add_(BRIDGE_FILTERTYPE_DEVICE_ONLY, "", it.get_data());
+        break;
+      case tag_name::deviceexists_not:
+        add_(BRIDGE_FILTERTYPE_DEVICEEXISTS_NOT, "", it.get_data());
+        break;
+      case tag_name::deviceexists_only:
+        add_(BRIDGE_FILTERTYPE_DEVICEEXISTS_ONLY, "", it.get_data());
+        break;
+      case tag_name::elapsedtimesincelastpressed_greaterthan:
+        add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTPRESSED_GREATERTHAN, "", it.get_data());
+        break;
+      case tag_name::elapsedtimesincelastpressed_lessthan:
+        add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTPRESSED_LESSTHAN, "", it.get_data());
+        break;
+      case tag_name::elapsedtimesincelastreleased_greaterthan:
+        add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTRELEASED_GREATERTHAN, "", it.get_data());
+        break;
+      case tag_name::elapsedtimesincelastreleased_lessthan:
+        add_(BRIDGE_FILTERTYPE_ELAPSEDTIMESINCELASTRELEASED_LESSTHAN, "", it.get_data());
+        break;
+      case tag_name::modifier_not:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_NOT, "", it.get_data());
+        break;
+      case tag_name::modifier_only:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_ONLY, "", it.get_data());
+        break;
+      case tag_name::modifierlocked_not:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_LOCKED_NOT, "", it.get_data());
+        break;
+      case tag_name::modifierlocked_only:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_LOCKED_ONLY, "", it.get_data());
+        break;
+      case tag_name::modifierstuck_not:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_STUCK_NOT, "", it.get_data());
+        break;
+      case tag_name::modifierstuck_only:
+        add_(BRIDGE_FILTERTYPE_MODIFIER_STUCK_ONLY, "", it.get_data());
+        break;
+      case tag_name::inputsource_not:
+      case tag_name::inputmode_not:
+      case tag_name::inputsourcedetail_not:
+      case tag_name::inputmodedetail_not:
+        // We allow "inputmode_*", "inputmodedetail_*", "inputsourcedetail_*" for compatibility.
+        add_(BRIDGE_FILTERTYPE_INPUTSOURCE_NOT, "InputSource::", it.get_data());
+        break;
+      case tag_name::inputsource_only:
+      case tag_name::inputmode_only:
+      case tag_name::inputsourcedetail_only:
+      case tag_name::inputmodedetail_only:
+        // We allow "inputmode_*", "inputmodedetail_*", "inputsourcedetail_*" for compatibility.
+        add_(BRIDGE_FILTERTYPE_INPUTSOURCE_ONLY, "InputSource::", it.get_data());
+        break;
+      case tag_name::lastpressedphysicalkey_not:
+        add_(BRIDGE_FILTERTYPE_LASTPRESSEDPHYSICALKEY_NOT, "", it.get_data());
+        break;
+      case tag_name::lastpressedphysicalkey_only:
+        add_(BRIDGE_FILTERTYPE_LASTPRESSEDPHYSICALKEY_ONLY, "", it.get_data());
+        break;
+      case tag_name::lastreleasedphysicalkey_not:
+        add_(BRIDGE_FILTERTYPE_LASTRELEASEDPHYSICALKEY_NOT, "", it.get_data());
+        break;
+      case tag_name::lastreleasedphysicalkey_only:
+        add_(BRIDGE_FILTERTYPE_LASTRELEASEDPHYSICALKEY_ONLY, "", it.get_data());
+        break;
+      case tag_name::lastsentevent_not:
+        add_(BRIDGE_FILTERTYPE_LASTSENTEVENT_NOT, "", it.get_data());
+        break;
+      case tag_name::lastsentevent_only:
+        add_(BRIDGE_FILTERTYPE_LASTSENTEVENT_ONLY, "", it.get_data());
+        break;
+      case tag_name::pressingphysicalkeys_greaterthan:
+        add_(BRIDGE_FILTERTYPE_PRESSINGPHYSICALKEYS_GREATERTHAN, "Count::RawValue::", it.get_data());
+        break;
+      case tag_name::pressingphysicalkeys_lessthan:
+        add_(BRIDGE_FILTERTYPE_PRESSINGPHYSICALKEYS_LESSTHAN, "Count::RawValue::", it.get_data());
+        break;
+
+      default:
+        break;
     }
   }
 }
@@ -53,9 +53,9 @@ xml_compiler::inputsource_loader::~inputsource_loader(void) {
 void xml_compiler::inputsource_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
     definition_type::type definition_type = definition_type::none;
-    if (it.get_tag_name() == "vkchangeinputsourcedef") {
+    if (it.get_tag() == tag_name::vkchangeinputsourcedef) {
       definition_type = definition_type::vkchangeinputsourcedef;
-    } else if (it.get_tag_name() == "inputsourcedef") {
+    } else if (it.get_tag() == tag_name::inputsourcedef) {
       definition_type = definition_type::inputsourcedef;
     }
 
@@ -71,27 +71,27 @@ void xml_compiler::inputsource_loader::traverse(const extracted_ptree& pt) const
       bool error = false;
 
       for (const auto& child : it.children_extracted_ptree()) {
-        if (child.get_tag_name() == "name") {
+        if (child.get_tag() == tag_name::name) {
           newinputsource->set_name(pqrs::string::remove_whitespaces_copy(child.get_data()));
 
           if (definition_type == definition_type::vkchangeinputsourcedef) {
             if (!boost::starts_with(*(newinputsource->get_name()), "KeyCode::VK_CHANGE_INPUTSOURCE_")) {
               error = true;
-              xml_compiler_.error_information_.set(boost::format("<name> within <vkchangeinputsourcedef> must start with \"KeyCode::VK_CHANGE_INPUTSOURCE_\":\n\n<name>%1%</name>") %
-                                                   *(newinputsource->get_name()));
+              xml_compiler_.error_information_().set(boost::format("<name> within <vkchangeinputsourcedef> must start with \"KeyCode::VK_CHANGE_INPUTSOURCE_\":\n\n<name>%1%</name>") %
+                                                     *(newinputsource->get_name()));
             }
           }
 
         } else {
-          if (child.get_tag_name() == "languagecode") {
+          if (child.get_tag() == tag_name::languagecode) {
             newinputsource->add_rule_languagecode(boost::trim_copy(child.get_data()));
-          } else if (child.get_tag_name() == "inputsourceid_equal") {
+          } else if (child.get_tag() == tag_name::inputsourceid_equal) {
             newinputsource->add_rule_inputsourceid_equal(boost::trim_copy(child.get_data()));
-          } else if (child.get_tag_name() == "inputsourceid_prefix") {
+          } else if (child.get_tag() == tag_name::inputsourceid_prefix) {
             newinputsource->add_rule_inputsourceid_prefix(boost::trim_copy(child.get_data()));
-          } else if (child.get_tag_name() == "inputmodeid_equal") {
+          } else if (child.get_tag() == tag_name::inputmodeid_equal) {
             newinputsource->add_rule_inputmodeid_equal(boost::trim_copy(child.get_data()));
-          } else if (child.get_tag_name() == "inputmodeid_prefix") {
+          } else if (child.get_tag() == tag_name::inputmodeid_prefix) {
             newinputsource->add_rule_inputmodeid_prefix(boost::trim_copy(child.get_data()));
           }
         }
@@ -106,14 +106,14 @@ void xml_compiler::inputsource_loader::traverse(const extracted_ptree& pt) const
 
       // name
       if (!newinputsource->get_name()) {
-        xml_compiler_.error_information_.set(boost::format("No <name> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("No <name> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
       if (newinputsource->get_name()->empty()) {
-        xml_compiler_.error_information_.set(boost::format("Empty <name> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("Empty <name> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
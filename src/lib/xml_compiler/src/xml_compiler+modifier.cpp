@@ -64,7 +64,7 @@ xml_compiler::modifier_loader::~modifier_loader(void) {
 
 void xml_compiler::modifier_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "modifierdef") {
+    if (it.get_tag() != tag_name::modifierdef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -81,13 +81,13 @@ void xml_compiler::modifier_loader::traverse(const extracted_ptree& pt) const {
         } else if (*attr_notify == "true") {
           newmodifier->set_notify(true);
         } else {
-          xml_compiler_.error_information_.set(std::string("Invalid 'notify' attribute within <modifierdef>: ") + *attr_notify);
+          xml_compiler_.error_information_().set(std::string("Invalid 'notify' attribute within <modifierdef>: ") + *attr_notify);
           continue;
         }
       }
 
       if (newmodifier->get_name()->empty()) {
-        xml_compiler_.error_information_.set("Empty <modifierdef>.");
+        xml_compiler_.error_information_().set("Empty <modifierdef>.");
         continue;
       }
 
@@ -2,7 +2,7 @@
 
 namespace pqrs {
 bool xml_compiler::preferences_node::handle_name_and_appendix_(const extracted_ptree::node& it) {
-  if (it.get_tag_name() == "name") {
+  if (it.get_tag() == tag_name::name) {
     if (!name_.empty()) {
       name_ += "\n";
     }
@@ -22,7 +22,7 @@ bool xml_compiler::preferences_node::handle_name_and_appendix_(const extracted_p
 
     return true;
 
-  } else if (it.get_tag_name() == "appendix") {
+  } else if (it.get_tag() == tag_name::appendix) {
     if (!name_.empty()) {
       name_ += "\n";
     }
@@ -41,7 +41,7 @@ bool xml_compiler::preferences_node::handle_name_and_appendix_(const extracted_p
 void xml_compiler::preferences_checkbox_node::handle_item_child(const extracted_ptree::node& it) {
   if (preferences_node::handle_name_and_appendix_(it)) {
     // do nothing
-  } else if (it.get_tag_name() == "identifier") {
+  } else if (it.get_tag() == tag_name::identifier) {
     identifier_ = boost::trim_copy(it.get_data());
   }
 }
@@ -51,7 +51,7 @@ void xml_compiler::preferences_number_node::handle_item_child(const extracted_pt
     return;
   }
 
-  if (it.get_tag_name() == "identifier") {
+  if (it.get_tag() == tag_name::identifier) {
     identifier_ = boost::trim_copy(it.get_data());
 
     // default
@@ -83,4 +83,119 @@ void xml_compiler::preferences_number_node::handle_item_child(const extracted_pt
     }
   }
 }
+
+namespace {
+class preferences_flat_tree_builder final {
+public:
+  preferences_flat_tree_builder(void) {
+    // An empty string is always at offset 0.
+    add_string("");
+  }
+
+  template <class T>
+  uint32_t add_tree(const xml_compiler::preferences_node_tree<T>& root) {
+    uint32_t root_index = static_cast<uint32_t>(nodes_.size());
+    add_node(root, PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE, PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE);
+
+    // Breadth-first order in order to store siblings contiguously.
+    std::vector<const xml_compiler::preferences_node_tree<T>*> trees;
+    trees.push_back(&root);
+
+    for (size_t i = 0; i < trees.size(); ++i) {
+      auto& children = trees[i]->get_children();
+      if (!children || children->empty()) continue;
+
+      uint32_t parent = root_index + static_cast<uint32_t>(i);
+      uint32_t first_child = static_cast<uint32_t>(nodes_.size());
+      nodes_[parent].first_child = first_child;
+      nodes_[parent].children_count = static_cast<uint32_t>(children->size());
+
+      for (size_t j = 0; j < children->size(); ++j) {
+        uint32_t next_sibling = PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE;
+        if (j + 1 < children->size()) {
+          next_sibling = first_child + static_cast<uint32_t>(j) + 1;
+        }
+
+        add_node(*((*children)[j]), parent, next_sibling);
+        trees.push_back(((*children)[j]).get());
+      }
+    }
+
+    return root_index;
+  }
+
+  void make(std::vector<char>& buffer, uint32_t checkbox_root, uint32_t number_root) const {
+    size_t nodes_size = sizeof(pqrs_xml_compiler_preferences_flat_node) * nodes_.size();
+
+    pqrs_xml_compiler_preferences_flat_tree tree;
+    tree.strings_offset = static_cast<uint32_t>(sizeof(tree) + nodes_size);
+    tree.strings_size = static_cast<uint32_t>(strings_.size());
+    tree.size = tree.strings_offset + tree.strings_size;
+    tree.checkbox_root = checkbox_root;
+    tree.number_root = number_root;
+    tree.nodes_count = static_cast<uint32_t>(nodes_.size());
+
+    buffer.resize(tree.size);
+    memcpy(&(buffer[0]), &tree, sizeof(tree));
+    if (nodes_size > 0) {
+      memcpy(&(buffer[sizeof(tree)]), &(nodes_[0]), nodes_size);
+    }
+    memcpy(&(buffer[tree.strings_offset]), strings_.c_str(), strings_.size());
+  }
+
+private:
+  uint32_t add_string(const std::string& string) {
+    auto it = string_offsets_.find(string);
+    if (it != string_offsets_.end()) {
+      return it->second;
+    }
+
+    uint32_t offset = static_cast<uint32_t>(strings_.size());
+    strings_ += string;
+    strings_ += '\0';
+    string_offsets_[string] = offset;
+    return offset;
+  }
+
+  template <class T>
+  void add_node(const xml_compiler::preferences_node_tree<T>& tree, uint32_t parent, uint32_t next_sibling) {
+    pqrs_xml_compiler_preferences_flat_node node;
+    node.index = static_cast<uint32_t>(nodes_.size());
+    node.parent = parent;
+    node.first_child = PQRS_XML_COMPILER_PREFERENCES_FLAT_NODE_NONE;
+    node.next_sibling = next_sibling;
+    node.children_count = 0;
+
+    auto& n = tree.get_node();
+    node.name = add_string(n.get_name());
+    node.identifier = add_string(n.get_identifier());
+    node.style = add_string(n.get_style());
+    node.default_value = n.get_default_value();
+    set_number_values(node, n);
+
+    nodes_.push_back(node);
+  }
+
+  void set_number_values(pqrs_xml_compiler_preferences_flat_node& node, const xml_compiler::preferences_checkbox_node&) {
+    node.base_unit = 0;
+    node.step = 1;
+  }
+  void set_number_values(pqrs_xml_compiler_preferences_flat_node& node, const xml_compiler::preferences_number_node& n) {
+    node.base_unit = add_string(n.get_base_unit());
+    node.step = n.get_step();
+  }
+
+  std::vector<pqrs_xml_compiler_preferences_flat_node> nodes_;
+  std::string strings_;
+  boost::unordered_map<std::string, uint32_t> string_offsets_;
+};
+}
+
+void xml_compiler::preferences_flat_tree::make(const preferences_node_tree<preferences_checkbox_node>& checkbox_node_tree,
+                                               const preferences_node_tree<preferences_number_node>& number_node_tree) {
+  preferences_flat_tree_builder builder;
+  uint32_t checkbox_root = builder.add_tree(checkbox_node_tree);
+  uint32_t number_root = builder.add_tree(number_node_tree);
+  builder.make(buffer_, checkbox_root, number_root);
+}
 }
@@ -110,4 +110,135 @@ void xml_compiler::remapclasses_initialize_vector::cleanup_(void) {
   data_.resize(start_index_);
   ended_ = true;
 }
+
+bool xml_compiler::remapclasses_initialize_vector::make_delta(std::vector<uint32_t>& out,
+                                                              const std::vector<uint32_t>& base) const {
+  assert(freezed_);
+
+  out.clear();
+
+  std::vector<size_t> base_offsets;
+  std::vector<size_t> offsets;
+  if (!get_offsets_(base_offsets, base)) return false;
+  if (!get_offsets_(offsets, data_)) return false;
+
+  uint32_t base_checksum = 0;
+  for (const auto& offset : base_offsets) {
+    base_checksum += get_checksum_(base, offset);
+  }
+  uint32_t checksum = 0;
+  for (const auto& offset : offsets) {
+    checksum += get_checksum_(data_, offset);
+  }
+
+  out.push_back(static_cast<uint32_t>(offsets.size()));
+  out.push_back(static_cast<uint32_t>(base_offsets.size()));
+  out.push_back(base_checksum);
+  out.push_back(checksum);
+  out.push_back(0); // the count of operations
+  const size_t index_of_operation_count = out.size() - 1;
+
+  size_t count = std::max(offsets.size(), base_offsets.size());
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t operation = BRIDGE_REMAPCLASSES_DELTA_OPERATION_NONE;
+    const std::vector<uint32_t>* v = &data_;
+    size_t offset = 0;
+
+    if (i >= base_offsets.size()) {
+      operation = BRIDGE_REMAPCLASSES_DELTA_OPERATION_ADD;
+      offset = offsets[i];
+
+    } else if (i >= offsets.size()) {
+      operation = BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE;
+      v = &base;
+      offset = base_offsets[i];
+
+    } else if (!is_equal_(base, base_offsets[i], data_, offsets[i])) {
+      operation = BRIDGE_REMAPCLASSES_DELTA_OPERATION_REPLACE;
+      offset = offsets[i];
+
+      // Virtual modifiers cannot be unregistered one by one in kext.
+      if (has_virtual_modifier_(base, base_offsets[i])) {
+        out.clear();
+        return false;
+      }
+    }
+
+    if (operation == BRIDGE_REMAPCLASSES_DELTA_OPERATION_NONE) continue;
+
+    if (has_virtual_modifier_(*v, offset)) {
+      out.clear();
+      return false;
+    }
+
+    out.push_back(operation);
+    if (operation == BRIDGE_REMAPCLASSES_DELTA_OPERATION_REMOVE) {
+      out.push_back(1);
+      out.push_back(static_cast<uint32_t>(i));
+    } else {
+      out.insert(out.end(), v->begin() + offset, v->begin() + offset + 1 + (*v)[offset]);
+    }
+    ++(out[index_of_operation_count]);
+  }
+
+  return true;
+}
+
+bool xml_compiler::remapclasses_initialize_vector::get_offsets_(std::vector<size_t>& offsets,
+                                                                const std::vector<uint32_t>& v) {
+  offsets.clear();
+
+  if (v.empty()) return false;
+
+  uint32_t count = v[INDEX_OF_CONFIG_COUNT];
+  offsets.resize(count, 0);
+
+  size_t offset = INDEX_OF_CONFIG_COUNT + 1;
+  for (uint32_t i = 0; i < count; ++i) {
+    if (offset + 1 >= v.size()) return false;
+
+    uint32_t size = v[offset];
+    uint32_t config_index = v[offset + 1];
+    if (size == 0 || offset + 1 + size > v.size()) return false;
+    if (config_index >= count || offsets[config_index] != 0) return false;
+
+    offsets[config_index] = offset;
+    offset += 1 + size;
+  }
+
+  return offset == v.size();
+}
+
+uint32_t
+xml_compiler::remapclasses_initialize_vector::get_checksum_(const std::vector<uint32_t>& v, size_t offset) {
+  return bridge_remapclasses_initialize_vector_checksum(v[offset + 1], v.data() + offset + 2, v[offset] - 1);
+}
+
+bool xml_compiler::remapclasses_initialize_vector::is_equal_(const std::vector<uint32_t>& v1, size_t offset1,
+                                                             const std::vector<uint32_t>& v2, size_t offset2) {
+  if (v1[offset1] != v2[offset2]) return false;
+
+  return std::equal(v1.begin() + offset1,
+                    v1.begin() + offset1 + 1 + v1[offset1],
+                    v2.begin() + offset2);
+}
+
+bool xml_compiler::remapclasses_initialize_vector::has_virtual_modifier_(const std::vector<uint32_t>& v, size_t offset) {
+  // skip size and configindex.
+  size_t end = offset + 1 + v[offset];
+  size_t i = offset + 2;
+
+  while (i < end) {
+    uint32_t size = v[i];
+    if (size > 0 && i + 1 < end) {
+      uint32_t type = v[i + 1];
+      if (type == BRIDGE_VK_MODIFIER || type == BRIDGE_MODIFIERNAME) {
+        return true;
+      }
+    }
+    i += 1 + size;
+  }
+
+  return false;
+}
 }
@@ -8,12 +8,12 @@
 
 namespace pqrs {
 void xml_compiler::remapclasses_initialize_vector_loader::traverse(const extracted_ptree& pt,
-                                                                   const std::string& parent_tag_name) {
+                                                                   tag_name::type parent_tag) {
   for (const auto& it : pt) {
     try {
-      if (it.get_tag_name() != "identifier") {
+      if (it.get_tag() != tag_name::identifier) {
         if (!it.children_empty()) {
-          traverse(it.children_extracted_ptree(), it.get_tag_name());
+          traverse(it.children_extracted_ptree(), it.get_tag());
         }
 
       } else {
@@ -24,7 +24,7 @@ void xml_compiler::remapclasses_initialize_vector_loader::traverse(const extract
 
         // ----------------------------------------
         auto raw_identifier = boost::trim_copy(it.get_data());
-        if (!xml_compiler_.valid_identifier_(raw_identifier, parent_tag_name)) {
+        if (!xml_compiler_.valid_identifier_(raw_identifier, parent_tag)) {
           continue;
         }
         auto identifier = raw_identifier;
@@ -60,7 +60,7 @@ void xml_compiler::remapclasses_initialize_vector_loader::traverse(const extract
       }
 
     } catch (std::exception& e) {
-      xml_compiler_.error_information_.set(e.what());
+      xml_compiler_.error_information_().set(e.what());
     }
   }
 }
@@ -72,10 +72,10 @@ void xml_compiler::remapclasses_initialize_vector_loader::traverse_autogen_(cons
 
   // ----------------------------------------
   for (const auto& it : pt) {
-    if (it.get_tag_name() == "item") {
-      xml_compiler_.error_information_.set(boost::format("You should not write <identifier> in <item> which has child <item> nodes.\nRemove <identifier>%1%</identifier>.") % raw_identifier);
+    if (it.get_tag() == tag_name::item) {
+      xml_compiler_.error_information_().set(boost::format("You should not write <identifier> in <item> which has child <item> nodes.\nRemove <identifier>%1%</identifier>.") % raw_identifier);
 
-    } else if (it.get_tag_name() != "autogen") {
+    } else if (it.get_tag() != tag_name::autogen) {
       size_t s = filter_vector_.size();
       traverse_autogen_(it.children_extracted_ptree(), identifier, raw_identifier);
       filter_vector_.resize(s);
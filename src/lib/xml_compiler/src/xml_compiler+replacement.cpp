@@ -4,7 +4,7 @@
 namespace pqrs {
 void xml_compiler::replacement_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "replacementdef") {
+    if (it.get_tag() != tag_name::replacementdef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -12,9 +12,9 @@ void xml_compiler::replacement_loader::traverse(const extracted_ptree& pt) const
       boost::optional<std::string> name;
       boost::optional<std::string> value;
       for (const auto& child : it.children_extracted_ptree()) {
-        if (child.get_tag_name() == "replacementname") {
+        if (child.get_tag() == tag_name::replacementname) {
           name = child.get_data();
-        } else if (child.get_tag_name() == "replacementvalue") {
+        } else if (child.get_tag() == tag_name::replacementvalue) {
           value = child.get_data();
         }
       }
@@ -22,20 +22,20 @@ void xml_compiler::replacement_loader::traverse(const extracted_ptree& pt) const
       // --------------------------------------------------
       // Validation
       if (!name) {
-        xml_compiler_.error_information_.set("No <replacementname> within <replacementdef>.");
+        xml_compiler_.error_information_().set("No <replacementname> within <replacementdef>.");
         continue;
       }
       if (name->empty()) {
-        xml_compiler_.error_information_.set("Empty <replacementname> within <replacementdef>.");
+        xml_compiler_.error_information_().set("Empty <replacementname> within <replacementdef>.");
         continue;
       }
       if (name->find_first_of("{{") != std::string::npos ||
           name->find_first_of("}}") != std::string::npos) {
-        xml_compiler_.error_information_.set(std::string("Do not use '{{' and '}}' within <replacementname>:\n\n") + *name);
+        xml_compiler_.error_information_().set(std::string("Do not use '{{' and '}}' within <replacementname>:\n\n") + *name);
       }
 
       if (!value) {
-        xml_compiler_.error_information_.set(std::string("No <replacementvalue> within <replacementdef>:\n\n") + *name);
+        xml_compiler_.error_information_().set(std::string("No <replacementvalue> within <replacementdef>:\n\n") + *name);
         continue;
       }
 
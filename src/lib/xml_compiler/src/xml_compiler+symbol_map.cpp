@@ -96,7 +96,7 @@ xml_compiler::symbol_map::get_name(const std::string& type, uint32_t value) cons
 // ============================================================
 void xml_compiler::symbol_map_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "symbol_map") {
+    if (it.get_tag() != tag_name::symbol_map) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -113,13 +113,13 @@ void xml_compiler::symbol_map_loader::traverse(const extracted_ptree& pt) const
 
         auto v = it.get_optional(attr);
         if (!v) {
-          xml_compiler_.error_information_.set(std::string("No '") + attrname + "' Attribute within <symbol_map>.");
+          xml_compiler_.error_information_().set(std::string("No '") + attrname + "' Attribute within <symbol_map>.");
           break;
         }
 
         std::string value = pqrs::string::remove_whitespaces_copy(*v);
         if (value.empty()) {
-          xml_compiler_.error_information_.set(std::string("Empty '") + attrname + "' Attribute within <symbol_map>.");
+          xml_compiler_.error_information_().set(std::string("Empty '") + attrname + "' Attribute within <symbol_map>.");
           continue;
         }
 
@@ -132,10 +132,10 @@ void xml_compiler::symbol_map_loader::traverse(const extracted_ptree& pt) const
 
       auto value = pqrs::string::to_uint32_t(vector[2]);
       if (!value) {
-        xml_compiler_.error_information_.set(boost::format("Invalid 'value' Attribute within <symbol_map>:\n"
-                                                           "\n"
-                                                           "<symbol_map type=\"%1%\" name=\"%2%\" value=\"%3%\" />") %
-                                             *(vector[0]) % *(vector[1]) % *(vector[2]));
+        xml_compiler_.error_information_().set(boost::format("Invalid 'value' Attribute within <symbol_map>:\n"
+                                                             "\n"
+                                                             "<symbol_map type=\"%1%\" name=\"%2%\" value=\"%3%\" />") %
+                                               *(vector[0]) % *(vector[1]) % *(vector[2]));
         continue;
       }
 
@@ -4,7 +4,7 @@
 namespace pqrs {
 void xml_compiler::ui_element_role_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "uielementroledef") {
+    if (it.get_tag() != tag_name::uielementroledef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -12,7 +12,7 @@ void xml_compiler::ui_element_role_loader::traverse(const extracted_ptree& pt) c
       std::string name = (pqrs::string::remove_whitespaces_copy(it.get_data()));
 
       if (name.empty()) {
-        xml_compiler_.error_information_.set("Empty <uielementroledef>.");
+        xml_compiler_.error_information_().set("Empty <uielementroledef>.");
         continue;
       }
 
@@ -28,7 +28,7 @@ xml_compiler::url_loader::~url_loader(void) {
 
 void xml_compiler::url_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "vkopenurldef") {
+    if (it.get_tag() != tag_name::vkopenurldef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -40,23 +40,23 @@ void xml_compiler::url_loader::traverse(const extracted_ptree& pt) const {
       bool error = false;
 
       for (const auto& child : it.children_extracted_ptree()) {
-        if (child.get_tag_name() == "name") {
+        if (child.get_tag() == tag_name::name) {
           newurl->set_name(pqrs::string::remove_whitespaces_copy(child.get_data()));
 
           if (!boost::starts_with(*(newurl->get_name()), "KeyCode::VK_OPEN_URL_")) {
             error = true;
-            xml_compiler_.error_information_.set(boost::format("<name> within <vkopenurldef> must start with \"KeyCode::VK_OPEN_URL_\":\n\n<name>%1%</name>") %
-                                                 *(newurl->get_name()));
+            xml_compiler_.error_information_().set(boost::format("<name> within <vkopenurldef> must start with \"KeyCode::VK_OPEN_URL_\":\n\n<name>%1%</name>") %
+                                                   *(newurl->get_name()));
           }
 
-        } else if (child.get_tag_name() == "url") {
+        } else if (child.get_tag() == tag_name::url) {
           newurl->set_url(boost::trim_copy(child.get_data()));
 
           auto type = child.get_optional("<xmlattr>.type");
           if (type) {
             newurl->set_type(boost::trim_copy(*type));
           }
-        } else if (child.get_tag_name() == "background") {
+        } else if (child.get_tag() == tag_name::background) {
           newurl->set_background(true);
         }
       }
@@ -70,27 +70,27 @@ void xml_compiler::url_loader::traverse(const extracted_ptree& pt) const {
 
       // name
       if (!newurl->get_name()) {
-        xml_compiler_.error_information_.set(boost::format("No <name> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("No <name> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
       if (newurl->get_name()->empty()) {
-        xml_compiler_.error_information_.set(boost::format("Empty <name> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("Empty <name> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
       // url
       if (!newurl->get_url()) {
-        xml_compiler_.error_information_.set(boost::format("No <url> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("No <url> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
       if (newurl->get_url()->empty()) {
-        xml_compiler_.error_information_.set(boost::format("Empty <url> within <%1%>.") %
-                                             it.get_tag_name());
+        xml_compiler_.error_information_().set(boost::format("Empty <url> within <%1%>.") %
+                                               it.get_tag_name());
         continue;
       }
 
@@ -21,7 +21,7 @@ bool xml_compiler::window_name::is_rules_matched(const std::string& window_name)
 // ============================================================
 void xml_compiler::window_name_loader::traverse(const extracted_ptree& pt) const {
   for (const auto& it : pt) {
-    if (it.get_tag_name() != "windownamedef") {
+    if (it.get_tag() != tag_name::windownamedef) {
       if (!it.children_empty()) {
         traverse(it.children_extracted_ptree());
       }
@@ -30,19 +30,19 @@ void xml_compiler::window_name_loader::traverse(const extracted_ptree& pt) const
       if (!newwindow_name) continue;
 
       for (const auto& child : it.children_extracted_ptree()) {
-        if (child.get_tag_name() == "name") {
+        if (child.get_tag() == tag_name::name) {
           newwindow_name->set_name(pqrs::string::remove_whitespaces_copy(child.get_data()));
-        } else if (child.get_tag_name() == "regex") {
+        } else if (child.get_tag() == tag_name::regex) {
           newwindow_name->add_rule_regex(boost::trim_copy(child.get_data()));
         }
       }
 
       if (!newwindow_name->get_name()) {
-        xml_compiler_.error_information_.set("No <name> within <windownamedef>.");
+        xml_compiler_.error_information_().set("No <name> within <windownamedef>.");
         continue;
       }
       if (newwindow_name->get_name()->empty()) {
-        xml_compiler_.error_information_.set("Empty <name> within <windownamedef>.");
+        xml_compiler_.error_information_().set("Empty <name> within <windownamedef>.");
         continue;
       }
 
@@ -73,23 +73,13 @@ bool xml_compiler::needs_reload(void) const {
 }
 
 void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
-  error_information_.clear();
   replacement_warnings_.clear();
   global_included_files_.clear();
   replacement_.clear();
-  symbol_map_.clear();
-  modifier_map_.clear();
-  app_vector_.clear();
-  bundle_identifier_override_vector_.clear();
-  window_name_vector_.clear();
-  vk_change_inputsource_map_.clear();
-  inputsource_vector_.clear();
-  vk_open_url_map_.clear();
-  identifier_map_.clear();
-  essential_configurations_.clear();
-  remapclasses_initialize_vector_.clear();
-  preferences_checkbox_node_tree_.clear();
-  preferences_number_node_tree_.clear();
+
+  // Build a new snapshot. The current snapshot is not changed until the reload is finished.
+  new_snapshot_.reset(new snapshot());
+  snapshot& s = *new_snapshot_;
 
   try {
     std::string private_xml_file_path = make_file_path(private_xml_directory_, "private.xml");
@@ -140,7 +130,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // symbol_map
     {
-      symbol_map_loader loader(*this, symbol_map_);
+      symbol_map_loader loader(*this, s.symbol_map_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -154,10 +144,10 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
     // modifier
     {
       modifier_loader loader(*this,
-                             symbol_map_,
-                             remapclasses_initialize_vector_,
-                             identifier_map_,
-                             modifier_map_);
+                             s.symbol_map_,
+                             s.remapclasses_initialize_vector_,
+                             s.identifier_map_,
+                             s.modifier_map_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -170,7 +160,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // app
     {
-      app_loader loader(*this, symbol_map_, app_vector_);
+      app_loader loader(*this, s.symbol_map_, s.app_vector_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -183,7 +173,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // bundle_identifier_override
     {
-      bundle_identifier_override_loader loader(*this, symbol_map_, bundle_identifier_override_vector_);
+      bundle_identifier_override_loader loader(*this, s.symbol_map_, s.bundle_identifier_override_vector_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -196,7 +186,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // window_name
     {
-      window_name_loader loader(*this, symbol_map_, window_name_vector_);
+      window_name_loader loader(*this, s.symbol_map_, s.window_name_vector_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -209,7 +199,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // ui_element_role
     {
-      ui_element_role_loader loader(*this, symbol_map_);
+      ui_element_role_loader loader(*this, s.symbol_map_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -222,7 +212,7 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
 
     // device
     {
-      device_loader loader(*this, symbol_map_);
+      device_loader loader(*this, s.symbol_map_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -238,11 +228,11 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
     // inputsource
     {
       inputsource_loader loader(*this,
-                                symbol_map_,
-                                remapclasses_initialize_vector_,
-                                identifier_map_,
-                                vk_change_inputsource_map_,
-                                inputsource_vector_);
+                                s.symbol_map_,
+                                s.remapclasses_initialize_vector_,
+                                s.identifier_map_,
+                                s.vk_change_inputsource_map_,
+                                s.inputsource_vector_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -257,10 +247,10 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
     // url
     {
       url_loader loader(*this,
-                        symbol_map_,
-                        remapclasses_initialize_vector_,
-                        identifier_map_,
-                        vk_open_url_map_);
+                        s.symbol_map_,
+                        s.remapclasses_initialize_vector_,
+                        s.identifier_map_,
+                        s.vk_open_url_map_);
 
       if (private_xml_ptree_ptr) {
         loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path));
@@ -285,10 +275,10 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
       {
         // prepare
         {
-          remapclasses_initialize_vector_prepare_loader<preferences_node_tree<preferences_number_node>> loader(*this, symbol_map_, essential_configurations_, &preferences_number_node_tree_);
+          remapclasses_initialize_vector_prepare_loader<preferences_node_tree<preferences_number_node>> loader(*this, s.symbol_map_, s.essential_configurations_, &s.preferences_number_node_tree_);
 
           if (number_xml_ptree_ptr) {
-            loader.traverse(make_extracted_ptree(*number_xml_ptree_ptr, number_xml_file_path), "");
+            loader.traverse(make_extracted_ptree(*number_xml_ptree_ptr, number_xml_file_path), tag_name::unknown);
             loader.fixup();
           }
           loader.cleanup();
@@ -296,14 +286,14 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
           global_included_files_.clear();
         }
         {
-          remapclasses_initialize_vector_prepare_loader<preferences_node_tree<preferences_checkbox_node>> loader(*this, symbol_map_, essential_configurations_, &preferences_checkbox_node_tree_);
+          remapclasses_initialize_vector_prepare_loader<preferences_node_tree<preferences_checkbox_node>> loader(*this, s.symbol_map_, s.essential_configurations_, &s.preferences_checkbox_node_tree_);
 
           if (private_xml_ptree_ptr) {
-            loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path), "");
+            loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path), tag_name::unknown);
             loader.fixup();
           }
           if (checkbox_xml_ptree_ptr) {
-            loader.traverse(make_extracted_ptree(*checkbox_xml_ptree_ptr, checkbox_xml_file_path), "");
+            loader.traverse(make_extracted_ptree(*checkbox_xml_ptree_ptr, checkbox_xml_file_path), tag_name::unknown);
             loader.fixup();
           }
           loader.cleanup();
@@ -314,29 +304,63 @@ void xml_compiler::reload(const std::string& checkbox_xml_file_name) {
         // ----------------------------------------
         {
           remapclasses_initialize_vector_loader loader(*this,
-                                                       symbol_map_,
-                                                       remapclasses_initialize_vector_,
-                                                       identifier_map_);
+                                                       s.symbol_map_,
+                                                       s.remapclasses_initialize_vector_,
+                                                       s.identifier_map_);
           if (private_xml_ptree_ptr) {
-            loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path), "");
+            loader.traverse(make_extracted_ptree(*private_xml_ptree_ptr, private_xml_file_path), tag_name::unknown);
           }
           if (checkbox_xml_ptree_ptr) {
-            loader.traverse(make_extracted_ptree(*checkbox_xml_ptree_ptr, checkbox_xml_file_path), "");
+            loader.traverse(make_extracted_ptree(*checkbox_xml_ptree_ptr, checkbox_xml_file_path), tag_name::unknown);
           }
 
           global_included_files_.clear();
         }
 
-        remapclasses_initialize_vector_.freeze();
+        s.remapclasses_initialize_vector_.freeze();
       }
     }
 
     if (!replacement_warnings_.empty()) {
-      error_information_.set(replacement_warnings_);
+      error_information_().set(replacement_warnings_);
     }
 
   } catch (std::exception& e) {
-    error_information_.set(e.what());
+    error_information_().set(e.what());
+  }
+
+  std::shared_ptr<snapshot> new_snapshot;
+  new_snapshot.swap(new_snapshot_);
+
+  // Keep the data of the previous snapshot if the reload failed.
+  // (We publish the partial snapshot until a reload succeeds in order to use settings which are loaded.)
+  if (s.error_information_.get_count() > 0 && reloaded_) {
+    std::shared_ptr<snapshot> previous(new snapshot(*get_snapshot()));
+    previous->error_information_ = s.error_information_;
+    std::atomic_store(&snapshot_, snapshot::ptr(previous));
+    return;
+  }
+
+  if (s.error_information_.get_count() == 0) {
+    reloaded_ = true;
+  }
+
+  s.preferences_flat_tree_.make(s.preferences_checkbox_node_tree_, s.preferences_number_node_tree_);
+
+  // Publish the new snapshot.
+  std::atomic_store(&snapshot_, snapshot::ptr(new_snapshot));
+  update_remapclasses_delta_vector_();
+}
+
+void xml_compiler::set_remapclasses_initialize_vector_uploaded(void) {
+  uploaded_remapclasses_initialize_vector_ = get_remapclasses_initialize_vector().get();
+  update_remapclasses_delta_vector_();
+}
+
+void xml_compiler::update_remapclasses_delta_vector_(void) {
+  if (!get_remapclasses_initialize_vector().make_delta(remapclasses_delta_vector_,
+                                                  uploaded_remapclasses_initialize_vector_)) {
+    remapclasses_delta_vector_.clear();
   }
 }
 
@@ -390,11 +414,11 @@ void xml_compiler::read_xml_(ptree_ptr& out,
     // So, we change "unspecified file" to file name by ourself.
     boost::replace_first(what, "<unspecified file>", std::string("<") + file_path + ">");
 
-    error_information_.set(what);
+    error_information_().set(what);
   }
 }
 
-boost::optional<const std::string&> xml_compiler::get_identifier(int config_index) const {
+boost::optional<const std::string&> xml_compiler::snapshot::get_identifier(int config_index) const {
   auto it = identifier_map_.find(config_index);
   if (it == identifier_map_.end()) {
     return boost::none;
@@ -402,7 +426,7 @@ boost::optional<const std::string&> xml_compiler::get_identifier(int config_inde
   return it->second;
 }
 
-boost::optional<int> xml_compiler::get_config_index(const std::string& identifier) const {
+boost::optional<int> xml_compiler::snapshot::get_config_index(const std::string& identifier) const {
   for (const auto& it : identifier_map_) {
     if (it.second == identifier) {
       return it.first;
@@ -411,7 +435,7 @@ boost::optional<int> xml_compiler::get_config_index(const std::string& identifie
   return boost::none;
 }
 
-boost::optional<const std::string&> xml_compiler::override_bundle_identifier(const std::string& bundle_identifier,
+boost::optional<const std::string&> xml_compiler::snapshot::override_bundle_identifier(const std::string& bundle_identifier,
                                                                              const std::string& window_name,
                                                                              const std::string& ui_element_role) const {
   for (const auto& it : bundle_identifier_override_vector_) {
@@ -425,7 +449,7 @@ boost::optional<const std::string&> xml_compiler::override_bundle_identifier(con
   return boost::none;
 }
 
-bool xml_compiler::is_app_matched(uint32_t& appid, size_t index, const std::string& application_identifier) const {
+bool xml_compiler::snapshot::is_app_matched(uint32_t& appid, size_t index, const std::string& application_identifier) const {
   if (index >= app_vector_.size()) {
     return false;
   }
@@ -447,7 +471,7 @@ bool xml_compiler::is_app_matched(uint32_t& appid, size_t index, const std::stri
   return true;
 }
 
-bool xml_compiler::is_inputsource_matched(uint32_t& inputsource,
+bool xml_compiler::snapshot::is_inputsource_matched(uint32_t& inputsource,
                                           size_t index,
                                           const std::string& languagecode,
                                           const std::string& inputsourceid,
@@ -473,7 +497,7 @@ bool xml_compiler::is_inputsource_matched(uint32_t& inputsource,
   return true;
 }
 
-bool xml_compiler::is_window_name_matched(uint32_t& windownameid, size_t index, const std::string& window_name) const {
+bool xml_compiler::snapshot::is_window_name_matched(uint32_t& windownameid, size_t index, const std::string& window_name) const {
   if (index >= window_name_vector_.size()) {
     return false;
   }
@@ -495,7 +519,7 @@ bool xml_compiler::is_window_name_matched(uint32_t& windownameid, size_t index,
   return true;
 }
 
-bool xml_compiler::is_vk_change_inputsource_matched(uint32_t keycode,
+bool xml_compiler::snapshot::is_vk_change_inputsource_matched(uint32_t keycode,
                                                     const std::string& languagecode,
                                                     const std::string& inputsourceid,
                                                     const std::string& inputmodeid) const {
@@ -510,7 +534,7 @@ bool xml_compiler::is_vk_change_inputsource_matched(uint32_t keycode,
   return it->second->is_rules_matched(languagecode, inputsourceid, inputmodeid);
 }
 
-boost::optional<const std::string&> xml_compiler::get_url(int keycode) const {
+boost::optional<const std::string&> xml_compiler::snapshot::get_url(int keycode) const {
   auto it = vk_open_url_map_.find(keycode);
   if (it == vk_open_url_map_.end()) {
     return boost::none;
@@ -522,7 +546,7 @@ boost::optional<const std::string&> xml_compiler::get_url(int keycode) const {
   return it->second->get_url();
 }
 
-boost::optional<const std::string&> xml_compiler::get_url_type(int keycode) const {
+boost::optional<const std::string&> xml_compiler::snapshot::get_url_type(int keycode) const {
   auto it = vk_open_url_map_.find(keycode);
   if (it == vk_open_url_map_.end()) {
     return boost::none;
@@ -534,7 +558,7 @@ boost::optional<const std::string&> xml_compiler::get_url_type(int keycode) cons
   return it->second->get_type();
 }
 
-bool xml_compiler::get_url_background(int keycode) const {
+bool xml_compiler::snapshot::get_url_background(int keycode) const {
   auto it = vk_open_url_map_.find(keycode);
   if (it == vk_open_url_map_.end()) {
     return false;
@@ -546,24 +570,24 @@ bool xml_compiler::get_url_background(int keycode) const {
   return it->second->get_background();
 }
 
-bool xml_compiler::valid_identifier_(const std::string& identifier, const std::string& parent_tag_name) const {
+bool xml_compiler::valid_identifier_(const std::string& identifier, tag_name::type parent_tag) const {
   if (identifier.empty()) {
-    error_information_.set("Empty <identifier>.");
+    error_information_().set("Empty <identifier>.");
     return false;
   }
 
-  if (parent_tag_name != "item") {
-    error_information_.set(boost::format("<identifier> must be placed directly under <item>:\n"
-                                         "\n"
-                                         "<identifier>%1%</identifier>") %
-                           identifier);
+  if (parent_tag != tag_name::item) {
+    error_information_().set(boost::format("<identifier> must be placed directly under <item>:\n"
+                                           "\n"
+                                           "<identifier>%1%</identifier>") %
+                             identifier);
     return false;
   }
 
   return true;
 }
 
-bool xml_compiler::debug_get_initialize_vector(std::vector<uint32_t>& out, const std::string& raw_identifier) const {
+bool xml_compiler::snapshot::debug_get_initialize_vector(std::vector<uint32_t>& out, const std::string& raw_identifier) const {
   std::string identifier = raw_identifier;
   normalize_identifier_(identifier);
 
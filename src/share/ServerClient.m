@@ -192,6 +192,26 @@
   return nil;
 }
 
+- (NSData*)event_trace {
+  NOEXCEPTION(return [self.proxy event_trace]);
+  return nil;
+}
+
+- (NSArray*)remap_statistics:(NSInteger)type {
+  NOEXCEPTION(return [self.proxy remap_statistics:type]);
+  return nil;
+}
+
+- (NSData*)latency_histograms:(BOOL)reset {
+  NOEXCEPTION(return [self.proxy latency_histograms:reset]);
+  return nil;
+}
+
+- (NSArray*)kext_log {
+  NOEXCEPTION(return [self.proxy kext_log]);
+  return nil;
+}
+
 - (NSDictionary*)focused_uielement_information {
   NOEXCEPTION(return [self.proxy focused_uielement_information]);
   return nil;
@@ -51,6 +51,10 @@
 
 // For EventViewer
 - (NSArray*)device_information:(NSInteger)type;
+- (NSData*)event_trace;
+- (NSArray*)remap_statistics:(NSInteger)type;
+- (NSData*)latency_histograms:(BOOL)reset;
+- (NSArray*)kext_log;
 - (NSDictionary*)focused_uielement_information;
 - (NSArray*)workspace_app_ids;
 - (NSArray*)workspace_window_name_ids;
@@ -1,6 +1,7 @@
 @import Cocoa;
 #import "PreferencesModel.h"
 #import "ServerClient.h"
+#include "bridge.h"
 
 @interface KarabinerCLI : NSObject
 
@@ -38,6 +39,10 @@
   [self output:@"    $ karabiner export\n"];
   [self output:@"    $ karabiner reloadxml\n"];
   [self output:@"    $ karabiner relaunch\n"];
+  [self output:@"    $ karabiner dump_event_trace (requires general.enable_event_trace)\n"];
+  [self output:@"    $ karabiner remap_statistics [items] (requires sysctl karabiner.statistics=1)\n"];
+  [self output:@"    $ karabiner latency_histogram [reset]\n"];
+  [self output:@"    $ karabiner dump_log (requires sysctl karabiner.debug=1, debug_pointing=1 or debug_devel=1)\n"];
   [self output:@"    $ karabiner be_careful_to_use__clear_all_values_by_name PROFILE_NAME\n"];
   [self output:@"\n"];
   [self output:@"Examples:\n"];
@@ -79,6 +84,159 @@
   [self.client updateStatusBar];
 }
 
+- (NSString*)traceTagName:(uint16_t)tag {
+  switch (tag) {
+  case BRIDGE_TRACE_TAG_INPUT_PUSH:
+    return @"input_push";
+  case BRIDGE_TRACE_TAG_INPUT_FIRE:
+    return @"input_fire";
+  case BRIDGE_TRACE_TAG_OUTPUT_FIRE:
+    return @"output_fire";
+  case BRIDGE_TRACE_TAG_INPUT_DROP:
+    return @"input_drop";
+  case BRIDGE_TRACE_TAG_OUTPUT_DROP:
+    return @"output_drop";
+  }
+  return [NSString stringWithFormat:@"tag:%d", tag];
+}
+
+- (NSString*)traceEventDescription:(const struct BridgeTraceEntry*)entry {
+  NSString* eventType = [self.client symbolMapName:@"EventType" value:entry->eventType];
+  NSString* flags = [NSString stringWithFormat:@"flags:0x%x", entry->flags];
+
+  switch (entry->event) {
+  case BRIDGE_TRACE_EVENT_KEYBOARD:
+    return [NSString stringWithFormat:@"keyboard %@ %@ %@",
+                                      eventType,
+                                      [self.client symbolMapName:@"KeyCode" value:entry->value],
+                                      flags];
+  case BRIDGE_TRACE_EVENT_UPDATE_FLAGS:
+    return [NSString stringWithFormat:@"update_flags %@", flags];
+  case BRIDGE_TRACE_EVENT_CONSUMER:
+    return [NSString stringWithFormat:@"consumer %@ %@ %@",
+                                      eventType,
+                                      [self.client symbolMapName:@"ConsumerKeyCode" value:entry->value],
+                                      flags];
+  case BRIDGE_TRACE_EVENT_RELATIVE_POINTER:
+    return [NSString stringWithFormat:@"relative_pointer buttons:0x%x dx:%d dy:%d", entry->value, entry->x, entry->y];
+  case BRIDGE_TRACE_EVENT_SCROLL_WHEEL:
+    return [NSString stringWithFormat:@"scroll_wheel delta1:%d delta2:%d", entry->x, entry->y];
+  case BRIDGE_TRACE_EVENT_WAIT:
+    return [NSString stringWithFormat:@"wait %dms", entry->value];
+  }
+  return [NSString stringWithFormat:@"event:%d", entry->event];
+}
+
+- (void)dumpEventTrace {
+  NSData* data = [self.client event_trace];
+  if ([data length] < sizeof(struct BridgeTraceHeader)) {
+    [self output:@"Failed to get the event trace from kext.\n"];
+    exit(1);
+  }
+
+  const struct BridgeTraceHeader* header = [data bytes];
+  const struct BridgeTraceEntry* entries = (const struct BridgeTraceEntry*)((const uint8_t*)([data bytes]) + sizeof(struct BridgeTraceHeader));
+  size_t count = ([data length] - sizeof(struct BridgeTraceHeader)) / sizeof(struct BridgeTraceEntry);
+  if (count > header->count) {
+    count = header->count;
+  }
+
+  if (header->lost > 0) {
+    [self output:[NSString stringWithFormat:@"# %d entries were lost\n", header->lost]];
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const struct BridgeTraceEntry* entry = entries + i;
+    [self output:[NSString stringWithFormat:@"%llu.%06llu %u %@ %@ device:0x%08x autogenId:%llu\n",
+                                            entry->timestamp / 1000000000,
+                                            (entry->timestamp / 1000) % 1000000,
+                                            entry->sequence,
+                                            [self traceTagName:entry->tag],
+                                            [self traceEventDescription:entry],
+                                            entry->device,
+                                            entry->autogenId]];
+  }
+}
+
+- (void)dumpRemapStatistics:(NSInteger)type {
+  NSArray* statistics = [self.client remap_statistics:type];
+  if (!statistics) {
+    [self output:@"Failed to get remap statistics from kext.\n"];
+    exit(1);
+  }
+
+  // Sort by the cumulative time.
+  statistics = [statistics sortedArrayUsingComparator:^NSComparisonResult(NSDictionary* a, NSDictionary* b) {
+    return [b[@"time"] compare:a[@"time"]];
+  }];
+
+  [self output:@"# time(us) attempts remaps filtered identifier\n"];
+  for (NSDictionary* s in statistics) {
+    NSString* identifier = s[@"identifier"];
+    if (type == BRIDGE_REMAP_STATISTICS_TYPE_ITEM) {
+      identifier = [NSString stringWithFormat:@"%@ #%@", identifier, s[@"item"]];
+    }
+    [self output:[NSString stringWithFormat:@"%llu %@ %@ %@ %@\n",
+                                            [s[@"time"] unsignedLongLongValue] / 1000,
+                                            s[@"attempts"],
+                                            s[@"remaps"],
+                                            s[@"filtered"],
+                                            identifier]];
+  }
+}
+
+- (void)dumpLog {
+  NSArray* messages = [self.client kext_log];
+  if (!messages) {
+    [self output:@"Failed to get log from kext.\n"];
+    exit(1);
+  }
+
+  for (NSString* message in messages) {
+    [self output:message];
+  }
+}
+
+// Return the upper bound (microseconds) of the bucket which contains the percentile.
+static uint64_t latencyPercentile(const struct BridgeLatencyHistogram* h, uint32_t percent) {
+  if (h->count == 0) return 0;
+
+  uint64_t threshold = (h->count * percent + 99) / 100;
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < BRIDGE_LATENCY_HISTOGRAM_BUCKET_COUNT - 1; ++i) {
+    total += h->buckets[i];
+    if (total >= threshold) {
+      uint32_t sub = BRIDGE_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT;
+      uint64_t upper = (i < sub) ? (i + 1) : ((uint64_t)(sub + 1 + i % sub) << (i / sub - 1));
+      return MIN(upper, h->max);
+    }
+  }
+  return h->max;
+}
+
+- (void)dumpLatencyHistogram:(BOOL)reset {
+  NSData* data = [self.client latency_histograms:reset];
+  if ([data length] != sizeof(struct BridgeLatencyHistogram) * BRIDGE_LATENCY_CLASS__END__) {
+    [self output:@"Failed to get latency histograms from kext.\n"];
+    exit(1);
+  }
+
+  NSArray* names = @[ @"keyboard", @"consumer", @"relative_pointer", @"scroll_wheel" ];
+
+  [self output:@"# class count avg(us) p50(us) p90(us) p99(us) max(us)\n"];
+  const struct BridgeLatencyHistogram* histograms = [data bytes];
+  for (uint32_t i = 0; i < BRIDGE_LATENCY_CLASS__END__; ++i) {
+    const struct BridgeLatencyHistogram* h = histograms + i;
+    [self output:[NSString stringWithFormat:@"%@ %llu %llu %llu %llu %llu %llu\n",
+                                            names[i],
+                                            h->count,
+                                            (h->count > 0 ? h->sum / h->count : 0),
+                                            latencyPercentile(h, 50),
+                                            latencyPercentile(h, 90),
+                                            latencyPercentile(h, 99),
+                                            h->max]];
+  }
+}
+
 - (void)main {
   NSArray* arguments = [[NSProcessInfo processInfo] arguments];
 
@@ -132,6 +290,30 @@
       } else if ([command isEqualToString:@"relaunch"]) {
         [self.client relaunch];
 
+      } else if ([command isEqualToString:@"dump_event_trace"]) {
+        [self dumpEventTrace];
+
+      } else if ([command isEqualToString:@"remap_statistics"]) {
+        if ([arguments count] == 2) {
+          [self dumpRemapStatistics:BRIDGE_REMAP_STATISTICS_TYPE_REMAPCLASS];
+        } else if ([arguments count] == 3 && [arguments[2] isEqualToString:@"items"]) {
+          [self dumpRemapStatistics:BRIDGE_REMAP_STATISTICS_TYPE_ITEM];
+        } else {
+          [self usage];
+        }
+
+      } else if ([command isEqualToString:@"dump_log"]) {
+        [self dumpLog];
+
+      } else if ([command isEqualToString:@"latency_histogram"]) {
+        if ([arguments count] == 2) {
+          [self dumpLatencyHistogram:NO];
+        } else if ([arguments count] == 3 && [arguments[2] isEqualToString:@"reset"]) {
+          [self dumpLatencyHistogram:YES];
+        } else {
+          [self usage];
+        }
+
       } else if ([command isEqualToString:@"select"]) {
         if ([arguments count] != 3) {
           [self usage];